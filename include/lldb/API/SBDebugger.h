@@ -14,6 +14,7 @@
 
 #include "lldb/API/SBDefines.h"
 #include "lldb/API/SBPlatform.h"
+#include "lldb/API/SBStructuredData.h"
 
 namespace lldb {
 
@@ -246,6 +247,13 @@ public:
 
   SBError RunREPL(lldb::LanguageType language, const char *repl_options);
 
+  //------------------------------------------------------------------
+  /// Get the statistics that "statistics dump" prints: timers,
+  /// per-module parse and index times, memory usage, cache hit rates
+  /// and remote packet statistics.
+  //------------------------------------------------------------------
+  SBStructuredData GetStatistics();
+
 private:
   friend class SBCommandInterpreter;
   friend class SBInputReader;
@@ -13,8 +13,6 @@
 #include "lldb/API/SBDefines.h"
 #include "lldb/API/SBModule.h"
 
-class StructuredDataImpl;
-
 namespace lldb {
 
 class SBStructuredData {
@@ -25,6 +23,8 @@ public:
 
   SBStructuredData(const lldb::EventSP &event_sp);
 
+  SBStructuredData(lldb_private::StructuredDataImpl *impl);
+
   ~SBStructuredData();
 
   lldb::SBStructuredData &operator=(const lldb::SBStructuredData &rhs);
@@ -33,12 +33,14 @@ public:
 
   void Clear();
 
+  lldb::SBError SetFromJSON(lldb::SBStream &stream);
+
   lldb::SBError GetAsJSON(lldb::SBStream &stream) const;
 
   lldb::SBError GetDescription(lldb::SBStream &stream) const;
 
 private:
-  std::unique_ptr<StructuredDataImpl> m_impl_up;
+  std::unique_ptr<lldb_private::StructuredDataImpl> m_impl_up;
 };
 }
 
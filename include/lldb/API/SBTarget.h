@@ -527,6 +527,39 @@ public:
   SBSymbolContext ResolveSymbolContextForAddress(const SBAddress &addr,
                                                  uint32_t resolve_scope);
 
+  //------------------------------------------------------------------
+  /// Resolve many addresses given as module offsets at once.
+  ///
+  /// This is faster than calling ResolveSymbolContextForAddress() for
+  /// each address: addresses in the same module are looked up in order
+  /// and share their compile unit, line table and block lookups, and
+  /// different modules are looked up in parallel.
+  ///
+  /// @param[in] uuids
+  ///     The UUID strings of the modules, one per offset.
+  ///
+  /// @param[in] array
+  ///     The offsets from the start of each module's image. For ELF
+  ///     files these are file addresses.
+  ///
+  /// @param[in] array_len
+  ///     The number of entries in \a uuids and \a array.
+  ///
+  /// @param[in] resolve_scope
+  ///     The symbol context items to resolve, a mask of
+  ///     lldb::SymbolContextItem values.
+  ///
+  /// @return
+  ///     A list with one symbol context per offset, in order. The symbol
+  ///     context of an offset that can't be resolved is empty. The
+  ///     inlined call chain is available through the block of each
+  ///     symbol context.
+  //------------------------------------------------------------------
+  lldb::SBSymbolContextList
+  ResolveSymbolContextsForModuleOffsets(const char **uuids, uint64_t *array,
+                                        size_t array_len,
+                                        uint32_t resolve_scope);
+
   //------------------------------------------------------------------
   /// Read target memory. If a target process is running then memory
   /// is read from here. Otherwise the memory is read from the object
@@ -245,6 +245,8 @@ private:
   // site, so let it be the
   // one to manage setting the location hit count once and only once.
   friend class StopInfoBreakpoint;
+  // The tests create sites without an owner to exercise the site lists.
+  friend class BreakpointSiteListTest;
 
   void BumpHitCounts();
 
@@ -13,8 +13,9 @@
 // C Includes
 // C++ Includes
 #include <functional>
-#include <map>
 #include <mutex>
+#include <utility>
+#include <vector>
 
 // Other libraries and framework includes
 // Project includes
@@ -154,9 +155,25 @@ public:
   //------------------------------------------------------------------
   bool RemoveByAddress(lldb::addr_t addr);
 
+  //------------------------------------------------------------------
+  /// Adds the breakpoint sites that overlap the range [\a lower_bound,
+  /// \a upper_bound) to \a bp_site_list.
+  ///
+  /// @result
+  ///   \b true if any breakpoint site overlaps the range.
+  //------------------------------------------------------------------
   bool FindInRange(lldb::addr_t lower_bound, lldb::addr_t upper_bound,
                    BreakpointSiteList &bp_site_list) const;
 
+  //------------------------------------------------------------------
+  /// Calls \a callback, in address order, for each breakpoint site that
+  /// overlaps the range [\a lower_bound, \a upper_bound). The list is
+  /// locked while \a callback runs, so it must not block.
+  //------------------------------------------------------------------
+  void ForEachInRange(
+      lldb::addr_t lower_bound, lldb::addr_t upper_bound,
+      std::function<void(BreakpointSite *)> const &callback) const;
+
   typedef void (*BreakpointSiteSPMapFunc)(lldb::BreakpointSiteSP &bp,
                                           void *baton);
 
@@ -183,23 +200,34 @@ public:
   //------------------------------------------------------------------
   size_t GetSize() const {
     std::lock_guard<std::recursive_mutex> guard(m_mutex);
-    return m_bp_site_list.size();
+    return m_sites.size();
   }
 
   bool IsEmpty() const {
     std::lock_guard<std::recursive_mutex> guard(m_mutex);
-    return m_bp_site_list.empty();
+    return m_sites.empty();
   }
 
 protected:
-  typedef std::map<lldb::addr_t, lldb::BreakpointSiteSP> collection;
+  // The sites are sorted by load address, with the addresses in their own
+  // array so that finding the site of a trap, or the sites in a range of
+  // memory being read, is a binary search over contiguous memory. Sites are
+  // added and removed far less often than they are looked up.
+  typedef std::vector<lldb::addr_t> AddressCollection;
+  typedef std::vector<lldb::BreakpointSiteSP> SiteCollection;
+  // The site IDs and addresses, sorted by ID.
+  typedef std::vector<std::pair<lldb::break_id_t, lldb::addr_t>> IDCollection;
 
-  collection::iterator GetIDIterator(lldb::break_id_t breakID);
+  // These return GetSize() if there is no such site.
+  size_t FindIndexByAddress(lldb::addr_t addr) const;
+  size_t FindIndexByID(lldb::break_id_t breakID) const;
 
-  collection::const_iterator GetIDConstIterator(lldb::break_id_t breakID) const;
+  void RemoveAtIndex(size_t index);
 
   mutable std::recursive_mutex m_mutex;
-  collection m_bp_site_list; // The breakpoint site list.
+  AddressCollection m_addresses;
+  SiteCollection m_sites; // The breakpoint sites, in address order.
+  IDCollection m_ids;
 };
 
 } // namespace lldb_private
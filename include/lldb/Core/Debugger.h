@@ -23,6 +23,7 @@
 #include "lldb/Core/FormatEntity.h"
 #include "lldb/Core/IOHandler.h"
 #include "lldb/Core/SourceManager.h"
+#include "lldb/Core/StructuredData.h"
 #include "lldb/Core/UserSettingsController.h"
 #include "lldb/Host/HostThread.h"
 #include "lldb/Host/Terminal.h"
@@ -225,7 +226,7 @@ public:
   bool EnableLog(llvm::StringRef channel,
                  llvm::ArrayRef<const char *> categories,
                  llvm::StringRef log_file, uint32_t log_options,
-                 llvm::raw_ostream &error_stream);
+                 llvm::raw_ostream &error_stream, size_t buffer_size = 0);
 
   void SetLoggingCallback(lldb::LogOutputCallback log_callback, void *baton);
 
@@ -320,6 +321,17 @@ public:
 
   Error RunREPL(lldb::LanguageType language, const char *repl_options);
 
+  //------------------------------------------------------------------
+  /// Gather performance statistics: the timer categories, the time
+  /// spent parsing and indexing each module, memory used by symbols and
+  /// strings, cache hit rates and the statistics of the processes of
+  /// this debugger's targets.
+  ///
+  /// @return
+  ///     A dictionary that "statistics dump" prints as JSON.
+  //------------------------------------------------------------------
+  StructuredData::DictionarySP GetStatistics();
+
   // This is for use in the command interpreter, when you either want the
   // selected target, or if no target
   // is present you want to prime the dummy target with entities that will be
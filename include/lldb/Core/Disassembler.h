@@ -31,8 +31,10 @@
 #include <functional> // for function
 #include <map>
 #include <memory> // for enable_shared_from_this
+#include <mutex>
 #include <set>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <stddef.h> // for size_t
@@ -84,20 +86,13 @@ public:
 
   const Address &GetAddress() const { return m_address; }
 
-  const char *GetMnemonic(const ExecutionContext *exe_ctx) {
-    CalculateMnemonicOperandsAndCommentIfNeeded(exe_ctx);
-    return m_opcode_name.c_str();
-  }
+  // These return copies, since another thread may compute the strings
+  // again for a different execution context while the caller uses them.
+  std::string GetMnemonic(const ExecutionContext *exe_ctx);
 
-  const char *GetOperands(const ExecutionContext *exe_ctx) {
-    CalculateMnemonicOperandsAndCommentIfNeeded(exe_ctx);
-    return m_mnemonics.c_str();
-  }
+  std::string GetOperands(const ExecutionContext *exe_ctx);
 
-  const char *GetComment(const ExecutionContext *exe_ctx) {
-    CalculateMnemonicOperandsAndCommentIfNeeded(exe_ctx);
-    return m_comment.c_str();
-  }
+  std::string GetComment(const ExecutionContext *exe_ctx);
 
   virtual void
   CalculateMnemonicOperandsAndComment(const ExecutionContext *exe_ctx) = 0;
@@ -246,15 +241,24 @@ protected:
   std::string m_opcode_name;
   std::string m_mnemonics;
   std::string m_comment;
+
+private:
+  // Cached instructions are shared, so they can be printed from several
+  // threads at once and in different execution contexts. The strings are
+  // symbolicated against the target and process, so they are computed again
+  // when those change or the process stops again.
+  std::mutex m_strings_mutex;
   bool m_calculated_strings;
+  const Target *m_strings_target;
+  uint32_t m_strings_process_id;
+  uint32_t m_strings_stop_id;
 
+  // m_strings_mutex must be held.
   void
-  CalculateMnemonicOperandsAndCommentIfNeeded(const ExecutionContext *exe_ctx) {
-    if (!m_calculated_strings) {
-      m_calculated_strings = true;
-      CalculateMnemonicOperandsAndComment(exe_ctx);
-    }
-  }
+  CalculateMnemonicOperandsAndCommentIfNeeded(const ExecutionContext *exe_ctx);
+
+  std::string GetString(const ExecutionContext *exe_ctx,
+                        const std::string &str);
 };
 
 namespace OperandMatchers {
@@ -377,11 +381,24 @@ public:
   FindPluginForTarget(const lldb::TargetSP target_sp, const ArchSpec &arch,
                       const char *flavor, const char *plugin_name);
 
+  // The disassembler returned for a range of a module may be shared with
+  // other callers through the module's DisassemblyCache, so it must not be
+  // modified.
   static lldb::DisassemblerSP
   DisassembleRange(const ArchSpec &arch, const char *plugin_name,
                    const char *flavor, const ExecutionContext &exe_ctx,
                    const AddressRange &disasm_range, bool prefer_file_cache);
 
+  // The branch map of the function or symbol that spans \a function_range.
+  // Maps are built from the object file contents and kept by the module's
+  // DisassemblyCache, so every caller shares them. Returns an empty shared
+  // pointer if the range can't be decoded from the object file.
+  static lldb::BranchMapSP GetBranchMap(const ArchSpec &arch,
+                                        const char *plugin_name,
+                                        const char *flavor,
+                                        const ExecutionContext &exe_ctx,
+                                        const AddressRange &function_range);
+
   static lldb::DisassemblerSP
   DisassembleBytes(const ArchSpec &arch, const char *plugin_name,
                    const char *flavor, const Address &start, const void *bytes,
@@ -456,6 +473,24 @@ public:
                                     size_t num_instructions, bool append,
                                     bool data_from_file) = 0;
 
+  //------------------------------------------------------------------
+  /// Decode all of \a data into the instruction list, the pieces of it
+  /// that start at \a chunk_starts in parallel, each with its own
+  /// disassembler. The instructions are the same as if \a data had been
+  /// decoded in one go.
+  ///
+  /// @param[in] chunk_starts
+  ///     The offsets in \a data where instructions start, in increasing
+  ///     order. The first one must be 0.
+  ///
+  /// @return
+  ///     The number of bytes that were decoded.
+  //------------------------------------------------------------------
+  size_t DecodeInstructionsInChunks(const Address &base_addr,
+                                    const DataExtractor &data,
+                                    std::vector<lldb::offset_t> chunk_starts,
+                                    bool data_from_file);
+
   InstructionList &GetInstructionList();
 
   const InstructionList &GetInstructionList() const;
@@ -544,14 +579,181 @@ protected:
   InstructionList m_instruction_list;
   lldb::addr_t m_base_addr;
   std::string m_flavor;
+  // True if ParseInstructions() read the instructions from the object file
+  // rather than from process memory.
+  bool m_decoded_from_file;
 
 private:
+  static lldb::DisassemblerSP
+  DisassembleRange(const ArchSpec &arch, const char *plugin_name,
+                   const char *flavor, const ExecutionContext &exe_ctx,
+                   const AddressRange &range, bool prefer_file_cache,
+                   Stream *error_strm_ptr);
+
+  // Split large ranges at function boundaries and decode the pieces on the
+  // task pool.
+  size_t DecodeInstructionsInParallel(const Address &base_addr,
+                                      const DataExtractor &data,
+                                      bool data_from_file);
+
+  // The disassemblers that decoded parts of m_instruction_list in parallel,
+  // the instructions refer back to them.
+  std::vector<lldb::DisassemblerSP> m_chunk_disassemblers;
+
   //------------------------------------------------------------------
   // For Disassembler only
   //------------------------------------------------------------------
   DISALLOW_COPY_AND_ASSIGN(Disassembler);
 };
 
+//----------------------------------------------------------------------
+/// @class BranchMap Disassembler.h "lldb/Core/Disassembler.h"
+/// @brief The instruction boundaries and branches of a function.
+///
+/// Stepping through a range runs to the next branch instead of single
+/// stepping every instruction. A branch map answers where that branch is
+/// without keeping the decoded instructions of the function around.
+//----------------------------------------------------------------------
+class BranchMap {
+public:
+  //------------------------------------------------------------------
+  /// Construct from the instructions of a function that starts at
+  /// \a file_addr. The instructions must be contiguous.
+  //------------------------------------------------------------------
+  BranchMap(lldb::addr_t file_addr, const InstructionList &instructions);
+
+  ~BranchMap();
+
+  lldb::addr_t GetFileAddress() const { return m_file_addr; }
+
+  size_t GetNumInstructions() const { return m_insn_offsets.size() - 1; }
+
+  //------------------------------------------------------------------
+  /// @return
+  ///     The index of the instruction that starts at \a file_addr, or
+  ///     UINT32_MAX if no instruction starts there.
+  //------------------------------------------------------------------
+  uint32_t GetIndexOfInstructionAt(lldb::addr_t file_addr) const;
+
+  //------------------------------------------------------------------
+  /// @return
+  ///     The index of the last instruction that starts before
+  ///     \a file_addr, or UINT32_MAX if \a file_addr isn't within or at
+  ///     the end of the function.
+  //------------------------------------------------------------------
+  uint32_t GetIndexOfLastInstructionBefore(lldb::addr_t file_addr) const;
+
+  //------------------------------------------------------------------
+  /// @return
+  ///     The index of the first branch at or after the instruction at
+  ///     \a start, or UINT32_MAX if there isn't one.
+  //------------------------------------------------------------------
+  uint32_t GetIndexOfNextBranch(uint32_t start) const;
+
+  lldb::addr_t GetInstructionAddress(uint32_t index) const {
+    return m_file_addr + m_insn_offsets[index];
+  }
+
+  lldb::addr_t GetInstructionEndAddress(uint32_t index) const {
+    return m_file_addr + m_insn_offsets[index + 1];
+  }
+
+private:
+  lldb::addr_t m_file_addr;
+  // The offset of each instruction from m_file_addr, followed by the offset
+  // of the end of the last instruction.
+  std::vector<uint32_t> m_insn_offsets;
+  // The indexes of the instructions that branch, in increasing order.
+  std::vector<uint32_t> m_branch_indexes;
+
+  DISALLOW_COPY_AND_ASSIGN(BranchMap);
+};
+
+//----------------------------------------------------------------------
+/// @class DisassemblyCache Disassembler.h "lldb/Core/Disassembler.h"
+/// @brief The disassembled ranges of a module, keyed by file address.
+///
+/// Instructions decoded from the object file stay valid as long as the
+/// module does. Instructions decoded from process memory are only used
+/// again while the process hasn't run or had its memory written to.
+//----------------------------------------------------------------------
+class DisassemblyCache {
+public:
+  DisassemblyCache();
+  ~DisassemblyCache();
+
+  //------------------------------------------------------------------
+  /// Find the disassembly of \a range.
+  ///
+  /// @param[in] config
+  ///     Identifies the architecture, flavor and plug-in the range was
+  ///     disassembled with.
+  ///
+  /// @param[in] prefer_file_cache
+  ///     If false and \a exe_ctx has a live process, only disassembly of
+  ///     the current process memory is returned.
+  ///
+  /// @return
+  ///     The cached disassembler, or an empty shared pointer if \a range
+  ///     hasn't been disassembled or the disassembly is out of date.
+  //------------------------------------------------------------------
+  lldb::DisassemblerSP Find(const ConstString &config,
+                            const AddressRange &range,
+                            const ExecutionContext &exe_ctx,
+                            bool prefer_file_cache);
+
+  void Add(const ConstString &config, const AddressRange &range,
+           const ExecutionContext &exe_ctx, bool from_file,
+           const lldb::DisassemblerSP &disasm_sp);
+
+  //------------------------------------------------------------------
+  /// Find the branch map of the function at \a range. Branch maps are
+  /// only built from the object file, so they never go out of date.
+  //------------------------------------------------------------------
+  lldb::BranchMapSP FindBranchMap(const ConstString &config,
+                                  const AddressRange &range);
+
+  void AddBranchMap(const ConstString &config, const AddressRange &range,
+                    const lldb::BranchMapSP &branch_map_sp);
+
+  void Clear();
+
+private:
+  struct Key {
+    lldb::addr_t file_addr;
+    lldb::addr_t byte_size;
+    const char *config;
+
+    bool operator<(const Key &rhs) const {
+      return std::tie(file_addr, byte_size, config) <
+             std::tie(rhs.file_addr, rhs.byte_size, rhs.config);
+    }
+  };
+
+  struct Entry {
+    lldb::DisassemblerSP disasm_sp;
+    size_t num_instructions;
+    bool from_file;
+    // The process state the instructions were read in, when they come from
+    // process memory.
+    uint32_t process_id;
+    uint32_t stop_id;
+    uint32_t memory_id;
+    uint64_t last_used;
+  };
+
+  std::mutex m_mutex;
+  std::map<Key, Entry> m_entries;
+  uint64_t m_use_count;
+  // The number of instructions in m_entries.
+  size_t m_num_instructions;
+  // Branch maps are a few bytes per instruction, so they are kept for as
+  // long as the module is.
+  std::map<Key, lldb::BranchMapSP> m_branch_maps;
+
+  DISALLOW_COPY_AND_ASSIGN(DisassemblyCache);
+};
+
 } // namespace lldb_private
 
 #endif // liblldb_Disassembler_h_
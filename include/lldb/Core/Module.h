@@ -59,6 +59,9 @@ namespace lldb_private {
 class Stream;
 }
 namespace lldb_private {
+class DisassemblyCache;
+}
+namespace lldb_private {
 class Symbol;
 }
 namespace lldb_private {
@@ -628,6 +631,18 @@ public:
     m_mod_time = mod_time;
   }
 
+  //------------------------------------------------------------------
+  /// Time spent parsing and indexing this module, in nanoseconds. The
+  /// code doing the work adds to these, "statistics dump" reports them.
+  //------------------------------------------------------------------
+  struct Statistics {
+    std::atomic<uint64_t> symtab_parse_nanos{0};
+    std::atomic<uint64_t> symtab_index_nanos{0};
+    std::atomic<uint64_t> debug_info_index_nanos{0};
+  };
+
+  Statistics &GetStatistics() { return m_statistics; }
+
   //------------------------------------------------------------------
   /// Tells whether this module is capable of being the main executable
   /// for a process.
@@ -698,6 +713,16 @@ public:
   //------------------------------------------------------------------
   virtual SectionList *GetSectionList();
 
+  //------------------------------------------------------------------
+  /// Get the object file, or the unified section list, only if it was
+  /// already created. Unlike GetObjectFile() and GetSectionList(), these
+  /// never load or parse anything. Hold the module's mutex when they may
+  /// race with another thread loading the module.
+  //------------------------------------------------------------------
+  ObjectFile *GetObjectFileIfLoaded() const;
+
+  SectionList *GetSectionListIfLoaded() const;
+
   //------------------------------------------------------------------
   /// Notify the module that the file addresses for the Sections have
   /// been updated.
@@ -972,6 +997,13 @@ public:
 
   PathMappingList &GetSourceMappingList() { return m_source_mappings; }
 
+  //------------------------------------------------------------------
+  /// Get the ranges of this module that have already been disassembled.
+  ///
+  /// The cache is created the first time it is asked for.
+  //------------------------------------------------------------------
+  DisassemblyCache &GetDisassemblyCache();
+
   const PathMappingList &GetSourceMappingList() const {
     return m_source_mappings;
   }
@@ -1142,6 +1174,8 @@ protected:
                                      ///is used by the ObjectFile and and
                                      ///ObjectFile instances for the debug info
 
+  Statistics m_statistics;
+  std::unique_ptr<DisassemblyCache> m_disassembly_cache_ap;
   std::atomic<bool> m_did_load_objfile{false};
   std::atomic<bool> m_did_load_symbol_vendor{false};
   std::atomic<bool> m_did_parse_uuid{false};
@@ -504,6 +504,43 @@ public:
                                           uint32_t resolve_scope,
                                           SymbolContext &sc) const;
 
+  //------------------------------------------------------------------
+  /// An address given as an offset into the module with a given UUID, the
+  /// way crash reports list them. The offset is relative to the header
+  /// address of the object file, or is a file address if the object file
+  /// has no header address (ELF).
+  //------------------------------------------------------------------
+  struct ModuleOffset {
+    UUID uuid;
+    lldb::addr_t offset;
+  };
+
+  //------------------------------------------------------------------
+  /// Resolve many module offsets at once.
+  ///
+  /// The requests are grouped by module and sorted by address. Addresses
+  /// that fall in the same line entry and block as the previous one reuse
+  /// its symbol context, and the modules are resolved in parallel.
+  ///
+  /// @param[in] requests
+  ///     The addresses to resolve.
+  ///
+  /// @param[in] resolve_scope
+  ///     The symbol context items to resolve, see
+  ///     Module::ResolveSymbolContextForAddress().
+  ///
+  /// @param[out] sc_list
+  ///     Set to one symbol context per request, in the order of
+  ///     \a requests. A symbol context is empty if its module isn't in
+  ///     this list or its address isn't in any section.
+  ///
+  /// @return
+  ///     The number of requests whose address was found in a module.
+  //------------------------------------------------------------------
+  size_t ResolveSymbolContextsForModuleOffsets(
+      const std::vector<ModuleOffset> &requests, uint32_t resolve_scope,
+      std::vector<SymbolContext> &sc_list) const;
+
   //------------------------------------------------------------------
   /// @copydoc Module::ResolveSymbolContextForFilePath (const char
   /// *,uint32_t,bool,uint32_t,SymbolContextList&)
@@ -202,8 +202,11 @@ public:
   static ObjectFileCreateMemoryInstance
   GetObjectFileCreateMemoryCallbackForPluginName(const ConstString &name);
 
+  // If plugin_name is set only that plug-in is asked to save the core file,
+  // otherwise the first plug-in that handles the process is used.
   static Error SaveCore(const lldb::ProcessSP &process_sp,
-                        const FileSpec &outfile);
+                        const FileSpec &outfile, lldb::SaveCoreStyle style,
+                        const ConstString &plugin_name = ConstString());
 
   //------------------------------------------------------------------
   // ObjectContainer
@@ -17,8 +17,10 @@
 #include "llvm/Support/Chrono.h"
 
 #include <cstdint> // for uint32_t, UINT32_MAX
+#include <list>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <stddef.h> // for size_t
 #include <string>   // for string
 #include <vector>
@@ -69,6 +71,13 @@ public:
 
     const FileSpec &GetFileSpec() { return m_file_spec; }
 
+    // The file spec this file was requested with, before any source path
+    // remapping or lookup in the target's modules.
+    const FileSpec &GetOriginalFileSpec() const { return m_file_spec_orig; }
+
+    // The target whose source path map was used to find this file, if any.
+    lldb::TargetSP GetTarget() const { return m_target_wp.lock(); }
+
     uint32_t GetSourceMapModificationID() const { return m_source_map_mod_id; }
 
     const char *PeekLineData(uint32_t line);
@@ -78,6 +87,8 @@ public:
     uint32_t GetNumLines();
 
   protected:
+    // Index the lines of the file up to and including "line", or the whole
+    // file if "line" is UINT32_MAX.
     bool CalculateLineOffsets(uint32_t line = UINT32_MAX);
 
     FileSpec m_file_spec_orig; // The original file spec that was used (can be
@@ -92,10 +103,16 @@ public:
     // If the target uses path remappings, be sure to clear our notion of a
     // source file if the path modification ID changes
     uint32_t m_source_map_mod_id = 0;
+    // The file contents, memory mapped when the file is local.
     lldb::DataBufferSP m_data_sp;
     typedef std::vector<uint32_t> LineOffsets;
     LineOffsets m_offsets;
+    // How far into m_data_sp the line offsets have been calculated, and
+    // whether that covers the whole file.
+    size_t m_scan_offset = 0;
+    bool m_offsets_complete = false;
     lldb::DebuggerWP m_debugger_wp;
+    lldb::TargetWP m_target_wp;
 
   private:
     void CommonInitializer(const FileSpec &file_spec, Target *target);
@@ -108,18 +125,30 @@ public:
   // The SourceFileCache class separates the source manager from the cache of
   // source files, so the
   // cache can be stored in the Debugger, but the source managers can be per
-  // target.
+  // target.  Only the most recently used files are kept.
+  //
+  // Files are cached by the file spec they were requested with and the target
+  // they were found with, since different targets can remap the same path to
+  // different files.
   class SourceFileCache {
   public:
-    SourceFileCache() = default;
+    SourceFileCache(size_t max_files = 64) : m_max_files(max_files) {}
     ~SourceFileCache() = default;
 
     void AddSourceFile(const FileSP &file_sp);
-    FileSP FindSourceFile(const FileSpec &file_spec) const;
+    FileSP FindSourceFile(const FileSpec &file_spec, Target *target) const;
+
+    size_t GetSize() const;
 
   protected:
-    typedef std::map<FileSpec, FileSP> FileCache;
+    // Files in most recently used order, and where each one is in that list.
+    typedef std::pair<FileSpec, Target *> FileKey;
+    typedef std::list<std::pair<FileKey, FileSP>> FileList;
+    typedef std::map<FileKey, FileList::iterator> FileCache;
+    mutable std::mutex m_mutex;
+    mutable FileList m_files;
     FileCache m_file_cache;
+    size_t m_max_files;
   };
 #endif // SWIG
 
@@ -14,6 +14,7 @@
 #include "llvm/Support/Chrono.h"
 
 #include <atomic>
+#include <vector>
 
 #include <stdint.h> // for uint32_t
 
@@ -54,6 +55,21 @@ public:
 
   static void SetQuiet(bool value);
 
+  //--------------------------------------------------------------
+  /// The time spent in a timer category, summed over all threads.
+  //--------------------------------------------------------------
+  struct CategoryStats {
+    const char *category;
+    std::chrono::nanoseconds time;
+    uint64_t count;
+  };
+
+  //--------------------------------------------------------------
+  /// Get the accumulated time of every category, sorted from the
+  /// most to the least expensive one.
+  //--------------------------------------------------------------
+  static std::vector<CategoryStats> GetCategoryStats();
+
   static void DumpCategoryTimes(Stream *s);
 
   static void ResetCategoryTimes();
@@ -73,6 +89,31 @@ private:
   DISALLOW_COPY_AND_ASSIGN(Timer);
 };
 
+//----------------------------------------------------------------------
+/// @class ScopedTimeAccumulator Timer.h "lldb/Core/Timer.h"
+/// @brief Add the time spent in a scope to a counter.
+///
+/// Timer categories are global, this is for statistics that are kept
+/// per object, like the time spent indexing a particular module.
+//----------------------------------------------------------------------
+class ScopedTimeAccumulator {
+public:
+  ScopedTimeAccumulator(std::atomic<uint64_t> &nanos)
+      : m_nanos(nanos), m_start(std::chrono::steady_clock::now()) {}
+
+  ~ScopedTimeAccumulator() {
+    m_nanos += std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - m_start)
+                   .count();
+  }
+
+private:
+  std::atomic<uint64_t> &m_nanos;
+  std::chrono::steady_clock::time_point m_start;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedTimeAccumulator);
+};
+
 } // namespace lldb_private
 
 #endif // liblldb_Timer_h_
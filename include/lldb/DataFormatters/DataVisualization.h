@@ -34,6 +34,12 @@ public:
 
   static uint32_t GetCurrentRevision();
 
+  static void DumpCacheStatistics(Stream &s);
+
+  static void ResetCacheStatistics();
+
+  static void GetCacheStatistics(uint64_t &hits, uint64_t &misses);
+
   static bool ShouldPrintAsOneLiner(ValueObject &valobj);
 
   static lldb::TypeFormatImplSP GetFormat(ValueObject &valobj,
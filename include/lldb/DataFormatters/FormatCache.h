@@ -101,8 +101,14 @@ public:
   void SetValidator(const ConstString &type,
                     lldb::TypeValidatorImplSP &synthetic_sp);
 
+  /// Drop all cached lookups. The hit/miss counters are not reset, so that
+  /// statistics survive invalidations triggered by formatter changes.
   void Clear();
 
+  size_t GetNumEntries();
+
+  void ResetStatistics();
+
   uint64_t GetCacheHits() { return m_cache_hits; }
 
   uint64_t GetCacheMisses() { return m_cache_misses; }
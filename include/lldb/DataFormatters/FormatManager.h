@@ -199,6 +199,16 @@ public:
 
   uint32_t GetCurrentRevision() override { return m_last_revision; }
 
+  // Formatter lookups are cached per type name and only invalidated by
+  // Changed(), so the hit rate reported here should approach 100% once a
+  // set of variables has been displayed.
+  void DumpCacheStatistics(Stream &s);
+
+  void ResetCacheStatistics();
+
+  // Sum of the hits and misses of all the formatter caches.
+  void GetCacheStatistics(uint64_t &hits, uint64_t &misses);
+
   static FormattersMatchVector
   GetPossibleMatches(ValueObject &valobj, lldb::DynamicValueType use_dynamic) {
     FormattersMatchVector matches;
@@ -17,6 +17,7 @@
 #include "lldb/Utility/Error.h"
 #include "lldb/lldb-private.h"
 #include <functional>
+#include <memory>
 
 class DWARFCompileUnit;
 
@@ -421,6 +422,22 @@ protected:
   bool GetOpAndEndOffsets(StackFrame &frame, lldb::offset_t &op_offset,
                           lldb::offset_t &end_offset);
 
+  //------------------------------------------------------------------
+  /// The location list entries and the simple forms of the expressions,
+  /// decoded the first time the expression is evaluated.  See
+  /// GetDecodedLocation().
+  //------------------------------------------------------------------
+  struct DecodedLocation;
+  typedef std::shared_ptr<const DecodedLocation> DecodedLocationSP;
+
+  DecodedLocationSP GetDecodedLocation() const;
+
+  //------------------------------------------------------------------
+  /// Forget the decoded location after the opcodes or the location list
+  /// slide changed.
+  //------------------------------------------------------------------
+  void ClearDecodedLocation();
+
   //------------------------------------------------------------------
   /// Classes that inherit from DWARFExpression can see and modify these
   //------------------------------------------------------------------
@@ -437,6 +454,8 @@ protected:
                                 ///offsets so that
   ///< they are relative to the object that owns the location list
   ///< (the function for frame base and variable location lists)
+  mutable DecodedLocationSP m_decoded_location_sp; ///< Only accessed with
+                                                   ///std::atomic_load/store
 };
 
 } // namespace lldb_private
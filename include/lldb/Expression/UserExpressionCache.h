@@ -0,0 +1,95 @@
+//===-- UserExpressionCache.h -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_UserExpressionCache_h_
+#define liblldb_UserExpressionCache_h_
+
+// C Includes
+// C++ Includes
+#include <list>
+#include <mutex>
+#include <string>
+
+// Other libraries and framework includes
+#include "llvm/ADT/StringRef.h"
+
+// Project includes
+#include "lldb/Expression/Expression.h"
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class UserExpressionCache UserExpressionCache.h
+/// "lldb/Expression/UserExpressionCache.h"
+/// @brief A bounded cache of parsed user expressions.
+///
+/// Parsing a user expression runs the compiler front end and usually the
+/// JIT. Expressions that are evaluated over and over, like watch
+/// expressions or expressions run by scripts on every stop, can instead
+/// reuse an expression that was parsed earlier with the same text and
+/// options, as long as UserExpression::MatchesContext() accepts the new
+/// execution context.
+///
+/// Expressions are taken out of the cache while they are in use and put
+/// back once they have completed, so a cached expression is never run by
+/// two clients at once. The least recently used entries are dropped when
+/// the cache grows past its size limit.
+//----------------------------------------------------------------------
+class UserExpressionCache {
+public:
+  struct Key {
+    std::string expr;
+    std::string prefix;
+    lldb::LanguageType language;
+    Expression::ResultType desired_type;
+    ExecutionPolicy execution_policy;
+    bool generate_debug_info;
+
+    bool operator==(const Key &rhs) const;
+  };
+
+  UserExpressionCache();
+
+  ~UserExpressionCache();
+
+  //------------------------------------------------------------------
+  /// Remove and return a cached expression that was parsed for \a key
+  /// and can be executed in \a exe_ctx, or an empty shared pointer if
+  /// there is none.
+  //------------------------------------------------------------------
+  lldb::UserExpressionSP Take(const Key &key, ExecutionContext &exe_ctx);
+
+  //------------------------------------------------------------------
+  /// Return a successfully parsed expression to the cache. The oldest
+  /// entries are dropped so that at most \a max_entries are kept.
+  //------------------------------------------------------------------
+  void Add(const Key &key, const lldb::UserExpressionSP &expr_sp,
+           size_t max_entries);
+
+  void Clear();
+
+  uint64_t GetHits() const { return m_hits; }
+
+  uint64_t GetMisses() const { return m_misses; }
+
+private:
+  typedef std::list<std::pair<Key, lldb::UserExpressionSP>> EntryList;
+
+  std::mutex m_mutex;
+  EntryList m_entries; ///< Most recently used entries are at the front.
+  uint64_t m_hits;
+  uint64_t m_misses;
+
+  DISALLOW_COPY_AND_ASSIGN(UserExpressionCache);
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_UserExpressionCache_h_
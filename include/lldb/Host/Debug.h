@@ -30,6 +30,9 @@ struct ResumeAction {
                          // eStateRunning, and eStateStepping.
   int signal; // When resuming this thread, resume it with this signal if this
               // value is > 0
+  lldb::addr_t range_start; // When stepping, keep stepping while the PC is
+  lldb::addr_t range_end;   // in [range_start, range_end). Ignored if the
+                            // range is empty.
 };
 
 //------------------------------------------------------------------
@@ -0,0 +1,83 @@
+//===-- DebugFileIndex.h ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_Host_DebugFileIndex_h
+#define liblldb_Host_DebugFileIndex_h
+
+#include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/UUID.h"
+#include "lldb/lldb-defines.h"
+
+#include "llvm/Support/Chrono.h"
+
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class DebugFileIndex DebugFileIndex.h "lldb/Host/DebugFileIndex.h"
+/// @brief An index of the build-id directories of debug file directories.
+///
+/// Separate debug files are commonly stored as
+/// "<debug-dir>/.build-id/xx/yyyy.debug", where "xxyyyy" is the build ID
+/// of the module. Looking one up used to mean a stat of that path in every
+/// debug directory for every module, which is slow when the debug
+/// directories are on a network file system.
+///
+/// This index lists each "<debug-dir>/.build-id/xx" directory once and
+/// answers later lookups from memory. A directory is listed again only
+/// when a lookup misses and its modification time has changed, so files
+/// added while the debugger runs are still found.
+//----------------------------------------------------------------------
+class DebugFileIndex {
+public:
+  DebugFileIndex() = default;
+
+  static DebugFileIndex &GetInstance();
+
+  //------------------------------------------------------------------
+  /// Find the debug file for a build ID in a debug directory.
+  ///
+  /// @param[in] debug_dir
+  ///     The debug directory that contains the ".build-id" directory.
+  ///
+  /// @param[in] uuid
+  ///     The build ID of the module.
+  ///
+  /// @return
+  ///     The path of the debug file named after \a uuid, or an empty
+  ///     FileSpec if the index has no such file.
+  //------------------------------------------------------------------
+  FileSpec FindBuildIDFile(const FileSpec &debug_dir, const UUID &uuid);
+
+  void Clear();
+
+private:
+  struct Directory {
+    bool exists = false;
+    llvm::sys::TimePoint<> mod_time;
+    std::set<std::string> file_names;
+  };
+
+  // Lists "path" into "directory" if it changed since it was last listed.
+  static void Refresh(const std::string &path, Directory &directory);
+
+  std::mutex m_mutex;
+  // The "<debug-dir>/.build-id/xx" directories, by path.
+  std::map<std::string, Directory> m_directories;
+
+  DISALLOW_COPY_AND_ASSIGN(DebugFileIndex);
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_Host_DebugFileIndex_h
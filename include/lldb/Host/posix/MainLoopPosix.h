@@ -14,12 +14,14 @@
 
 #include "llvm/ADT/DenseMap.h"
 
+#include <vector>
+
 namespace lldb_private {
 
 // Posix implementation of the MainLoopBase class. It can monitor file
 // descriptors for
-// readability using pselect. In addition to the common base, this class
-// provides the ability to
+// readability using pselect, or epoll on Linux. In addition to the common
+// base, this class provides the ability to
 // invoke a given handler when a signal is received.
 //
 // Since this class is primarily intended to be used for single-threaded
@@ -39,8 +41,27 @@ private:
 public:
   typedef std::unique_ptr<SignalHandle> SignalHandleUP;
 
+  enum class Backend {
+    // Rebuild an fd_set and call pselect on every iteration. Limited to
+    // FD_SETSIZE descriptors and linear in the number of descriptors.
+    PSelect,
+    // Keep the descriptors registered with an epoll instance and receive
+    // signals through a signalfd. Only available on Linux.
+    EPoll,
+  };
+
+  // The default backend is epoll where it is available, unless the
+  // LLDB_MAINLOOP_BACKEND environment variable is set to "pselect".
+  static Backend GetDefaultBackend();
+
+  explicit MainLoopPosix(Backend backend = GetDefaultBackend());
+
   ~MainLoopPosix() override;
 
+  // The backend in use, which is PSelect if epoll was requested but could
+  // not be set up.
+  Backend GetBackend() const { return m_backend; }
+
   ReadHandleUP RegisterReadObject(const lldb::IOObjectSP &object_sp,
                                   const Callback &callback,
                                   Error &error) override;
@@ -73,6 +94,16 @@ protected:
   void UnregisterSignal(int signo);
 
 private:
+  Error RunPSelect();
+  Error RunEPoll();
+
+  // Point the signalfd at the currently registered signals.
+  Error UpdateSignalFD();
+
+  // Invoke the callbacks of the signals that were delivered. Returns true if
+  // termination was requested.
+  bool DispatchSignals(const std::vector<int> &signals);
+
   class SignalHandle {
   public:
     ~SignalHandle() { m_mainloop.UnregisterSignal(m_signo); }
@@ -96,6 +127,9 @@ private:
 
   llvm::DenseMap<IOObject::WaitableHandle, Callback> m_read_fds;
   llvm::DenseMap<int, SignalInfo> m_signals;
+  Backend m_backend;
+  int m_epoll_fd;
+  int m_signal_fd;
   bool m_terminate_request : 1;
 };
 
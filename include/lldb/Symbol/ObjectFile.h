@@ -22,6 +22,9 @@
 #include "lldb/Symbol/UnwindPlan.h"
 #include "lldb/lldb-private.h"
 
+#include <map>
+#include <mutex>
+
 namespace lldb_private {
 
 class ObjectFileJITDelegate {
@@ -352,6 +355,15 @@ public:
   //------------------------------------------------------------------
   virtual Symtab *GetSymtab() = 0;
 
+  //------------------------------------------------------------------
+  /// Get the symbol table without parsing it.
+  ///
+  /// @return
+  ///     The symbol table if GetSymtab() already parsed it, NULL
+  ///     otherwise.
+  //------------------------------------------------------------------
+  Symtab *GetSymtabIfParsed() const { return m_symtab_ap.get(); }
+
   //------------------------------------------------------------------
   /// Appends a Symbol for the specified so_addr to the symbol table.
   ///
@@ -803,6 +815,25 @@ public:
   size_t MemoryMapSectionData(const Section *section,
                               DataExtractor &section_data) const;
 
+  //------------------------------------------------------------------
+  /// Get how many section bytes are memory mapped and how many are on
+  /// the heap.
+  ///
+  /// Sections are served as slices of the object file data, which is a
+  /// memory mapping of local files. Only sections whose contents differ
+  /// from the file, see CreateSectionDataCopy(), are copied, usually to
+  /// the heap.
+  /// Sections that haven't been parsed yet are not counted.
+  ///
+  /// @param[out] mapped_byte_size
+  ///     The number of section bytes served from a memory mapping.
+  ///
+  /// @param[out] heap_byte_size
+  ///     The number of section bytes held in heap buffers.
+  //------------------------------------------------------------------
+  void GetSectionDataByteSizes(uint64_t &mapped_byte_size,
+                               uint64_t &heap_byte_size) const;
+
   bool IsInMemory() const { return m_memory_addr != LLDB_INVALID_ADDRESS; }
 
   // Strip linker annotations (such as @@VERSION) from symbol names.
@@ -873,6 +904,30 @@ protected:
 
   ConstString GetNextSyntheticSymbolName();
 
+  //------------------------------------------------------------------
+  /// Create the contents of a section when they differ from the bytes
+  /// in the file, e.g. because the section is compressed or relocations
+  /// have to be applied to it.
+  ///
+  /// The result is cached, so this is normally called once per
+  /// section. Two threads reading the same section for the first time
+  /// may both call it.
+  ///
+  /// @return
+  ///     A buffer holding the section contents, or an empty shared
+  ///     pointer if the bytes in the file can be used as they are.
+  //------------------------------------------------------------------
+  virtual lldb::DataBufferSP CreateSectionDataCopy(const Section *section) {
+    return lldb::DataBufferSP();
+  }
+
+  lldb::DataBufferSP GetSectionDataCopy(const Section *section) const;
+
+  // The result of CreateSectionDataCopy() for each section ID, guarded by
+  // m_section_data_mutex.
+  mutable std::mutex m_section_data_mutex;
+  mutable std::map<lldb::user_id_t, lldb::DataBufferSP> m_section_data_copies;
+
 private:
   DISALLOW_COPY_AND_ASSIGN(ObjectFile);
 };
@@ -10,6 +10,7 @@
 #ifndef liblldb_Symtab_h_
 #define liblldb_Symtab_h_
 
+#include <atomic>
 #include <mutex>
 #include <vector>
 
@@ -142,6 +143,32 @@ public:
 
   ObjectFile *GetObjectFile() { return m_objfile; }
 
+  //------------------------------------------------------------------
+  /// Raw symbol names, by symbol index, that haven't been decoded into
+  /// the symbols' Mangled names yet.
+  //------------------------------------------------------------------
+  struct LazyNames {
+    /// The raw name of each symbol, or null if the symbol has its name.
+    std::vector<const char *> names;
+    /// The buffers the raw names point into.
+    std::vector<lldb::DataBufferSP> buffers;
+  };
+
+  typedef Mangled (*NameDecoder)(const char *raw_name);
+
+  //------------------------------------------------------------------
+  /// Let the symbols listed in \a lazy_names get their names only when
+  /// they are needed.
+  ///
+  /// Decoding and interning the name of every symbol of a large symbol
+  /// table is expensive when only a few symbols will ever be looked at,
+  /// e.g. when symbolicating addresses. A symbol's name is decoded with
+  /// \a decoder when the symbol is handed out by this symbol table, and
+  /// all the names are decoded when they are all needed, e.g. to build
+  /// the name indexes.
+  //------------------------------------------------------------------
+  void SetLazyNames(LazyNames lazy_names, NameDecoder decoder);
+
 protected:
   typedef std::vector<Symbol> collection;
   typedef collection::iterator iterator;
@@ -150,6 +177,8 @@ protected:
       FileRangeToIndexMap;
   void InitNameIndexes();
   void InitAddressIndexes();
+  void DecodeLazyName(size_t idx) const;
+  void DecodeAllLazyNames() const;
 
   ObjectFile *m_objfile;
   collection m_symbols;
@@ -161,6 +190,10 @@ protected:
   mutable std::recursive_mutex
       m_mutex; // Provide thread safety for this symbol table
   bool m_file_addr_to_index_computed : 1, m_name_indexes_computed : 1;
+  // Guarded by m_mutex, and only set while some names aren't decoded.
+  mutable LazyNames m_lazy_names;
+  NameDecoder m_lazy_name_decoder;
+  mutable std::atomic<bool> m_has_lazy_names;
 
 private:
   bool CheckSymbolAtIndex(size_t idx, Debug symbol_debug_type,
@@ -22,6 +22,7 @@
 
 #include <stddef.h> // for size_t
 #include <stdint.h> // for int64_t
+#include <vector>
 namespace lldb_private {
 class ModuleList;
 }
@@ -268,6 +269,13 @@ public:
                                              lldb::addr_t base_addr,
                                              bool base_addr_is_offset);
 
+  /// Creates the modules for @p files that aren't in the target yet, in
+  /// parallel, so that the LoadModuleAtAddress() calls that follow find
+  /// them in the shared module list. This parses the object file headers
+  /// and section lists and locates the separate debug files, but leaves
+  /// the symbol tables and debug info to be read when they are first used.
+  void PreloadModules(const std::vector<lldb_private::FileSpec> &files);
+
   //------------------------------------------------------------------
   /// Get information about the shared cache for a process, if possible.
   ///
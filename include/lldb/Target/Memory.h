@@ -29,6 +29,8 @@ namespace lldb_private {
 //----------------------------------------------------------------------
 class MemoryCache {
 public:
+  typedef Range<lldb::addr_t, lldb::addr_t> AddrRange;
+
   //------------------------------------------------------------------
   // Constructors and Destructors
   //------------------------------------------------------------------
@@ -38,6 +40,17 @@ public:
 
   void Clear(bool clear_invalid_ranges = false);
 
+  //------------------------------------------------------------------
+  // Called when the process stops. Instead of dropping everything that
+  // was read during previous stops, the cached blocks are set aside and
+  // verified against checksums computed by the process plug-in the first
+  // time memory is read again. Blocks whose contents did not change are
+  // reused, so re-displaying unchanged variables costs a single round
+  // trip instead of one read per cache line. If the process plug-in
+  // can't compute checksums, this is equivalent to Clear().
+  //------------------------------------------------------------------
+  void ProcessDidStop();
+
   void Flush(lldb::addr_t addr, size_t size);
 
   size_t Read(lldb::addr_t addr, void *dst, size_t dst_len, Error &error);
@@ -54,10 +67,23 @@ public:
   void AddL1CacheData(lldb::addr_t addr,
                       const lldb::DataBufferSP &data_buffer_sp);
 
+  //------------------------------------------------------------------
+  // How reads were served since the process was created. A hit is a
+  // read, or a cache line of a read, served from the cache; a miss is
+  // a read that went to the process.
+  //------------------------------------------------------------------
+  struct Statistics {
+    uint64_t l1_hits = 0;
+    uint64_t l2_hits = 0;
+    uint64_t misses = 0;
+    uint64_t reused_blocks = 0; // Blocks still valid after a stop
+  };
+
+  Statistics GetStatistics();
+
 protected:
   typedef std::map<lldb::addr_t, lldb::DataBufferSP> BlockMap;
   typedef RangeArray<lldb::addr_t, lldb::addr_t, 4> InvalidRanges;
-  typedef Range<lldb::addr_t, lldb::addr_t> AddrRange;
   //------------------------------------------------------------------
   // Classes that inherit from MemoryCache can see and modify these
   //------------------------------------------------------------------
@@ -67,11 +93,16 @@ protected:
                        // a chunk
   BlockMap m_L2_cache; // A memory cache of fixed size chinks
                        // (m_L2_cache_line_byte_size bytes in size each)
+  BlockMap m_unverified_L1_cache; // Blocks read before the last stop that
+  BlockMap m_unverified_L2_cache; // still need to be checked for changes
   InvalidRanges m_invalid_ranges;
   Process &m_process;
   uint32_t m_L2_cache_line_byte_size;
+  Statistics m_statistics;
 
 private:
+  void VerifyUnverifiedBlocks();
+
   DISALLOW_COPY_AND_ASSIGN(MemoryCache);
 };
 
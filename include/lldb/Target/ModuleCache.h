@@ -44,6 +44,17 @@ class UUID;
 /// UUID view   :
 /// /tmp/lldb/remote-linux/.cache/30C94DC6-6A1F-E951-80C3-D68D2B89E576-D5AE213C/libc.so.6
 /// Sysroot view: /tmp/lldb/remote-linux/ubuntu/lib/x86_64-linux-gnu/libc.so.6
+///
+/// The UUID view can also hold a pre-parsed symbol table for a module:
+///  /${CACHE_ROOT}/.cache/${UUID}/${MODULE_FILENAME}.symtab
+/// The file only contains offsets (symbol values are section IDs plus
+/// section offsets, names are offsets into a string table), so it is mapped
+/// read-only and shared through the page cache by every debugger process
+/// that loads the same module.
+///
+/// It can also hold the decompressed contents of compressed sections:
+///  /${CACHE_ROOT}/.cache/${UUID}/${MODULE_FILENAME}${SECTION_NAME}.section
+/// These are mapped read-only too.
 //----------------------------------------------------------------------
 
 class ModuleCache {
@@ -59,6 +70,48 @@ public:
                   const SymfileDownloader &symfile_downloader,
                   lldb::ModuleSP &cached_module_sp, bool *did_create_ptr);
 
+  //------------------------------------------------------------------
+  /// Save the symbol table of \a objfile in the cache under
+  /// \a root_dir_spec. Fails if the object file has no UUID or if a symbol
+  /// refers to a section that isn't in the object file's section list.
+  //------------------------------------------------------------------
+  static Error PutSymtab(const FileSpec &root_dir_spec, ObjectFile &objfile,
+                         const Symtab &symtab);
+
+  //------------------------------------------------------------------
+  /// Fill in \a symtab from the symbol table cached for \a objfile under
+  /// \a root_dir_spec.
+  ///
+  /// @return
+  ///     True if a symbol table that matches the object file on disk was
+  ///     found and loaded, false otherwise (\a symtab is left untouched).
+  //------------------------------------------------------------------
+  static bool GetSymtab(const FileSpec &root_dir_spec, ObjectFile &objfile,
+                        Symtab &symtab);
+
+  //------------------------------------------------------------------
+  /// Save \a data, the contents of the section \a section_name of
+  /// \a objfile, in the cache under \a root_dir_spec. Fails if the object
+  /// file has no UUID.
+  //------------------------------------------------------------------
+  static Error PutSectionData(const FileSpec &root_dir_spec,
+                              ObjectFile &objfile,
+                              const ConstString &section_name,
+                              const DataBuffer &data);
+
+  //------------------------------------------------------------------
+  /// Get the contents of the section \a section_name of \a objfile saved
+  /// under \a root_dir_spec.
+  ///
+  /// @return
+  ///     The section contents, mapped from the cache directory if they
+  ///     are large enough, or an empty shared pointer if there are no
+  ///     contents cached for this object file on disk.
+  //------------------------------------------------------------------
+  static lldb::DataBufferSP GetSectionData(const FileSpec &root_dir_spec,
+                                           ObjectFile &objfile,
+                                           const ConstString &section_name);
+
 private:
   Error Put(const FileSpec &root_dir_spec, const char *hostname,
             const ModuleSpec &module_spec, const FileSpec &tmp_file,
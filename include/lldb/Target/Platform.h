@@ -50,6 +50,12 @@ public:
 
   FileSpec GetModuleCacheDirectory() const;
   bool SetModuleCacheDirectory(const FileSpec &dir_spec);
+
+  bool GetUseSymtabCache() const;
+  bool SetUseSymtabCache(bool use_symtab_cache);
+
+  bool GetCacheDecompressedSections() const;
+  bool SetCacheDecompressedSections(bool cache_sections);
 };
 
 typedef std::shared_ptr<PlatformProperties> PlatformPropertiesSP;
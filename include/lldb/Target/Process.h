@@ -52,6 +52,7 @@
 #include "lldb/lldb-private.h"
 
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/Optional.h"
 
 namespace lldb_private {
 
@@ -98,6 +99,8 @@ public:
 
   bool GetWarningsOptimization() const;
 
+  bool GetRevalidateMemoryCache() const;
+
 protected:
   static void OptionValueChangedCallback(void *baton,
                                          OptionValue *option_value);
@@ -1580,6 +1583,17 @@ public:
     return StructuredData::ObjectSP();
   }
 
+  //------------------------------------------------------------------
+  /// Get statistics about this process for "statistics dump".
+  ///
+  /// The base class reports the memory cache hit rates. Plug-ins that
+  /// talk to the process over a protocol add their own counters.
+  ///
+  /// @return
+  ///     A dictionary of statistics, never null.
+  //------------------------------------------------------------------
+  virtual StructuredData::DictionarySP GetStatistics();
+
   //------------------------------------------------------------------
   /// Print a user-visible warning about a module being built with optimization
   ///
@@ -1786,6 +1800,19 @@ public:
   size_t ReadCStringFromMemory(lldb::addr_t vm_addr, std::string &out_str,
                                Error &error);
 
+  //------------------------------------------------------------------
+  /// Read memory for saving into a core file.
+  ///
+  /// Unlike ReadMemory(), this doesn't stop at the first page that can't
+  /// be read: unreadable pages are filled with zeros and reading carries
+  /// on after them, so  buf always receives  size bytes.
+  ///
+  /// @return
+  ///     The number of bytes that were actually read from the process.
+  //------------------------------------------------------------------
+  size_t ReadMemoryZeroFillingGaps(lldb::addr_t vm_addr, void *buf,
+                                   size_t size);
+
   size_t ReadMemoryFromInferior(lldb::addr_t vm_addr, void *buf, size_t size,
                                 Error &error);
 
@@ -2061,6 +2088,33 @@ public:
   virtual Error
   GetMemoryRegions(std::vector<lldb::MemoryRegionInfoSP> &region_list);
 
+  //------------------------------------------------------------------
+  /// Compute a checksum of the current contents of several memory
+  /// ranges at once.
+  ///
+  /// The memory cache uses this after a stop to find out which of the
+  /// blocks it read earlier are still valid without reading them again.
+  /// Checksums are CRC-32 values as computed by llvm::JamCRC.
+  ///
+  /// @param[in] ranges
+  ///     The load address ranges to checksum.
+  ///
+  /// @param[out] checksums
+  ///     One entry per range, in the same order. Ranges that could not
+  ///     be read completely have no value.
+  ///
+  /// @return
+  ///     An error value. Fails if the process plug-in can't compute
+  ///     checksums.
+  //------------------------------------------------------------------
+  virtual Error
+  CalculateMemoryChecksums(llvm::ArrayRef<MemoryCache::AddrRange> ranges,
+                           std::vector<llvm::Optional<uint32_t>> &checksums) {
+    Error error;
+    error.SetErrorString("Process::CalculateMemoryChecksums() not supported");
+    return error;
+  }
+
   virtual Error GetWatchpointSupportInfo(uint32_t &num) {
     Error error;
     num = 0;
@@ -28,6 +28,7 @@
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/UserSettingsController.h"
 #include "lldb/Expression/Expression.h"
+#include "lldb/Expression/UserExpressionCache.h"
 #include "lldb/Symbol/TypeSystem.h"
 #include "lldb/Target/ExecutionContextScope.h"
 #include "lldb/Target/PathMappingList.h"
@@ -177,6 +178,8 @@ public:
 
   bool GetNonStopModeEnabled() const;
 
+  uint64_t GetExpressionCacheSize() const;
+
   void SetNonStopModeEnabled(bool b);
 
   bool GetDisplayRuntimeSupportValues() const;
@@ -991,6 +994,13 @@ public:
       Expression::ResultType desired_type,
       const EvaluateExpressionOptions &options, Error &error);
 
+  // Parsed user expressions that can be reused by later evaluations of the
+  // same text. Cleared whenever modules are loaded or unloaded, since that
+  // can change what names in an expression refer to.
+  UserExpressionCache &GetUserExpressionCache() {
+    return m_user_expression_cache;
+  }
+
   // Creates a FunctionCaller for the given language, the rest of the parameters
   // have the
   // same meaning as for the FunctionCaller constructor.  Since a FunctionCaller
@@ -1232,6 +1242,8 @@ protected:
 
   lldb::SourceManagerUP m_source_manager_ap;
 
+  UserExpressionCache m_user_expression_cache;
+
   typedef std::map<lldb::user_id_t, StopHookSP> StopHookCollection;
   StopHookCollection m_stop_hooks;
   lldb::user_id_t m_stop_hook_next_id;
@@ -268,6 +268,18 @@ public:
 
   bool ThreadStoppedForAReason();
 
+  //------------------------------------------------------------------
+  /// Tell whether this thread can be left out of stop processing.
+  ///
+  /// This is cheap: it never asks the process plug-in for the thread's
+  /// stop info.
+  ///
+  /// @return
+  ///     True if the thread is only running its base plan, has no completed
+  ///     plans, and is known to have no stop reason for the current stop.
+  //------------------------------------------------------------------
+  bool IsIdleAtStop();
+
   static const char *RunModeAsCString(lldb::RunMode mode);
 
   static const char *StopReasonAsCString(lldb::StopReason reason);
@@ -1202,6 +1214,16 @@ public:
   //----------------------------------------------------------------------
   virtual bool CalculateStopInfo() = 0;
 
+  //----------------------------------------------------------------------
+  // Thread subclasses whose process already knows which threads stopped
+  // for a reason can override this so that threads that didn't can be
+  // skipped without calculating their stop info.
+  //
+  // @return
+  //      True only if CalculateStopInfo() would set no stop info.
+  //----------------------------------------------------------------------
+  virtual bool KnownToHaveNoStopReason() { return false; }
+
   //----------------------------------------------------------------------
   // Gets the temporary resume state for a thread.
   //
@@ -444,6 +444,15 @@ public:
 
   virtual bool StopOthers();
 
+  // If this plan is going to single step until the PC leaves a range of
+  // load addresses, return that range as [range_start, range_end). Process
+  // plugins whose debug server can step through a range on its own use this
+  // so the process doesn't stop after every instruction.
+  virtual bool GetSteppingRange(lldb::addr_t &range_start,
+                                lldb::addr_t &range_end) {
+    return false;
+  }
+
   // This is the wrapper for DoWillResume that does generic ThreadPlan logic,
   // then
   // calls DoWillResume.
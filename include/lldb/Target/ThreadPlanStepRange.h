@@ -37,6 +37,8 @@ public:
   bool ShouldStop(Event *event_ptr) override = 0;
   Vote ShouldReportStop(Event *event_ptr) override;
   bool StopOthers() override;
+  bool GetSteppingRange(lldb::addr_t &range_start,
+                        lldb::addr_t &range_end) override;
   lldb::StateType GetPlanRunState() override;
   bool WillStop() override;
   bool MischiefManaged() override;
@@ -64,6 +66,12 @@ protected:
   // plan, then just single step.
   bool SetNextBranchBreakpoint();
 
+  // Find where to run to from \a pc using the branch map of the function
+  // that contains the current range. Returns false if there is no usable
+  // map, otherwise \a run_to_address is left invalid when the next branch
+  // is too close to be worth a breakpoint.
+  bool GetRunToAddressFromBranchMap(lldb::addr_t pc, Address &run_to_address);
+
   void ClearNextBranchBreakpoint();
 
   bool NextRangeBreakpointExplainsStop(lldb::StopInfoSP stop_info_sp);
@@ -84,7 +92,17 @@ protected:
   bool m_given_ranges_only;
 
 private:
+  BranchMap *GetBranchMapForRange(size_t range_index);
+
+  struct RangeBranchMap {
+    bool looked_up = false;
+    lldb::BranchMapSP branch_map_sp;
+  };
+
   std::vector<lldb::DisassemblerSP> m_instruction_ranges;
+  // The branch map of the function each of m_address_ranges is in, looked up
+  // the first time we step in that range.
+  std::vector<RangeBranchMap> m_branch_maps;
 
   DISALLOW_COPY_AND_ASSIGN(ThreadPlanStepRange);
 };
@@ -84,6 +84,12 @@ public:
   //------------------------------------------------------------------
   virtual lldb::offset_t GetByteSize() const = 0;
 
+  //------------------------------------------------------------------
+  /// Tells whether the bytes are a memory mapping of a file rather than
+  /// a copy on the heap.
+  //------------------------------------------------------------------
+  virtual bool IsMemoryMapped() const { return false; }
+
   llvm::ArrayRef<uint8_t> GetData() const {
     return llvm::ArrayRef<uint8_t>(GetBytes(), GetByteSize());
   }
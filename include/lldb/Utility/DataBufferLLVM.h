@@ -36,6 +36,7 @@ public:
   uint8_t *GetBytes() override;
   const uint8_t *GetBytes() const override;
   lldb::offset_t GetByteSize() const override;
+  bool IsMemoryMapped() const override;
 
   char *GetChars() { return reinterpret_cast<char *>(GetBytes()); }
 
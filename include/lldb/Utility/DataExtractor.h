@@ -936,6 +936,8 @@ public:
 
   lldb::DataBufferSP &GetSharedDataBuffer() { return m_data_sp; }
 
+  const lldb::DataBufferSP &GetSharedDataBuffer() const { return m_data_sp; }
+
   //------------------------------------------------------------------
   /// Peek at a C string at \a offset.
   ///
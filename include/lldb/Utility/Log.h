@@ -23,7 +23,9 @@
 #include <atomic>
 #include <cstdarg>
 #include <cstdint>
+#include <deque>
 #include <memory>      // for shared_ptr
+#include <mutex>
 #include <string>      // for string
 #include <type_traits> // for forward
 
@@ -45,6 +47,12 @@ template <class C> class ManagedStatic;
 #define LLDB_LOG_OPTION_BACKTRACE (1U << 7)
 #define LLDB_LOG_OPTION_APPEND (1U << 8)
 #define LLDB_LOG_OPTION_PREPEND_FILE_FUNCTION (1U << 9)
+// Queue log records in per-thread buffers and write them from a background
+// thread instead of formatting and writing them on the logging thread.
+#define LLDB_LOG_OPTION_BUFFERED (1U << 10)
+// Keep the most recent log records in memory and only write them when the
+// channel is dumped or lldb crashes. Implies LLDB_LOG_OPTION_BUFFERED.
+#define LLDB_LOG_OPTION_CIRCULAR (1U << 11)
 
 //----------------------------------------------------------------------
 // Logging Functions
@@ -108,7 +116,23 @@ public:
   EnableLogChannel(const std::shared_ptr<llvm::raw_ostream> &log_stream_sp,
                    uint32_t log_options, llvm::StringRef channel,
                    llvm::ArrayRef<const char *> categories,
-                   llvm::raw_ostream &error_stream);
+                   llvm::raw_ostream &error_stream, size_t buffer_size = 0);
+
+  // Write the records a LLDB_LOG_OPTION_CIRCULAR channel kept in memory to
+  // \a stream_sp, or to the stream the channel was enabled with if it is
+  // null, and forget them.
+  static bool DumpLogChannel(llvm::StringRef channel,
+                             const std::shared_ptr<llvm::raw_ostream> &stream_sp,
+                             llvm::raw_ostream &error_stream);
+
+  // Write out the records of all buffered channels that have not been written
+  // yet, including the ones circular channels kept in memory. When lldb
+  // crashes, only the records circular channels kept in memory are written.
+  static void FlushBufferedLogChannels();
+
+  // Write out the records buffered channels still hold and stop the thread
+  // writing them. This must be called before the channels are destroyed.
+  static void Terminate();
 
   static bool DisableLogChannel(llvm::StringRef channel,
                                 llvm::ArrayRef<const char *> categories,
@@ -128,7 +152,7 @@ public:
   // object and writing to it, the output will be silently discarded.
   //------------------------------------------------------------------
   Log(Channel &channel) : m_channel(channel) {}
-  ~Log() = default;
+  ~Log();
 
   void PutCString(const char *cstr);
   void PutString(llvm::StringRef str);
@@ -158,6 +182,9 @@ public:
   bool GetVerbose() const;
 
 private:
+  struct Record;
+  class RecordBuffer;
+
   Channel &m_channel;
 
   // The mutex makes sure enable/disable operations are thread-safe. The options
@@ -170,10 +197,22 @@ private:
   std::atomic<uint32_t> m_options{0};
   std::atomic<uint32_t> m_mask{0};
 
+  // The formatted records of a LLDB_LOG_OPTION_CIRCULAR channel, oldest
+  // first.
+  std::mutex m_circular_mutex;
+  std::deque<std::string> m_circular_records;
+  size_t m_circular_capacity = 0;
+  // The stream the records are written to when lldb crashes.
+  std::shared_ptr<llvm::raw_ostream> m_circular_stream_sp;
+
   void WriteHeader(llvm::raw_ostream &OS, llvm::StringRef file,
                    llvm::StringRef function);
   void WriteMessage(const std::string &message);
 
+  void WriteRecord(const Record &record, std::string &output);
+  void WriteCircularRecords(llvm::raw_ostream &stream);
+  void WriteCircularRecordsOnCrash();
+
   void Format(llvm::StringRef file, llvm::StringRef function,
               const llvm::formatv_object_base &payload);
 
@@ -183,13 +222,15 @@ private:
   }
 
   void Enable(const std::shared_ptr<llvm::raw_ostream> &stream_sp,
-              uint32_t options, uint32_t flags);
+              uint32_t options, uint32_t flags, size_t buffer_size);
 
   void Disable(uint32_t flags);
 
   typedef llvm::StringMap<Log> ChannelMap;
   static llvm::ManagedStatic<ChannelMap> g_channel_map;
 
+  static void DumpCircularLogsOnCrash(void *);
+
   static void ListCategories(llvm::raw_ostream &stream,
                              const ChannelMap::value_type &entry);
   static uint32_t GetFlags(llvm::raw_ostream &stream, const ChannelMap::value_type &entry,
@@ -1068,6 +1068,16 @@ enum TypeSummaryCapping {
   eTypeSummaryUncapped = false
 };
 
+//----------------------------------------------------------------------
+// How much of a process' memory "process save-core" writes out
+//----------------------------------------------------------------------
+enum SaveCoreStyle {
+  eSaveCoreUnspecified = 0,
+  eSaveCoreFull,      // All readable memory
+  eSaveCoreDirtyOnly, // Skip read-only memory that is backed by a file
+  eSaveCoreStackOnly  // Only the thread stacks
+};
+
 } // namespace lldb
 
 #endif // LLDB_lldb_enumerations_h_
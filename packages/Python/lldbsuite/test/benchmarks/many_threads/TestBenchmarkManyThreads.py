@@ -0,0 +1,50 @@
+"""
+Benchmark stopping at a breakpoint in a process with many idle threads.
+"""
+
+from __future__ import print_function
+
+
+import os
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestBenchmarkManyThreads(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.num_threads = 1000
+
+    @benchmarks_test
+    @skipIfWindows
+    def test_continue_with_many_threads(self):
+        """Benchmark continuing to a breakpoint with many idle threads"""
+        self.build()
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        bkpt = target.BreakpointCreateBySourceRegex(
+            "// break here", lldb.SBFileSpec("main.cpp"))
+        self.assertTrue(bkpt.GetNumLocations() > 0, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(
+            [str(self.num_threads)], None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        stopwatch = Stopwatch()
+        for i in range(0, 25):
+            stopwatch.start()
+            threads = lldbutil.continue_to_breakpoint(process, bkpt)
+            stopwatch.stop()
+            # Only the thread that hit the breakpoint has a stop reason.
+            self.assertEqual(len(threads), 1)
+            self.assertGreater(process.GetNumThreads(), self.num_threads)
+
+        print("continue with %d threads: %s" % (self.num_threads, stopwatch))
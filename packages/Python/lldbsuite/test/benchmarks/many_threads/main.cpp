@@ -0,0 +1,38 @@
+#include <condition_variable>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+std::mutex g_mutex;
+std::condition_variable g_cv;
+bool g_done = false;
+int g_counter = 0;
+
+void idle_thread() {
+  std::unique_lock<std::mutex> lock(g_mutex);
+  g_cv.wait(lock, [] { return g_done; });
+}
+
+void hit_breakpoint(int i) {
+  g_counter += i; // break here
+}
+
+int main(int argc, char const *argv[]) {
+  int num_threads = argc > 1 ? atoi(argv[1]) : 1000;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_threads; ++i)
+    threads.push_back(std::thread(idle_thread));
+
+  for (int i = 0; i < 30; ++i)
+    hit_breakpoint(i);
+
+  {
+    std::lock_guard<std::mutex> lock(g_mutex);
+    g_done = true;
+  }
+  g_cv.notify_all();
+  for (auto &thread : threads)
+    thread.join();
+  return 0;
+}
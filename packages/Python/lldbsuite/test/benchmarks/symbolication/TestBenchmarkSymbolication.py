@@ -0,0 +1,117 @@
+"""
+Benchmark symbolicating a shuffled set of module offsets from several modules,
+one address at a time and with SBTarget.ResolveSymbolContextsForModuleOffsets.
+"""
+
+from __future__ import print_function
+
+
+import os
+import random
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbbench import *
+from lldbsuite.test.lldbtest import *
+
+
+class TestBenchmarkSymbolication(BenchBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        BenchBase.setUp(self)
+        self.resolve_scope = (lldb.eSymbolContextFunction |
+                              lldb.eSymbolContextBlock |
+                              lldb.eSymbolContextLineEntry)
+
+    def module_base(self, module):
+        """Return the file address that module offsets are relative to"""
+        header_addr = module.GetObjectFileHeaderAddress()
+        if header_addr.IsValid():
+            return header_addr.GetFileAddress()
+        return 0
+
+    def module_offsets(self, module):
+        """Return the offsets of every fourth byte of the code in module"""
+        base = self.module_base(module)
+        offsets = []
+        for i in range(module.GetNumSymbols()):
+            symbol = module.GetSymbolAtIndex(i)
+            if symbol.GetType() != lldb.eSymbolTypeCode:
+                continue
+            start = symbol.GetStartAddress().GetFileAddress()
+            end = symbol.GetEndAddress().GetFileAddress()
+            if start == lldb.LLDB_INVALID_ADDRESS or end <= start:
+                continue
+            offsets.extend(range(start - base, end - base, 4))
+        return offsets
+
+    def describe(self, sc):
+        """Return the function, inlined call chain and line of sc"""
+        inlined = []
+        block = sc.GetBlock()
+        if block.IsValid() and not block.IsInlined():
+            block = block.GetContainingInlinedBlock()
+        while block.IsValid():
+            inlined.append(block.GetInlinedName())
+            block = block.GetParent().GetContainingInlinedBlock()
+        line_entry = sc.GetLineEntry()
+        return (sc.GetFunction().GetName(), tuple(inlined),
+                line_entry.GetFileSpec().GetFilename(), line_entry.GetLine())
+
+    @benchmarks_test
+    @skipIfWindows
+    def test_symbolication(self):
+        """Benchmark symbolicating module offsets from several modules"""
+        self.build()
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        modules = [target.GetModuleAtIndex(0)]
+        for lib in ["a", "b", "c"]:
+            lib_path = os.path.join(
+                os.getcwd(), self.platformContext.shlib_prefix +
+                "symbolication_" + lib + "." +
+                self.platformContext.shlib_extension)
+            module = target.AddModule(lib_path, None, None)
+            self.assertTrue(module, "couldn't add " + lib_path)
+            modules.append(module)
+
+        requests = []
+        for module in modules:
+            uuid = module.GetUUIDString()
+            self.assertTrue(uuid)
+            requests.extend((uuid, offset)
+                            for offset in self.module_offsets(module))
+        self.assertTrue(len(requests) > 0)
+
+        # Crash reports list addresses in no particular order.
+        random.Random(0).shuffle(requests)
+        uuids = [uuid for uuid, offset in requests]
+        offsets = [offset for uuid, offset in requests]
+        modules_by_uuid = dict((m.GetUUIDString(), (m, self.module_base(m)))
+                               for m in modules)
+
+        one_by_one = Stopwatch()
+        with one_by_one:
+            expected = []
+            for uuid, offset in requests:
+                module, base = modules_by_uuid[uuid]
+                addr = module.ResolveFileAddress(base + offset)
+                expected.append(target.ResolveSymbolContextForAddress(
+                    addr, self.resolve_scope))
+
+        batch = Stopwatch()
+        with batch:
+            sc_list = target.ResolveSymbolContextsForModuleOffsets(
+                uuids, offsets, self.resolve_scope)
+
+        self.assertEqual(sc_list.GetSize(), len(requests))
+        for i in range(len(requests)):
+            self.assertEqual(self.describe(expected[i]),
+                             self.describe(sc_list.GetContextAtIndex(i)))
+
+        print("%d addresses from %d modules, one at a time: %s" %
+              (len(requests), len(modules), one_by_one))
+        print("%d addresses from %d modules, batched: %s" %
+              (len(requests), len(modules), batch))
@@ -0,0 +1,11 @@
+LEVEL := ../../make
+
+LIB_PREFIX := symbolication_
+
+DYLIB_NAME := $(LIB_PREFIX)a
+DYLIB_CXX_SOURCES := a.cpp
+DYLIB_ONLY := YES
+
+CXXFLAGS += -fPIC
+
+include $(LEVEL)/Makefile.rules
@@ -0,0 +1,2 @@
+#define LIB_NAME lib_b
+#include "funcs.h"
@@ -0,0 +1,11 @@
+LEVEL := ../../make
+
+LIB_PREFIX := symbolication_
+
+DYLIB_NAME := $(LIB_PREFIX)b
+DYLIB_CXX_SOURCES := b.cpp
+DYLIB_ONLY := YES
+
+CXXFLAGS += -fPIC
+
+include $(LEVEL)/Makefile.rules
@@ -0,0 +1,51 @@
+// Defines a few hundred functions with inlined helpers, so that the
+// symbolicated addresses cover many line entries and nested blocks.
+// LIB_NAME makes the function names different in each module.
+
+#define CONCAT2(a, b) a##b
+#define CONCAT(a, b) CONCAT2(a, b)
+
+static inline __attribute__((always_inline)) int inlined_add(int a, int b) {
+  return a + b;
+}
+
+static inline __attribute__((always_inline)) int inlined_mix(int a, int b) {
+  int c = inlined_add(a, b);
+  return c * inlined_add(c, a);
+}
+
+#define FUNC(n)                                                                \
+  int CONCAT(LIB_NAME, _func_##n)(int x) {                                     \
+    int y = inlined_mix(x, n);                                                 \
+    if (y & 1)                                                                 \
+      y = inlined_add(y, x);                                                   \
+    return y;                                                                  \
+  }
+
+#define FUNC10(n)                                                              \
+  FUNC(n##0)                                                                   \
+  FUNC(n##1)                                                                   \
+  FUNC(n##2)                                                                   \
+  FUNC(n##3)                                                                   \
+  FUNC(n##4)                                                                   \
+  FUNC(n##5)                                                                   \
+  FUNC(n##6)                                                                   \
+  FUNC(n##7)                                                                   \
+  FUNC(n##8)                                                                   \
+  FUNC(n##9)
+
+#define FUNC100(n)                                                             \
+  FUNC10(n##0)                                                                 \
+  FUNC10(n##1)                                                                 \
+  FUNC10(n##2)                                                                 \
+  FUNC10(n##3)                                                                 \
+  FUNC10(n##4)                                                                 \
+  FUNC10(n##5)                                                                 \
+  FUNC10(n##6)                                                                 \
+  FUNC10(n##7)                                                                 \
+  FUNC10(n##8)                                                                 \
+  FUNC10(n##9)
+
+FUNC100(1)
+FUNC100(2)
+FUNC100(3)
@@ -0,0 +1,4 @@
+#define LIB_NAME main
+#include "funcs.h"
+
+int main(int argc, char const *argv[]) { return main_func_100(argc); }
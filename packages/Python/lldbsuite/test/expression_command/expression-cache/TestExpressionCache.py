@@ -0,0 +1,49 @@
+"""
+Test that parsed expressions are reused only where they are still valid.
+"""
+
+from __future__ import print_function
+
+
+import lldb
+from lldbsuite.test.lldbtest import *
+import lldbsuite.test.lldbutil as lldbutil
+
+
+class ExpressionCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def run_to_loop(self):
+        self.build()
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_source_regexp(self, "Break in loop.")
+        lldbutil.run_break_set_by_source_regexp(self, "Break in scale.")
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+    def check_iterations(self):
+        for i in range(3):
+            self.expect("expression value + 1",
+                        substrs=["(int)", "= %d" % (i + 1)])
+            self.runCmd("continue")
+
+            # The same text in a different function refers to a different
+            # variable and must not reuse the code parsed in main.
+            self.expect("expression value + 1",
+                        substrs=["(double)", "= %d" % (i + 1)])
+            self.runCmd("continue")
+
+    def test_expression_cache(self):
+        """Test repeated evaluation of an expression with the cache enabled."""
+        self.run_to_loop()
+        self.check_iterations()
+
+    def test_expression_cache_disabled(self):
+        """Test repeated evaluation of an expression with the cache disabled."""
+        self.run_to_loop()
+        self.runCmd("settings set target.expression-cache-size 0")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear target.expression-cache-size"))
+        self.check_iterations()
@@ -0,0 +1,15 @@
+#include <stdio.h>
+
+double scale(double value) {
+  return value * 0.5; // Break in scale.
+}
+
+int main(int argc, char const *argv[]) {
+  int total = 0;
+  for (int value = 0; value < 3; ++value) {
+    total += value; // Break in loop.
+    scale(value);
+  }
+  printf("%d\n", total);
+  return 0;
+}
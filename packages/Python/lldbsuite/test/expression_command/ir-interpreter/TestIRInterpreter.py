@@ -85,3 +85,38 @@ class IRInterpreterTestCase(TestBase):
                 jit_result,
                 "While evaluating " +
                 expression)
+
+    @add_test_categories(['pyapi'])
+    def test_ir_interpreter_without_jit(self):
+        """Test expressions that the interpreter handles without JIT"""
+        self.build_and_run()
+
+        set_up_expressions = ["float $f = 1.5",
+                              "double $d = 2.25",
+                              "int $n = 7"]
+
+        for expression in set_up_expressions:
+            self.runCmd("expression -- " + expression)
+
+        expressions = [
+            ("$f * 2", "(float)", "= 3"),
+            ("$d / 2", "(double)", "= 1.125"),
+            ("$f < $d", "(bool)", "= true"),
+            ("(int)($d * 4)", "(int)", "= 9"),
+            ("(double)$n / 2", "(double)", "= 3.5"),
+            ("$n > 5 ? $d : $f", "(double)", "= 2.25"),
+            ("int r = 0; switch ($n) { case 7: r = 1; break; default: r = 2; } r",
+             "(int)", "= 1"),
+            ("int s = 0; for (int i = 0; i < $n; ++i) s += i; s",
+             "(int)", "= 21"),
+            ("[](int x) { return x * 3; }($n)", "(int)", "= 21"),
+            # Larger than the chunks memory intrinsics are copied in, with
+            # an overlapping move that has to copy back to front.
+            ("struct B { char c[100000]; } b = {}; b.c[70000] = 5; "
+             "__builtin_memmove(b.c + 29999, b.c, 70001); B e = b; "
+             "(int)e.c[99999]",
+             "(int)", "= 5")]
+
+        for expression, type_name, value in expressions:
+            self.expect("expression -l c++ --allow-jit false -- " + expression,
+                        substrs=[type_name, value])
@@ -0,0 +1,95 @@
+"""
+Test reading debug info from SHF_COMPRESSED and .zdebug sections.
+"""
+
+from __future__ import print_function
+
+import os
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class CompressedDebugInfoTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.line = line_number('main.c', '// Break here.')
+
+    def check_compressed_debug_info(self, cflags):
+        # CFLAGS are passed to the linker too, so the linked debug sections
+        # stay compressed. The module cache needs a build ID.
+        d = {'CFLAGS_EXTRAS': cflags, 'LD_EXTRAS': '-Wl,--build-id'}
+        self.build(dictionary=d)
+        self.setTearDownCleanup(dictionary=d)
+        return self.check_debug_info()
+
+    def check_debug_info(self):
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        lldbutil.run_break_set_by_file_and_line(
+            self, "main.c", self.line, num_expected_locations=1,
+            loc_exact=True)
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertEqual(process.GetState(), lldb.eStateStopped)
+
+        frame = process.GetSelectedThread().GetFrameAtIndex(0)
+        self.assertEqual(frame.GetFunctionName(), "sum")
+        self.assertEqual(frame.GetLineEntry().GetLine(), self.line)
+        p = frame.FindVariable("p")
+        self.assertTrue(p.IsValid())
+        self.assertEqual(p.GetChildMemberWithName("x").GetValueAsSigned(), 1)
+        self.assertEqual(p.GetChildMemberWithName("y").GetValueAsSigned(), 2)
+        return target
+
+    @skipUnlessPlatform(['linux'])
+    def test_shf_compressed(self):
+        """Test debug info in SHF_COMPRESSED sections."""
+        self.check_compressed_debug_info("-gz=zlib")
+
+    @skipUnlessPlatform(['linux'])
+    def test_zdebug(self):
+        """Test debug info in GNU style .zdebug sections."""
+        self.check_compressed_debug_info("-gz=zlib-gnu")
+
+    @skipUnlessPlatform(['linux'])
+    def test_section_cache(self):
+        """Test that decompressed sections are saved in the module cache."""
+        cache_dir = os.path.join(os.getcwd(), "module-cache")
+        self.runCmd("settings set platform.module-cache-directory " +
+                    cache_dir)
+        self.runCmd("settings set platform.cache-decompressed-sections true")
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear platform.cache-decompressed-sections"))
+        self.addTearDownHook(lambda: self.runCmd(
+            "settings clear platform.module-cache-directory"))
+
+        target = self.check_compressed_debug_info("-gz=zlib")
+        cached = []
+        for root, dirs, files in os.walk(cache_dir):
+            cached += [f for f in files if f.endswith(".section")]
+        self.assertTrue("a.out.debug_info.section" in cached)
+
+        # Drop the module, so that a second session has to load the section
+        # again, and check that it comes from the cache.
+        target.GetProcess().Kill()
+        self.dbg.DeleteTarget(target)
+        lldb.SBDebugger.MemoryPressureDetected()
+        log_file = os.path.join(os.getcwd(), "modules.log")
+        self.runCmd("log enable -f '%s' lldb module" % log_file)
+        try:
+            self.check_debug_info()
+        finally:
+            self.runCmd("log disable lldb module")
+        with open(log_file, "r") as f:
+            log = f.read()
+        self.assertTrue("Loaded section .debug_info of " in log)
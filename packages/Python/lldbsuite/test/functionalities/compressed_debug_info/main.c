@@ -0,0 +1,17 @@
+struct point {
+  int x;
+  int y;
+};
+
+int
+sum(struct point p)
+{
+  return p.x + p.y; // Break here.
+}
+
+int
+main()
+{
+  struct point p = {1, 2};
+  return sum(p) - 3;
+}
@@ -0,0 +1,62 @@
+"""
+Test that formatter lookups are cached across stops.
+"""
+
+from __future__ import print_function
+
+
+import re
+import lldb
+from lldbsuite.test.lldbtest import *
+import lldbsuite.test.lldbutil as lldbutil
+
+
+class FormatterCacheTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        # Find the line number to break at.
+        self.line = line_number('main.cpp', '// Set break point at this line.')
+
+    def get_cache_counts(self):
+        self.runCmd("type cache stats")
+        output = self.res.GetOutput()
+        m = re.search(r"\(all\)\s+entries: (\d+)\s+hits: (\d+)\s+misses: (\d+)",
+                      output)
+        self.assertTrue(m is not None, "unexpected output: " + output)
+        return [int(group) for group in m.groups()]
+
+    def test_cache_survives_stops(self):
+        """Test that formatter lookups are not repeated on every stop."""
+        self.build()
+        self.runCmd("file a.out", CURRENT_EXECUTABLE_SET)
+
+        lldbutil.run_break_set_by_file_and_line(
+            self, "main.cpp", self.line, num_expected_locations=1, loc_exact=True)
+
+        self.runCmd("run", RUN_SUCCEEDED)
+
+        def cleanup():
+            self.runCmd('type summary clear', check=False)
+
+        self.addTearDownHook(cleanup)
+
+        self.runCmd("type summary add -s \"(${var.x}, ${var.y})\" Point")
+        self.runCmd("frame variable p")
+        self.runCmd("type cache reset")
+
+        self.runCmd("continue")
+        self.expect("frame variable p", substrs=['(Point) p = ('])
+        entries, hits, misses = self.get_cache_counts()
+        self.assertTrue(entries > 0)
+        self.assertTrue(hits > 0)
+        self.assertEqual(misses, 0, "formatters re-resolved after a stop")
+
+        # Changing the registry must invalidate the cached lookups.
+        self.runCmd("type summary add -s \"point\" Point")
+        self.expect("frame variable p", substrs=['(Point) p = point'])
+        entries, hits, misses = self.get_cache_counts()
+        self.assertTrue(misses > 0)
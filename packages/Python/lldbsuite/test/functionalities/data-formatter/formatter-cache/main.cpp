@@ -0,0 +1,21 @@
+//===-- main.cpp ------------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+struct Point {
+  int x;
+  int y;
+};
+
+int main() {
+  Point p = {1, 2};
+  for (int i = 0; i < 3; i++) {
+    p.x += i; // Set break point at this line.
+  }
+  return p.x;
+}
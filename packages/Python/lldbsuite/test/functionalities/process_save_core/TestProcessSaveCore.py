@@ -65,3 +65,67 @@ class ProcessSaveCoreTestCase(TestBase):
             self.assertTrue(self.dbg.DeleteTarget(target))
             if (os.path.isfile(core)):
                 os.unlink(core)
+
+    def save_and_load_linux_core(self, options, saves_globals=True):
+        self.build()
+        exe = os.path.join(os.getcwd(), "a.out")
+        core = os.path.join(os.getcwd(), "core")
+        target = self.dbg.CreateTarget(exe)
+        try:
+            target.BreakpointCreateByName("bar")
+            process = target.LaunchSimple(
+                None, None, self.get_process_working_directory())
+            self.assertEqual(process.GetState(), lldb.eStateStopped)
+            self.runCmd("process save-core %s %s" % (options, core))
+            self.assertTrue(os.path.isfile(core))
+            self.assertTrue(process.Kill().Success())
+            self.assertTrue(self.dbg.DeleteTarget(target))
+
+            # Load the core file and check that we stopped in bar with the
+            # right arguments (and globals, if their memory was saved).
+            target = self.dbg.CreateTarget(exe)
+            process = target.LoadCore(core)
+            self.assertTrue(process, PROCESS_IS_VALID)
+            thread = process.GetSelectedThread()
+            self.assertTrue(thread.IsValid())
+            frame = thread.GetFrameAtIndex(0)
+            self.assertEqual(frame.GetFunctionName(), "bar(int)")
+            self.assertEqual(frame.FindVariable("x").GetValueAsSigned(), 3)
+            if saves_globals:
+                self.assertEqual(
+                    frame.EvaluateExpression("global").GetValueAsSigned(), 42)
+            self.assertEqual(
+                thread.GetFrameAtIndex(1).GetFunctionName(), "foo(int)")
+        finally:
+            self.assertTrue(self.dbg.DeleteTarget(target))
+            if (os.path.isfile(core)):
+                os.unlink(core)
+
+    @not_remote_testsuite_ready
+    @skipUnlessPlatform(["linux"])
+    @skipIf(archs=no_match(["x86_64", "aarch64"]))
+    def test_save_linux_core(self):
+        """Test that we can save and load a Linux ELF core file."""
+        self.save_and_load_linux_core("--style full")
+
+    @not_remote_testsuite_ready
+    @skipUnlessPlatform(["linux"])
+    @skipIf(archs=no_match(["x86_64", "aarch64"]))
+    def test_save_linux_core_modified_memory(self):
+        """Test saving a Linux core file with only the modified memory."""
+        self.save_and_load_linux_core("--style modified-memory")
+
+    @not_remote_testsuite_ready
+    @skipUnlessPlatform(["linux"])
+    @skipIf(archs=no_match(["x86_64"]))
+    def test_save_linux_mini_dump(self):
+        """Test that we can save and load a Linux minidump."""
+        self.save_and_load_linux_core("--plugin-name minidump --style stack",
+                                      saves_globals=False)
+
+    @not_remote_testsuite_ready
+    @skipUnlessPlatform(["linux"])
+    @skipIf(archs=no_match(["x86_64"]))
+    def test_save_linux_full_memory_mini_dump(self):
+        """Test that we can save and load a full-memory Linux minidump."""
+        self.save_and_load_linux_core("--plugin-name minidump --style full")
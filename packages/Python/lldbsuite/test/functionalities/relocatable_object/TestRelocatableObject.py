@@ -0,0 +1,80 @@
+"""
+Test reading the debug info of a large ELF relocatable object file, whose
+debug sections have to be relocated while the file itself is mapped
+read-only.
+"""
+
+from __future__ import print_function
+
+import json
+import os
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class RelocatableObjectTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def get_module_statistics(self, path):
+        stats = self.dbg.GetStatistics()
+        self.assertTrue(stats.IsValid())
+        stream = lldb.SBStream()
+        self.assertTrue(stats.GetAsJSON(stream).Success())
+        modules = json.loads(stream.GetData())["modules"]
+        for module in modules:
+            if module["path"] == path:
+                return module
+        self.fail("no statistics for " + path)
+
+    @skipUnlessPlatform(['linux'])
+    def test_relocatable_object(self):
+        """Test the types and functions in the DWARF of a large .o file."""
+        self.build()
+        obj = os.path.join(os.getcwd(), "main.o")
+        # Only files of 16K or more are mapped.
+        self.assertTrue(os.path.getsize(obj) >= 16 * 1024)
+
+        target = self.dbg.CreateTarget(obj)
+        self.assertTrue(target, VALID_TARGET)
+        module = target.GetModuleAtIndex(0)
+        self.assertTrue(module.IsValid())
+
+        # The names of types, members and functions are all found through
+        # relocations in .debug_info.
+        self.assertEqual(module.GetNumCompileUnits(), 1)
+        self.assertEqual(
+            module.GetCompileUnitAtIndex(0).GetFileSpec().GetFilename(),
+            "main.c")
+        for n in [100, 150, 299]:
+            struct_type = module.FindFirstType("struct_%d" % n)
+            self.assertTrue(struct_type.IsValid(), "struct_%d" % n)
+            self.assertEqual(struct_type.GetNumberOfFields(), 2)
+            self.assertEqual(struct_type.GetFieldAtIndex(0).GetName(),
+                             "member_%d" % n)
+            self.assertEqual(struct_type.GetFieldAtIndex(1).GetName(),
+                             "other_%d" % n)
+
+            sc_list = module.FindFunctions("func_%d" % n,
+                                           lldb.eFunctionNameTypeFull)
+            self.assertEqual(sc_list.GetSize(), 1)
+            function = sc_list.GetContextAtIndex(0).GetFunction()
+            self.assertTrue(function.IsValid(), "func_%d" % n)
+            self.assertEqual(function.GetName(), "func_%d" % n)
+            arg_type = function.GetType().GetFunctionArgumentTypes()
+            self.assertEqual(arg_type.GetSize(), 1)
+            self.assertEqual(
+                arg_type.GetTypeAtIndex(0).GetPointeeType().GetName(),
+                "struct_%d" % n)
+
+        # The file is mapped, and only the relocated debug sections are
+        # copied to the heap.
+        stats = self.get_module_statistics(obj)
+        self.assertTrue(stats["sectionMappedByteSize"] > 0)
+        self.assertTrue(stats["sectionHeapByteSize"] > 0)
+        self.assertTrue(stats["sectionHeapByteSize"] <
+                        stats["sectionMappedByteSize"])
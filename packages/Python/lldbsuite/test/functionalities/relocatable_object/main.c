@@ -0,0 +1,43 @@
+// Enough types and functions that main.o is memory mapped when it is read
+// and its debug sections have plenty of relocations.
+
+#define DEFINE_TYPE_AND_FUNCTION(n)                                            \
+  struct struct_##n {                                                          \
+    int member_##n;                                                            \
+    double other_##n;                                                          \
+  };                                                                           \
+  int func_##n(struct struct_##n *s) {                                         \
+    return s->member_##n + (int)s->other_##n;                                  \
+  }
+
+#define DEFINE_10(n)                                                           \
+  DEFINE_TYPE_AND_FUNCTION(n##0)                                               \
+  DEFINE_TYPE_AND_FUNCTION(n##1)                                               \
+  DEFINE_TYPE_AND_FUNCTION(n##2)                                               \
+  DEFINE_TYPE_AND_FUNCTION(n##3)                                               \
+  DEFINE_TYPE_AND_FUNCTION(n##4)                                               \
+  DEFINE_TYPE_AND_FUNCTION(n##5)                                               \
+  DEFINE_TYPE_AND_FUNCTION(n##6)                                               \
+  DEFINE_TYPE_AND_FUNCTION(n##7)                                               \
+  DEFINE_TYPE_AND_FUNCTION(n##8)                                               \
+  DEFINE_TYPE_AND_FUNCTION(n##9)
+
+#define DEFINE_100(n)                                                          \
+  DEFINE_10(n##0)                                                              \
+  DEFINE_10(n##1)                                                              \
+  DEFINE_10(n##2)                                                              \
+  DEFINE_10(n##3)                                                              \
+  DEFINE_10(n##4)                                                              \
+  DEFINE_10(n##5)                                                              \
+  DEFINE_10(n##6)                                                              \
+  DEFINE_10(n##7)                                                              \
+  DEFINE_10(n##8)                                                              \
+  DEFINE_10(n##9)
+
+DEFINE_100(1)
+DEFINE_100(2)
+
+int main() {
+  struct struct_100 s = {1, 2.0};
+  return func_100(&s);
+}
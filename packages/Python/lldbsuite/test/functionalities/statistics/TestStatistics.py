@@ -0,0 +1,71 @@
+"""
+Test the statistics command and SBDebugger.GetStatistics().
+"""
+
+from __future__ import print_function
+
+import json
+import os
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class StatisticsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    NO_DEBUG_INFO_TESTCASE = True
+
+    def get_statistics(self):
+        stats = self.dbg.GetStatistics()
+        self.assertTrue(stats.IsValid())
+        stream = lldb.SBStream()
+        self.assertTrue(stats.GetAsJSON(stream).Success())
+        return json.loads(stream.GetData())
+
+    def test_statistics_dump(self):
+        """Test that statistics dump prints the expected sections."""
+        self.build()
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+
+        self.expect("statistics dump",
+                    substrs=['"timers"', '"modules"', '"memory"',
+                             '"formatterCache"', '"targets"'])
+        self.expect("statistics dump --compact", substrs=['"modules":'])
+        self.runCmd("statistics reset")
+
+    def test_get_statistics(self):
+        """Test the module and process statistics of a stopped process."""
+        self.build()
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        target.BreakpointCreateByName("foo")
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertEqual(process.GetState(), lldb.eStateStopped)
+
+        stats = self.get_statistics()
+        paths = [module["path"] for module in stats["modules"]]
+        self.assertTrue(exe in paths)
+        exe_stats = stats["modules"][paths.index(exe)]
+        self.assertTrue(exe_stats["symbolCount"] > 0)
+        self.assertTrue(exe_stats["symtabParseTime"] >= 0)
+        self.assertTrue(stats["memory"]["stringsByteSize"] > 0)
+        # Local files are mapped, nothing in a linked executable needs to be
+        # copied to the heap.
+        self.assertTrue(os.path.getsize(exe) >= 16 * 1024)
+        self.assertTrue(exe_stats["sectionMappedByteSize"] > 0)
+        self.assertEqual(exe_stats["sectionHeapByteSize"], 0)
+        self.assertTrue("sectionsMappedByteSize" in stats["memory"])
+        self.assertTrue("sectionsHeapByteSize" in stats["memory"])
+
+        self.assertEqual(len(stats["targets"]), 1)
+        process_stats = stats["targets"][0]["process"]
+        self.assertTrue("memoryCache" in process_stats)
+        if "gdbRemote" in process_stats:
+            self.assertTrue(process_stats["gdbRemote"]["packetCount"] > 0)
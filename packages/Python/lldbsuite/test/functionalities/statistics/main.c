@@ -0,0 +1,14 @@
+// Make a.out big enough to be memory mapped when it is read.
+const char g_padding[32 * 1024] = {1};
+
+int
+foo(int x)
+{
+  return x * 2;
+}
+
+int
+main()
+{
+  return foo(0);
+}
@@ -204,3 +204,63 @@ class RegisterVariableTestCase(TestBase):
         # print("executed {} expressions with values in registers".format(register_variables_count))
 
         self.runCmd("kill")
+
+    def frame_variable_values(self):
+        """Run to each breakpoint and collect the values and locations of the
+        variables in the frame."""
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        breakpoint = target.BreakpointCreateBySourceRegex(
+            "set breakpoint here", lldb.SBFileSpec("test.c"))
+        self.assertTrue(breakpoint.GetNumLocations() == 3, VALID_BREAKPOINT)
+
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+
+        values = []
+        thread = lldbutil.get_stopped_thread(
+            process, lldb.eStopReasonBreakpoint)
+        while thread:
+            frame = thread.GetFrameAtIndex(0)
+            for var in frame.GetVariables(True, True, False, True):
+                values.append((frame.GetFunctionName(), var.GetName(),
+                               var.GetValue(), var.GetLocation()))
+            process.Continue()
+            thread = lldbutil.get_stopped_thread(
+                process, lldb.eStopReasonBreakpoint)
+
+        process.Kill()
+        self.dbg.DeleteTarget(target)
+        return values
+
+    @expectedFailureAll(compiler="clang", compiler_version=['<', '3.5'])
+    @expectedFailureAll(compiler="gcc", compiler_version=[
+            '>=', '4.8.2'], archs=["i386"])
+    @expectedFailureAll(compiler="gcc", compiler_version=[
+            '<', '4.9'], archs=["x86_64"])
+    def test_locations_match_evaluator(self):
+        """Test that register and location list variables read the same
+        whether or not their location is evaluated by the DWARF stack
+        machine."""
+        self.build()
+
+        # Single register locations are evaluated directly unless verbose
+        # expression logging is on.
+        direct = self.frame_variable_values()
+        self.assertTrue(
+            any(value is not None for (_, _, value, _) in direct),
+            "expected to read some variables")
+
+        log_file = os.path.join(os.getcwd(), "TestRegisterVariables.log")
+        self.runCmd("log enable -v -f '%s' lldb expr" % log_file)
+        self.addTearDownHook(lambda: os.path.exists(log_file) and
+                             os.remove(log_file))
+        evaluated = self.frame_variable_values()
+        self.runCmd("log disable lldb expr")
+
+        self.assertEqual(direct, evaluated)
+        with open(log_file) as f:
+            self.assertTrue("DW_OP_" in f.read(),
+                            "expected the evaluator to log its opcodes")
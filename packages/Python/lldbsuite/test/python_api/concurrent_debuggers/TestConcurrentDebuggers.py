@@ -0,0 +1,122 @@
+"""
+Test that Python threads can drive separate debuggers at the same time.
+"""
+
+from __future__ import print_function
+
+
+import os
+import threading
+import time
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class ConcurrentDebuggersTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    NUM_DEBUGGERS = 4
+    NUM_ITERATIONS = 3
+
+    def setUp(self):
+        # Call super's setUp().
+        TestBase.setUp(self)
+        self.exe = os.path.join(os.getcwd(), "a.out")
+
+    def debug_one_process(self, errors):
+        """Launch, inspect and kill a process in a debugger of its own."""
+        debugger = lldb.SBDebugger.Create(False)
+        try:
+            debugger.SetAsync(False)
+            target = debugger.CreateTarget(self.exe)
+            if not target:
+                errors.append("couldn't create target")
+                return
+
+            target.BreakpointCreateByName("stop_here")
+            for i in range(self.NUM_ITERATIONS):
+                process = target.LaunchSimple(
+                    None, None, self.get_process_working_directory())
+                if not process or process.GetState() != lldb.eStateStopped:
+                    errors.append("process didn't stop at the breakpoint")
+                    return
+
+                frame = process.GetSelectedThread().GetFrameAtIndex(0)
+                value = frame.EvaluateExpression("value + 1")
+                if value.GetValueAsSigned() != 42:
+                    errors.append("unexpected expression result: " + str(value))
+
+                counter = target.FindFirstGlobalVariable("g_counter")
+                error = lldb.SBError()
+                data = process.ReadMemory(counter.GetLoadAddress(), 4, error)
+                if error.Fail() or len(data) != 4:
+                    errors.append("couldn't read g_counter: " + str(error))
+
+                functions = target.FindFunctions("stop_here")
+                if functions.GetSize() != 1:
+                    errors.append("couldn't find stop_here")
+
+                process.Kill()
+        finally:
+            lldb.SBDebugger.Destroy(debugger)
+
+    @add_test_categories(['pyapi'])
+    @skipIfiOSSimulator
+    @skipIfRemote
+    def test_concurrent_debuggers(self):
+        """Test several debuggers used from Python threads concurrently."""
+        self.build()
+
+        errors = []
+        threads = [threading.Thread(target=self.debug_one_process,
+                                    args=(errors,))
+                   for i in range(self.NUM_DEBUGGERS)]
+        for thread in threads:
+            thread.start()
+        for thread in threads:
+            thread.join()
+
+        self.assertEqual(errors, [])
+
+    @add_test_categories(['pyapi'])
+    @skipIfiOSSimulator
+    @skipIfRemote
+    def test_gil_released_during_expression(self):
+        """Test that other Python threads run while an SB call blocks."""
+        self.build()
+
+        target = self.dbg.CreateTarget(self.exe)
+        self.assertTrue(target, VALID_TARGET)
+        target.BreakpointCreateByName("stop_here")
+        process = target.LaunchSimple(
+            None, None, self.get_process_working_directory())
+        self.assertTrue(process, PROCESS_IS_VALID)
+        self.addTearDownHook(lambda: process.Kill())
+
+        ticks = [0]
+        done = threading.Event()
+
+        def ticker():
+            while not done.is_set():
+                ticks[0] += 1
+                time.sleep(0.01)
+
+        ticker_thread = threading.Thread(target=ticker)
+        ticker_thread.start()
+        try:
+            frame = process.GetSelectedThread().GetFrameAtIndex(0)
+            ticks_before = ticks[0]
+            value = frame.EvaluateExpression("take_a_nap()")
+            ticks_during = ticks[0] - ticks_before
+        finally:
+            done.set()
+            ticker_thread.join()
+
+        self.assertTrue(value.GetError().Success(), str(value.GetError()))
+        self.assertEqual(value.GetValueAsSigned(), 1)
+        self.assertTrue(ticks_during > 0,
+                        "Python thread made no progress during the expression")
@@ -0,0 +1,20 @@
+#include <stdio.h>
+#include <unistd.h>
+
+int g_counter = 41;
+
+int stop_here(int value) {
+  return value + 1; // Set break point at this line.
+}
+
+int take_a_nap(void) {
+  usleep(500000);
+  return 1;
+}
+
+int main(int argc, char const *argv[]) {
+  g_counter = stop_here(g_counter);
+  take_a_nap();
+  printf("%d\n", g_counter);
+  return 0;
+}
@@ -0,0 +1,106 @@
+"""
+Test that SBTarget.ResolveSymbolContextsForModuleOffsets resolves every
+address the same way as SBTarget.ResolveSymbolContextForAddress.
+"""
+
+from __future__ import print_function
+
+
+import os
+import random
+
+import lldb
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class SymbolContextModuleOffsetsTestCase(TestBase):
+
+    mydir = TestBase.compute_mydir(__file__)
+
+    def module_base(self, module):
+        """Return the file address that module offsets are relative to"""
+        header_addr = module.GetObjectFileHeaderAddress()
+        if header_addr.IsValid():
+            return header_addr.GetFileAddress()
+        return 0
+
+    def module_offsets(self, module):
+        """Return the offsets of every byte of the functions and globals in
+        module"""
+        base = self.module_base(module)
+        offsets = []
+        for i in range(module.GetNumSymbols()):
+            symbol = module.GetSymbolAtIndex(i)
+            if symbol.GetType() not in [lldb.eSymbolTypeCode,
+                                        lldb.eSymbolTypeData]:
+                continue
+            start = symbol.GetStartAddress().GetFileAddress()
+            end = symbol.GetEndAddress().GetFileAddress()
+            if start == lldb.LLDB_INVALID_ADDRESS or end <= start:
+                continue
+            offsets.extend(range(start - base, end - base))
+        return offsets
+
+    def describe(self, sc):
+        """Return the parts of sc that the tests compare"""
+        inlined = []
+        block = sc.GetBlock()
+        block_range = None
+        if block.IsValid():
+            block_range = (block.GetRangeStartAddress(0).GetFileAddress(),
+                           block.GetRangeEndAddress(0).GetFileAddress())
+            if not block.IsInlined():
+                block = block.GetContainingInlinedBlock()
+        while block.IsValid():
+            inlined.append(block.GetInlinedName())
+            block = block.GetParent().GetContainingInlinedBlock()
+        line_entry = sc.GetLineEntry()
+        return (sc.GetCompileUnit().GetFileSpec().GetFilename(),
+                sc.GetFunction().GetName(), block_range, tuple(inlined),
+                line_entry.GetFileSpec().GetFilename(), line_entry.GetLine(),
+                sc.GetSymbol().GetName())
+
+    def check_scope(self, target, module, resolve_scope):
+        uuid = module.GetUUIDString()
+        base = self.module_base(module)
+        offsets = self.module_offsets(module)
+        self.assertTrue(len(offsets) > 0)
+        random.Random(0).shuffle(offsets)
+
+        sc_list = target.ResolveSymbolContextsForModuleOffsets(
+            [uuid] * len(offsets), offsets, resolve_scope)
+        self.assertEqual(sc_list.GetSize(), len(offsets))
+        for i, offset in enumerate(offsets):
+            addr = module.ResolveFileAddress(base + offset)
+            expected = target.ResolveSymbolContextForAddress(
+                addr, resolve_scope)
+            self.assertEqual(
+                self.describe(expected),
+                self.describe(sc_list.GetContextAtIndex(i)),
+                "offset 0x%x with scope 0x%x" % (offset, resolve_scope))
+
+    @add_test_categories(['pyapi'])
+    @skipIfWindows
+    def test(self):
+        """Test resolving module offsets in a batch"""
+        self.build()
+        exe = os.path.join(os.getcwd(), "a.out")
+        target = self.dbg.CreateTarget(exe)
+        self.assertTrue(target, VALID_TARGET)
+        module = target.GetModuleAtIndex(0)
+
+        # Asking only for the compile unit must not carry one compile unit
+        # over to the functions of the next one.
+        for resolve_scope in [lldb.eSymbolContextCompUnit,
+                              lldb.eSymbolContextCompUnit |
+                              lldb.eSymbolContextLineEntry,
+                              lldb.eSymbolContextFunction |
+                              lldb.eSymbolContextBlock |
+                              lldb.eSymbolContextLineEntry,
+                              lldb.eSymbolContextSymbol,
+                              lldb.eSymbolContextEverything,
+                              lldb.eSymbolContextEverything |
+                              lldb.eSymbolContextVariable]:
+            self.check_scope(target, module, resolve_scope)
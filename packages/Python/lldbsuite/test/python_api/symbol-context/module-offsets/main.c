@@ -0,0 +1,12 @@
+int g_main_var = 1;
+
+int other(int x);
+
+static int helper(int x) {
+  int y = x * 3;
+  return y + g_main_var;
+}
+
+int main(int argc, char const *argv[]) {
+  return helper(argc) + other(argc);
+}
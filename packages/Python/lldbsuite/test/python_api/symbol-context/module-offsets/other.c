@@ -0,0 +1,6 @@
+int g_other_var = 2;
+
+int other(int x) {
+  int z = x + g_other_var;
+  return z * 2;
+}
@@ -39,6 +39,72 @@ class TestGdbRemote_vCont(gdbremote_testcase.GdbRemoteTestCaseBase):
     def vCont_supports_S(self):
         self.vCont_supports_mode("S")
 
+    def vCont_supports_r(self):
+        self.vCont_supports_mode("r")
+
+    def range_step_stops_outside_range(self):
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=[
+                "get-code-address-hex:swap_chars",
+                "sleep:1",
+                "call-function:swap_chars",
+                "sleep:5"])
+        self.add_process_info_collection_packets()
+        self.add_register_info_collection_packets()
+        self.test_sequence.add_log_lines(
+            ["read packet: $c#63",
+             {"type": "output_match", "regex": r"^code address: 0x([0-9a-fA-F]+)\r\n$",
+              "capture": {1: "function_address"}},
+             "read packet: {}".format(chr(3)),
+             {"direction": "send", "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);",
+              "capture": {1: "stop_signo", 2: "stop_thread_id"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        endian = self.parse_process_info_response(context).get("endian")
+        self.assertIsNotNone(endian)
+        reg_infos = self.parse_register_info_packets(context)
+        self.assertIsNotNone(reg_infos)
+        self.add_lldb_register_index(reg_infos)
+        (_, pc_reg_info) = self.find_pc_reg_info(reg_infos)
+        self.assertIsNotNone(pc_reg_info)
+
+        thread_id = int(context.get("stop_thread_id"), 16)
+        function_address = int(context.get("function_address"), 16)
+
+        # Stop at the start of swap_chars.
+        self.reset_test_sequence()
+        self.add_set_breakpoint_packets(
+            function_address, do_continue=True, breakpoint_kind=1)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.reset_test_sequence()
+        self.add_remove_breakpoint_packets(
+            function_address, breakpoint_kind=1)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        # The first few bytes of the function hold more than one instruction,
+        # a single step would stop inside them.
+        range_end = function_address + 4
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $vCont;r{0:x},{1:x}:{2:x}#00".format(
+                function_address, range_end, thread_id),
+             {"direction": "send", "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);",
+              "capture": {1: "stop_signo"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertEqual(int(context.get("stop_signo"), 16),
+                         lldbutil.get_signal_number('SIGTRAP'))
+
+        pc = self.read_register_values(
+            [pc_reg_info], endian,
+            thread_id=thread_id)[pc_reg_info["lldb_register_index"]]
+        self.assertTrue(pc < function_address or pc >= range_end)
+
     @debugserver_test
     def test_vCont_supports_c_debugserver(self):
         self.init_debugserver_test()
@@ -87,6 +153,21 @@ class TestGdbRemote_vCont(gdbremote_testcase.GdbRemoteTestCaseBase):
         self.build()
         self.vCont_supports_S()
 
+    @llgs_test
+    def test_vCont_supports_r_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.vCont_supports_r()
+
+    @llgs_test
+    @skipUnlessPlatform(["linux"])
+    @skipIf(archs=no_match(["i386", "x86_64"]))
+    def test_range_step_stops_outside_range_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.range_step_stops_outside_range()
+
     @debugserver_test
     def test_single_step_only_steps_one_instruction_with_Hc_vCont_s_debugserver(
             self):
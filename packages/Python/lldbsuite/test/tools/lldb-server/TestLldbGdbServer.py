@@ -18,6 +18,7 @@ import gdbremote_testcase
 import lldbgdbserverutils
 import platform
 import signal
+import zlib
 from lldbsuite.test.decorators import *
 from lldbsuite.test.lldbtest import *
 from lldbsuite.test.lldbdwarf import *
@@ -865,6 +866,54 @@ class LldbGdbServerTestCase(gdbremote_testcase.GdbRemoteTestCaseBase, DwarfOpcod
         self.set_inferior_startup_launch()
         self.m_packet_reads_memory()
 
+    def qMemoryChecksums_matches_memory_contents(self):
+        MEMORY_CONTENTS = "Test contents 0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ abcdefghijklmnopqrstuvwxyz"
+
+        # Start up the inferior.
+        procs = self.prep_debug_monitor_and_inferior(
+            inferior_args=[
+                "set-message:%s" %
+                MEMORY_CONTENTS,
+                "get-data-address-hex:g_message",
+                "sleep:5"])
+
+        # Run the process, get the message address and stop it.
+        self.test_sequence.add_log_lines(
+            [
+                "read packet: $c#63",
+                {"type": "output_match", "regex": self.maybe_strict_output_regex(r"data address: 0x([0-9a-fA-F]+)\r\n"),
+                 "capture": {1: "message_address"}},
+                "read packet: {}".format(chr(3)),
+                {"direction": "send", "regex": r"^\$T([0-9a-fA-F]{2})thread:([0-9a-fA-F]+);", "capture": {1: "stop_signo", 2: "stop_thread_id"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+        self.assertIsNotNone(context.get("message_address"))
+        message_address = int(context.get("message_address"), 16)
+
+        # Ask for the checksum of the message and of an unmapped range.
+        self.reset_test_sequence()
+        self.test_sequence.add_log_lines(
+            ["read packet: $qMemoryChecksums:{0:x},{1:x};0,10#00".format(
+                message_address, len(MEMORY_CONTENTS)),
+             {"direction": "send", "regex": r"^\$([0-9a-fA-F]+);(x)#[0-9a-fA-F]{2}$",
+              "capture": {1: "checksum", 2: "unmapped"}}],
+            True)
+        context = self.expect_gdbremote_sequence()
+        self.assertIsNotNone(context)
+
+        # The checksum is a CRC-32 without the final inversion.
+        expected = ~zlib.crc32(MEMORY_CONTENTS) & 0xffffffff
+        self.assertEqual(int(context.get("checksum"), 16), expected)
+        self.assertEqual(context.get("unmapped"), "x")
+
+    @llgs_test
+    def test_qMemoryChecksums_matches_memory_contents_llgs(self):
+        self.init_llgs_test()
+        self.build()
+        self.set_inferior_startup_launch()
+        self.qMemoryChecksums_matches_memory_contents()
+
     def qMemoryRegionInfo_is_supported(self):
         # Start up the inferior.
         procs = self.prep_debug_monitor_and_inferior()
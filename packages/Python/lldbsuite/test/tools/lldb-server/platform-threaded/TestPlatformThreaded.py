@@ -0,0 +1,80 @@
+"""
+Test that lldb-server platform --threaded serves concurrent sessions that
+each keep their own working directory.
+"""
+
+from __future__ import print_function
+
+import os
+import shutil
+import tempfile
+import time
+
+import gdbremote_testcase
+from lldbsuite.test.decorators import *
+from lldbsuite.test.lldbtest import *
+from lldbsuite.test import lldbutil
+
+
+class TestPlatformThreaded(gdbremote_testcase.GdbRemoteTestCaseBase):
+    mydir = TestBase.compute_mydir(__file__)
+
+    def start_threaded_platform(self):
+        port_file = os.path.join(self.session_dirs[0], "port")
+        self.spawnSubprocess(
+            self.debug_monitor_exe,
+            ["platform", "--server", "--threaded", "--listen",
+             "localhost:0", "--socket-file", port_file])
+        self.addTearDownHook(self.cleanupSubprocesses)
+
+        for i in range(100):
+            if os.path.exists(port_file):
+                with open(port_file) as f:
+                    port = f.read().strip()
+                if port:
+                    return int(port)
+            time.sleep(0.1)
+        self.fail("lldb-server platform didn't write its port")
+
+    def connect_platform(self, port):
+        debugger = lldb.SBDebugger.Create()
+        self.addTearDownHook(lambda: lldb.SBDebugger.Destroy(debugger))
+        platform = lldb.SBPlatform("remote-linux")
+        debugger.SetSelectedPlatform(platform)
+        error = platform.ConnectRemote(lldb.SBPlatformConnectOptions(
+            "connect://localhost:%d" % port))
+        self.assertTrue(error.Success(), str(error))
+        self.addTearDownHook(lambda: platform.DisconnectRemote())
+        return platform
+
+    @llgs_test
+    @no_debug_info_test
+    @skipIfRemote
+    @skipUnlessPlatform(["linux"])
+    def test_sessions_have_separate_working_directories(self):
+        self.init_llgs_test(False)
+
+        self.session_dirs = [tempfile.mkdtemp(), tempfile.mkdtemp()]
+        for d in self.session_dirs:
+            self.addTearDownHook(lambda d=d: shutil.rmtree(d))
+
+        port = self.start_threaded_platform()
+        platforms = [self.connect_platform(port) for d in self.session_dirs]
+
+        for platform, d in zip(platforms, self.session_dirs):
+            self.assertTrue(platform.SetWorkingDirectory(d))
+        for platform, d in zip(platforms, self.session_dirs):
+            self.assertEqual(platform.GetWorkingDirectory(), d)
+
+        # Relative paths and shell commands use the session's directory.
+        for i, platform in enumerate(platforms):
+            error = platform.MakeDirectory("session-%d" % i)
+            self.assertTrue(error.Success(), str(error))
+            self.assertTrue(os.path.isdir(
+                os.path.join(self.session_dirs[i], "session-%d" % i)))
+
+            shell_command = lldb.SBPlatformShellCommand("pwd")
+            error = platform.Run(shell_command)
+            self.assertTrue(error.Success(), str(error))
+            self.assertEqual(shell_command.GetOutput().strip(),
+                             self.session_dirs[i])
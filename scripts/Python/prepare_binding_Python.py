@@ -205,6 +205,9 @@ def do_swig_rebuild(options, dependency_file, config_build_dir, settings):
             "-c++",
             "-shadow",
             "-python",
+            # Release the GIL for the duration of every call into liblldb, so
+            # that other Python threads keep running while one of them is
+            # blocked in the debugger (launching, evaluating expressions...).
             "-threads",
             "-I" + os.path.normpath(os.path.join(options.src_root, "include")),
             "-I" + os.path.curdir,
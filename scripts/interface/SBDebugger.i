@@ -393,6 +393,12 @@ public:
     
     lldb::SBError
     RunREPL (lldb::LanguageType language, const char *repl_options);
+
+    %feature("docstring",
+    "Get the statistics that 'statistics dump' prints as structured data."
+    ) GetStatistics;
+    lldb::SBStructuredData
+    GetStatistics ();
 }; // class SBDebugger
 
 } // namespace lldb
@@ -33,6 +33,9 @@ namespace lldb {
         void
         Clear();
 
+        lldb::SBError
+        SetFromJSON(lldb::SBStream &stream);
+
         lldb::SBError
         GetAsJSON(lldb::SBStream &stream) const;
 
@@ -552,6 +552,23 @@ public:
     ResolveSymbolContextForAddress (const SBAddress& addr, 
                                     uint32_t resolve_scope);
 
+    %feature("docstring", "
+    //------------------------------------------------------------------
+    /// Resolve many addresses given as module offsets at once.
+    ///
+    /// Takes a list of module UUID strings and a list of offsets from the
+    /// start of each module's image, and returns an SBSymbolContextList
+    /// with one symbol context per offset, in order. Addresses in the same
+    /// module share their line table and block lookups, and different
+    /// modules are resolved in parallel.
+    //------------------------------------------------------------------
+    ") ResolveSymbolContextsForModuleOffsets;
+    lldb::SBSymbolContextList
+    ResolveSymbolContextsForModuleOffsets (const char **uuids,
+                                           uint64_t *array,
+                                           size_t array_len,
+                                           uint32_t resolve_scope);
+
      %feature("docstring", "
     //------------------------------------------------------------------
     /// Read target memory. If a target process is running then memory  
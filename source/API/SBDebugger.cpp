@@ -26,6 +26,7 @@
 #include "lldb/API/SBSourceManager.h"
 #include "lldb/API/SBStream.h"
 #include "lldb/API/SBStringList.h"
+#include "lldb/API/SBStructuredData.h"
 #include "lldb/API/SBTarget.h"
 #include "lldb/API/SBThread.h"
 #include "lldb/API/SBTypeCategory.h"
@@ -39,6 +40,7 @@
 #include "lldb/Core/Debugger.h"
 #include "lldb/Core/State.h"
 #include "lldb/Core/StreamFile.h"
+#include "lldb/Core/StructuredDataImpl.h"
 #include "lldb/DataFormatters/DataVisualization.h"
 #include "lldb/Initialization/SystemLifetimeManager.h"
 #include "lldb/Interpreter/Args.h"
@@ -842,6 +844,13 @@ SBError SBDebugger::RunREPL(lldb::LanguageType language,
   return error;
 }
 
+SBStructuredData SBDebugger::GetStatistics() {
+  StructuredDataImpl *impl = new StructuredDataImpl();
+  if (m_opaque_sp)
+    impl->SetObjectSP(m_opaque_sp->GetStatistics());
+  return SBStructuredData(impl);
+}
+
 void SBDebugger::reset(const DebuggerSP &debugger_sp) {
   m_opaque_sp = debugger_sp;
 }
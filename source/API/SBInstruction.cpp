@@ -57,9 +57,29 @@ public:
 
   bool IsValid() const { return (bool)m_inst_sp; }
 
+  // The instruction returns copies of its strings, so keep the last one of
+  // each kind here for the "const char *" our API hands out.
+  const char *SetMnemonic(std::string mnemonic) {
+    m_mnemonic = std::move(mnemonic);
+    return m_mnemonic.c_str();
+  }
+
+  const char *SetOperands(std::string operands) {
+    m_operands = std::move(operands);
+    return m_operands.c_str();
+  }
+
+  const char *SetComment(std::string comment) {
+    m_comment = std::move(comment);
+    return m_comment.c_str();
+  }
+
 protected:
   lldb::DisassemblerSP m_disasm_sp; // Can be empty/invalid
   lldb::InstructionSP m_inst_sp;
+  std::string m_mnemonic;
+  std::string m_operands;
+  std::string m_comment;
 };
 
 using namespace lldb;
@@ -104,7 +124,7 @@ const char *SBInstruction::GetMnemonic(SBTarget target) {
       target_sp->CalculateExecutionContext(exe_ctx);
       exe_ctx.SetProcessSP(target_sp->GetProcessSP());
     }
-    return inst_sp->GetMnemonic(&exe_ctx);
+    return m_opaque_sp->SetMnemonic(inst_sp->GetMnemonic(&exe_ctx));
   }
   return NULL;
 }
@@ -121,7 +141,7 @@ const char *SBInstruction::GetOperands(SBTarget target) {
       target_sp->CalculateExecutionContext(exe_ctx);
       exe_ctx.SetProcessSP(target_sp->GetProcessSP());
     }
-    return inst_sp->GetOperands(&exe_ctx);
+    return m_opaque_sp->SetOperands(inst_sp->GetOperands(&exe_ctx));
   }
   return NULL;
 }
@@ -138,7 +158,7 @@ const char *SBInstruction::GetComment(SBTarget target) {
       target_sp->CalculateExecutionContext(exe_ctx);
       exe_ctx.SetProcessSP(target_sp->GetProcessSP());
     }
-    return inst_sp->GetComment(&exe_ctx);
+    return m_opaque_sp->SetComment(inst_sp->GetComment(&exe_ctx));
   }
   return NULL;
 }
@@ -1269,7 +1269,7 @@ lldb::SBError SBProcess::SaveCore(const char *file_name) {
   }
 
   FileSpec core_file(file_name, false);
-  error.ref() = PluginManager::SaveCore(process_sp, core_file);
+  error.ref() = PluginManager::SaveCore(process_sp, core_file, eSaveCoreFull);
   return error;
 }
 
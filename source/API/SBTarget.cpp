@@ -631,6 +631,33 @@ SBTarget::ResolveSymbolContextForAddress(const SBAddress &addr,
   return sc;
 }
 
+lldb::SBSymbolContextList SBTarget::ResolveSymbolContextsForModuleOffsets(
+    const char **uuids, uint64_t *array, size_t array_len,
+    uint32_t resolve_scope) {
+  lldb::SBSymbolContextList sb_sc_list;
+  TargetSP target_sp(GetSP());
+  if (!target_sp || uuids == nullptr || array == nullptr)
+    return sb_sc_list;
+
+  // "uuids" is null terminated. Offsets past its end get no module and
+  // resolve to empty symbol contexts.
+  std::vector<ModuleList::ModuleOffset> requests(array_len);
+  bool end_of_uuids = false;
+  for (size_t i = 0; i < array_len; ++i) {
+    end_of_uuids = end_of_uuids || uuids[i] == nullptr;
+    if (!end_of_uuids)
+      requests[i].uuid.SetFromCString(uuids[i]);
+    requests[i].offset = array[i];
+  }
+
+  std::vector<SymbolContext> sc_list;
+  target_sp->GetImages().ResolveSymbolContextsForModuleOffsets(
+      requests, resolve_scope, sc_list);
+  for (const SymbolContext &sc : sc_list)
+    sb_sc_list->Append(sc);
+  return sb_sc_list;
+}
+
 size_t SBTarget::ReadMemory(const SBAddress addr, void *buf, size_t size,
                             lldb::SBError &error) {
   SBError sb_error;
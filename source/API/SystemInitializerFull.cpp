@@ -91,6 +91,7 @@
 #include "Plugins/UnwindAssembly/x86/UnwindAssembly-x86.h"
 
 #include "Plugins/JITLoader/Mono/JITLoaderMono.h"
+#include "Plugins/ObjectFile/Minidump/ObjectFileMinidump.h"
 #include "Plugins/ObjectFile/Mono/ObjectFileMono.h"
 #include "Plugins/SymbolVendor/Mono/SymbolVendorMono.h"
 
@@ -311,6 +312,7 @@ void SystemInitializerFull::Initialize() {
   JITLoaderGDB::Initialize();
   ProcessElfCore::Initialize();
   minidump::ProcessMinidump::Initialize();
+  ObjectFileMinidump::Initialize();
   MemoryHistoryASan::Initialize();
   AddressSanitizerRuntime::Initialize();
   ThreadSanitizerRuntime::Initialize();
@@ -438,6 +440,7 @@ void SystemInitializerFull::Terminate() {
   JITLoaderGDB::Terminate();
   ProcessElfCore::Terminate();
   minidump::ProcessMinidump::Terminate();
+  ObjectFileMinidump::Terminate();
   MemoryHistoryASan::Terminate();
   AddressSanitizerRuntime::Terminate();
   ThreadSanitizerRuntime::Terminate();
@@ -33,7 +33,8 @@ BreakpointSite::BreakpointSite(BreakpointSiteList *list,
       m_enabled(false), // Need to create it disabled, so the first enable turns
                         // it on.
       m_owners(), m_owners_mutex() {
-  m_owners.Add(owner);
+  if (owner)
+    m_owners.Add(owner);
 }
 
 BreakpointSite::~BreakpointSite() {
@@ -19,7 +19,8 @@
 using namespace lldb;
 using namespace lldb_private;
 
-BreakpointSiteList::BreakpointSiteList() : m_mutex(), m_bp_site_list() {}
+BreakpointSiteList::BreakpointSiteList()
+    : m_mutex(), m_addresses(), m_sites(), m_ids() {}
 
 BreakpointSiteList::~BreakpointSiteList() {}
 
@@ -30,14 +31,25 @@ BreakpointSiteList::~BreakpointSiteList() {}
 lldb::break_id_t BreakpointSiteList::Add(const BreakpointSiteSP &bp) {
   lldb::addr_t bp_site_load_addr = bp->GetLoadAddress();
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  collection::iterator iter = m_bp_site_list.find(bp_site_load_addr);
-
-  if (iter == m_bp_site_list.end()) {
-    m_bp_site_list.insert(iter, collection::value_type(bp_site_load_addr, bp));
-    return bp->GetID();
-  } else {
+  AddressCollection::iterator addr_pos = std::lower_bound(
+      m_addresses.begin(), m_addresses.end(), bp_site_load_addr);
+  if (addr_pos != m_addresses.end() && *addr_pos == bp_site_load_addr)
     return LLDB_INVALID_BREAK_ID;
-  }
+
+  const size_t index = addr_pos - m_addresses.begin();
+  m_addresses.insert(addr_pos, bp_site_load_addr);
+  m_sites.insert(m_sites.begin() + index, bp);
+
+  // Site IDs are handed out in increasing order, so this is almost always an
+  // append.
+  const lldb::break_id_t bp_site_id = bp->GetID();
+  IDCollection::value_type id_entry(bp_site_id, bp_site_load_addr);
+  if (m_ids.empty() || m_ids.back().first < bp_site_id)
+    m_ids.push_back(id_entry);
+  else
+    m_ids.insert(std::lower_bound(m_ids.begin(), m_ids.end(), id_entry),
+                 id_entry);
+  return bp_site_id;
 }
 
 bool BreakpointSiteList::ShouldStop(StoppointCallbackContext *context,
@@ -67,58 +79,58 @@ lldb::break_id_t BreakpointSiteList::FindIDByAddress(lldb::addr_t addr) {
 
 bool BreakpointSiteList::Remove(lldb::break_id_t break_id) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  collection::iterator pos = GetIDIterator(break_id); // Predicate
-  if (pos != m_bp_site_list.end()) {
-    m_bp_site_list.erase(pos);
-    return true;
-  }
-  return false;
+  size_t index = FindIndexByID(break_id);
+  if (index == m_sites.size())
+    return false;
+  RemoveAtIndex(index);
+  return true;
 }
 
 bool BreakpointSiteList::RemoveByAddress(lldb::addr_t address) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  collection::iterator pos = m_bp_site_list.find(address);
-  if (pos != m_bp_site_list.end()) {
-    m_bp_site_list.erase(pos);
-    return true;
-  }
-  return false;
+  size_t index = FindIndexByAddress(address);
+  if (index == m_sites.size())
+    return false;
+  RemoveAtIndex(index);
+  return true;
 }
 
-class BreakpointSiteIDMatches {
-public:
-  BreakpointSiteIDMatches(lldb::break_id_t break_id) : m_break_id(break_id) {}
-
-  bool operator()(std::pair<lldb::addr_t, BreakpointSiteSP> val_pair) const {
-    return m_break_id == val_pair.second.get()->GetID();
-  }
-
-private:
-  const lldb::break_id_t m_break_id;
-};
+size_t BreakpointSiteList::FindIndexByAddress(lldb::addr_t addr) const {
+  AddressCollection::const_iterator pos =
+      std::lower_bound(m_addresses.begin(), m_addresses.end(), addr);
+  if (pos == m_addresses.end() || *pos != addr)
+    return m_sites.size();
+  return pos - m_addresses.begin();
+}
 
-BreakpointSiteList::collection::iterator
-BreakpointSiteList::GetIDIterator(lldb::break_id_t break_id) {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  return std::find_if(m_bp_site_list.begin(),
-                      m_bp_site_list.end(),               // Search full range
-                      BreakpointSiteIDMatches(break_id)); // Predicate
+size_t BreakpointSiteList::FindIndexByID(lldb::break_id_t break_id) const {
+  IDCollection::const_iterator pos = std::lower_bound(
+      m_ids.begin(), m_ids.end(), break_id,
+      [](const IDCollection::value_type &entry, lldb::break_id_t id) {
+        return entry.first < id;
+      });
+  if (pos == m_ids.end() || pos->first != break_id)
+    return m_sites.size();
+  return FindIndexByAddress(pos->second);
 }
 
-BreakpointSiteList::collection::const_iterator
-BreakpointSiteList::GetIDConstIterator(lldb::break_id_t break_id) const {
-  std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  return std::find_if(m_bp_site_list.begin(),
-                      m_bp_site_list.end(),               // Search full range
-                      BreakpointSiteIDMatches(break_id)); // Predicate
+void BreakpointSiteList::RemoveAtIndex(size_t index) {
+  IDCollection::value_type id_entry(m_sites[index]->GetID(),
+                                    m_addresses[index]);
+  IDCollection::iterator id_pos =
+      std::lower_bound(m_ids.begin(), m_ids.end(), id_entry);
+  if (id_pos != m_ids.end() && *id_pos == id_entry)
+    m_ids.erase(id_pos);
+  m_addresses.erase(m_addresses.begin() + index);
+  m_sites.erase(m_sites.begin() + index);
 }
 
 BreakpointSiteSP BreakpointSiteList::FindByID(lldb::break_id_t break_id) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
   BreakpointSiteSP stop_sp;
-  collection::iterator pos = GetIDIterator(break_id);
-  if (pos != m_bp_site_list.end())
-    stop_sp = pos->second;
+  size_t index = FindIndexByID(break_id);
+  if (index != m_sites.size())
+    stop_sp = m_sites[index];
 
   return stop_sp;
 }
@@ -127,9 +139,9 @@ const BreakpointSiteSP
 BreakpointSiteList::FindByID(lldb::break_id_t break_id) const {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
   BreakpointSiteSP stop_sp;
-  collection::const_iterator pos = GetIDConstIterator(break_id);
-  if (pos != m_bp_site_list.end())
-    stop_sp = pos->second;
+  size_t index = FindIndexByID(break_id);
+  if (index != m_sites.size())
+    stop_sp = m_sites[index];
 
   return stop_sp;
 }
@@ -137,18 +149,18 @@ BreakpointSiteList::FindByID(lldb::break_id_t break_id) const {
 BreakpointSiteSP BreakpointSiteList::FindByAddress(lldb::addr_t addr) {
   BreakpointSiteSP found_sp;
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  collection::iterator iter = m_bp_site_list.find(addr);
-  if (iter != m_bp_site_list.end())
-    found_sp = iter->second;
+  size_t index = FindIndexByAddress(addr);
+  if (index != m_sites.size())
+    found_sp = m_sites[index];
   return found_sp;
 }
 
 bool BreakpointSiteList::BreakpointSiteContainsBreakpoint(
     lldb::break_id_t bp_site_id, lldb::break_id_t bp_id) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  collection::const_iterator pos = GetIDConstIterator(bp_site_id);
-  if (pos != m_bp_site_list.end())
-    return pos->second->IsBreakpointAtThisSite(bp_id);
+  size_t index = FindIndexByID(bp_site_id);
+  if (index != m_sites.size())
+    return m_sites[index]->IsBreakpointAtThisSite(bp_id);
 
   return false;
 }
@@ -157,50 +169,54 @@ void BreakpointSiteList::Dump(Stream *s) const {
   s->Printf("%p: ", static_cast<const void *>(this));
   // s->Indent();
   s->Printf("BreakpointSiteList with %u BreakpointSites:\n",
-            (uint32_t)m_bp_site_list.size());
+            (uint32_t)m_sites.size());
   s->IndentMore();
-  collection::const_iterator pos;
-  collection::const_iterator end = m_bp_site_list.end();
-  for (pos = m_bp_site_list.begin(); pos != end; ++pos)
-    pos->second.get()->Dump(s);
+  for (const BreakpointSiteSP &site_sp : m_sites)
+    site_sp->Dump(s);
   s->IndentLess();
 }
 
 void BreakpointSiteList::ForEach(
     std::function<void(BreakpointSite *)> const &callback) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  for (auto pair : m_bp_site_list)
-    callback(pair.second.get());
+  for (const BreakpointSiteSP &site_sp : m_sites)
+    callback(site_sp.get());
 }
 
 bool BreakpointSiteList::FindInRange(lldb::addr_t lower_bound,
                                      lldb::addr_t upper_bound,
                                      BreakpointSiteList &bp_site_list) const {
-  if (lower_bound > upper_bound)
-    return false;
+  bool found = false;
+  ForEachInRange(lower_bound, upper_bound,
+                 [&bp_site_list, &found](BreakpointSite *bp_site) {
+                   bp_site_list.Add(bp_site->shared_from_this());
+                   found = true;
+                 });
+  return found;
+}
+
+void BreakpointSiteList::ForEachInRange(
+    lldb::addr_t lower_bound, lldb::addr_t upper_bound,
+    std::function<void(BreakpointSite *)> const &callback) const {
+  if (lower_bound >= upper_bound)
+    return;
 
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  collection::const_iterator lower, upper, pos;
-  lower = m_bp_site_list.lower_bound(lower_bound);
-  if (lower == m_bp_site_list.end() || (*lower).first >= upper_bound)
-    return false;
+  AddressCollection::const_iterator lower =
+      std::lower_bound(m_addresses.begin(), m_addresses.end(), lower_bound);
+  size_t index = lower - m_addresses.begin();
 
   // This is one tricky bit.  The breakpoint might overlap the bottom end of the
   // range.  So we grab the
   // breakpoint prior to the lower bound, and check that that + its byte size
   // isn't in our range.
-  if (lower != m_bp_site_list.begin()) {
-    collection::const_iterator prev_pos = lower;
-    prev_pos--;
-    const BreakpointSiteSP &prev_bp = (*prev_pos).second;
-    if (prev_bp->GetLoadAddress() + prev_bp->GetByteSize() > lower_bound)
-      bp_site_list.Add(prev_bp);
+  if (index > 0) {
+    BreakpointSite *prev_bp = m_sites[index - 1].get();
+    if (m_addresses[index - 1] + prev_bp->GetByteSize() > lower_bound)
+      callback(prev_bp);
   }
 
-  upper = m_bp_site_list.upper_bound(upper_bound);
-
-  for (pos = lower; pos != upper; pos++) {
-    bp_site_list.Add((*pos).second);
-  }
-  return true;
+  const size_t num_sites = m_sites.size();
+  for (; index < num_sites && m_addresses[index] < upper_bound; ++index)
+    callback(m_sites[index].get());
 }
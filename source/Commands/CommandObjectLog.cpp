@@ -32,6 +32,9 @@
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"
 
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -47,6 +50,8 @@ static OptionDefinition g_log_options[] = {
   { LLDB_OPT_SET_1, false, "stack",      'S', OptionParser::eNoArgument,       nullptr, nullptr, 0, eArgTypeNone,     "Append a stack backtrace to each log line." },
   { LLDB_OPT_SET_1, false, "append",     'a', OptionParser::eNoArgument,       nullptr, nullptr, 0, eArgTypeNone,     "Append to the log file instead of overwriting." },
   { LLDB_OPT_SET_1, false, "file-function",'F',OptionParser::eNoArgument,      nullptr, nullptr, 0, eArgTypeNone,     "Prepend the names of files and function that generate the logs." },
+  { LLDB_OPT_SET_1, false, "buffered",   'b', OptionParser::eNoArgument,       nullptr, nullptr, 0, eArgTypeNone,     "Queue log records on the logging thread and write them from a background thread." },
+  { LLDB_OPT_SET_1, false, "circular",   'c', OptionParser::eRequiredArgument, nullptr, nullptr, 0, eArgTypeCount,    "Keep the last <count> log records in memory and only write them on 'log dump' or when lldb crashes." },
     // clang-format on
 };
 
@@ -89,7 +94,7 @@ public:
 
   class CommandOptions : public Options {
   public:
-    CommandOptions() : Options(), log_file(), log_options(0) {}
+    CommandOptions() : Options(), log_file(), log_options(0), buffer_size(0) {}
 
     ~CommandOptions() override = default;
 
@@ -129,6 +134,15 @@ public:
       case 'F':
         log_options |= LLDB_LOG_OPTION_PREPEND_FILE_FUNCTION;
         break;
+      case 'b':
+        log_options |= LLDB_LOG_OPTION_BUFFERED;
+        break;
+      case 'c':
+        if (option_arg.getAsInteger(0, buffer_size) || buffer_size == 0)
+          error.SetErrorStringWithFormat("invalid record count '%s'",
+                                         option_arg.str().c_str());
+        log_options |= LLDB_LOG_OPTION_CIRCULAR;
+        break;
       default:
         error.SetErrorStringWithFormat("unrecognized option '%c'",
                                        short_option);
@@ -141,6 +155,7 @@ public:
     void OptionParsingStarting(ExecutionContext *execution_context) override {
       log_file.Clear();
       log_options = 0;
+      buffer_size = 0;
     }
 
     llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
@@ -151,6 +166,7 @@ public:
 
     FileSpec log_file;
     uint32_t log_options;
+    size_t buffer_size;
   };
 
 protected:
@@ -175,7 +191,7 @@ protected:
     llvm::raw_string_ostream error_stream(error);
     bool success = m_interpreter.GetDebugger().EnableLog(
         channel, args.GetArgumentArrayRef(), log_file, m_options.log_options,
-        error_stream);
+        error_stream, m_options.buffer_size);
     result.GetErrorStream() << error_stream.str();
 
     if (success)
@@ -295,6 +311,113 @@ protected:
   }
 };
 
+static OptionDefinition g_log_dump_options[] = {
+    // clang-format off
+  { LLDB_OPT_SET_1, false, "file", 'f', OptionParser::eRequiredArgument, nullptr, nullptr, 0, eArgTypeFilename, "Write the log records to this file instead of the log's own destination." },
+    // clang-format on
+};
+
+class CommandObjectLogDump : public CommandObjectParsed {
+public:
+  //------------------------------------------------------------------
+  // Constructors and Destructors
+  //------------------------------------------------------------------
+  CommandObjectLogDump(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "log dump",
+                            "Write out the log records that a channel enabled "
+                            "with --circular kept in memory.",
+                            nullptr),
+        m_options() {
+    CommandArgumentEntry arg;
+    CommandArgumentData channel_arg;
+
+    // Define the first (and only) variant of this arg.
+    channel_arg.arg_type = eArgTypeLogChannel;
+    channel_arg.arg_repetition = eArgRepeatPlain;
+
+    // There is only one variant this argument could be; put it into the
+    // argument entry.
+    arg.push_back(channel_arg);
+
+    // Push the data for the first argument into the m_arguments vector.
+    m_arguments.push_back(arg);
+  }
+
+  ~CommandObjectLogDump() override = default;
+
+  Options *GetOptions() override { return &m_options; }
+
+  class CommandOptions : public Options {
+  public:
+    CommandOptions() : Options(), log_file() {}
+
+    ~CommandOptions() override = default;
+
+    Error SetOptionValue(uint32_t option_idx, llvm::StringRef option_arg,
+                         ExecutionContext *execution_context) override {
+      Error error;
+      const int short_option = m_getopt_table[option_idx].val;
+
+      switch (short_option) {
+      case 'f':
+        log_file.SetFile(option_arg, true);
+        break;
+      default:
+        error.SetErrorStringWithFormat("unrecognized option '%c'",
+                                       short_option);
+        break;
+      }
+
+      return error;
+    }
+
+    void OptionParsingStarting(ExecutionContext *execution_context) override {
+      log_file.Clear();
+    }
+
+    llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
+      return llvm::makeArrayRef(g_log_dump_options);
+    }
+
+    FileSpec log_file;
+  };
+
+protected:
+  bool DoExecute(Args &args, CommandReturnObject &result) override {
+    if (args.GetArgumentCount() != 1) {
+      result.AppendErrorWithFormat("%s takes a log channel.\n",
+                                   m_cmd_name.c_str());
+      return false;
+    }
+
+    std::shared_ptr<llvm::raw_ostream> stream_sp;
+    if (m_options.log_file) {
+      std::error_code ec;
+      stream_sp = std::make_shared<llvm::raw_fd_ostream>(
+          m_options.log_file.GetPath(), ec, llvm::sys::fs::F_Text);
+      if (ec) {
+        result.AppendErrorWithFormat("unable to open log file '%s': %s\n",
+                                     m_options.log_file.GetPath().c_str(),
+                                     ec.message().c_str());
+        return false;
+      }
+    }
+
+    std::string error;
+    llvm::raw_string_ostream error_stream(error);
+    bool success = Log::DumpLogChannel(args[0].ref, stream_sp, error_stream);
+    result.GetErrorStream() << error_stream.str();
+
+    if (success)
+      result.SetStatus(eReturnStatusSuccessFinishNoResult);
+    else
+      result.SetStatus(eReturnStatusFailed);
+    return result.Succeeded();
+  }
+
+  CommandOptions m_options;
+};
+
 class CommandObjectLogTimer : public CommandObjectParsed {
 public:
   //------------------------------------------------------------------
@@ -372,6 +495,8 @@ CommandObjectLog::CommandObjectLog(CommandInterpreter &interpreter)
                  CommandObjectSP(new CommandObjectLogDisable(interpreter)));
   LoadSubCommand("list",
                  CommandObjectSP(new CommandObjectLogList(interpreter)));
+  LoadSubCommand("dump",
+                 CommandObjectSP(new CommandObjectLogDump(interpreter)));
   LoadSubCommand("timers",
                  CommandObjectSP(new CommandObjectLogTimer(interpreter)));
 }
@@ -1278,27 +1278,91 @@ protected:
 //-------------------------------------------------------------------------
 // CommandObjectProcessSaveCore
 //-------------------------------------------------------------------------
+
+static OptionEnumValueElement g_save_core_style[] = {
+    {eSaveCoreFull, "full", "Save all readable memory."},
+    {eSaveCoreDirtyOnly, "modified-memory",
+     "Don't save read-only memory that is backed by a file, such as the code "
+     "of the executable and shared libraries."},
+    {eSaveCoreStackOnly, "stack", "Only save the stacks of the threads."},
+    {0, nullptr, nullptr}};
+
+static OptionDefinition g_process_save_core_options[] = {
+    // clang-format off
+  { LLDB_OPT_SET_1, false, "style",       's', OptionParser::eRequiredArgument, nullptr, g_save_core_style, 0, eArgTypeNone,       "Choose how much of the process' memory to save in the core file." },
+  { LLDB_OPT_SET_1, false, "plugin-name", 'p', OptionParser::eRequiredArgument, nullptr, nullptr,           0, eArgTypePlugin,     "Use the named object file plug-in to write the core file, e.g. \"elf\" or \"minidump\"." },
+    // clang-format on
+};
+
 #pragma mark CommandObjectProcessSaveCore
 
 class CommandObjectProcessSaveCore : public CommandObjectParsed {
 public:
+  class CommandOptions : public Options {
+  public:
+    CommandOptions() : Options() { OptionParsingStarting(nullptr); }
+
+    ~CommandOptions() override = default;
+
+    Error SetOptionValue(uint32_t option_idx, llvm::StringRef option_arg,
+                         ExecutionContext *execution_context) override {
+      Error error;
+      const int short_option = m_getopt_table[option_idx].val;
+
+      switch (short_option) {
+      case 's':
+        m_style = (SaveCoreStyle)Args::StringToOptionEnum(
+            option_arg, GetDefinitions()[option_idx].enum_values,
+            eSaveCoreUnspecified, error);
+        break;
+      case 'p':
+        m_plugin_name.SetString(option_arg);
+        break;
+      default:
+        error.SetErrorStringWithFormat("invalid short option character '%c'",
+                                       short_option);
+        break;
+      }
+      return error;
+    }
+
+    void OptionParsingStarting(ExecutionContext *execution_context) override {
+      m_style = eSaveCoreFull;
+      m_plugin_name.Clear();
+    }
+
+    llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
+      return llvm::makeArrayRef(g_process_save_core_options);
+    }
+
+    // Instance variables to hold the values for command options.
+    SaveCoreStyle m_style;
+    ConstString m_plugin_name;
+  };
+
   CommandObjectProcessSaveCore(CommandInterpreter &interpreter)
       : CommandObjectParsed(interpreter, "process save-core",
                             "Save the current process as a core file using an "
                             "appropriate file type.",
-                            "process save-core FILE",
+                            "process save-core [-s style] [-p plugin] FILE",
                             eCommandRequiresProcess | eCommandTryTargetAPILock |
-                                eCommandProcessMustBeLaunched) {}
+                                eCommandProcessMustBeLaunched |
+                                eCommandProcessMustBePaused),
+        m_options() {}
 
   ~CommandObjectProcessSaveCore() override = default;
 
+  Options *GetOptions() override { return &m_options; }
+
 protected:
   bool DoExecute(Args &command, CommandReturnObject &result) override {
     ProcessSP process_sp = m_exe_ctx.GetProcessSP();
     if (process_sp) {
       if (command.GetArgumentCount() == 1) {
         FileSpec output_file(command.GetArgumentAtIndex(0), false);
-        Error error = PluginManager::SaveCore(process_sp, output_file);
+        Error error = PluginManager::SaveCore(process_sp, output_file,
+                                              m_options.m_style,
+                                              m_options.m_plugin_name);
         if (error.Success()) {
           result.SetStatus(eReturnStatusSuccessFinishResult);
         } else {
@@ -1319,6 +1383,8 @@ protected:
 
     return result.Succeeded();
   }
+
+  CommandOptions m_options;
 };
 
 //-------------------------------------------------------------------------
@@ -0,0 +1,139 @@
+//===-- CommandObjectStats.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "CommandObjectStats.h"
+
+// C Includes
+// C++ Includes
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/StructuredData.h"
+#include "lldb/Core/Timer.h"
+#include "lldb/Host/OptionParser.h"
+#include "lldb/Interpreter/CommandInterpreter.h"
+#include "lldb/Interpreter/CommandReturnObject.h"
+#include "lldb/Interpreter/Options.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+static OptionDefinition g_statistics_dump_options[] = {
+    // clang-format off
+  { LLDB_OPT_SET_1, false, "compact", 'c', OptionParser::eNoArgument, nullptr, nullptr, 0, eArgTypeNone, "Print the statistics on a single line instead of pretty printing them." },
+    // clang-format on
+};
+
+class CommandObjectStatsDump : public CommandObjectParsed {
+public:
+  CommandObjectStatsDump(CommandInterpreter &interpreter)
+      : CommandObjectParsed(
+            interpreter, "statistics dump",
+            "Print timers, per-module parse and index times, memory usage, "
+            "cache hit rates and remote packet statistics as JSON.",
+            "statistics dump [<command-options>]"),
+        m_options() {}
+
+  ~CommandObjectStatsDump() override = default;
+
+  Options *GetOptions() override { return &m_options; }
+
+  class CommandOptions : public Options {
+  public:
+    CommandOptions() : Options(), m_compact(false) {}
+
+    ~CommandOptions() override = default;
+
+    Error SetOptionValue(uint32_t option_idx, llvm::StringRef option_arg,
+                         ExecutionContext *execution_context) override {
+      Error error;
+      const int short_option = m_getopt_table[option_idx].val;
+
+      switch (short_option) {
+      case 'c':
+        m_compact = true;
+        break;
+      default:
+        error.SetErrorStringWithFormat("unrecognized option '%c'",
+                                       short_option);
+        break;
+      }
+      return error;
+    }
+
+    void OptionParsingStarting(ExecutionContext *execution_context) override {
+      m_compact = false;
+    }
+
+    llvm::ArrayRef<OptionDefinition> GetDefinitions() override {
+      return llvm::makeArrayRef(g_statistics_dump_options);
+    }
+
+    bool m_compact;
+  };
+
+protected:
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    if (command.GetArgumentCount() != 0) {
+      result.AppendErrorWithFormat("%s takes no arguments.\n",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    StructuredData::DictionarySP stats_sp =
+        m_interpreter.GetDebugger().GetStatistics();
+    stats_sp->Dump(result.GetOutputStream(), !m_options.m_compact);
+    result.GetOutputStream().EOL();
+    result.SetStatus(eReturnStatusSuccessFinishResult);
+    return true;
+  }
+
+  CommandOptions m_options;
+};
+
+class CommandObjectStatsReset : public CommandObjectParsed {
+public:
+  CommandObjectStatsReset(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "statistics reset",
+                            "Reset the timer statistics.",
+                            "statistics reset") {}
+
+  ~CommandObjectStatsReset() override = default;
+
+protected:
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    if (command.GetArgumentCount() != 0) {
+      result.AppendErrorWithFormat("%s takes no arguments.\n",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    Timer::ResetCategoryTimes();
+    result.SetStatus(eReturnStatusSuccessFinishNoResult);
+    return true;
+  }
+};
+
+//-------------------------------------------------------------------------
+// CommandObjectStats
+//-------------------------------------------------------------------------
+
+CommandObjectStats::CommandObjectStats(CommandInterpreter &interpreter)
+    : CommandObjectMultiword(interpreter, "statistics",
+                             "Commands for inspecting LLDB's own performance.",
+                             "statistics <subcommand> [<command-options>]") {
+  LoadSubCommand("dump",
+                 CommandObjectSP(new CommandObjectStatsDump(interpreter)));
+  LoadSubCommand("reset",
+                 CommandObjectSP(new CommandObjectStatsReset(interpreter)));
+}
+
+CommandObjectStats::~CommandObjectStats() = default;
@@ -3199,6 +3199,80 @@ public:
   ~CommandObjectTypeSummary() override = default;
 };
 
+//-------------------------------------------------------------------------
+// CommandObjectTypeCacheStats
+//-------------------------------------------------------------------------
+
+class CommandObjectTypeCacheStats : public CommandObjectParsed {
+public:
+  CommandObjectTypeCacheStats(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "type cache stats",
+                            "Show hit and miss counts for the formatter "
+                            "lookup caches.",
+                            nullptr) {}
+
+  ~CommandObjectTypeCacheStats() override = default;
+
+protected:
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    if (command.GetArgumentCount() != 0) {
+      result.AppendErrorWithFormat("%s takes no arguments.\n",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    DataVisualization::DumpCacheStatistics(result.GetOutputStream());
+    result.SetStatus(eReturnStatusSuccessFinishResult);
+    return result.Succeeded();
+  }
+};
+
+//-------------------------------------------------------------------------
+// CommandObjectTypeCacheReset
+//-------------------------------------------------------------------------
+
+class CommandObjectTypeCacheReset : public CommandObjectParsed {
+public:
+  CommandObjectTypeCacheReset(CommandInterpreter &interpreter)
+      : CommandObjectParsed(interpreter, "type cache reset",
+                            "Reset the formatter lookup cache statistics. "
+                            "Cached formatters are kept.",
+                            nullptr) {}
+
+  ~CommandObjectTypeCacheReset() override = default;
+
+protected:
+  bool DoExecute(Args &command, CommandReturnObject &result) override {
+    if (command.GetArgumentCount() != 0) {
+      result.AppendErrorWithFormat("%s takes no arguments.\n",
+                                   m_cmd_name.c_str());
+      result.SetStatus(eReturnStatusFailed);
+      return false;
+    }
+
+    DataVisualization::ResetCacheStatistics();
+    result.SetStatus(eReturnStatusSuccessFinishNoResult);
+    return result.Succeeded();
+  }
+};
+
+class CommandObjectTypeCache : public CommandObjectMultiword {
+public:
+  CommandObjectTypeCache(CommandInterpreter &interpreter)
+      : CommandObjectMultiword(interpreter, "type cache",
+                               "Commands for inspecting the formatter lookup "
+                               "caches.",
+                               "type cache [<sub-command-options>] ") {
+    LoadSubCommand("stats", CommandObjectSP(
+                                new CommandObjectTypeCacheStats(interpreter)));
+    LoadSubCommand("reset", CommandObjectSP(
+                                new CommandObjectTypeCacheReset(interpreter)));
+  }
+
+  ~CommandObjectTypeCache() override = default;
+};
+
 //-------------------------------------------------------------------------
 // CommandObjectType
 //-------------------------------------------------------------------------
@@ -3207,6 +3281,8 @@ CommandObjectType::CommandObjectType(CommandInterpreter &interpreter)
     : CommandObjectMultiword(interpreter, "type",
                              "Commands for operating on the type system.",
                              "type [<sub-command-options>]") {
+  LoadSubCommand("cache",
+                 CommandObjectSP(new CommandObjectTypeCache(interpreter)));
   LoadSubCommand("category",
                  CommandObjectSP(new CommandObjectTypeCategory(interpreter)));
   LoadSubCommand("filter",
@@ -14,10 +14,13 @@
 #include "lldb/Core/FormatEntity.h"
 #include "lldb/Core/Listener.h" // for Listener
 #include "lldb/Core/Mangled.h"  // for Mangled
+#include "lldb/Core/Module.h"
 #include "lldb/Core/PluginManager.h"
+#include "lldb/Core/Section.h"
 #include "lldb/Core/State.h"
 #include "lldb/Core/StreamAsynchronousIO.h"
 #include "lldb/Core/StreamFile.h"
+#include "lldb/Core/Timer.h"
 #include "lldb/DataFormatters/DataVisualization.h"
 #include "lldb/Expression/REPL.h"
 #include "lldb/Host/File.h" // for File, File::kInv...
@@ -32,8 +35,12 @@
 #include "lldb/Interpreter/Property.h"          // for PropertyDefinition
 #include "lldb/Interpreter/ScriptInterpreter.h" // for ScriptInterpreter
 #include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h" // for SymbolContext
+#include "lldb/Symbol/SymbolFile.h"
+#include "lldb/Symbol/SymbolVendor.h"
+#include "lldb/Symbol/Symtab.h"
 #include "lldb/Target/Language.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/StructuredDataPlugin.h"
@@ -544,6 +551,9 @@ void Debugger::Terminate() {
       g_debugger_list_ptr->clear();
     }
   }
+
+  // Write out the buffered log records before the log channels go away.
+  Log::Terminate();
 }
 
 void Debugger::SettingsInitialize() { Target::SettingsInitialize(); }
@@ -1255,7 +1265,7 @@ void Debugger::SetLoggingCallback(lldb::LogOutputCallback log_callback,
 bool Debugger::EnableLog(llvm::StringRef channel,
                          llvm::ArrayRef<const char *> categories,
                          llvm::StringRef log_file, uint32_t log_options,
-                         llvm::raw_ostream &error_stream) {
+                         llvm::raw_ostream &error_stream, size_t buffer_size) {
   const bool should_close = true;
   const bool unbuffered = true;
 
@@ -1289,12 +1299,14 @@ bool Debugger::EnableLog(llvm::StringRef channel,
   }
   assert(log_stream_sp);
 
-  if (log_options == 0)
-    log_options =
+  const uint32_t buffering_options =
+      LLDB_LOG_OPTION_BUFFERED | LLDB_LOG_OPTION_CIRCULAR;
+  if ((log_options & ~buffering_options) == 0)
+    log_options |=
         LLDB_LOG_OPTION_PREPEND_THREAD_NAME | LLDB_LOG_OPTION_THREADSAFE;
 
   return Log::EnableLogChannel(log_stream_sp, log_options, channel, categories,
-                               error_stream);
+                               error_stream, buffer_size);
 }
 
 SourceManager &Debugger::GetSourceManager() {
@@ -1744,3 +1756,148 @@ Error Debugger::RunREPL(LanguageType language, const char *repl_options) {
 
   return err;
 }
+
+static double NanosToSeconds(uint64_t nanos) {
+  return std::chrono::duration<double>(std::chrono::nanoseconds(nanos))
+      .count();
+}
+
+static uint64_t GetDebugInfoByteSize(const SectionList &section_list) {
+  uint64_t byte_size = 0;
+  const size_t num_sections = section_list.GetSize();
+  for (size_t i = 0; i < num_sections; ++i) {
+    SectionSP section_sp = section_list.GetSectionAtIndex(i);
+    const SectionType type = section_sp->GetType();
+    if (type >= eSectionTypeDWARFDebugAbbrev &&
+        type <= eSectionTypeDWARFAppleObjC)
+      byte_size += section_sp->GetFileSize();
+    byte_size += GetDebugInfoByteSize(section_sp->GetChildren());
+  }
+  return byte_size;
+}
+
+StructuredData::DictionarySP Debugger::GetStatistics() {
+  auto stats_sp = std::make_shared<StructuredData::Dictionary>();
+
+  auto timers_sp = std::make_shared<StructuredData::Array>();
+  for (const Timer::CategoryStats &category : Timer::GetCategoryStats()) {
+    auto timer_sp = std::make_shared<StructuredData::Dictionary>();
+    timer_sp->AddStringItem("category", category.category);
+    timer_sp->AddFloatItem(
+        "totalTime", std::chrono::duration<double>(category.time).count());
+    timer_sp->AddIntegerItem("count", category.count);
+    timers_sp->Push(timer_sp);
+  }
+  stats_sp->AddItem("timers", timers_sp);
+
+  // Report every module in the process, not just the ones in our targets:
+  // modules are shared between debuggers.
+  uint64_t total_symtab_byte_size = 0;
+  uint64_t total_section_mapped_byte_size = 0;
+  uint64_t total_section_heap_byte_size = 0;
+  auto modules_sp = std::make_shared<StructuredData::Array>();
+  {
+    std::lock_guard<std::recursive_mutex> guard(
+        Module::GetAllocationModuleCollectionMutex());
+    const size_t num_modules = Module::GetNumberAllocatedModules();
+    for (size_t i = 0; i < num_modules; ++i) {
+      Module *module = Module::GetAllocatedModuleAtIndex(i);
+      auto module_sp = std::make_shared<StructuredData::Dictionary>();
+      module_sp->AddStringItem("path", module->GetFileSpec().GetPath());
+      if (module->GetObjectName())
+        module_sp->AddStringItem("objectName",
+                                 module->GetObjectName().GetCString());
+      const Module::Statistics &module_stats = module->GetStatistics();
+      module_sp->AddFloatItem("symtabParseTime",
+                              NanosToSeconds(module_stats.symtab_parse_nanos));
+      module_sp->AddFloatItem("symtabIndexTime",
+                              NanosToSeconds(module_stats.symtab_index_nanos));
+      module_sp->AddFloatItem(
+          "debugInfoIndexTime",
+          NanosToSeconds(module_stats.debug_info_index_nanos));
+
+      // Only report what was already loaded, gathering statistics must not
+      // parse anything. Skip the details of modules that another thread is
+      // busy with rather than waiting for them.
+      std::unique_lock<std::recursive_mutex> module_guard(module->GetMutex(),
+                                                          std::try_to_lock);
+      ObjectFile *objfile =
+          module_guard.owns_lock() ? module->GetObjectFileIfLoaded() : nullptr;
+      if (objfile) {
+        if (SectionList *section_list = module->GetSectionListIfLoaded())
+          module_sp->AddIntegerItem("debugInfoByteSize",
+                                    GetDebugInfoByteSize(*section_list));
+        if (Symtab *symtab = objfile->GetSymtabIfParsed()) {
+          const uint64_t symtab_byte_size =
+              symtab->GetNumSymbols() * sizeof(Symbol);
+          module_sp->AddIntegerItem("symbolCount", symtab->GetNumSymbols());
+          module_sp->AddIntegerItem("symtabByteSize", symtab_byte_size);
+          total_symtab_byte_size += symtab_byte_size;
+        }
+
+        // Include the separate debug info file, if it was loaded already.
+        uint64_t mapped_byte_size = 0;
+        uint64_t heap_byte_size = 0;
+        objfile->GetSectionDataByteSizes(mapped_byte_size, heap_byte_size);
+        SymbolVendor *symbols = module->GetSymbolVendor(false);
+        SymbolFile *symfile = symbols ? symbols->GetSymbolFile() : nullptr;
+        ObjectFile *debug_objfile =
+            symfile ? symfile->GetObjectFile() : nullptr;
+        if (debug_objfile && debug_objfile != objfile) {
+          uint64_t debug_mapped_byte_size = 0;
+          uint64_t debug_heap_byte_size = 0;
+          debug_objfile->GetSectionDataByteSizes(debug_mapped_byte_size,
+                                                 debug_heap_byte_size);
+          mapped_byte_size += debug_mapped_byte_size;
+          heap_byte_size += debug_heap_byte_size;
+        }
+        module_sp->AddIntegerItem("sectionMappedByteSize", mapped_byte_size);
+        module_sp->AddIntegerItem("sectionHeapByteSize", heap_byte_size);
+        total_section_mapped_byte_size += mapped_byte_size;
+        total_section_heap_byte_size += heap_byte_size;
+      }
+      modules_sp->Push(module_sp);
+    }
+  }
+  stats_sp->AddItem("modules", modules_sp);
+
+  auto memory_sp = std::make_shared<StructuredData::Dictionary>();
+  memory_sp->AddIntegerItem("stringsByteSize", ConstString::StaticMemorySize());
+  memory_sp->AddIntegerItem("symtabsByteSize", total_symtab_byte_size);
+  memory_sp->AddIntegerItem("sectionsMappedByteSize",
+                            total_section_mapped_byte_size);
+  memory_sp->AddIntegerItem("sectionsHeapByteSize",
+                            total_section_heap_byte_size);
+  stats_sp->AddItem("memory", memory_sp);
+
+  uint64_t formatter_hits = 0;
+  uint64_t formatter_misses = 0;
+  DataVisualization::GetCacheStatistics(formatter_hits, formatter_misses);
+  auto formatters_sp = std::make_shared<StructuredData::Dictionary>();
+  formatters_sp->AddIntegerItem("hits", formatter_hits);
+  formatters_sp->AddIntegerItem("misses", formatter_misses);
+  formatters_sp->AddFloatItem(
+      "hitRate", formatter_hits + formatter_misses
+                     ? double(formatter_hits) /
+                           (formatter_hits + formatter_misses)
+                     : 0.0);
+  stats_sp->AddItem("formatterCache", formatters_sp);
+
+  auto targets_sp = std::make_shared<StructuredData::Array>();
+  const size_t num_targets = m_target_list.GetNumTargets();
+  for (size_t i = 0; i < num_targets; ++i) {
+    TargetSP target_sp = m_target_list.GetTargetAtIndex(i);
+    auto target_stats_sp = std::make_shared<StructuredData::Dictionary>();
+    if (Module *exe_module = target_sp->GetExecutableModulePointer())
+      target_stats_sp->AddStringItem("executable",
+                                     exe_module->GetFileSpec().GetPath());
+    target_stats_sp->AddIntegerItem("moduleCount",
+                                    target_sp->GetImages().GetSize());
+    if (ProcessSP process_sp = target_sp->GetProcessSP())
+      target_stats_sp->AddItem("process", process_sp->GetStatistics());
+    targets_sp->Push(target_stats_sp);
+  }
+  stats_sp->AddItem("targets", targets_sp);
+
+  return stats_sp;
+}
@@ -26,9 +26,12 @@
 #include "lldb/Interpreter/OptionValueString.h"
 #include "lldb/Interpreter/OptionValueUInt64.h"
 #include "lldb/Symbol/Function.h"
+#include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/Symbol.h"        // for Symbol
 #include "lldb/Symbol/SymbolContext.h" // for SymbolContext
+#include "lldb/Symbol/Symtab.h"
 #include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/Process.h"
 #include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/StackFrame.h"
 #include "lldb/Target/Target.h"
@@ -39,20 +42,37 @@
 #include "lldb/Utility/RegularExpression.h"
 #include "lldb/Utility/Stream.h"            // for Stream
 #include "lldb/Utility/StreamString.h"      // for StreamString
+#include "lldb/Utility/TaskPool.h"
 #include "lldb/lldb-private-enumerations.h" // for InstructionType:...
 #include "lldb/lldb-private-interfaces.h"   // for DisassemblerCrea...
 #include "lldb/lldb-private-types.h"        // for RegisterInfo
 #include "llvm/ADT/Triple.h"                // for Triple, Triple::...
 #include "llvm/Support/Compiler.h"          // for LLVM_PRETTY_FUNC...
 
+#include <algorithm>
 #include <cstdint> // for uint32_t, UINT32...
 #include <cstring>
+#include <future>
+#include <thread>
 #include <utility> // for pair
 
 #include <assert.h> // for assert
 
 #define DEFAULT_DISASM_BYTE_SIZE 32
 
+// The number of ranges each module keeps the disassembly of.
+static const size_t g_max_cached_disassemblies = 256;
+
+// The number of instructions each module keeps, a decoded instruction takes
+// a few hundred bytes.
+static const size_t g_max_cached_instructions = 64 * 1024;
+
+// Ranges smaller than this are decoded on the calling thread.
+static const size_t g_min_parallel_decode_size = 1024 * 1024;
+
+// The smallest piece of a range that gets its own task.
+static const size_t g_min_parallel_chunk_size = 256 * 1024;
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -192,21 +212,100 @@ lldb::DisassemblerSP Disassembler::DisassembleRange(
     const ArchSpec &arch, const char *plugin_name, const char *flavor,
     const ExecutionContext &exe_ctx, const AddressRange &range,
     bool prefer_file_cache) {
-  lldb::DisassemblerSP disasm_sp;
-  if (range.GetByteSize() > 0 && range.GetBaseAddress().IsValid()) {
-    disasm_sp = Disassembler::FindPluginForTarget(exe_ctx.GetTargetSP(), arch,
-                                                  flavor, plugin_name);
+  return DisassembleRange(arch, plugin_name, flavor, exe_ctx, range,
+                          prefer_file_cache, nullptr);
+}
 
-    if (disasm_sp) {
-      size_t bytes_disassembled = disasm_sp->ParseInstructions(
-          &exe_ctx, range, nullptr, prefer_file_cache);
-      if (bytes_disassembled == 0)
-        disasm_sp.reset();
-    }
+// Resolve the flavor the same way FindPluginForTarget does, and return the
+// DisassemblyCache key for the architecture, flavor and plug-in.
+static ConstString GetDisassemblyConfig(const ArchSpec &arch,
+                                        const char *plugin_name,
+                                        const char *&flavor,
+                                        const ExecutionContext &exe_ctx) {
+  TargetSP target_sp = exe_ctx.GetTargetSP();
+  if (target_sp && flavor == nullptr) {
+    if (arch.GetTriple().getArch() == llvm::Triple::x86 ||
+        arch.GetTriple().getArch() == llvm::Triple::x86_64)
+      flavor = target_sp->GetDisassemblyFlavor();
   }
+
+  StreamString config_strm;
+  config_strm.Printf("%s/%s/%s", arch.GetTriple().getTriple().c_str(),
+                     flavor ? flavor : "default",
+                     plugin_name ? plugin_name : "");
+  return ConstString(config_strm.GetString());
+}
+
+lldb::DisassemblerSP Disassembler::DisassembleRange(
+    const ArchSpec &arch, const char *plugin_name, const char *flavor,
+    const ExecutionContext &exe_ctx, const AddressRange &range,
+    bool prefer_file_cache, Stream *error_strm_ptr) {
+  if (range.GetByteSize() == 0 || !range.GetBaseAddress().IsValid())
+    return lldb::DisassemblerSP();
+
+  const ConstString config =
+      GetDisassemblyConfig(arch, plugin_name, flavor, exe_ctx);
+  ModuleSP module_sp = range.GetBaseAddress().GetModule();
+  if (module_sp) {
+    lldb::DisassemblerSP disasm_sp =
+        module_sp->GetDisassemblyCache().Find(config, range, exe_ctx,
+                                              prefer_file_cache);
+    if (disasm_sp)
+      return disasm_sp;
+  }
+
+  lldb::DisassemblerSP disasm_sp =
+      Disassembler::FindPlugin(arch, flavor, plugin_name);
+  if (!disasm_sp)
+    return disasm_sp;
+
+  size_t bytes_disassembled = disasm_sp->ParseInstructions(
+      &exe_ctx, range, error_strm_ptr, prefer_file_cache);
+  if (bytes_disassembled == 0)
+    return lldb::DisassemblerSP();
+
+  if (module_sp)
+    module_sp->GetDisassemblyCache().Add(config, range, exe_ctx,
+                                         disasm_sp->m_decoded_from_file,
+                                         disasm_sp);
   return disasm_sp;
 }
 
+lldb::BranchMapSP Disassembler::GetBranchMap(
+    const ArchSpec &arch, const char *plugin_name, const char *flavor,
+    const ExecutionContext &exe_ctx, const AddressRange &function_range) {
+  lldb::BranchMapSP branch_map_sp;
+  ModuleSP module_sp = function_range.GetBaseAddress().GetModule();
+  if (!module_sp || function_range.GetByteSize() == 0)
+    return branch_map_sp;
+
+  const ConstString config =
+      GetDisassemblyConfig(arch, plugin_name, flavor, exe_ctx);
+  DisassemblyCache &cache = module_sp->GetDisassemblyCache();
+  branch_map_sp = cache.FindBranchMap(config, function_range);
+  if (branch_map_sp)
+    return branch_map_sp;
+
+  // Don't go through DisassembleRange, the instructions of the function
+  // aren't needed once the map is built.
+  lldb::DisassemblerSP disasm_sp =
+      Disassembler::FindPlugin(arch, flavor, plugin_name);
+  if (!disasm_sp)
+    return branch_map_sp;
+
+  const bool prefer_file_cache = true;
+  if (disasm_sp->ParseInstructions(&exe_ctx, function_range, nullptr,
+                                   prefer_file_cache) == 0 ||
+      !disasm_sp->m_decoded_from_file)
+    return branch_map_sp;
+
+  branch_map_sp = std::make_shared<BranchMap>(
+      function_range.GetBaseAddress().GetFileAddress(),
+      disasm_sp->GetInstructionList());
+  cache.AddBranchMap(config, function_range, branch_map_sp);
+  return branch_map_sp;
+}
+
 lldb::DisassemblerSP
 Disassembler::DisassembleBytes(const ArchSpec &arch, const char *plugin_name,
                                const char *flavor, const Address &start,
@@ -238,24 +337,19 @@ bool Disassembler::Disassemble(Debugger &debugger, const ArchSpec &arch,
                                uint32_t num_mixed_context_lines,
                                uint32_t options, Stream &strm) {
   if (disasm_range.GetByteSize()) {
-    lldb::DisassemblerSP disasm_sp(Disassembler::FindPluginForTarget(
-        exe_ctx.GetTargetSP(), arch, flavor, plugin_name));
-
-    if (disasm_sp) {
-      AddressRange range;
-      ResolveAddress(exe_ctx, disasm_range.GetBaseAddress(),
-                     range.GetBaseAddress());
-      range.SetByteSize(disasm_range.GetByteSize());
-      const bool prefer_file_cache = false;
-      size_t bytes_disassembled = disasm_sp->ParseInstructions(
-          &exe_ctx, range, &strm, prefer_file_cache);
-      if (bytes_disassembled == 0)
-        return false;
+    AddressRange range;
+    ResolveAddress(exe_ctx, disasm_range.GetBaseAddress(),
+                   range.GetBaseAddress());
+    range.SetByteSize(disasm_range.GetByteSize());
+    const bool prefer_file_cache = false;
+    lldb::DisassemblerSP disasm_sp(DisassembleRange(
+        arch, plugin_name, flavor, exe_ctx, range, prefer_file_cache, &strm));
+    if (!disasm_sp)
+      return false;
 
-      return PrintInstructions(disasm_sp.get(), debugger, arch, exe_ctx,
-                               num_instructions, mixed_source_and_assembly,
-                               num_mixed_context_lines, options, strm);
-    }
+    return PrintInstructions(disasm_sp.get(), debugger, arch, exe_ctx,
+                             num_instructions, mixed_source_and_assembly,
+                             num_mixed_context_lines, options, strm);
   }
   return false;
 }
@@ -677,10 +771,51 @@ bool Disassembler::Disassemble(Debugger &debugger, const ArchSpec &arch,
 
 Instruction::Instruction(const Address &address, AddressClass addr_class)
     : m_address(address), m_address_class(addr_class), m_opcode(),
-      m_calculated_strings(false) {}
+      m_strings_mutex(), m_calculated_strings(false),
+      m_strings_target(nullptr), m_strings_process_id(0),
+      m_strings_stop_id(0) {}
 
 Instruction::~Instruction() = default;
 
+std::string Instruction::GetMnemonic(const ExecutionContext *exe_ctx) {
+  return GetString(exe_ctx, m_opcode_name);
+}
+
+std::string Instruction::GetOperands(const ExecutionContext *exe_ctx) {
+  return GetString(exe_ctx, m_mnemonics);
+}
+
+std::string Instruction::GetComment(const ExecutionContext *exe_ctx) {
+  return GetString(exe_ctx, m_comment);
+}
+
+std::string Instruction::GetString(const ExecutionContext *exe_ctx,
+                                   const std::string &str) {
+  std::lock_guard<std::mutex> guard(m_strings_mutex);
+  CalculateMnemonicOperandsAndCommentIfNeeded(exe_ctx);
+  return str;
+}
+
+void Instruction::CalculateMnemonicOperandsAndCommentIfNeeded(
+    const ExecutionContext *exe_ctx) {
+  const Target *target = exe_ctx ? exe_ctx->GetTargetPtr() : nullptr;
+  const Process *process = exe_ctx ? exe_ctx->GetProcessPtr() : nullptr;
+  const uint32_t process_id = process ? process->GetUniqueID() : 0;
+  const uint32_t stop_id = process ? process->GetStopID() : 0;
+  if (m_calculated_strings && target == m_strings_target &&
+      process_id == m_strings_process_id && stop_id == m_strings_stop_id)
+    return;
+
+  m_calculated_strings = true;
+  m_strings_target = target;
+  m_strings_process_id = process_id;
+  m_strings_stop_id = stop_id;
+  m_opcode_name.clear();
+  m_mnemonics.clear();
+  m_comment.clear();
+  CalculateMnemonicOperandsAndComment(exe_ctx);
+}
+
 AddressClass Instruction::GetAddressClass() {
   if (m_address_class == eAddressClassInvalid)
     m_address_class = m_address.GetAddressClass();
@@ -697,6 +832,7 @@ void Instruction::Dump(lldb_private::Stream *s, uint32_t max_opcode_byte_size,
   size_t opcode_column_width = 7;
   const size_t operand_column_width = 25;
 
+  std::lock_guard<std::mutex> guard(m_strings_mutex);
   CalculateMnemonicOperandsAndCommentIfNeeded(exe_ctx);
 
   StreamString ss;
@@ -1187,6 +1323,11 @@ size_t Disassembler::ParseInstructions(const ExecutionContext *exe_ctx,
       DataExtractor data(data_sp, m_arch.GetByteOrder(),
                          m_arch.GetAddressByteSize());
       const bool data_from_file = load_addr == LLDB_INVALID_ADDRESS;
+      m_decoded_from_file = data_from_file;
+      m_chunk_disassemblers.clear();
+      if (bytes_read >= g_min_parallel_decode_size)
+        return DecodeInstructionsInParallel(range.GetBaseAddress(), data,
+                                            data_from_file);
       return DecodeInstructions(range.GetBaseAddress(), data, 0, UINT32_MAX,
                                 false, data_from_file);
     } else if (error_strm_ptr) {
@@ -1240,12 +1381,128 @@ size_t Disassembler::ParseInstructions(const ExecutionContext *exe_ctx,
   return m_instruction_list.GetSize();
 }
 
+size_t Disassembler::DecodeInstructionsInParallel(const Address &base_addr,
+                                                  const DataExtractor &data,
+                                                  bool data_from_file) {
+  const offset_t data_size = data.GetByteSize();
+  const size_t max_chunks =
+      std::min<size_t>(std::max(1u, std::thread::hardware_concurrency()),
+                       data_size / g_min_parallel_chunk_size);
+
+  // Only split where a function starts, so every piece begins on an
+  // instruction boundary.
+  std::vector<offset_t> chunk_starts(1, 0);
+  ModuleSP module_sp = base_addr.GetModule();
+  ObjectFile *objfile = module_sp ? module_sp->GetObjectFile() : nullptr;
+  Symtab *symtab = objfile ? objfile->GetSymtab() : nullptr;
+  if (symtab && max_chunks > 1) {
+    const addr_t base_file_addr = base_addr.GetFileAddress();
+    std::vector<offset_t> symbol_offsets;
+    {
+      std::lock_guard<std::recursive_mutex> guard(symtab->GetMutex());
+      std::vector<uint32_t> indexes;
+      symtab->AppendSymbolIndexesWithType(eSymbolTypeCode, indexes);
+      for (uint32_t idx : indexes) {
+        const Symbol *symbol = symtab->SymbolAtIndex(idx);
+        if (!symbol || !symbol->ValueIsAddress())
+          continue;
+        const addr_t file_addr = symbol->GetAddressRef().GetFileAddress();
+        if (file_addr > base_file_addr &&
+            file_addr < base_file_addr + data_size)
+          symbol_offsets.push_back(file_addr - base_file_addr);
+      }
+    }
+    std::sort(symbol_offsets.begin(), symbol_offsets.end());
+
+    const offset_t target_chunk_size = data_size / max_chunks;
+    for (offset_t offset : symbol_offsets) {
+      if (chunk_starts.size() == max_chunks)
+        break;
+      if (offset - chunk_starts.back() >= target_chunk_size &&
+          data_size - offset >= g_min_parallel_chunk_size)
+        chunk_starts.push_back(offset);
+    }
+  }
+
+  return DecodeInstructionsInChunks(base_addr, data, std::move(chunk_starts),
+                                    data_from_file);
+}
+
+size_t Disassembler::DecodeInstructionsInChunks(
+    const Address &base_addr, const DataExtractor &data,
+    std::vector<offset_t> chunk_starts, bool data_from_file) {
+  const offset_t data_size = data.GetByteSize();
+  m_chunk_disassemblers.clear();
+
+  // The helper disassemblers are created here rather than in the tasks
+  // because finding a plug-in isn't thread safe.
+  const size_t num_chunks = chunk_starts.size();
+  std::vector<DisassemblerSP> helpers;
+  for (size_t i = 1; i < num_chunks; ++i) {
+    DisassemblerSP helper_sp =
+        FindPlugin(m_arch, m_flavor.c_str(), GetPluginName().GetCString());
+    if (!helper_sp)
+      break;
+    helpers.push_back(helper_sp);
+  }
+  if (num_chunks < 2 || helpers.size() + 1 != num_chunks)
+    return DecodeInstructions(base_addr, data, 0, UINT32_MAX, false,
+                              data_from_file);
+
+  chunk_starts.push_back(data_size);
+  std::vector<size_t> chunk_bytes(num_chunks, 0);
+  std::vector<std::future<void>> futures;
+  for (size_t i = 1; i < num_chunks; ++i) {
+    futures.push_back(TaskPool::AddTask([&, i]() {
+      Address chunk_addr(base_addr);
+      chunk_addr.Slide(chunk_starts[i]);
+      DataExtractor chunk_data(data, 0, chunk_starts[i + 1]);
+      chunk_bytes[i] = helpers[i - 1]->DecodeInstructions(
+          chunk_addr, chunk_data, chunk_starts[i], UINT32_MAX, false,
+          data_from_file);
+    }));
+  }
+  DataExtractor first_data(data, 0, chunk_starts[1]);
+  chunk_bytes[0] = DecodeInstructions(base_addr, first_data, 0, UINT32_MAX,
+                                      false, data_from_file);
+  for (auto &future : futures)
+    future.wait();
+
+  // Stitch the pieces together in order, the same way decoding the whole
+  // range in one go would have.
+  offset_t end = chunk_bytes[0];
+  size_t i = 1;
+  for (; i < num_chunks && end == chunk_starts[i]; ++i) {
+    DisassemblerSP &helper_sp = helpers[i - 1];
+    InstructionList &chunk_list = helper_sp->GetInstructionList();
+    const size_t num_instructions = chunk_list.GetSize();
+    for (size_t idx = 0; idx < num_instructions; ++idx) {
+      InstructionSP inst_sp = chunk_list.GetInstructionAtIndex(idx);
+      m_instruction_list.Append(inst_sp);
+    }
+    // The instructions refer back to the disassembler that decoded them.
+    m_chunk_disassemblers.push_back(helper_sp);
+    end = chunk_starts[i] + chunk_bytes[i];
+  }
+
+  // A piece stopped before the next one starts. It may have stopped only
+  // because an instruction crosses into the next piece, so carry on from
+  // there without the later pieces.
+  if (i < num_chunks) {
+    Address rest_addr(base_addr);
+    rest_addr.Slide(end);
+    end += DecodeInstructions(rest_addr, data, end, UINT32_MAX, true,
+                              data_from_file);
+  }
+  return end;
+}
+
 //----------------------------------------------------------------------
 // Disassembler copy constructor
 //----------------------------------------------------------------------
 Disassembler::Disassembler(const ArchSpec &arch, const char *flavor)
     : m_arch(arch), m_instruction_list(), m_base_addr(LLDB_INVALID_ADDRESS),
-      m_flavor() {
+      m_flavor(), m_decoded_from_file(false) {
   if (flavor == nullptr)
     m_flavor.assign("default");
   else
@@ -1275,6 +1532,172 @@ const InstructionList &Disassembler::GetInstructionList() const {
   return m_instruction_list;
 }
 
+//----------------------------------------------------------------------
+// DisassemblyCache
+//----------------------------------------------------------------------
+DisassemblyCache::DisassemblyCache()
+    : m_mutex(), m_entries(), m_use_count(0), m_num_instructions(0) {}
+
+DisassemblyCache::~DisassemblyCache() = default;
+
+lldb::DisassemblerSP DisassemblyCache::Find(const ConstString &config,
+                                            const AddressRange &range,
+                                            const ExecutionContext &exe_ctx,
+                                            bool prefer_file_cache) {
+  Key key = {range.GetBaseAddress().GetFileAddress(), range.GetByteSize(),
+             config.GetCString()};
+  Process *process = exe_ctx.GetProcessPtr();
+  const bool process_is_live = process && process->IsAlive();
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto pos = m_entries.find(key);
+  if (pos == m_entries.end())
+    return lldb::DisassemblerSP();
+
+  Entry &entry = pos->second;
+  bool valid;
+  if (entry.from_file) {
+    // The caller wants to see what is in memory right now, which may differ
+    // from the file if the process rewrites its own code.
+    valid = prefer_file_cache || !process_is_live;
+  } else {
+    valid = process_is_live && entry.process_id == process->GetUniqueID() &&
+            entry.stop_id == process->GetStopID() &&
+            entry.memory_id == process->GetModIDRef().GetMemoryID();
+  }
+  if (!valid) {
+    m_num_instructions -= entry.num_instructions;
+    m_entries.erase(pos);
+    return lldb::DisassemblerSP();
+  }
+  entry.last_used = ++m_use_count;
+  return entry.disasm_sp;
+}
+
+void DisassemblyCache::Add(const ConstString &config,
+                           const AddressRange &range,
+                           const ExecutionContext &exe_ctx, bool from_file,
+                           const lldb::DisassemblerSP &disasm_sp) {
+  const size_t num_instructions = disasm_sp->GetInstructionList().GetSize();
+  if (num_instructions > g_max_cached_instructions)
+    return;
+
+  Entry entry = {disasm_sp, num_instructions, from_file, 0, 0, 0, 0};
+  if (!from_file) {
+    Process *process = exe_ctx.GetProcessPtr();
+    if (!process)
+      return;
+    entry.process_id = process->GetUniqueID();
+    entry.stop_id = process->GetStopID();
+    entry.memory_id = process->GetModIDRef().GetMemoryID();
+  }
+  Key key = {range.GetBaseAddress().GetFileAddress(), range.GetByteSize(),
+             config.GetCString()};
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  entry.last_used = ++m_use_count;
+  Entry &cached = m_entries[key];
+  m_num_instructions -= cached.num_instructions;
+  cached = entry;
+  m_num_instructions += entry.num_instructions;
+
+  // Evict the least recently used ranges until both limits are met.
+  while (m_entries.size() > g_max_cached_disassemblies ||
+         m_num_instructions > g_max_cached_instructions) {
+    auto oldest = std::min_element(
+        m_entries.begin(), m_entries.end(),
+        [](const std::pair<const Key, Entry> &lhs,
+           const std::pair<const Key, Entry> &rhs) {
+          return lhs.second.last_used < rhs.second.last_used;
+        });
+    m_num_instructions -= oldest->second.num_instructions;
+    m_entries.erase(oldest);
+  }
+}
+
+lldb::BranchMapSP DisassemblyCache::FindBranchMap(const ConstString &config,
+                                                 const AddressRange &range) {
+  Key key = {range.GetBaseAddress().GetFileAddress(), range.GetByteSize(),
+             config.GetCString()};
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto pos = m_branch_maps.find(key);
+  if (pos == m_branch_maps.end())
+    return lldb::BranchMapSP();
+  return pos->second;
+}
+
+void DisassemblyCache::AddBranchMap(const ConstString &config,
+                                    const AddressRange &range,
+                                    const lldb::BranchMapSP &branch_map_sp) {
+  Key key = {range.GetBaseAddress().GetFileAddress(), range.GetByteSize(),
+             config.GetCString()};
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_branch_maps[key] = branch_map_sp;
+}
+
+void DisassemblyCache::Clear() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_entries.clear();
+  m_num_instructions = 0;
+  m_branch_maps.clear();
+}
+
+//----------------------------------------------------------------------
+// BranchMap
+//----------------------------------------------------------------------
+BranchMap::BranchMap(lldb::addr_t file_addr,
+                     const InstructionList &instructions)
+    : m_file_addr(file_addr), m_insn_offsets(), m_branch_indexes() {
+  const size_t num_instructions = instructions.GetSize();
+  m_insn_offsets.reserve(num_instructions + 1);
+  uint32_t end_offset = 0;
+  for (size_t i = 0; i < num_instructions; ++i) {
+    InstructionSP inst_sp = instructions.GetInstructionAtIndex(i);
+    const uint32_t offset =
+        inst_sp->GetAddress().GetFileAddress() - m_file_addr;
+    m_insn_offsets.push_back(offset);
+    if (inst_sp->DoesBranch())
+      m_branch_indexes.push_back(i);
+    end_offset = offset + inst_sp->GetOpcode().GetByteSize();
+  }
+  m_insn_offsets.push_back(end_offset);
+}
+
+BranchMap::~BranchMap() = default;
+
+uint32_t BranchMap::GetIndexOfInstructionAt(lldb::addr_t file_addr) const {
+  if (file_addr < m_file_addr ||
+      file_addr >= m_file_addr + m_insn_offsets.back())
+    return UINT32_MAX;
+  const uint32_t offset = file_addr - m_file_addr;
+  auto end = m_insn_offsets.end() - 1;
+  auto pos = std::lower_bound(m_insn_offsets.begin(), end, offset);
+  if (pos == end || *pos != offset)
+    return UINT32_MAX;
+  return pos - m_insn_offsets.begin();
+}
+
+uint32_t
+BranchMap::GetIndexOfLastInstructionBefore(lldb::addr_t file_addr) const {
+  if (file_addr <= m_file_addr ||
+      file_addr > m_file_addr + m_insn_offsets.back())
+    return UINT32_MAX;
+  const uint32_t offset = file_addr - m_file_addr;
+  auto end = m_insn_offsets.end() - 1;
+  auto pos = std::lower_bound(m_insn_offsets.begin(), end, offset);
+  return (pos - m_insn_offsets.begin()) - 1;
+}
+
+uint32_t BranchMap::GetIndexOfNextBranch(uint32_t start) const {
+  auto pos =
+      std::lower_bound(m_branch_indexes.begin(), m_branch_indexes.end(), start);
+  if (pos == m_branch_indexes.end())
+    return UINT32_MAX;
+  return *pos;
+}
+
 //----------------------------------------------------------------------
 // Class PseudoInstruction
 //----------------------------------------------------------------------
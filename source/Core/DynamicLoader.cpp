@@ -14,11 +14,14 @@
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
+#include "lldb/Host/Symbols.h"
 #include "lldb/Symbol/ObjectFile.h" // for ObjectFile
 #include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Target/Platform.h"
 #include "lldb/Target/Process.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/ConstString.h"     // for ConstString
+#include "lldb/Utility/TaskPool.h"
 #include "lldb/lldb-private-interfaces.h" // for DynamicLoaderCreateInstance
 
 #include "llvm/ADT/StringRef.h" // for StringRef
@@ -221,6 +224,71 @@ ModuleSP DynamicLoader::LoadModuleAtAddress(const FileSpec &file,
   return module_sp;
 }
 
+// Finds the separate debug file of "module_sp" the way the symbol vendor
+// would and records it, so that creating the symbol vendor later doesn't
+// have to search for it again.
+static void LocateSeparateDebugFile(const ModuleSP &module_sp) {
+  ObjectFile *obj_file = module_sp->GetObjectFile();
+  UUID uuid;
+  if (!obj_file || !obj_file->GetUUID(&uuid))
+    return;
+
+  FileSpecList file_spec_list = obj_file->GetDebugSymbolFilePaths();
+  for (size_t idx = 0; idx < file_spec_list.GetSize(); ++idx) {
+    ModuleSpec module_spec;
+    module_spec.GetFileSpec() = obj_file->GetFileSpec();
+    module_spec.GetFileSpec().ResolvePath();
+    module_spec.GetSymbolFileSpec() = file_spec_list.GetFileSpecAtIndex(idx);
+    module_spec.GetUUID() = uuid;
+    FileSpec symbol_fspec = Symbols::LocateExecutableSymbolFile(module_spec);
+    if (symbol_fspec) {
+      std::lock_guard<std::recursive_mutex> guard(module_sp->GetMutex());
+      if (!module_sp->GetSymbolFileFileSpec())
+        module_sp->SetSymbolFileFileSpec(symbol_fspec);
+      return;
+    }
+  }
+}
+
+void DynamicLoader::PreloadModules(const std::vector<FileSpec> &files) {
+  Target &target = m_process->GetTarget();
+  // Only host paths can be opened directly, other platforms may have to
+  // download the files first.
+  PlatformSP platform_sp = target.GetPlatform();
+  if (!platform_sp || !platform_sp->IsHost() || files.size() < 2)
+    return;
+
+  std::vector<ModuleSpec> module_specs;
+  ModuleList &modules = target.GetImages();
+  for (const FileSpec &file : files) {
+    ModuleSpec module_spec(file, target.GetArchitecture());
+    if (modules.FindFirstModule(module_spec))
+      continue;
+    // Create the module where Target::GetSharedModule() will look for it.
+    PathMappingList &search_paths = target.GetImageSearchPathList();
+    if (search_paths.GetSize())
+      search_paths.RemapPath(file.GetDirectory(),
+                             module_spec.GetFileSpec().GetDirectory());
+    module_specs.push_back(module_spec);
+  }
+
+  TaskRunner<void> task_runner;
+  for (const ModuleSpec &module_spec : module_specs) {
+    task_runner.AddTask([&target, &module_spec]() {
+      ModuleSP module_sp;
+      bool did_create = false;
+      ModuleList::GetSharedModule(module_spec, module_sp,
+                                  &target.GetExecutableSearchPaths(), nullptr,
+                                  &did_create);
+      if (!module_sp || !did_create)
+        return;
+      module_sp->GetSectionList();
+      LocateSeparateDebugFile(module_sp);
+    });
+  }
+  task_runner.WaitForAllTasks();
+}
+
 int64_t DynamicLoader::ReadUnsignedIntWithSizeInBytes(addr_t addr,
                                                       int size_in_bytes) {
   Error error;
@@ -4228,25 +4228,19 @@ public:
           if (highlight_attr)
             window.AttributeOn(highlight_attr);
 
-          const char *mnemonic = inst->GetMnemonic(&exe_ctx);
-          const char *operands = inst->GetOperands(&exe_ctx);
-          const char *comment = inst->GetComment(&exe_ctx);
-
-          if (mnemonic != nullptr && mnemonic[0] == '\0')
-            mnemonic = nullptr;
-          if (operands != nullptr && operands[0] == '\0')
-            operands = nullptr;
-          if (comment != nullptr && comment[0] == '\0')
-            comment = nullptr;
+          const std::string mnemonic = inst->GetMnemonic(&exe_ctx);
+          const std::string operands = inst->GetOperands(&exe_ctx);
+          const std::string comment = inst->GetComment(&exe_ctx);
 
           strm.Clear();
 
-          if (mnemonic != nullptr && operands != nullptr && comment != nullptr)
-            strm.Printf("%-8s %-25s ; %s", mnemonic, operands, comment);
-          else if (mnemonic != nullptr && operands != nullptr)
-            strm.Printf("%-8s %s", mnemonic, operands);
-          else if (mnemonic != nullptr)
-            strm.Printf("%s", mnemonic);
+          if (!mnemonic.empty() && !operands.empty() && !comment.empty())
+            strm.Printf("%-8s %-25s ; %s", mnemonic.c_str(), operands.c_str(),
+                        comment.c_str());
+          else if (!mnemonic.empty() && !operands.empty())
+            strm.Printf("%-8s %s", mnemonic.c_str(), operands.c_str());
+          else if (!mnemonic.empty())
+            strm.Printf("%s", mnemonic.c_str());
 
           int right_pad = 1;
           window.PutCStringTruncated(strm.GetData(), right_pad);
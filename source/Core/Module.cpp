@@ -12,6 +12,7 @@
 #include "lldb/Core/AddressRange.h" // for AddressRange
 #include "lldb/Core/AddressResolverFileLine.h"
 #include "lldb/Core/Debugger.h"     // for Debugger
+#include "lldb/Core/Disassembler.h"
 #include "lldb/Core/FileSpecList.h" // for FileSpecList
 #include "lldb/Core/Mangled.h"      // for Mangled
 #include "lldb/Core/ModuleSpec.h"
@@ -1153,6 +1154,13 @@ void Module::ReportError(const char *format, ...) {
   }
 }
 
+DisassemblyCache &Module::GetDisassemblyCache() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  if (!m_disassembly_cache_ap)
+    m_disassembly_cache_ap.reset(new DisassemblyCache());
+  return *m_disassembly_cache_ap;
+}
+
 bool Module::FileHasChanged() const {
   if (!m_file_has_changed)
     m_file_has_changed =
@@ -1320,6 +1328,14 @@ SectionList *Module::GetSectionList() {
   return m_sections_ap.get();
 }
 
+ObjectFile *Module::GetObjectFileIfLoaded() const {
+  return m_did_load_objfile.load() ? m_objfile_sp.get() : nullptr;
+}
+
+SectionList *Module::GetSectionListIfLoaded() const {
+  return m_sections_ap.get();
+}
+
 void Module::SectionFileAddressesChanged() {
   ObjectFile *obj_file = GetObjectFile();
   if (obj_file)
@@ -15,12 +15,16 @@
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Host/FileSystem.h"
 #include "lldb/Host/Symbols.h"
+#include "lldb/Symbol/Block.h"
+#include "lldb/Symbol/Function.h"
 #include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/Symbol.h"
 #include "lldb/Symbol/SymbolContext.h" // for SymbolContextList, SymbolCon...
 #include "lldb/Symbol/VariableList.h"
 #include "lldb/Utility/ConstString.h" // for ConstString
 #include "lldb/Utility/Log.h"
 #include "lldb/Utility/Logging.h" // for GetLogIfAnyCategoriesSet
+#include "lldb/Utility/TaskPool.h"
 #include "lldb/Utility/UUID.h"    // for UUID, operator!=, operator==
 #include "lldb/lldb-defines.h"    // for LLDB_INVALID_INDEX32
 
@@ -33,11 +37,14 @@
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h" // for fs
 
+#include <algorithm>
 #include <chrono> // for operator!=, time_point
+#include <map>
 #include <memory> // for shared_ptr
 #include <mutex>
 #include <string>  // for string
 #include <utility> // for distance
+#include <vector>
 
 namespace lldb_private {
 class Function;
@@ -639,6 +646,156 @@ uint32_t ModuleList::ResolveSymbolContextForAddress(const Address &so_addr,
   return resolved_flags;
 }
 
+// Returns true if every item of "sc" that was resolved is known to be the
+// same for "file_addr", so that "sc" can be reused for it without another
+// lookup.
+static bool SymbolContextCoversFileAddress(const SymbolContext &sc,
+                                           uint32_t resolve_scope,
+                                           addr_t file_addr) {
+  // Variables are looked up by the address they live at, and nothing in
+  // "sc" says how far that variable extends.
+  if (resolve_scope & eSymbolContextVariable)
+    return false;
+
+  if (resolve_scope & eSymbolContextCompUnit) {
+    // Compile units don't know their address ranges, but a line entry from
+    // their line table or one of their functions that covers "file_addr"
+    // shows that "file_addr" is in the same compile unit.
+    if (sc.comp_unit == nullptr)
+      return false;
+    const bool line_entry_covers =
+        sc.line_entry.IsValid() &&
+        sc.line_entry.range.ContainsFileAddress(file_addr);
+    const bool function_covers =
+        sc.function && sc.function->GetCompileUnit() == sc.comp_unit &&
+        sc.function->GetAddressRange().ContainsFileAddress(file_addr);
+    if (!line_entry_covers && !function_covers)
+      return false;
+  }
+
+  if (resolve_scope & eSymbolContextLineEntry) {
+    if (!sc.line_entry.IsValid() ||
+        !sc.line_entry.range.ContainsFileAddress(file_addr))
+      return false;
+  }
+
+  if (resolve_scope & (eSymbolContextFunction | eSymbolContextBlock)) {
+    if (sc.function == nullptr ||
+        !sc.function->GetAddressRange().ContainsFileAddress(file_addr))
+      return false;
+  }
+
+  if (resolve_scope & eSymbolContextBlock) {
+    // The block is the deepest one containing the previous address. It is
+    // the deepest one for "file_addr" too if "file_addr" is in one of its
+    // ranges but in none of its children.
+    if (sc.block == nullptr)
+      return false;
+    const addr_t func_offset =
+        file_addr -
+        sc.function->GetAddressRange().GetBaseAddress().GetFileAddress();
+    if (!sc.block->Contains(func_offset))
+      return false;
+    for (Block *child = sc.block->GetFirstChild(); child;
+         child = child->GetSibling()) {
+      if (child->Contains(func_offset))
+        return false;
+    }
+  }
+
+  if (resolve_scope & eSymbolContextSymbol) {
+    if (sc.symbol == nullptr || !sc.symbol->ContainsFileAddress(file_addr))
+      return false;
+  }
+
+  return true;
+}
+
+size_t ModuleList::ResolveSymbolContextsForModuleOffsets(
+    const std::vector<ModuleOffset> &requests, uint32_t resolve_scope,
+    std::vector<SymbolContext> &sc_list) const {
+  sc_list.clear();
+  sc_list.resize(requests.size());
+
+  // Group the requests by module.
+  struct Group {
+    ModuleSP module_sp;
+    // (file address, request index) pairs.
+    std::vector<std::pair<addr_t, size_t>> addrs;
+  };
+  std::vector<Group> groups;
+  std::map<UUID, size_t> group_indexes;
+  for (size_t i = 0; i < requests.size(); ++i) {
+    const ModuleOffset &request = requests[i];
+    auto pos = group_indexes.find(request.uuid);
+    if (pos == group_indexes.end()) {
+      Group group;
+      group.module_sp = FindModule(request.uuid);
+      pos = group_indexes.emplace(request.uuid, groups.size()).first;
+      groups.push_back(std::move(group));
+    }
+    Group &group = groups[pos->second];
+    if (!group.module_sp)
+      continue;
+
+    // ELF files have no header address, their file addresses already are
+    // offsets from the start of the image.
+    addr_t file_addr = request.offset;
+    if (ObjectFile *obj_file = group.module_sp->GetObjectFile()) {
+      Address header_addr = obj_file->GetHeaderAddress();
+      if (header_addr.IsValid())
+        file_addr += header_addr.GetFileAddress();
+    }
+    group.addrs.emplace_back(file_addr, i);
+  }
+
+  // Resolve each module's addresses in ascending order so that neighbouring
+  // addresses can share the compile unit, line table and block lookups.
+  // Modules are independent, so they are resolved in parallel.
+  std::vector<size_t> num_resolved(groups.size(), 0);
+  TaskRunner<void> task_runner;
+  for (size_t g = 0; g < groups.size(); ++g) {
+    if (!groups[g].module_sp || groups[g].addrs.empty())
+      continue;
+    task_runner.AddTask([&groups, &sc_list, &num_resolved, g,
+                         resolve_scope]() {
+      Group &group = groups[g];
+      std::sort(group.addrs.begin(), group.addrs.end());
+      const SymbolContext *prev_sc = nullptr;
+      addr_t prev_file_addr = LLDB_INVALID_ADDRESS;
+      for (const auto &addr_and_index : group.addrs) {
+        const addr_t file_addr = addr_and_index.first;
+        SymbolContext &sc = sc_list[addr_and_index.second];
+        if (prev_sc &&
+            (file_addr == prev_file_addr ||
+             SymbolContextCoversFileAddress(*prev_sc, resolve_scope,
+                                            file_addr))) {
+          sc = *prev_sc;
+          ++num_resolved[g];
+          continue;
+        }
+
+        Address so_addr;
+        if (!group.module_sp->ResolveFileAddress(file_addr, so_addr)) {
+          prev_sc = nullptr;
+          continue;
+        }
+        group.module_sp->ResolveSymbolContextForAddress(so_addr, resolve_scope,
+                                                        sc);
+        ++num_resolved[g];
+        prev_sc = &sc;
+        prev_file_addr = file_addr;
+      }
+    });
+  }
+  task_runner.WaitForAllTasks();
+
+  size_t total = 0;
+  for (size_t n : num_resolved)
+    total += n;
+  return total;
+}
+
 uint32_t ModuleList::ResolveSymbolContextForFilePath(
     const char *file_path, uint32_t line, bool check_inlines,
     uint32_t resolve_scope, SymbolContextList &sc_list) const {
@@ -710,7 +867,7 @@ Error ModuleList::GetSharedModule(const ModuleSpec &module_spec,
                                   ModuleSP *old_module_sp_ptr,
                                   bool *did_create_ptr, bool always_create) {
   ModuleList &shared_module_list = GetSharedModuleList();
-  std::lock_guard<std::recursive_mutex> guard(
+  std::unique_lock<std::recursive_mutex> guard(
       shared_module_list.m_modules_mutex);
   char path[PATH_MAX];
 
@@ -763,21 +920,37 @@ Error ModuleList::GetSharedModule(const ModuleSpec &module_spec,
   if (module_sp)
     return error;
 
+  // Reading and parsing the object file is what takes the time when many
+  // modules are loaded at once, so let other threads create their modules
+  // in the meantime.
+  guard.unlock();
   module_sp.reset(new Module(module_spec));
+  ObjectFile *objfile = module_sp->GetObjectFile();
+  guard.lock();
+
   // Make sure there are a module and an object file since we can specify
   // a valid file path with an architecture that might not be in that file.
   // By getting the object file we can guarantee that the architecture matches
-  if (module_sp->GetObjectFile()) {
+  if (objfile) {
     // If we get in here we got the correct arch, now we just need
     // to verify the UUID if one was given
     if (uuid_ptr && *uuid_ptr != module_sp->GetUUID()) {
       module_sp.reset();
     } else {
-      if (module_sp->GetObjectFile() &&
-          module_sp->GetObjectFile()->GetType() ==
-              ObjectFile::eTypeStubLibrary) {
+      if (objfile->GetType() == ObjectFile::eTypeStubLibrary) {
         module_sp.reset();
       } else {
+        // Another thread may have created the same module while the lock
+        // wasn't held.
+        if (!always_create) {
+          ModuleList matching_module_list;
+          if (shared_module_list.FindModules(module_spec,
+                                             matching_module_list) > 0) {
+            module_sp = matching_module_list.GetModuleAtIndex(0);
+            return error;
+          }
+        }
+
         if (did_create_ptr) {
           *did_create_ptr = true;
         }
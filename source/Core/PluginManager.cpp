@@ -1067,18 +1067,27 @@ PluginManager::GetObjectFileCreateMemoryCallbackForPluginName(
 }
 
 Error PluginManager::SaveCore(const lldb::ProcessSP &process_sp,
-                              const FileSpec &outfile) {
+                              const FileSpec &outfile,
+                              lldb::SaveCoreStyle style,
+                              const ConstString &plugin_name) {
   Error error;
   std::lock_guard<std::recursive_mutex> guard(GetObjectFileMutex());
   ObjectFileInstances &instances = GetObjectFileInstances();
 
   ObjectFileInstances::iterator pos, end = instances.end();
   for (pos = instances.begin(); pos != end; ++pos) {
-    if (pos->save_core && pos->save_core(process_sp, outfile, error))
+    if (plugin_name && plugin_name != pos->name)
+      continue;
+    if (pos->save_core && pos->save_core(process_sp, outfile, style, error))
       return error;
   }
-  error.SetErrorString(
-      "no ObjectFile plugins were able to save a core for this process");
+  if (plugin_name)
+    error.SetErrorStringWithFormat(
+        "the \"%s\" plugin is not able to save a core for this process",
+        plugin_name.GetCString());
+  else
+    error.SetErrorString(
+        "no ObjectFile plugins were able to save a core for this process");
   return error;
 }
 
@@ -31,6 +31,7 @@
 
 #include "llvm/ADT/Twine.h" // for Twine
 
+#include <cstring>
 #include <memory>
 #include <utility> // for pair
 
@@ -75,7 +76,8 @@ SourceManager::FileSP SourceManager::GetFile(const FileSpec &file_spec) {
   if (same_as_previous)
     file_sp = m_last_file_sp;
   else if (debugger_sp)
-    file_sp = debugger_sp->GetSourceFileCache().FindSourceFile(file_spec);
+    file_sp = debugger_sp->GetSourceFileCache().FindSourceFile(
+        file_spec, m_target_wp.lock().get());
 
   TargetSP target_sp(m_target_wp.lock());
 
@@ -359,7 +361,8 @@ SourceManager::File::File(const FileSpec &file_spec, Target *target)
     : m_file_spec_orig(file_spec), m_file_spec(file_spec),
       m_mod_time(FileSystem::GetModificationTime(file_spec)),
       m_debugger_wp(target ? target->GetDebugger().shared_from_this()
-                           : DebuggerSP()) {
+                           : DebuggerSP()),
+      m_target_wp(target ? target->shared_from_this() : TargetSP()) {
   CommonInitializer(file_spec, target);
 }
 
@@ -503,6 +506,8 @@ void SourceManager::File::UpdateIfNeeded() {
     m_mod_time = curr_mod_time;
     m_data_sp = DataBufferLLVM::CreateFromPath(m_file_spec.GetPath());
     m_offsets.clear();
+    m_scan_offset = 0;
+    m_offsets_complete = false;
   }
 }
 
@@ -627,57 +632,76 @@ bool lldb_private::operator==(const SourceManager::File &lhs,
   return lhs.m_mod_time == rhs.m_mod_time;
 }
 
+// Return the first '\n' or '\r' in [s, end), or end if there is none.  The
+// bulk of the buffer is checked eight bytes at a time.
+static const char *FindNewlineChar(const char *s, const char *end) {
+  const uint64_t ones = 0x0101010101010101ULL;
+  const uint64_t highs = 0x8080808080808080ULL;
+  const uint64_t lf = ones * '\n';
+  const uint64_t cr = ones * '\r';
+
+  while (s < end && (reinterpret_cast<uintptr_t>(s) & 7) != 0) {
+    if (is_newline_char(*s))
+      return s;
+    ++s;
+  }
+  while (end - s >= 8) {
+    uint64_t word;
+    memcpy(&word, s, sizeof(word));
+    // A byte of x is zero exactly when its high bit is set in
+    // (x - ones) & ~x & highs.
+    const uint64_t x = word ^ lf;
+    const uint64_t y = word ^ cr;
+    if (((x - ones) & ~x & highs) | ((y - ones) & ~y & highs))
+      break;
+    s += 8;
+  }
+  while (s < end && !is_newline_char(*s))
+    ++s;
+  return s;
+}
+
 bool SourceManager::File::CalculateLineOffsets(uint32_t line) {
-  line =
-      UINT32_MAX; // TODO: take this line out when we support partial indexing
-  if (line == UINT32_MAX) {
-    // Already done?
-    if (!m_offsets.empty() && m_offsets[0] == UINT32_MAX)
-      return true;
-
-    if (m_offsets.empty()) {
-      if (m_data_sp.get() == NULL)
-        return false;
-
-      const char *start = (char *)m_data_sp->GetBytes();
-      if (start) {
-        const char *end = start + m_data_sp->GetByteSize();
-
-        // Calculate all line offsets from scratch
-
-        // Push a 1 at index zero to indicate the file has been completely
-        // indexed.
-        m_offsets.push_back(UINT32_MAX);
-        const char *s;
-        for (s = start; s < end; ++s) {
-          char curr_ch = *s;
-          if (is_newline_char(curr_ch)) {
-            if (s + 1 < end) {
-              char next_ch = s[1];
-              if (is_newline_char(next_ch)) {
-                if (curr_ch != next_ch)
-                  ++s;
-              }
-            }
-            m_offsets.push_back(s + 1 - start);
-          }
-        }
-        if (!m_offsets.empty()) {
-          if (m_offsets.back() < size_t(end - start))
-            m_offsets.push_back(end - start);
-        }
-        return true;
+  if (m_offsets_complete)
+    return true;
+  if (m_data_sp.get() == NULL)
+    return false;
+
+  const char *start = (const char *)m_data_sp->GetBytes();
+  if (start == NULL)
+    return false;
+  const char *end = start + m_data_sp->GetByteSize();
+
+  // Index zero doesn't hold a line offset since line 1 always starts at zero.
+  if (m_offsets.empty())
+    m_offsets.push_back(UINT32_MAX);
+
+  // GetLineOffset() and LineIsValid() need the offset of the line after
+  // "line" too.
+  const size_t needed_size =
+      line == UINT32_MAX ? SIZE_MAX : static_cast<size_t>(line) + 1;
+  const char *s = start + m_scan_offset;
+  while (m_offsets.size() < needed_size) {
+    s = FindNewlineChar(s, end);
+    if (s == end) {
+      if (m_offsets.back() < size_t(end - start))
+        m_offsets.push_back(end - start);
+      m_offsets_complete = true;
+      break;
+    }
+    char curr_ch = *s;
+    if (s + 1 < end) {
+      char next_ch = s[1];
+      if (is_newline_char(next_ch)) {
+        if (curr_ch != next_ch)
+          ++s;
       }
-    } else {
-      // Some lines have been populated, start where we last left off
-      assert("Not implemented yet" && false);
     }
-
-  } else {
-    // Calculate all line offsets up to "line"
-    assert("Not implemented yet" && false);
+    ++s;
+    m_offsets.push_back(s - start);
   }
-  return false;
+  m_scan_offset = s - start;
+  return true;
 }
 
 bool SourceManager::File::GetLine(uint32_t line_no, std::string &buffer) {
@@ -696,21 +720,42 @@ bool SourceManager::File::GetLine(uint32_t line_no, std::string &buffer) {
 }
 
 void SourceManager::SourceFileCache::AddSourceFile(const FileSP &file_sp) {
-  FileSpec file_spec;
-  FileCache::iterator pos = m_file_cache.find(file_spec);
-  if (pos == m_file_cache.end())
-    m_file_cache[file_spec] = file_sp;
-  else {
-    if (file_sp != pos->second)
-      m_file_cache[file_spec] = file_sp;
+  // Key the file by the spec it was asked for, which is what later lookups
+  // will use, rather than by the path it was remapped or resolved to.
+  const FileKey key(file_sp->GetOriginalFileSpec(), file_sp->GetTarget().get());
+  std::lock_guard<std::mutex> guard(m_mutex);
+  FileCache::iterator pos = m_file_cache.find(key);
+  if (pos != m_file_cache.end()) {
+    m_files.erase(pos->second);
+    m_file_cache.erase(pos);
+  }
+  m_files.emplace_front(key, file_sp);
+  m_file_cache[key] = m_files.begin();
+
+  // Source managers hold on to the files they are showing, so evicting one
+  // here only drops the cache's reference to its contents.
+  while (m_files.size() > m_max_files) {
+    m_file_cache.erase(m_files.back().first);
+    m_files.pop_back();
   }
 }
 
 SourceManager::FileSP SourceManager::SourceFileCache::FindSourceFile(
-    const FileSpec &file_spec) const {
-  FileSP file_sp;
-  FileCache::const_iterator pos = m_file_cache.find(file_spec);
-  if (pos != m_file_cache.end())
-    file_sp = pos->second;
+    const FileSpec &file_spec, Target *target) const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  FileCache::const_iterator pos = m_file_cache.find(FileKey(file_spec, target));
+  if (pos == m_file_cache.end())
+    return FileSP();
+  const FileSP &file_sp = pos->second->second;
+  // A target that has gone away may have been replaced by a new one at the
+  // same address, which must not see the old target's remapped files.
+  if (target && file_sp->GetTarget().get() != target)
+    return FileSP();
+  m_files.splice(m_files.begin(), m_files, pos->second);
   return file_sp;
 }
+
+size_t SourceManager::SourceFileCache::GetSize() const {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  return m_files.size();
+}
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include <map>
 #include <mutex>
+#include <set>
 #include <utility> // for pair
 #include <vector>
 
@@ -27,8 +28,41 @@ using namespace lldb_private;
 #define TIMER_INDENT_AMOUNT 2
 
 namespace {
-typedef std::map<const char *, std::chrono::nanoseconds> TimerCategoryMap;
 typedef std::vector<Timer *> TimerStack;
+
+//----------------------------------------------------------------------
+// Category times are accumulated per thread: only the owning thread
+// adds categories to its table and adds time to them, so a timer never
+// takes a lock when it stops. Other threads only read the tables when
+// the times get dumped.
+//----------------------------------------------------------------------
+struct CategoryTime {
+  std::atomic<const char *> category{nullptr};
+  std::atomic<uint64_t> nanos{0};
+  std::atomic<uint64_t> count{0};
+};
+
+const size_t kCategoriesPerThread = 1024; // Must be a power of two
+
+struct ThreadTimers {
+  TimerStack stack;
+  CategoryTime categories[kCategoriesPerThread];
+};
+
+struct CategoryTotal {
+  uint64_t nanos = 0;
+  uint64_t count = 0;
+};
+
+typedef std::map<const char *, CategoryTotal> TimerCategoryMap;
+
+// All the per thread tables, and the times of threads that have exited or
+// that had more categories than fit in their table.
+struct TimerRegistry {
+  std::mutex mutex;
+  std::set<ThreadTimers *> threads;
+  TimerCategoryMap retired;
+};
 } // end of anonymous namespace
 
 std::atomic<bool> Timer::g_quiet(true);
@@ -38,40 +72,87 @@ static std::mutex &GetFileMutex() {
   return *g_file_mutex_ptr;
 }
 
-static std::mutex &GetCategoryMutex() {
-  static std::mutex g_category_mutex;
-  return g_category_mutex;
-}
-
-static TimerCategoryMap &GetCategoryMap() {
-  static TimerCategoryMap g_category_map;
-  return g_category_map;
+static TimerRegistry &GetTimerRegistry() {
+  // Leaked on purpose, threads may exit after static destructors ran.
+  static TimerRegistry *g_registry_ptr = new TimerRegistry();
+  return *g_registry_ptr;
 }
 
 static void ThreadSpecificCleanup(void *p) {
-  delete static_cast<TimerStack *>(p);
+  ThreadTimers *timers = static_cast<ThreadTimers *>(p);
+  TimerRegistry &registry = GetTimerRegistry();
+  {
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    for (const CategoryTime &entry : timers->categories) {
+      if (const char *category = entry.category.load()) {
+        CategoryTotal &total = registry.retired[category];
+        total.nanos += entry.nanos.load(std::memory_order_relaxed);
+        total.count += entry.count.load(std::memory_order_relaxed);
+      }
+    }
+    registry.threads.erase(timers);
+  }
+  delete timers;
 }
 
-static TimerStack *GetTimerStackForCurrentThread() {
+static ThreadTimers *GetTimersForCurrentThread() {
   static lldb::thread_key_t g_key =
       Host::ThreadLocalStorageCreate(ThreadSpecificCleanup);
 
-  void *timer_stack = Host::ThreadLocalStorageGet(g_key);
-  if (timer_stack == NULL) {
-    Host::ThreadLocalStorageSet(g_key, new TimerStack);
-    timer_stack = Host::ThreadLocalStorageGet(g_key);
+  void *timers = Host::ThreadLocalStorageGet(g_key);
+  if (timers == NULL) {
+    ThreadTimers *new_timers = new ThreadTimers;
+    {
+      TimerRegistry &registry = GetTimerRegistry();
+      std::lock_guard<std::mutex> guard(registry.mutex);
+      registry.threads.insert(new_timers);
+    }
+    Host::ThreadLocalStorageSet(g_key, new_timers);
+    timers = Host::ThreadLocalStorageGet(g_key);
   }
-  return (TimerStack *)timer_stack;
+  return (ThreadTimers *)timers;
+}
+
+static void AddCategoryTime(ThreadTimers &timers, const char *category,
+                            uint64_t nanos) {
+  const size_t mask = kCategoriesPerThread - 1;
+  size_t index = (reinterpret_cast<uintptr_t>(category) >> 3) & mask;
+  for (size_t probe = 0; probe < kCategoriesPerThread; ++probe) {
+    CategoryTime &entry = timers.categories[(index + probe) & mask];
+    const char *entry_category =
+        entry.category.load(std::memory_order_relaxed);
+    if (entry_category == nullptr) {
+      // Publish the times before the category so that readers never see a
+      // category with the times of another one.
+      entry.nanos.store(nanos, std::memory_order_relaxed);
+      entry.count.store(1, std::memory_order_relaxed);
+      entry.category.store(category, std::memory_order_release);
+      return;
+    }
+    if (entry_category == category) {
+      entry.nanos.fetch_add(nanos, std::memory_order_relaxed);
+      entry.count.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+  }
+
+  // The table is full, fall back to the shared map.
+  TimerRegistry &registry = GetTimerRegistry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  CategoryTotal &total = registry.retired[category];
+  total.nanos += nanos;
+  total.count += 1;
 }
 
 void Timer::SetQuiet(bool value) { g_quiet = value; }
 
 Timer::Timer(const char *category, const char *format, ...)
     : m_category(category), m_total_start(std::chrono::steady_clock::now()) {
-  TimerStack *stack = GetTimerStackForCurrentThread();
-  if (!stack)
+  ThreadTimers *timers = GetTimersForCurrentThread();
+  if (!timers)
     return;
 
+  TimerStack *stack = &timers->stack;
   stack->push_back(this);
   if (g_quiet && stack->size() <= g_display_depth) {
     std::lock_guard<std::mutex> lock(GetFileMutex());
@@ -92,10 +173,11 @@ Timer::Timer(const char *category, const char *format, ...)
 Timer::~Timer() {
   using namespace std::chrono;
 
-  TimerStack *stack = GetTimerStackForCurrentThread();
-  if (!stack)
+  ThreadTimers *timers = GetTimersForCurrentThread();
+  if (!timers)
     return;
 
+  TimerStack *stack = &timers->stack;
   auto stop_time = steady_clock::now();
   auto total_dur = stop_time - m_total_start;
   auto timer_dur = total_dur - m_child_duration;
@@ -114,45 +196,61 @@ Timer::~Timer() {
     stack->back()->ChildDuration(total_dur);
 
   // Keep total results for each category so we can dump results.
-  {
-    std::lock_guard<std::mutex> guard(GetCategoryMutex());
-    TimerCategoryMap &category_map = GetCategoryMap();
-    category_map[m_category] += timer_dur;
-  }
+  AddCategoryTime(*timers, m_category,
+                  duration_cast<nanoseconds>(timer_dur).count());
 }
 
 void Timer::SetDisplayDepth(uint32_t depth) { g_display_depth = depth; }
 
-/* binary function predicate:
- * - returns whether a person is less than another person
- */
-static bool
-CategoryMapIteratorSortCriterion(const TimerCategoryMap::const_iterator &lhs,
-                                 const TimerCategoryMap::const_iterator &rhs) {
-  return lhs->second > rhs->second;
-}
-
 void Timer::ResetCategoryTimes() {
-  std::lock_guard<std::mutex> guard(GetCategoryMutex());
-  TimerCategoryMap &category_map = GetCategoryMap();
-  category_map.clear();
+  TimerRegistry &registry = GetTimerRegistry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  registry.retired.clear();
+  // The owning threads may be adding to these concurrently, a time that is
+  // recorded while resetting may or may not be kept.
+  for (ThreadTimers *timers : registry.threads) {
+    for (CategoryTime &entry : timers->categories) {
+      entry.nanos.store(0, std::memory_order_relaxed);
+      entry.count.store(0, std::memory_order_relaxed);
+    }
+  }
 }
 
-void Timer::DumpCategoryTimes(Stream *s) {
-  std::lock_guard<std::mutex> guard(GetCategoryMutex());
-  TimerCategoryMap &category_map = GetCategoryMap();
-  std::vector<TimerCategoryMap::const_iterator> sorted_iterators;
-  TimerCategoryMap::const_iterator pos, end = category_map.end();
-  for (pos = category_map.begin(); pos != end; ++pos) {
-    sorted_iterators.push_back(pos);
+std::vector<Timer::CategoryStats> Timer::GetCategoryStats() {
+  TimerCategoryMap category_map;
+  {
+    TimerRegistry &registry = GetTimerRegistry();
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    category_map = registry.retired;
+    for (ThreadTimers *timers : registry.threads) {
+      for (const CategoryTime &entry : timers->categories) {
+        const char *category = entry.category.load(std::memory_order_acquire);
+        if (!category)
+          continue;
+        CategoryTotal &total = category_map[category];
+        total.nanos += entry.nanos.load(std::memory_order_relaxed);
+        total.count += entry.count.load(std::memory_order_relaxed);
+      }
+    }
   }
-  std::sort(sorted_iterators.begin(), sorted_iterators.end(),
-            CategoryMapIteratorSortCriterion);
-
-  const size_t count = sorted_iterators.size();
-  for (size_t i = 0; i < count; ++i) {
-    const auto timer = sorted_iterators[i]->second;
-    s->Printf("%.9f sec for %s\n", std::chrono::duration<double>(timer).count(),
-              sorted_iterators[i]->first);
+
+  std::vector<CategoryStats> stats;
+  for (const auto &pair : category_map) {
+    if (pair.second.count == 0)
+      continue;
+    stats.push_back({pair.first, std::chrono::nanoseconds(pair.second.nanos),
+                     pair.second.count});
   }
+  std::sort(stats.begin(), stats.end(),
+            [](const CategoryStats &lhs, const CategoryStats &rhs) {
+              return lhs.time > rhs.time;
+            });
+  return stats;
+}
+
+void Timer::DumpCategoryTimes(Stream *s) {
+  for (const CategoryStats &stats : GetCategoryStats())
+    s->Printf("%.9f sec for %s\n",
+              std::chrono::duration<double>(stats.time).count(),
+              stats.category);
 }
@@ -29,6 +29,18 @@ uint32_t DataVisualization::GetCurrentRevision() {
   return GetFormatManager().GetCurrentRevision();
 }
 
+void DataVisualization::DumpCacheStatistics(Stream &s) {
+  GetFormatManager().DumpCacheStatistics(s);
+}
+
+void DataVisualization::ResetCacheStatistics() {
+  GetFormatManager().ResetCacheStatistics();
+}
+
+void DataVisualization::GetCacheStatistics(uint64_t &hits, uint64_t &misses) {
+  GetFormatManager().GetCacheStatistics(hits, misses);
+}
+
 bool DataVisualization::ShouldPrintAsOneLiner(ValueObject &valobj) {
   return GetFormatManager().ShouldPrintAsOneLiner(valobj);
 }
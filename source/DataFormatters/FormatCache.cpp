@@ -106,36 +106,22 @@ void FormatCache::Entry::SetValidator(lldb::TypeValidatorImplSP validator_sp) {
 }
 
 FormatCache::FormatCache()
-    : m_map(), m_mutex()
-#ifdef LLDB_CONFIGURATION_DEBUG
-      ,
-      m_cache_hits(0), m_cache_misses(0)
-#endif
-{
-}
+    : m_map(), m_mutex(), m_cache_hits(0), m_cache_misses(0) {}
 
 FormatCache::Entry &FormatCache::GetEntry(const ConstString &type) {
-  auto i = m_map.find(type), e = m_map.end();
-  if (i != e)
-    return i->second;
-  m_map[type] = FormatCache::Entry();
   return m_map[type];
 }
 
 bool FormatCache::GetFormat(const ConstString &type,
                             lldb::TypeFormatImplSP &format_sp) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
+  auto &entry = GetEntry(type);
   if (entry.IsFormatCached()) {
-#ifdef LLDB_CONFIGURATION_DEBUG
     m_cache_hits++;
-#endif
     format_sp = entry.GetFormat();
     return true;
   }
-#ifdef LLDB_CONFIGURATION_DEBUG
   m_cache_misses++;
-#endif
   format_sp.reset();
   return false;
 }
@@ -143,17 +129,13 @@ bool FormatCache::GetFormat(const ConstString &type,
 bool FormatCache::GetSummary(const ConstString &type,
                              lldb::TypeSummaryImplSP &summary_sp) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
+  auto &entry = GetEntry(type);
   if (entry.IsSummaryCached()) {
-#ifdef LLDB_CONFIGURATION_DEBUG
     m_cache_hits++;
-#endif
     summary_sp = entry.GetSummary();
     return true;
   }
-#ifdef LLDB_CONFIGURATION_DEBUG
   m_cache_misses++;
-#endif
   summary_sp.reset();
   return false;
 }
@@ -161,17 +143,13 @@ bool FormatCache::GetSummary(const ConstString &type,
 bool FormatCache::GetSynthetic(const ConstString &type,
                                lldb::SyntheticChildrenSP &synthetic_sp) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
+  auto &entry = GetEntry(type);
   if (entry.IsSyntheticCached()) {
-#ifdef LLDB_CONFIGURATION_DEBUG
     m_cache_hits++;
-#endif
     synthetic_sp = entry.GetSynthetic();
     return true;
   }
-#ifdef LLDB_CONFIGURATION_DEBUG
   m_cache_misses++;
-#endif
   synthetic_sp.reset();
   return false;
 }
@@ -179,17 +157,13 @@ bool FormatCache::GetSynthetic(const ConstString &type,
 bool FormatCache::GetValidator(const ConstString &type,
                                lldb::TypeValidatorImplSP &validator_sp) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
-  auto entry = GetEntry(type);
+  auto &entry = GetEntry(type);
   if (entry.IsValidatorCached()) {
-#ifdef LLDB_CONFIGURATION_DEBUG
     m_cache_hits++;
-#endif
     validator_sp = entry.GetValidator();
     return true;
   }
-#ifdef LLDB_CONFIGURATION_DEBUG
   m_cache_misses++;
-#endif
   validator_sp.reset();
   return false;
 }
@@ -222,3 +196,14 @@ void FormatCache::Clear() {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
   m_map.clear();
 }
+
+size_t FormatCache::GetNumEntries() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  return m_map.size();
+}
+
+void FormatCache::ResetStatistics() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  m_cache_hits = 0;
+  m_cache_misses = 0;
+}
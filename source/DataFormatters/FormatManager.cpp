@@ -22,6 +22,7 @@
 #include "lldb/Target/ExecutionContext.h"
 #include "lldb/Target/Language.h"
 #include "lldb/Utility/Log.h"
+#include "lldb/Utility/Stream.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -122,6 +123,51 @@ void FormatManager::Changed() {
   }
 }
 
+static void DumpFormatCacheStatistics(Stream &s, const char *name,
+                                      FormatCache &cache) {
+  const uint64_t hits = cache.GetCacheHits();
+  const uint64_t misses = cache.GetCacheMisses();
+  const uint64_t lookups = hits + misses;
+  s.Printf("%-20s entries: %-8" PRIu64 " hits: %-10" PRIu64
+           " misses: %-10" PRIu64 " hit rate: %.1f%%\n",
+           name, static_cast<uint64_t>(cache.GetNumEntries()), hits, misses,
+           lookups ? (100.0 * hits) / lookups : 0.0);
+}
+
+void FormatManager::DumpCacheStatistics(Stream &s) {
+  s.Printf("Formatter registry revision: %" PRIu32 "\n",
+           GetCurrentRevision());
+  DumpFormatCacheStatistics(s, "(all)", m_format_cache);
+  std::lock_guard<std::recursive_mutex> guard(m_language_categories_mutex);
+  for (auto &iter : m_language_categories_map) {
+    if (iter.second)
+      DumpFormatCacheStatistics(
+          s, Language::GetNameForLanguageType(iter.first),
+          iter.second->GetFormatCache());
+  }
+}
+
+void FormatManager::ResetCacheStatistics() {
+  m_format_cache.ResetStatistics();
+  std::lock_guard<std::recursive_mutex> guard(m_language_categories_mutex);
+  for (auto &iter : m_language_categories_map) {
+    if (iter.second)
+      iter.second->GetFormatCache().ResetStatistics();
+  }
+}
+
+void FormatManager::GetCacheStatistics(uint64_t &hits, uint64_t &misses) {
+  hits = m_format_cache.GetCacheHits();
+  misses = m_format_cache.GetCacheMisses();
+  std::lock_guard<std::recursive_mutex> guard(m_language_categories_mutex);
+  for (auto &iter : m_language_categories_map) {
+    if (iter.second) {
+      hits += iter.second->GetFormatCache().GetCacheHits();
+      misses += iter.second->GetFormatCache().GetCacheMisses();
+    }
+  }
+}
+
 bool FormatManager::GetFormatFromCString(const char *format_cstr,
                                          bool partial_match_ok,
                                          lldb::Format &format) {
@@ -684,9 +730,7 @@ FormatManager::GetFormat(ValueObject &valobj,
     }
     if (retval) {
       if (log)
-        log->Printf(
-            "[FormatManager::GetFormat] Language search success. Returning.");
-      return retval;
+        log->Printf("[FormatManager::GetFormat] Language search success.");
     }
   }
   if (!retval) {
@@ -762,9 +806,8 @@ FormatManager::GetSummaryFormat(ValueObject &valobj,
     }
     if (retval) {
       if (log)
-        log->Printf("[FormatManager::GetSummaryFormat] Language search "
-                    "success. Returning.");
-      return retval;
+        log->Printf(
+            "[FormatManager::GetSummaryFormat] Language search success.");
     }
   }
   if (!retval) {
@@ -841,9 +884,8 @@ FormatManager::GetSyntheticChildren(ValueObject &valobj,
     }
     if (retval) {
       if (log)
-        log->Printf("[FormatManager::GetSyntheticChildren] Language search "
-                    "success. Returning.");
-      return retval;
+        log->Printf(
+            "[FormatManager::GetSyntheticChildren] Language search success.");
     }
   }
   if (!retval) {
@@ -907,9 +949,7 @@ FormatManager::GetValidator(ValueObject &valobj,
     }
     if (retval) {
       if (log)
-        log->Printf("[FormatManager::GetValidator] Language search success. "
-                    "Returning.");
-      return retval;
+        log->Printf("[FormatManager::GetValidator] Language search success.");
     }
   }
   if (!retval) {
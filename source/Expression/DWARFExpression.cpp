@@ -13,6 +13,7 @@
 #include <inttypes.h>
 
 // C++ Includes
+#include <atomic>
 #include <vector>
 
 #include "lldb/Core/RegisterValue.h"
@@ -65,7 +66,8 @@ DWARFExpression::DWARFExpression(DWARFCompileUnit *dwarf_cu)
 DWARFExpression::DWARFExpression(const DWARFExpression &rhs)
     : m_module_wp(rhs.m_module_wp), m_data(rhs.m_data),
       m_dwarf_cu(rhs.m_dwarf_cu), m_reg_kind(rhs.m_reg_kind),
-      m_loclist_slide(rhs.m_loclist_slide) {}
+      m_loclist_slide(rhs.m_loclist_slide),
+      m_decoded_location_sp(std::atomic_load(&rhs.m_decoded_location_sp)) {}
 
 DWARFExpression::DWARFExpression(lldb::ModuleSP module_sp,
                                  const DataExtractor &data,
@@ -88,6 +90,7 @@ bool DWARFExpression::IsValid() const { return m_data.GetByteSize() > 0; }
 
 void DWARFExpression::SetOpcodeData(const DataExtractor &data) {
   m_data = data;
+  ClearDecodedLocation();
 }
 
 void DWARFExpression::CopyOpcodeData(lldb::ModuleSP module_sp,
@@ -100,6 +103,7 @@ void DWARFExpression::CopyOpcodeData(lldb::ModuleSP module_sp,
     m_data.SetData(DataBufferSP(new DataBufferHeap(bytes, data_length)));
     m_data.SetByteOrder(data.GetByteOrder());
     m_data.SetAddressByteSize(data.GetAddressByteSize());
+    ClearDecodedLocation();
   }
 }
 
@@ -111,6 +115,7 @@ void DWARFExpression::CopyOpcodeData(const void *data,
     m_data.SetData(DataBufferSP(new DataBufferHeap(data, data_length)));
     m_data.SetByteOrder(byte_order);
     m_data.SetAddressByteSize(addr_byte_size);
+    ClearDecodedLocation();
   }
 }
 
@@ -122,6 +127,7 @@ void DWARFExpression::CopyOpcodeData(uint64_t const_value,
         DataBufferSP(new DataBufferHeap(&const_value, const_value_byte_size)));
     m_data.SetByteOrder(endian::InlHostByteOrder());
     m_data.SetAddressByteSize(addr_byte_size);
+    ClearDecodedLocation();
   }
 }
 
@@ -131,6 +137,7 @@ void DWARFExpression::SetOpcodeData(lldb::ModuleSP module_sp,
                                     lldb::offset_t data_length) {
   m_module_wp = module_sp;
   m_data.SetData(data, data_offset, data_length);
+  ClearDecodedLocation();
 }
 
 void DWARFExpression::DumpLocation(Stream *s, lldb::offset_t offset,
@@ -591,6 +598,7 @@ void DWARFExpression::DumpLocation(Stream *s, lldb::offset_t offset,
 
 void DWARFExpression::SetLocationListSlide(addr_t slide) {
   m_loclist_slide = slide;
+  ClearDecodedLocation();
 }
 
 int DWARFExpression::GetRegisterKind() { return m_reg_kind; }
@@ -1016,6 +1024,7 @@ bool DWARFExpression::Update_DW_OP_addr(lldb::addr_t file_addr) {
       // pointer to the heap data so "m_data" will now correctly
       // manage the heap data.
       m_data.SetData(DataBufferSP(head_data_ap.release()));
+      ClearDecodedLocation();
       return true;
     } else {
       const offset_t op_arg_size = GetOpcodeDataSize(m_data, offset, op);
@@ -1152,6 +1161,7 @@ bool DWARFExpression::LinkThreadLocalStorage(
   // TLS data
   m_module_wp = new_module_sp;
   m_data.SetData(heap_data_sp);
+  ClearDecodedLocation();
   return true;
 }
 
@@ -1257,15 +1267,201 @@ bool DWARFExpression::Evaluate(ExecutionContextScope *exe_scope,
                   result, error_ptr);
 }
 
+namespace {
+//----------------------------------------------------------------------
+// Most variable and frame base locations are a single register or
+// register relative opcode. Those are recognized when the expression is
+// decoded and evaluated without the DWARF stack machine.
+//----------------------------------------------------------------------
+struct SimpleLocation {
+  enum Kind : uint8_t {
+    eNone,            // Needs the full DWARF expression evaluator
+    eRegister,        // DW_OP_regN, DW_OP_regx
+    eRegisterOffset,  // DW_OP_bregN, DW_OP_bregx
+    eFrameBaseOffset, // DW_OP_fbreg
+  };
+
+  Kind kind = eNone;
+  uint32_t reg_num = 0;
+  int64_t offset = 0;
+};
+} // namespace
+
+struct DWARFExpression::DecodedLocation {
+  struct Entry {
+    lldb::addr_t lo_pc;
+    lldb::addr_t hi_pc;
+    lldb::offset_t offset;
+    lldb::offset_t length;
+    SimpleLocation simple;
+  };
+
+  // The entries of a location list, in order, up to the end of list entry.
+  std::vector<Entry> entries;
+  // The simple form of the expression when this isn't a location list.
+  SimpleLocation simple;
+};
+
+static SimpleLocation DecodeSimpleLocation(const DataExtractor &opcodes,
+                                           lldb::offset_t offset,
+                                           lldb::offset_t length) {
+  SimpleLocation simple;
+  if (length == 0 || !opcodes.ValidOffsetForDataOfSize(offset, length))
+    return simple;
+
+  const lldb::offset_t end_offset = offset + length;
+  const uint8_t op = opcodes.GetU8(&offset);
+  SimpleLocation::Kind kind;
+  uint32_t reg_num = 0;
+  int64_t value_offset = 0;
+  if (op >= DW_OP_reg0 && op <= DW_OP_reg31) {
+    kind = SimpleLocation::eRegister;
+    reg_num = op - DW_OP_reg0;
+  } else if (op == DW_OP_regx) {
+    kind = SimpleLocation::eRegister;
+    reg_num = opcodes.GetULEB128(&offset);
+  } else if (op >= DW_OP_breg0 && op <= DW_OP_breg31) {
+    kind = SimpleLocation::eRegisterOffset;
+    reg_num = op - DW_OP_breg0;
+    value_offset = opcodes.GetSLEB128(&offset);
+  } else if (op == DW_OP_bregx) {
+    kind = SimpleLocation::eRegisterOffset;
+    reg_num = opcodes.GetULEB128(&offset);
+    value_offset = opcodes.GetSLEB128(&offset);
+  } else if (op == DW_OP_fbreg) {
+    kind = SimpleLocation::eFrameBaseOffset;
+    value_offset = opcodes.GetSLEB128(&offset);
+  } else
+    return simple;
+
+  // Anything after the first opcode needs the evaluator.
+  if (offset != end_offset)
+    return simple;
+
+  simple.kind = kind;
+  simple.reg_num = reg_num;
+  simple.offset = value_offset;
+  return simple;
+}
+
+// Evaluate "simple" exactly as the DWARF expression evaluator would evaluate
+// the opcode it was decoded from.
+static bool EvaluateSimpleLocation(const SimpleLocation &simple,
+                                   ExecutionContext *exe_ctx,
+                                   RegisterContext *reg_ctx,
+                                   lldb::RegisterKind reg_kind, Value &result,
+                                   Error *error_ptr) {
+  StackFrame *frame = exe_ctx ? exe_ctx->GetFramePtr() : nullptr;
+  if (reg_ctx == nullptr && frame)
+    reg_ctx = frame->GetRegisterContext().get();
+
+  switch (simple.kind) {
+  case SimpleLocation::eRegister: {
+    Value value;
+    if (!ReadRegisterValueAsScalar(reg_ctx, reg_kind, simple.reg_num,
+                                   error_ptr, value))
+      return false;
+    result = value;
+    return true;
+  }
+
+  case SimpleLocation::eRegisterOffset: {
+    Value value;
+    if (!ReadRegisterValueAsScalar(reg_ctx, reg_kind, simple.reg_num,
+                                   error_ptr, value))
+      return false;
+    value.ResolveValue(exe_ctx) += (uint64_t)simple.offset;
+    value.ClearContext();
+    value.SetValueType(Value::eValueTypeLoadAddress);
+    result = value;
+    return true;
+  }
+
+  case SimpleLocation::eFrameBaseOffset: {
+    if (!exe_ctx) {
+      if (error_ptr)
+        error_ptr->SetErrorStringWithFormat(
+            "NULL execution context for DW_OP_fbreg.\n");
+      return false;
+    }
+    if (!frame) {
+      if (error_ptr)
+        error_ptr->SetErrorString(
+            "Invalid stack frame in context for DW_OP_fbreg opcode.");
+      return false;
+    }
+    Scalar frame_base;
+    if (!frame->GetFrameBaseValue(frame_base, error_ptr))
+      return false;
+    frame_base += simple.offset;
+    result = Value(frame_base);
+    result.SetValueType(Value::eValueTypeLoadAddress);
+    return true;
+  }
+
+  case SimpleLocation::eNone:
+    break;
+  }
+  return false;
+}
+
+DWARFExpression::DecodedLocationSP
+DWARFExpression::GetDecodedLocation() const {
+  DecodedLocationSP decoded_sp = std::atomic_load(&m_decoded_location_sp);
+  if (decoded_sp)
+    return decoded_sp;
+
+  // Two threads may decode the same expression at once. They get the same
+  // result, so it doesn't matter whose is kept.
+  auto decoded = std::make_shared<DecodedLocation>();
+  if (IsLocationList()) {
+    lldb::offset_t offset = 0;
+    while (m_data.ValidOffset(offset)) {
+      addr_t lo_pc = LLDB_INVALID_ADDRESS;
+      addr_t hi_pc = LLDB_INVALID_ADDRESS;
+      if (!AddressRangeForLocationListEntry(m_dwarf_cu, m_data, &offset, lo_pc,
+                                            hi_pc))
+        break;
+
+      if (lo_pc == 0 && hi_pc == 0)
+        break;
+
+      DecodedLocation::Entry entry;
+      entry.lo_pc = lo_pc;
+      entry.hi_pc = hi_pc;
+      entry.length = m_data.GetU16(&offset);
+      entry.offset = offset;
+      entry.simple = DecodeSimpleLocation(m_data, entry.offset, entry.length);
+      decoded->entries.push_back(entry);
+      offset += entry.length;
+    }
+  } else {
+    decoded->simple = DecodeSimpleLocation(m_data, 0, m_data.GetByteSize());
+  }
+
+  decoded_sp = decoded;
+  std::atomic_store(&m_decoded_location_sp, decoded_sp);
+  return decoded_sp;
+}
+
+void DWARFExpression::ClearDecodedLocation() {
+  std::atomic_store(&m_decoded_location_sp, DecodedLocationSP());
+}
+
 bool DWARFExpression::Evaluate(
     ExecutionContext *exe_ctx, ClangExpressionVariableList *expr_locals,
     ClangExpressionDeclMap *decl_map, RegisterContext *reg_ctx,
     lldb::addr_t loclist_base_load_addr, const Value *initial_value_ptr,
     const Value *object_address_ptr, Value &result, Error *error_ptr) const {
   ModuleSP module_sp = m_module_wp.lock();
+  DecodedLocationSP decoded_sp = GetDecodedLocation();
+
+  // The evaluator logs every step of the stack machine in verbose mode, so
+  // leave everything to it then.
+  Log *log(lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+  const bool use_simple = !(log && log->GetVerbose());
 
   if (IsLocationList()) {
-    lldb::offset_t offset = 0;
     addr_t pc;
     StackFrame *frame = NULL;
     if (reg_ctx)
@@ -1287,31 +1483,18 @@ bool DWARFExpression::Evaluate(
         return false;
       }
 
-      addr_t curr_loclist_base_load_addr = loclist_base_load_addr;
-
-      while (m_data.ValidOffset(offset)) {
-        // We need to figure out what the value is for the location.
-        addr_t lo_pc = LLDB_INVALID_ADDRESS;
-        addr_t hi_pc = LLDB_INVALID_ADDRESS;
-        if (!AddressRangeForLocationListEntry(m_dwarf_cu, m_data, &offset,
-                                              lo_pc, hi_pc))
-          break;
-
-        if (lo_pc == 0 && hi_pc == 0)
-          break;
-
-        lo_pc += curr_loclist_base_load_addr - m_loclist_slide;
-        hi_pc += curr_loclist_base_load_addr - m_loclist_slide;
-
-        uint16_t length = m_data.GetU16(&offset);
-
-        if (length > 0 && lo_pc <= pc && pc < hi_pc) {
+      const addr_t slide = loclist_base_load_addr - m_loclist_slide;
+      for (const DecodedLocation::Entry &entry : decoded_sp->entries) {
+        if (entry.length > 0 && entry.lo_pc + slide <= pc &&
+            pc < entry.hi_pc + slide) {
+          if (use_simple && entry.simple.kind != SimpleLocation::eNone)
+            return EvaluateSimpleLocation(entry.simple, exe_ctx, reg_ctx,
+                                          m_reg_kind, result, error_ptr);
           return DWARFExpression::Evaluate(
               exe_ctx, expr_locals, decl_map, reg_ctx, module_sp, m_data,
-              m_dwarf_cu, offset, length, m_reg_kind, initial_value_ptr,
-              object_address_ptr, result, error_ptr);
+              m_dwarf_cu, entry.offset, entry.length, m_reg_kind,
+              initial_value_ptr, object_address_ptr, result, error_ptr);
         }
-        offset += length;
       }
     }
     if (error_ptr)
@@ -1320,6 +1503,9 @@ bool DWARFExpression::Evaluate(
   }
 
   // Not a location list, just a single expression.
+  if (use_simple && decoded_sp->simple.kind != SimpleLocation::eNone)
+    return EvaluateSimpleLocation(decoded_sp->simple, exe_ctx, reg_ctx,
+                                  m_reg_kind, result, error_ptr);
   return DWARFExpression::Evaluate(
       exe_ctx, expr_locals, decl_map, reg_ctx, module_sp, m_data, m_dwarf_cu, 0,
       m_data.GetByteSize(), m_reg_kind, initial_value_ptr, object_address_ptr,
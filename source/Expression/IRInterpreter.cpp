@@ -37,8 +37,11 @@
 #include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/IR/Operator.h"
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
+#include <cmath>
 #include <map>
 
 using namespace llvm;
@@ -89,6 +92,42 @@ static bool CanIgnoreCall(const CallInst *call) {
   return false;
 }
 
+static bool IsMemoryIntrinsic(const CallInst *call) {
+  const llvm::Function *called_function = call->getCalledFunction();
+
+  if (!called_function || !called_function->isIntrinsic())
+    return false;
+
+  switch (called_function->getIntrinsicID()) {
+  default:
+    return false;
+  case llvm::Intrinsic::memcpy:
+  case llvm::Intrinsic::memmove:
+  case llvm::Intrinsic::memset:
+    // The interpreter only handles a scalar length.
+    return call->getNumArgOperands() >= 3 &&
+           call->getArgOperand(2)->getType()->isIntegerTy();
+  }
+}
+
+// Inline functions and lambdas used by an expression are emitted into the
+// expression's module, so calls to them can be interpreted too.
+static const llvm::Function *GetCalleeWithBody(const CallInst *call) {
+  const llvm::Function *called_function = call->getCalledFunction();
+
+  if (!called_function || called_function->isDeclaration() ||
+      called_function->isVarArg())
+    return nullptr;
+
+  return called_function;
+}
+
+// Floating point arithmetic is done with the host's float and double, so
+// other formats (e.g. x87 long double) are left to the JIT.
+static bool IsSupportedFloatType(const Type *type) {
+  return type->isFloatTy() || type->isDoubleTy();
+}
+
 class InterpreterStackFrame {
 public:
   typedef std::map<const Value *, lldb::addr_t> ValueMap;
@@ -238,6 +277,35 @@ public:
     return write_error.Success();
   }
 
+  bool EvaluateFloatValue(double &result, const Value *value, Module &module) {
+    Type *type = value->getType();
+    lldb_private::Scalar bits;
+
+    if (!IsSupportedFloatType(type) || !EvaluateValue(bits, value, module))
+      return false;
+
+    if (type->isFloatTy())
+      result = llvm::BitsToFloat(bits.UInt());
+    else
+      result = llvm::BitsToDouble(bits.ULongLong());
+
+    return true;
+  }
+
+  bool AssignFloatValue(const Value *value, double result, Module &module) {
+    Type *type = value->getType();
+    lldb_private::Scalar bits;
+
+    if (type->isFloatTy())
+      bits = llvm::FloatToBits(static_cast<float>(result));
+    else if (type->isDoubleTy())
+      bits = llvm::DoubleToBits(result);
+    else
+      return false;
+
+    return AssignValue(value, bits, module);
+  }
+
   bool ResolveConstantValue(APInt &value, const Constant *constant) {
     switch (constant->getValueID()) {
     default:
@@ -461,8 +529,10 @@ static const char *memory_read_error = "Interpreter couldn't read from memory";
 static const char *infinite_loop_error = "Interpreter ran for too many cycles";
 // static const char *bad_result_error                 = "Result of expression
 // is in bad memory";
-static const char *too_many_functions_error =
-    "Interpreter doesn't handle modules with multiple function bodies.";
+static const char *too_deep_error =
+    "Interpreter reached the maximum function call depth";
+
+static const uint32_t max_call_depth = 16;
 
 static bool CanResolveConstant(llvm::Constant *constant) {
   switch (constant->getValueID()) {
@@ -498,28 +568,12 @@ static bool CanResolveConstant(llvm::Constant *constant) {
   }
 }
 
-bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
+static bool CanInterpretFunction(llvm::Function &function,
                                  lldb_private::Error &error,
                                  const bool support_function_calls) {
   lldb_private::Log *log(
       lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
 
-  bool saw_function_with_body = false;
-
-  for (Module::iterator fi = module.begin(), fe = module.end(); fi != fe;
-       ++fi) {
-    if (fi->begin() != fi->end()) {
-      if (saw_function_with_body) {
-        if (log)
-          log->Printf("More than one function in the module has a body");
-        error.SetErrorToGenericError();
-        error.SetErrorString(too_many_functions_error);
-        return false;
-      }
-      saw_function_with_body = true;
-    }
-  }
-
   for (Function::iterator bbi = function.begin(), bbe = function.end();
        bbi != bbe; ++bbi) {
     for (BasicBlock::iterator ii = bbi->begin(), ie = bbi->end(); ii != ie;
@@ -547,7 +601,8 @@ bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
           return false;
         }
 
-        if (!CanIgnoreCall(call_inst) && !support_function_calls) {
+        if (!CanIgnoreCall(call_inst) && !IsMemoryIntrinsic(call_inst) &&
+            !GetCalleeWithBody(call_inst) && !support_function_calls) {
           if (log)
             log->Printf("Unsupported instruction: %s",
                         PrintValue(&*ii).c_str());
@@ -611,6 +666,42 @@ bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
       case Instruction::Xor:
       case Instruction::ZExt:
         break;
+      case Instruction::FAdd:
+      case Instruction::FSub:
+      case Instruction::FMul:
+      case Instruction::FDiv:
+      case Instruction::FRem:
+      case Instruction::FCmp:
+      case Instruction::FPExt:
+      case Instruction::FPTrunc:
+      case Instruction::FPToSI:
+      case Instruction::FPToUI:
+      case Instruction::SIToFP:
+      case Instruction::UIToFP:
+      case Instruction::Select:
+      case Instruction::Switch: {
+        bool supported_types = true;
+
+        if (ii->getType()->isFloatingPointTy())
+          supported_types &= IsSupportedFloatType(ii->getType());
+
+        for (int oi = 0, oe = ii->getNumOperands(); oi != oe; ++oi) {
+          Type *operand_type = ii->getOperand(oi)->getType();
+          if (operand_type->isFloatingPointTy())
+            supported_types &= IsSupportedFloatType(operand_type);
+          else if (operand_type->isIntegerTy())
+            supported_types &= operand_type->getIntegerBitWidth() <= 64;
+        }
+
+        if (!supported_types) {
+          if (log)
+            log->Printf("Unsupported operand type: %s",
+                        PrintValue(&*ii).c_str());
+          error.SetErrorToGenericError();
+          error.SetErrorString(unsupported_operand_error);
+          return false;
+        }
+      } break;
       }
 
       for (int oi = 0, oe = ii->getNumOperands(); oi != oe; ++oi) {
@@ -645,53 +736,137 @@ bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
   return true;
 }
 
-bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
-                              llvm::ArrayRef<lldb::addr_t> args,
-                              lldb_private::IRExecutionUnit &execution_unit,
-                              lldb_private::Error &error,
-                              lldb::addr_t stack_frame_bottom,
-                              lldb::addr_t stack_frame_top,
-                              lldb_private::ExecutionContext &exe_ctx) {
-  lldb_private::Log *log(
-      lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+bool IRInterpreter::CanInterpret(llvm::Module &module, llvm::Function &function,
+                                 lldb_private::Error &error,
+                                 const bool support_function_calls) {
+  // Every function body in the module may be reached through a call from
+  // the expression, so they all have to be interpretable.
+  for (Module::iterator fi = module.begin(), fe = module.end(); fi != fe;
+       ++fi) {
+    if (fi->isDeclaration())
+      continue;
 
-  if (log) {
-    std::string s;
-    raw_string_ostream oss(s);
+    if (!CanInterpretFunction(*fi, error, support_function_calls))
+      return false;
+  }
 
-    module.print(oss, NULL);
+  return true;
+}
 
-    oss.flush();
+// Memory intrinsics are copied through a buffer of at most this many bytes,
+// so a large or bogus length can't make us allocate without bound.
+static const size_t k_memory_intrinsic_chunk_size = 64 * 1024;
 
-    log->Printf("Module as passed in to IRInterpreter::Interpret: \n\"%s\"",
-                s.c_str());
-  }
+static bool CopyMemory(lldb_private::IRExecutionUnit &execution_unit,
+                       lldb::addr_t dst, lldb::addr_t src, size_t size,
+                       lldb_private::Error &error) {
+  if (size == 0)
+    return true;
 
-  DataLayout data_layout(&module);
+  lldb_private::DataBufferHeap buffer(
+      std::min(size, k_memory_intrinsic_chunk_size), 0);
 
-  InterpreterStackFrame frame(data_layout, execution_unit, stack_frame_bottom,
-                              stack_frame_top);
+  // When the destination overlaps the end of the source (memmove), copy the
+  // chunks from back to front so no byte is overwritten before it is read.
+  const bool backwards = dst > src && dst - src < size;
 
-  if (frame.m_frame_process_address == LLDB_INVALID_ADDRESS) {
-    error.SetErrorString("Couldn't allocate stack frame");
-  }
+  size_t bytes_left = size;
+  while (bytes_left > 0) {
+    const size_t chunk_size =
+        std::min(bytes_left, (size_t)buffer.GetByteSize());
+    const size_t offset =
+        backwards ? bytes_left - chunk_size : size - bytes_left;
 
-  int arg_index = 0;
+    lldb_private::Error read_error;
+    execution_unit.ReadMemory(buffer.GetBytes(), src + offset, chunk_size,
+                              read_error);
+    if (!read_error.Success()) {
+      error.SetErrorToGenericError();
+      error.SetErrorString(memory_read_error);
+      return false;
+    }
 
-  for (llvm::Function::arg_iterator ai = function.arg_begin(),
-                                    ae = function.arg_end();
-       ai != ae; ++ai, ++arg_index) {
-    if (args.size() <= static_cast<size_t>(arg_index)) {
-      error.SetErrorString("Not enough arguments passed in to function");
+    lldb_private::Error write_error;
+    execution_unit.WriteMemory(dst + offset, buffer.GetBytes(), chunk_size,
+                               write_error);
+    if (!write_error.Success()) {
+      error.SetErrorToGenericError();
+      error.SetErrorString(memory_write_error);
       return false;
     }
 
-    lldb::addr_t ptr = args[arg_index];
+    bytes_left -= chunk_size;
+  }
 
-    frame.MakeArgument(&*ai, ptr);
+  return true;
+}
+
+static bool
+InterpretMemoryIntrinsic(llvm::Module &module, const CallInst &call_inst,
+                         InterpreterStackFrame &frame,
+                         lldb_private::IRExecutionUnit &execution_unit,
+                         lldb_private::Error &error) {
+  // memcpy, memmove and memset all take (dst, src or value, size, ...).
+  lldb_private::Scalar D;
+  lldb_private::Scalar S;
+  lldb_private::Scalar N;
+
+  if (!frame.EvaluateValue(D, call_inst.getArgOperand(0), module) ||
+      !frame.EvaluateValue(S, call_inst.getArgOperand(1), module) ||
+      !frame.EvaluateValue(N, call_inst.getArgOperand(2), module)) {
+    error.SetErrorToGenericError();
+    error.SetErrorString(bad_value_error);
+    return false;
   }
 
-  uint32_t num_insts = 0;
+  lldb::addr_t dst = D.ULongLong(LLDB_INVALID_ADDRESS);
+  size_t size = N.ULongLong();
+
+  if (call_inst.getCalledFunction()->getIntrinsicID() !=
+      llvm::Intrinsic::memset)
+    return CopyMemory(execution_unit, dst, S.ULongLong(LLDB_INVALID_ADDRESS),
+                      size, error);
+
+  if (size == 0)
+    return true;
+
+  lldb_private::DataBufferHeap buffer(
+      std::min(size, k_memory_intrinsic_chunk_size), (uint8_t)S.UInt());
+
+  for (size_t offset = 0; offset < size; offset += buffer.GetByteSize()) {
+    const size_t chunk_size =
+        std::min(size - offset, (size_t)buffer.GetByteSize());
+    lldb_private::Error write_error;
+    execution_unit.WriteMemory(dst + offset, buffer.GetBytes(), chunk_size,
+                               write_error);
+    if (!write_error.Success()) {
+      error.SetErrorToGenericError();
+      error.SetErrorString(memory_write_error);
+      return false;
+    }
+  }
+
+  return true;
+}
+
+static bool InterpretCall(llvm::Module &module, const CallInst &call_inst,
+                          const llvm::Function &callee,
+                          InterpreterStackFrame &frame, DataLayout &data_layout,
+                          lldb_private::IRExecutionUnit &execution_unit,
+                          lldb_private::Error &error,
+                          lldb_private::ExecutionContext &exe_ctx,
+                          uint32_t &num_insts, uint32_t call_depth);
+
+static bool InterpretFunction(llvm::Module &module,
+                              const llvm::Function &function,
+                              InterpreterStackFrame &frame,
+                              DataLayout &data_layout,
+                              lldb_private::IRExecutionUnit &execution_unit,
+                              lldb_private::Error &error,
+                              lldb_private::ExecutionContext &exe_ctx,
+                              uint32_t &num_insts, uint32_t call_depth) {
+  lldb_private::Log *log(
+      lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
 
   frame.Jump(&function.front());
 
@@ -992,6 +1167,50 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
       }
     }
       continue;
+    case Instruction::Switch: {
+      const SwitchInst *switch_inst = dyn_cast<SwitchInst>(inst);
+
+      if (!switch_inst) {
+        if (log)
+          log->Printf("getOpcode() returns Switch, but instruction is not a "
+                      "SwitchInst");
+        error.SetErrorToGenericError();
+        error.SetErrorString(interpreter_internal_error);
+        return false;
+      }
+
+      Value *condition = switch_inst->getCondition();
+
+      lldb_private::Scalar C;
+
+      if (!frame.EvaluateValue(C, condition, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(condition).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      APInt condition_value(condition->getType()->getIntegerBitWidth(),
+                            C.ULongLong());
+
+      const BasicBlock *destination = switch_inst->getDefaultDest();
+
+      for (auto switch_case : switch_inst->cases()) {
+        if (switch_case.getCaseValue()->getValue() == condition_value) {
+          destination = switch_case.getCaseSuccessor();
+          break;
+        }
+      }
+
+      frame.Jump(destination);
+
+      if (log) {
+        log->Printf("Interpreted a SwitchInst");
+        log->Printf("  cond : %s", frame.SummarizeValue(condition).c_str());
+      }
+    }
+      continue;
     case Instruction::PHI: {
       const PHINode *phi_inst = dyn_cast<PHINode>(inst);
 
@@ -1298,6 +1517,317 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
         log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
       }
     } break;
+    case Instruction::FAdd:
+    case Instruction::FSub:
+    case Instruction::FMul:
+    case Instruction::FDiv:
+    case Instruction::FRem: {
+      Value *lhs = inst->getOperand(0);
+      Value *rhs = inst->getOperand(1);
+
+      double L;
+      double R;
+
+      if (!frame.EvaluateFloatValue(L, lhs, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(lhs).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      if (!frame.EvaluateFloatValue(R, rhs, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(rhs).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      // Single precision operations are done in double precision and then
+      // rounded, which gives the same result for these operations.
+      double result = 0;
+
+      switch (inst->getOpcode()) {
+      default:
+        break;
+      case Instruction::FAdd:
+        result = L + R;
+        break;
+      case Instruction::FSub:
+        result = L - R;
+        break;
+      case Instruction::FMul:
+        result = L * R;
+        break;
+      case Instruction::FDiv:
+        result = L / R;
+        break;
+      case Instruction::FRem:
+        result = std::fmod(L, R);
+        break;
+      }
+
+      if (!frame.AssignFloatValue(inst, result, module)) {
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      if (log) {
+        log->Printf("Interpreted a %s", inst->getOpcodeName());
+        log->Printf("  L : %s", frame.SummarizeValue(lhs).c_str());
+        log->Printf("  R : %s", frame.SummarizeValue(rhs).c_str());
+        log->Printf("  = : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
+    case Instruction::FCmp: {
+      const FCmpInst *fcmp_inst = dyn_cast<FCmpInst>(inst);
+
+      if (!fcmp_inst) {
+        if (log)
+          log->Printf(
+              "getOpcode() returns FCmp, but instruction is not an FCmpInst");
+        error.SetErrorToGenericError();
+        error.SetErrorString(interpreter_internal_error);
+        return false;
+      }
+
+      Value *lhs = inst->getOperand(0);
+      Value *rhs = inst->getOperand(1);
+
+      double L;
+      double R;
+
+      if (!frame.EvaluateFloatValue(L, lhs, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(lhs).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      if (!frame.EvaluateFloatValue(R, rhs, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(rhs).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      const bool ordered = !std::isnan(L) && !std::isnan(R);
+      bool compare_result = false;
+
+      switch (fcmp_inst->getPredicate()) {
+      default:
+        error.SetErrorToGenericError();
+        error.SetErrorString(interpreter_internal_error);
+        return false;
+      case CmpInst::FCMP_FALSE:
+        compare_result = false;
+        break;
+      case CmpInst::FCMP_OEQ:
+        compare_result = ordered && L == R;
+        break;
+      case CmpInst::FCMP_OGT:
+        compare_result = ordered && L > R;
+        break;
+      case CmpInst::FCMP_OGE:
+        compare_result = ordered && L >= R;
+        break;
+      case CmpInst::FCMP_OLT:
+        compare_result = ordered && L < R;
+        break;
+      case CmpInst::FCMP_OLE:
+        compare_result = ordered && L <= R;
+        break;
+      case CmpInst::FCMP_ONE:
+        compare_result = ordered && L != R;
+        break;
+      case CmpInst::FCMP_ORD:
+        compare_result = ordered;
+        break;
+      case CmpInst::FCMP_UNO:
+        compare_result = !ordered;
+        break;
+      case CmpInst::FCMP_UEQ:
+        compare_result = !ordered || L == R;
+        break;
+      case CmpInst::FCMP_UGT:
+        compare_result = !ordered || L > R;
+        break;
+      case CmpInst::FCMP_UGE:
+        compare_result = !ordered || L >= R;
+        break;
+      case CmpInst::FCMP_ULT:
+        compare_result = !ordered || L < R;
+        break;
+      case CmpInst::FCMP_ULE:
+        compare_result = !ordered || L <= R;
+        break;
+      case CmpInst::FCMP_UNE:
+        compare_result = !ordered || L != R;
+        break;
+      case CmpInst::FCMP_TRUE:
+        compare_result = true;
+        break;
+      }
+
+      lldb_private::Scalar result(compare_result ? 1 : 0);
+
+      frame.AssignValue(inst, result, module);
+
+      if (log) {
+        log->Printf("Interpreted an FCmpInst");
+        log->Printf("  L : %s", frame.SummarizeValue(lhs).c_str());
+        log->Printf("  R : %s", frame.SummarizeValue(rhs).c_str());
+        log->Printf("  = : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
+    case Instruction::FPExt:
+    case Instruction::FPTrunc: {
+      Value *src_operand = inst->getOperand(0);
+
+      double F;
+
+      if (!frame.EvaluateFloatValue(F, src_operand, module) ||
+          !frame.AssignFloatValue(inst, F, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(src_operand).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      if (log) {
+        log->Printf("Interpreted a %s", inst->getOpcodeName());
+        log->Printf("  Src : %s", frame.SummarizeValue(src_operand).c_str());
+        log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
+    case Instruction::SIToFP:
+    case Instruction::UIToFP: {
+      Value *src_operand = inst->getOperand(0);
+
+      lldb_private::Scalar I;
+
+      if (!frame.EvaluateValue(I, src_operand, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(src_operand).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      const unsigned bit_width = src_operand->getType()->getIntegerBitWidth();
+      uint64_t bits = I.ULongLong();
+      if (bit_width < 64)
+        bits &= (1ULL << bit_width) - 1;
+
+      // Convert straight to the destination type so that the value is only
+      // rounded once.
+      double result;
+
+      if (inst->getOpcode() == Instruction::SIToFP) {
+        int64_t value = llvm::SignExtend64(bits, bit_width);
+        result = inst->getType()->isFloatTy() ? static_cast<float>(value)
+                                              : static_cast<double>(value);
+      } else {
+        result = inst->getType()->isFloatTy() ? static_cast<float>(bits)
+                                              : static_cast<double>(bits);
+      }
+
+      if (!frame.AssignFloatValue(inst, result, module)) {
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      if (log) {
+        log->Printf("Interpreted a %s", inst->getOpcodeName());
+        log->Printf("  Src : %s", frame.SummarizeValue(src_operand).c_str());
+        log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
+    case Instruction::FPToSI:
+    case Instruction::FPToUI: {
+      Value *src_operand = inst->getOperand(0);
+
+      double F;
+
+      if (!frame.EvaluateFloatValue(F, src_operand, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(src_operand).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      // Out of range conversions produce an undefined value in IR; don't
+      // perform them on the host, where they are undefined behavior.
+      lldb_private::Scalar result(0);
+
+      if (inst->getOpcode() == Instruction::FPToSI) {
+        if (F > -9223372036854775809.0 && F < 9223372036854775808.0)
+          result = static_cast<long long>(F);
+      } else {
+        if (F > -1.0 && F < 18446744073709551616.0)
+          result = static_cast<unsigned long long>(F);
+      }
+
+      frame.AssignValue(inst, result, module);
+
+      if (log) {
+        log->Printf("Interpreted a %s", inst->getOpcodeName());
+        log->Printf("  Src : %s", frame.SummarizeValue(src_operand).c_str());
+        log->Printf("  =   : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
+    case Instruction::Select: {
+      const SelectInst *select_inst = dyn_cast<SelectInst>(inst);
+
+      if (!select_inst) {
+        if (log)
+          log->Printf("getOpcode() returns Select, but instruction is not a "
+                      "SelectInst");
+        error.SetErrorToGenericError();
+        error.SetErrorString(interpreter_internal_error);
+        return false;
+      }
+
+      const Value *condition = select_inst->getCondition();
+
+      lldb_private::Scalar C;
+
+      if (!frame.EvaluateValue(C, condition, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(condition).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      const Value *selected = C.IsZero() ? select_inst->getFalseValue()
+                                         : select_inst->getTrueValue();
+
+      lldb_private::Scalar result;
+
+      if (!frame.EvaluateValue(result, selected, module)) {
+        if (log)
+          log->Printf("Couldn't evaluate %s", PrintValue(selected).c_str());
+        error.SetErrorToGenericError();
+        error.SetErrorString(bad_value_error);
+        return false;
+      }
+
+      frame.AssignValue(inst, result, module);
+
+      if (log) {
+        log->Printf("Interpreted a SelectInst");
+        log->Printf("  cond : %s", frame.SummarizeValue(condition).c_str());
+        log->Printf("  =    : %s", frame.SummarizeValue(inst).c_str());
+      }
+    } break;
     case Instruction::Load: {
       const LoadInst *load_inst = dyn_cast<LoadInst>(inst);
 
@@ -1501,6 +2031,21 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
       if (CanIgnoreCall(call_inst))
         break;
 
+      if (IsMemoryIntrinsic(call_inst)) {
+        if (!InterpretMemoryIntrinsic(module, *call_inst, frame,
+                                      execution_unit, error))
+          return false;
+        break;
+      }
+
+      if (const llvm::Function *callee = GetCalleeWithBody(call_inst)) {
+        if (!InterpretCall(module, *call_inst, *callee, frame, data_layout,
+                           execution_unit, error, exe_ctx, num_insts,
+                           call_depth))
+          return false;
+        break;
+      }
+
       // Get the return type
       llvm::Type *returnType = call_inst->getType();
       if (returnType == nullptr) {
@@ -1703,3 +2248,159 @@ bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
 
   return false;
 }
+
+static bool InterpretCall(llvm::Module &module, const CallInst &call_inst,
+                          const llvm::Function &callee,
+                          InterpreterStackFrame &frame, DataLayout &data_layout,
+                          lldb_private::IRExecutionUnit &execution_unit,
+                          lldb_private::Error &error,
+                          lldb_private::ExecutionContext &exe_ctx,
+                          uint32_t &num_insts, uint32_t call_depth) {
+  lldb_private::Log *log(
+      lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+
+  if (call_depth >= max_call_depth) {
+    if (log)
+      log->Printf("Too many nested calls to %s",
+                  callee.getName().str().c_str());
+    error.SetErrorToGenericError();
+    error.SetErrorString(too_deep_error);
+    return false;
+  }
+
+  // The callee's frame is carved out of the stack below everything the
+  // caller has allocated so far, so resolve the result and the arguments in
+  // the caller's frame before creating it.
+  lldb::addr_t result_address = LLDB_INVALID_ADDRESS;
+
+  if (!call_inst.getType()->isVoidTy()) {
+    result_address = frame.ResolveValue(&call_inst, module);
+    if (result_address == LLDB_INVALID_ADDRESS) {
+      error.SetErrorToGenericError();
+      error.SetErrorString(bad_value_error);
+      return false;
+    }
+  }
+
+  SmallVector<lldb::addr_t, 8> arg_addresses;
+
+  for (unsigned i = 0, e = call_inst.getNumArgOperands(); i != e; ++i) {
+    lldb::addr_t arg_address =
+        frame.ResolveValue(call_inst.getArgOperand(i), module);
+    if (arg_address == LLDB_INVALID_ADDRESS) {
+      if (log)
+        log->Printf("Couldn't evaluate %s",
+                    PrintValue(call_inst.getArgOperand(i)).c_str());
+      error.SetErrorToGenericError();
+      error.SetErrorString(bad_value_error);
+      return false;
+    }
+    arg_addresses.push_back(arg_address);
+  }
+
+  InterpreterStackFrame callee_frame(data_layout, execution_unit,
+                                     frame.m_frame_process_address,
+                                     frame.m_stack_pointer);
+
+  size_t arg_index = 0;
+
+  for (llvm::Function::const_arg_iterator ai = callee.arg_begin(),
+                                          ae = callee.arg_end();
+       ai != ae && arg_index < arg_addresses.size(); ++ai, ++arg_index) {
+    lldb::addr_t data_address = callee_frame.Malloc(ai->getType());
+
+    if (data_address == LLDB_INVALID_ADDRESS) {
+      error.SetErrorToGenericError();
+      error.SetErrorString(memory_allocation_error);
+      return false;
+    }
+
+    if (!CopyMemory(execution_unit, data_address, arg_addresses[arg_index],
+                    data_layout.getTypeStoreSize(ai->getType()), error))
+      return false;
+
+    callee_frame.m_values[&*ai] = data_address;
+  }
+
+  if (log)
+    log->Printf("Interpreting a call to %s", callee.getName().str().c_str());
+
+  if (!InterpretFunction(module, callee, callee_frame, data_layout,
+                         execution_unit, error, exe_ctx, num_insts,
+                         call_depth + 1))
+    return false;
+
+  if (result_address == LLDB_INVALID_ADDRESS)
+    return true;
+
+  // InterpretFunction stops at the callee's ret instruction.
+  const ReturnInst *ret_inst = dyn_cast<ReturnInst>(&*callee_frame.m_ii);
+  const Value *ret_value = ret_inst ? ret_inst->getReturnValue() : nullptr;
+  lldb::addr_t ret_address =
+      ret_value ? callee_frame.ResolveValue(ret_value, module)
+                : LLDB_INVALID_ADDRESS;
+
+  if (ret_address == LLDB_INVALID_ADDRESS) {
+    if (log)
+      log->Printf("Couldn't find the value returned by %s",
+                  callee.getName().str().c_str());
+    error.SetErrorToGenericError();
+    error.SetErrorString(bad_value_error);
+    return false;
+  }
+
+  return CopyMemory(execution_unit, result_address, ret_address,
+                    data_layout.getTypeStoreSize(call_inst.getType()), error);
+}
+
+bool IRInterpreter::Interpret(llvm::Module &module, llvm::Function &function,
+                              llvm::ArrayRef<lldb::addr_t> args,
+                              lldb_private::IRExecutionUnit &execution_unit,
+                              lldb_private::Error &error,
+                              lldb::addr_t stack_frame_bottom,
+                              lldb::addr_t stack_frame_top,
+                              lldb_private::ExecutionContext &exe_ctx) {
+  lldb_private::Log *log(
+      lldb_private::GetLogIfAllCategoriesSet(LIBLLDB_LOG_EXPRESSIONS));
+
+  if (log) {
+    std::string s;
+    raw_string_ostream oss(s);
+
+    module.print(oss, NULL);
+
+    oss.flush();
+
+    log->Printf("Module as passed in to IRInterpreter::Interpret: \n\"%s\"",
+                s.c_str());
+  }
+
+  DataLayout data_layout(&module);
+
+  InterpreterStackFrame frame(data_layout, execution_unit, stack_frame_bottom,
+                              stack_frame_top);
+
+  if (frame.m_frame_process_address == LLDB_INVALID_ADDRESS) {
+    error.SetErrorString("Couldn't allocate stack frame");
+  }
+
+  int arg_index = 0;
+
+  for (llvm::Function::arg_iterator ai = function.arg_begin(),
+                                    ae = function.arg_end();
+       ai != ae; ++ai, ++arg_index) {
+    if (args.size() <= static_cast<size_t>(arg_index)) {
+      error.SetErrorString("Not enough arguments passed in to function");
+      return false;
+    }
+
+    lldb::addr_t ptr = args[arg_index];
+
+    frame.MakeArgument(&*ai, ptr);
+  }
+
+  uint32_t num_insts = 0;
+
+  return InterpretFunction(module, function, frame, data_layout,
+                           execution_unit, error, exe_ctx, num_insts, 0);
+}
@@ -26,6 +26,7 @@
 #include "lldb/Expression/IRInterpreter.h"
 #include "lldb/Expression/Materializer.h"
 #include "lldb/Expression/UserExpression.h"
+#include "lldb/Expression/UserExpressionCache.h"
 #include "lldb/Host/HostInfo.h"
 #include "lldb/Symbol/Block.h"
 #include "lldb/Symbol/Function.h"
@@ -208,23 +209,47 @@ lldb::ExpressionResults UserExpression::Evaluate(
       language = frame->GetLanguage();
   }
 
-  lldb::UserExpressionSP user_expression_sp(
-      target->GetUserExpressionForLanguage(expr, full_prefix, language,
-                                           desired_type, options, error));
-  if (error.Fail()) {
-    if (log)
-      log->Printf("== [UserExpression::Evaluate] Getting expression: %s ==",
-                  error.AsCString());
-    return lldb::eExpressionSetupError;
+  const bool keep_expression_in_memory = true;
+  const bool generate_debug_info = options.GetGenerateDebugInfo();
+
+  // Expressions that declare things, or that may refer to persistent
+  // variables and types which can be redefined at any time, are always
+  // parsed from scratch.
+  const size_t expression_cache_size = target->GetExpressionCacheSize();
+  const bool use_expression_cache =
+      expression_cache_size > 0 &&
+      execution_policy != eExecutionPolicyTopLevel &&
+      !options.GetREPLEnabled() &&
+      expr.find('$') == llvm::StringRef::npos &&
+      full_prefix.find('$') == llvm::StringRef::npos;
+  UserExpressionCache::Key cache_key = {expr.str(), full_prefix.str(),
+                                        language,   desired_type,
+                                        execution_policy, generate_debug_info};
+
+  lldb::UserExpressionSP user_expression_sp;
+  if (use_expression_cache)
+    user_expression_sp =
+        target->GetUserExpressionCache().Take(cache_key, exe_ctx);
+  else if (execution_policy == eExecutionPolicyTopLevel)
+    target->GetUserExpressionCache().Clear();
+  const bool parsed_from_cache = (bool)user_expression_sp;
+
+  if (!parsed_from_cache) {
+    user_expression_sp.reset(target->GetUserExpressionForLanguage(
+        expr, full_prefix, language, desired_type, options, error));
+    if (error.Fail()) {
+      if (log)
+        log->Printf("== [UserExpression::Evaluate] Getting expression: %s ==",
+                    error.AsCString());
+      return lldb::eExpressionSetupError;
+    }
   }
 
   if (log)
-    log->Printf("== [UserExpression::Evaluate] Parsing expression %s ==",
+    log->Printf("== [UserExpression::Evaluate] %s expression %s ==",
+                parsed_from_cache ? "Reusing parsed" : "Parsing",
                 expr.str().c_str());
 
-  const bool keep_expression_in_memory = true;
-  const bool generate_debug_info = options.GetGenerateDebugInfo();
-
   if (options.InvokeCancelCallback(lldb::eExpressionEvaluationParse)) {
     error.SetErrorString("expression interrupted by callback before parse");
     result_valobj_sp = ValueObjectConstResult::Create(
@@ -235,6 +260,7 @@ lldb::ExpressionResults UserExpression::Evaluate(
   DiagnosticManager diagnostic_manager;
 
   bool parse_success =
+      parsed_from_cache ||
       user_expression_sp->Parse(diagnostic_manager, exe_ctx, execution_policy,
                                 keep_expression_in_memory, generate_debug_info);
 
@@ -293,6 +319,11 @@ lldb::ExpressionResults UserExpression::Evaluate(
     if (jit_module_sp_ptr)
       *jit_module_sp_ptr = user_expression_sp->GetJITModule();
 
+    // Only the expression that was parsed from the original text can be
+    // reused; expressions with fix-its applied have different text.
+    const bool can_cache_expression =
+        use_expression_cache && fixed_expression->empty();
+
     lldb::ExpressionVariableSP expr_result;
 
     if (execution_policy == eExecutionPolicyNever &&
@@ -338,6 +369,12 @@ lldb::ExpressionResults UserExpression::Evaluate(
           error.SetExpressionError(execution_results,
                                    diagnostic_manager.GetString().c_str());
       } else {
+        // An expression that didn't complete may still be referenced by a
+        // thread plan, so only completed ones go back into the cache.
+        if (can_cache_expression)
+          target->GetUserExpressionCache().Add(cache_key, user_expression_sp,
+                                               expression_cache_size);
+
         if (expr_result) {
           result_valobj_sp = expr_result->GetValueObject();
 
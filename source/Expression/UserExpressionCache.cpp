@@ -0,0 +1,84 @@
+//===-- UserExpressionCache.cpp ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Expression/UserExpressionCache.h"
+
+// C Includes
+// C++ Includes
+#include <vector>
+
+// Other libraries and framework includes
+// Project includes
+#include "lldb/Expression/UserExpression.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+bool UserExpressionCache::Key::operator==(const Key &rhs) const {
+  return expr == rhs.expr && prefix == rhs.prefix &&
+         language == rhs.language && desired_type == rhs.desired_type &&
+         execution_policy == rhs.execution_policy &&
+         generate_debug_info == rhs.generate_debug_info;
+}
+
+UserExpressionCache::UserExpressionCache()
+    : m_mutex(), m_entries(), m_hits(0), m_misses(0) {}
+
+UserExpressionCache::~UserExpressionCache() = default;
+
+UserExpressionSP UserExpressionCache::Take(const Key &key,
+                                           ExecutionContext &exe_ctx) {
+  // Checking the context looks up the frame's symbol context, which takes
+  // module locks, so only collect the candidates while holding our mutex.
+  std::vector<UserExpressionSP> candidates;
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (const auto &entry : m_entries) {
+      if (entry.first == key)
+        candidates.push_back(entry.second);
+    }
+  }
+
+  for (const UserExpressionSP &expr_sp : candidates) {
+    if (!expr_sp->MatchesContext(exe_ctx))
+      continue;
+
+    // Another thread may have taken this expression, or the cache may have
+    // been cleared, while we weren't holding the mutex.
+    std::lock_guard<std::mutex> guard(m_mutex);
+    for (auto pos = m_entries.begin(), end = m_entries.end(); pos != end;
+         ++pos) {
+      if (pos->second == expr_sp) {
+        m_entries.erase(pos);
+        ++m_hits;
+        return expr_sp;
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  ++m_misses;
+  return UserExpressionSP();
+}
+
+void UserExpressionCache::Add(const Key &key, const UserExpressionSP &expr_sp,
+                              size_t max_entries) {
+  if (!expr_sp || max_entries == 0)
+    return;
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_entries.emplace_front(key, expr_sp);
+  while (m_entries.size() > max_entries)
+    m_entries.pop_back();
+}
+
+void UserExpressionCache::Clear() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_entries.clear();
+}
@@ -0,0 +1,73 @@
+//===-- DebugFileIndex.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Host/DebugFileIndex.h"
+
+#include "llvm/ADT/StringRef.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+
+using namespace lldb_private;
+
+DebugFileIndex &DebugFileIndex::GetInstance() {
+  static DebugFileIndex *g_index = new DebugFileIndex();
+  return *g_index;
+}
+
+void DebugFileIndex::Refresh(const std::string &path, Directory &directory) {
+  namespace fs = llvm::sys::fs;
+  fs::file_status status;
+  if (fs::status(path, status) || !fs::is_directory(status)) {
+    directory.exists = false;
+    directory.file_names.clear();
+    return;
+  }
+
+  const llvm::sys::TimePoint<> mod_time = status.getLastModificationTime();
+  if (directory.exists && directory.mod_time == mod_time)
+    return;
+
+  directory.exists = true;
+  directory.mod_time = mod_time;
+  directory.file_names.clear();
+  std::error_code EC;
+  for (fs::directory_iterator iter(path, EC), end; iter != end && !EC;
+       iter.increment(EC))
+    directory.file_names.insert(llvm::sys::path::filename(iter->path()).str());
+}
+
+FileSpec DebugFileIndex::FindBuildIDFile(const FileSpec &debug_dir,
+                                         const UUID &uuid) {
+  if (!uuid.IsValid())
+    return FileSpec();
+
+  // The first byte of the build ID names the directory, the rest the file.
+  // Both are lower case hex.
+  std::string uuid_str = llvm::StringRef(uuid.GetAsString("")).lower();
+  std::string path = debug_dir.GetPath() + "/.build-id/" +
+                     uuid_str.substr(0, 2);
+  std::string file_name = uuid_str.substr(2) + ".debug";
+
+  std::lock_guard<std::mutex> guard(m_mutex);
+  auto pos = m_directories.find(path);
+  if (pos == m_directories.end())
+    pos = m_directories.emplace(path, Directory()).first;
+  else if (pos->second.file_names.count(file_name))
+    return FileSpec(path + "/" + file_name, false);
+
+  Refresh(path, pos->second);
+  if (pos->second.file_names.count(file_name))
+    return FileSpec(path + "/" + file_name, false);
+  return FileSpec();
+}
+
+void DebugFileIndex::Clear() {
+  std::lock_guard<std::mutex> guard(m_mutex);
+  m_directories.clear();
+}
@@ -14,6 +14,8 @@
 #include "lldb/Host/common/NativeBreakpoint.h"
 #include "lldb/Host/common/SoftwareBreakpoint.h"
 
+#include <algorithm>
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -210,20 +212,30 @@ Error NativeBreakpointList::GetBreakpoint(lldb::addr_t addr,
 
 Error NativeBreakpointList::RemoveTrapsFromBuffer(lldb::addr_t addr, void *buf,
                                                   size_t size) const {
-  for (const auto &map : m_breakpoints) {
-    lldb::addr_t bp_addr = map.first;
-    // Breapoint not in range, ignore
-    if (bp_addr < addr || addr + size <= bp_addr)
-      continue;
-    const auto &bp_sp = map.second;
+  if (size == 0)
+    return Error();
+
+  // Start with the last breakpoint before the range, its opcode may extend
+  // into it.
+  auto pos = m_breakpoints.lower_bound(addr);
+  if (pos != m_breakpoints.begin())
+    --pos;
+  for (; pos != m_breakpoints.end() && pos->first < addr + size; ++pos) {
     // Not software breakpoint, ignore
-    if (!bp_sp->IsSoftwareBreakpoint())
+    if (!pos->second->IsSoftwareBreakpoint())
+      continue;
+    auto software_bp_sp =
+        std::static_pointer_cast<SoftwareBreakpoint>(pos->second);
+    const lldb::addr_t bp_addr = pos->first;
+    const lldb::addr_t bp_end = bp_addr + software_bp_sp->m_opcode_size;
+    // Breakpoint not in range, ignore
+    if (bp_end <= addr)
       continue;
-    auto software_bp_sp = std::static_pointer_cast<SoftwareBreakpoint>(bp_sp);
-    auto opcode_addr = static_cast<char *>(buf) + bp_addr - addr;
-    auto saved_opcodes = software_bp_sp->m_saved_opcodes;
-    auto opcode_size = software_bp_sp->m_opcode_size;
-    ::memcpy(opcode_addr, saved_opcodes, opcode_size);
+    const lldb::addr_t copy_addr = std::max(bp_addr, addr);
+    const lldb::addr_t copy_end = std::min(bp_end, addr + size);
+    ::memcpy(static_cast<char *>(buf) + (copy_addr - addr),
+             software_bp_sp->m_saved_opcodes + (copy_addr - bp_addr),
+             copy_end - copy_addr);
   }
   return Error();
 }
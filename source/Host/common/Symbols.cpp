@@ -12,6 +12,7 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Core/Timer.h"
+#include "lldb/Host/DebugFileIndex.h"
 #include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Target/Target.h"
 #include "lldb/Utility/DataBuffer.h"
@@ -221,15 +222,20 @@ FileSpec Symbols::LocateExecutableSymbolFile(const ModuleSpec &module_spec) {
 #endif
 #endif // LLVM_ON_WIN32
 
-    std::string uuid_str;
     const UUID &module_uuid = module_spec.GetUUID();
-    if (module_uuid.IsValid()) {
-      // Some debug files are stored in the .build-id directory like this:
-      //   /usr/lib/debug/.build-id/ff/e7fe727889ad82bb153de2ad065b2189693315.debug
-      uuid_str = module_uuid.GetAsString("");
-      uuid_str.insert(2, 1, '/');
-      uuid_str = uuid_str + ".debug";
-    }
+    auto matches_module = [&](const FileSpec &file_spec) {
+      if (llvm::sys::fs::equivalent(file_spec.GetPath(),
+                                    module_spec.GetFileSpec().GetPath()))
+        return false;
+      lldb_private::ModuleSpecList specs;
+      const size_t num_specs =
+          ObjectFile::GetModuleSpecifications(file_spec, 0, 0, specs);
+      assert(num_specs <= 1 &&
+             "Symbol Vendor supports only a single architecture");
+      ModuleSpec mspec;
+      return num_specs == 1 && specs.GetModuleSpecAtIndex(0, mspec) &&
+             mspec.GetUUID() == module_uuid;
+    };
 
     size_t num_directories = debug_file_search_paths.GetSize();
     for (size_t idx = 0; idx < num_directories; ++idx) {
@@ -238,12 +244,19 @@ FileSpec Symbols::LocateExecutableSymbolFile(const ModuleSpec &module_spec) {
       if (!llvm::sys::fs::is_directory(dirspec.GetPath()))
         continue;
 
+      // Some debug files are stored in the .build-id directory like this:
+      //   /usr/lib/debug/.build-id/ff/e7fe727889ad82bb153de2ad065b2189693315.debug
+      // Those are looked up in an index rather than on disk.
+      FileSpec build_id_spec =
+          DebugFileIndex::GetInstance().FindBuildIDFile(dirspec, module_uuid);
+      if (build_id_spec && matches_module(build_id_spec))
+        return build_id_spec;
+
       std::vector<std::string> files;
       std::string dirname = dirspec.GetPath();
 
       files.push_back(dirname + "/" + symbol_filename);
       files.push_back(dirname + "/.debug/" + symbol_filename);
-      files.push_back(dirname + "/.build-id/" + uuid_str);
 
       // Some debug files may stored in the module directory like this:
       //   /usr/lib/debug/usr/lib/library.so.debug
@@ -254,25 +267,8 @@ FileSpec Symbols::LocateExecutableSymbolFile(const ModuleSpec &module_spec) {
       for (size_t idx_file = 0; idx_file < num_files; ++idx_file) {
         const std::string &filename = files[idx_file];
         FileSpec file_spec(filename, true);
-
-        if (llvm::sys::fs::equivalent(file_spec.GetPath(),
-                                      module_spec.GetFileSpec().GetPath()))
-          continue;
-
-        if (file_spec.Exists()) {
-          lldb_private::ModuleSpecList specs;
-          const size_t num_specs =
-              ObjectFile::GetModuleSpecifications(file_spec, 0, 0, specs);
-          assert(num_specs <= 1 &&
-                 "Symbol Vendor supports only a single architecture");
-          if (num_specs == 1) {
-            ModuleSpec mspec;
-            if (specs.GetModuleSpecAtIndex(0, mspec)) {
-              if (mspec.GetUUID() == module_uuid)
-                return file_spec;
-            }
-          }
-        }
+        if (file_spec.Exists() && matches_module(file_spec))
+          return file_spec;
       }
     }
   }
@@ -9,13 +9,22 @@
 
 #include "lldb/Host/posix/MainLoopPosix.h"
 #include "lldb/Utility/Error.h"
+#include "llvm/ADT/StringRef.h"
 #include <algorithm>
 #include <cassert>
 #include <cerrno>
 #include <csignal>
+#include <cstdlib>
 #include <sys/select.h>
+#include <unistd.h>
 #include <vector>
 
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#define MAINLOOP_HAVE_EPOLL 1
+#endif
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -26,9 +35,36 @@ static void SignalHandler(int signo, siginfo_t *info, void *) {
   g_signal_flags[signo] = 1;
 }
 
+MainLoopPosix::Backend MainLoopPosix::GetDefaultBackend() {
+#ifdef MAINLOOP_HAVE_EPOLL
+  const char *backend = ::getenv("LLDB_MAINLOOP_BACKEND");
+  if (backend && llvm::StringRef(backend) == "pselect")
+    return Backend::PSelect;
+  return Backend::EPoll;
+#else
+  return Backend::PSelect;
+#endif
+}
+
+MainLoopPosix::MainLoopPosix(Backend backend)
+    : m_backend(Backend::PSelect), m_epoll_fd(-1), m_signal_fd(-1),
+      m_terminate_request(false) {
+#ifdef MAINLOOP_HAVE_EPOLL
+  if (backend == Backend::EPoll) {
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (m_epoll_fd != -1)
+      m_backend = Backend::EPoll;
+  }
+#endif
+}
+
 MainLoopPosix::~MainLoopPosix() {
   assert(m_read_fds.size() == 0);
   assert(m_signals.size() == 0);
+  if (m_signal_fd != -1)
+    close(m_signal_fd);
+  if (m_epoll_fd != -1)
+    close(m_epoll_fd);
 }
 
 MainLoopPosix::ReadHandleUP
@@ -39,14 +75,27 @@ MainLoopPosix::RegisterReadObject(const IOObjectSP &object_sp,
     return nullptr;
   }
 
-  const bool inserted =
-      m_read_fds.insert({object_sp->GetWaitableHandle(), callback}).second;
+  const IOObject::WaitableHandle fd = object_sp->GetWaitableHandle();
+  const bool inserted = m_read_fds.insert({fd, callback}).second;
   if (!inserted) {
     error.SetErrorStringWithFormat("File descriptor %d already monitored.",
-                                   object_sp->GetWaitableHandle());
+                                   fd);
     return nullptr;
   }
 
+#ifdef MAINLOOP_HAVE_EPOLL
+  if (m_backend == Backend::EPoll) {
+    struct epoll_event event = {};
+    event.events = EPOLLIN;
+    event.data.fd = fd;
+    if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, fd, &event) == -1) {
+      error.SetErrorToErrno();
+      m_read_fds.erase(fd);
+      return nullptr;
+    }
+  }
+#endif
+
   return CreateReadHandle(object_sp);
 }
 
@@ -87,6 +136,16 @@ MainLoopPosix::RegisterSignal(int signo, const Callback &callback,
   m_signals.insert({signo, info});
   g_signal_flags[signo] = 0;
 
+  // The signal stays blocked while the epoll backend waits, it is picked up
+  // through the signalfd instead.
+  if (m_backend == Backend::EPoll) {
+    error = UpdateSignalFD();
+    if (error.Fail()) {
+      UnregisterSignal(signo);
+      return nullptr;
+    }
+  }
+
   return SignalHandleUP(new SignalHandle(*this, signo));
 }
 
@@ -94,6 +153,13 @@ void MainLoopPosix::UnregisterReadObject(IOObject::WaitableHandle handle) {
   bool erased = m_read_fds.erase(handle);
   UNUSED_IF_ASSERT_DISABLED(erased);
   assert(erased);
+
+#ifdef MAINLOOP_HAVE_EPOLL
+  // This fails if the descriptor was closed already, which removed it from
+  // the epoll set anyway.
+  if (m_backend == Backend::EPoll)
+    epoll_ctl(m_epoll_fd, EPOLL_CTL_DEL, handle, nullptr);
+#endif
 }
 
 void MainLoopPosix::UnregisterSignal(int signo) {
@@ -110,14 +176,76 @@ void MainLoopPosix::UnregisterSignal(int signo) {
                   nullptr);
 
   m_signals.erase(it);
+
+  if (m_backend == Backend::EPoll)
+    UpdateSignalFD();
+}
+
+Error MainLoopPosix::UpdateSignalFD() {
+#ifdef MAINLOOP_HAVE_EPOLL
+  sigset_t mask;
+  sigemptyset(&mask);
+  for (const auto &sig : m_signals)
+    sigaddset(&mask, sig.first);
+
+  if (m_signal_fd != -1) {
+    if (signalfd(m_signal_fd, &mask, 0) == -1)
+      return Error(errno, eErrorTypePOSIX);
+    return Error();
+  }
+
+  if (m_signals.empty())
+    return Error();
+
+  m_signal_fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+  if (m_signal_fd == -1)
+    return Error(errno, eErrorTypePOSIX);
+
+  struct epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.fd = m_signal_fd;
+  if (epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_signal_fd, &event) == -1) {
+    Error error(errno, eErrorTypePOSIX);
+    close(m_signal_fd);
+    m_signal_fd = -1;
+    return error;
+  }
+  return Error();
+#else
+  return Error("signalfd is not supported on this platform");
+#endif
+}
+
+bool MainLoopPosix::DispatchSignals(const std::vector<int> &signals) {
+  for (int sig : signals) {
+    if (g_signal_flags[sig] == 0)
+      continue; // No signal
+    g_signal_flags[sig] = 0;
+
+    auto it = m_signals.find(sig);
+    if (it == m_signals.end())
+      continue; // Signal must have gotten unregistered in the meantime
+
+    it->second.callback(*this); // Do the work
+
+    if (m_terminate_request)
+      return true;
+  }
+  return false;
 }
 
 Error MainLoopPosix::Run() {
+  m_terminate_request = false;
+  if (m_backend == Backend::EPoll)
+    return RunEPoll();
+  return RunPSelect();
+}
+
+Error MainLoopPosix::RunPSelect() {
   std::vector<int> signals;
   sigset_t sigmask;
   std::vector<int> read_fds;
   fd_set read_fd_set;
-  m_terminate_request = false;
 
   // run until termination or until we run out of things to listen to
   while (!m_terminate_request && (!m_read_fds.empty() || !m_signals.empty())) {
@@ -148,25 +276,66 @@ Error MainLoopPosix::Run() {
         errno != EINTR)
       return Error(errno, eErrorTypePOSIX);
 
-    for (int sig : signals) {
-      if (g_signal_flags[sig] == 0)
-        continue; // No signal
-      g_signal_flags[sig] = 0;
+    if (DispatchSignals(signals))
+      return Error();
 
-      auto it = m_signals.find(sig);
-      if (it == m_signals.end())
-        continue; // Signal must have gotten unregistered in the meantime
+    for (int fd : read_fds) {
+      if (!FD_ISSET(fd, &read_fd_set))
+        continue; // Not ready
 
-      it->second.callback(*this); // Do the work
+      auto it = m_read_fds.find(fd);
+      if (it == m_read_fds.end())
+        continue; // File descriptor must have gotten unregistered in the
+                  // meantime
+
+      it->second(*this); // Do the work
 
       if (m_terminate_request)
         return Error();
     }
+  }
+  return Error();
+}
 
-    for (int fd : read_fds) {
-      if (!FD_ISSET(fd, &read_fd_set))
-        continue; // Not ready
+Error MainLoopPosix::RunEPoll() {
+#ifdef MAINLOOP_HAVE_EPOLL
+  const int k_max_events = 64;
+  struct epoll_event events[k_max_events];
+  std::vector<int> signals;
+  std::vector<int> read_fds;
+
+  // run until termination or until we run out of things to listen to
+  while (!m_terminate_request && (!m_read_fds.empty() || !m_signals.empty())) {
+    int num_events = epoll_wait(m_epoll_fd, events, k_max_events, -1);
+    if (num_events == -1) {
+      if (errno != EINTR)
+        return Error(errno, eErrorTypePOSIX);
+      num_events = 0;
+    }
 
+    read_fds.clear();
+    for (int i = 0; i < num_events; ++i) {
+      if (events[i].data.fd != m_signal_fd) {
+        read_fds.push_back(events[i].data.fd);
+        continue;
+      }
+
+      struct signalfd_siginfo info;
+      while (read(m_signal_fd, &info, sizeof(info)) == sizeof(info)) {
+        if (info.ssi_signo < NSIG)
+          g_signal_flags[info.ssi_signo] = 1;
+      }
+    }
+
+    // A handler running on another thread can also have flagged a signal,
+    // so check all of them, not just the ones read from the signalfd.
+    signals.clear();
+    for (const auto &sig : m_signals)
+      signals.push_back(sig.first);
+    if (DispatchSignals(signals))
+      return Error();
+
+    for (int fd : read_fds) {
       auto it = m_read_fds.find(fd);
       if (it == m_read_fds.end())
         continue; // File descriptor must have gotten unregistered in the
@@ -179,4 +348,7 @@ Error MainLoopPosix::Run() {
     }
   }
   return Error();
+#else
+  return Error("epoll is not supported on this platform");
+#endif
 }
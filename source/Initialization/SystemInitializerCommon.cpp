@@ -122,4 +122,5 @@ void SystemInitializerCommon::Terminate() {
 
   HostInfo::Terminate();
   Log::DisableAllLogChannels();
+  Log::Terminate();
 }
@@ -45,6 +45,8 @@
 
 #include "lldb/Utility/RegularExpression.h"
 
+#include <atomic>
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -763,11 +765,7 @@ public:
 
   bool ParseOperands(
       llvm::SmallVectorImpl<Instruction::Operand> &operands) override {
-    const char *operands_string = GetOperands(nullptr);
-
-    if (!operands_string) {
-      return false;
-    }
+    const std::string operands_string = GetOperands(nullptr);
 
     llvm::StringRef operands_ref(operands_string);
 
@@ -874,9 +872,11 @@ public:
 
 protected:
   std::weak_ptr<DisassemblerLLVMC> m_disasm_wp;
-  LazyBool m_does_branch;
-  LazyBool m_has_delay_slot;
-  LazyBool m_is_call;
+  // Cached instructions are shared between threads. These are computed with
+  // the disassembler locked, and checked without taking the lock.
+  std::atomic<LazyBool> m_does_branch;
+  std::atomic<LazyBool> m_has_delay_slot;
+  std::atomic<LazyBool> m_is_call;
   bool m_is_valid;
   bool m_using_file_addr;
 };
@@ -404,7 +404,12 @@ void DynamicLoaderPOSIXDYLD::RefreshModules() {
   if (m_rendezvous.ModulesDidLoad()) {
     ModuleList new_modules;
 
+    std::vector<FileSpec> module_names;
     E = m_rendezvous.loaded_end();
+    for (I = m_rendezvous.loaded_begin(); I != E; ++I)
+      module_names.push_back(I->file_spec);
+    PreloadModules(module_names);
+
     for (I = m_rendezvous.loaded_begin(); I != E; ++I) {
       ModuleSP module_sp =
           LoadModuleAtAddress(I->file_spec, I->link_addr, I->base_addr, true);
@@ -516,6 +521,7 @@ void DynamicLoaderPOSIXDYLD::LoadAllCurrentModules() {
     module_names.push_back(I->file_spec);
   m_process->PrefetchModuleSpecs(
       module_names, m_process->GetTarget().GetArchitecture().GetTriple());
+  PreloadModules(module_names);
 
   for (I = m_rendezvous.begin(), E = m_rendezvous.end(); I != E; ++I) {
     ModuleSP module_sp =
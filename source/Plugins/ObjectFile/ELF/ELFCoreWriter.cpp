@@ -0,0 +1,499 @@
+//===-- ELFCoreWriter.cpp ---------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "ELFCoreWriter.h"
+
+#include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/RegisterValue.h"
+#include "lldb/Host/File.h"
+#include "lldb/Interpreter/Args.h"
+#include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StopInfo.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+#include "lldb/Target/ThreadList.h"
+#include "lldb/Utility/DataBuffer.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Logging.h"
+#include "lldb/Utility/StreamString.h"
+
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/Support/ELF.h"
+#include "llvm/Support/MathExtras.h"
+
+#include <algorithm>
+#include <future>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+
+// Linux core note types, as read by ProcessElfCore.
+enum {
+  NT_PRSTATUS = 1,
+  NT_PRPSINFO = 3,
+  NT_AUXV = 6,
+  NT_FILE = 0x46494c45,
+};
+
+// Sizes of the 64-bit elf_prstatus (without the registers) and elf_prpsinfo
+// structures. See ELFLinuxPrStatus and ELFLinuxPrPsInfo in ThreadElfCore.h.
+const size_t k_prstatus_size = 112;
+const size_t k_prpsinfo_size = 136;
+
+const size_t k_ehdr_size = 64;
+const size_t k_phdr_size = 56;
+const size_t k_page_size = 0x1000;
+
+// Memory is copied to the core file in chunks of this size. The next chunk
+// is read from the process while the previous one is being written.
+const size_t k_chunk_size = 1024 * 1024;
+
+// The general purpose registers in the order of the kernel's
+// user_regs_struct, which is what NT_PRSTATUS notes contain.
+const char *const g_x86_64_gpr_names[] = {
+    "r15", "r14",    "r13", "r12", "rbp",     "rbx",     "r11",
+    "r10", "r9",     "r8",  "rax", "rcx",     "rdx",     "rsi",
+    "rdi", "orig_rax", "rip", "cs", "rflags", "rsp",     "ss",
+    "fs_base", "gs_base", "ds", "es", "fs",   "gs"};
+
+const char *const g_arm64_gpr_names[] = {
+    "x0",  "x1",  "x2",  "x3",  "x4",  "x5",  "x6",  "x7",  "x8",
+    "x9",  "x10", "x11", "x12", "x13", "x14", "x15", "x16", "x17",
+    "x18", "x19", "x20", "x21", "x22", "x23", "x24", "x25", "x26",
+    "x27", "x28", "fp",  "lr",  "sp",  "pc",  "cpsr"};
+
+struct CoreSegment {
+  addr_t vaddr;
+  addr_t size;
+  uint32_t flags;
+  bool save_contents;
+  uint64_t offset;
+};
+
+struct FileMapping {
+  addr_t start;
+  addr_t end;
+  std::string path;
+};
+
+} // namespace
+
+static llvm::ArrayRef<const char *> GetGPRNames(const ArchSpec &arch,
+                                                uint16_t &machine) {
+  switch (arch.GetMachine()) {
+  case llvm::Triple::x86_64:
+    machine = llvm::ELF::EM_X86_64;
+    return g_x86_64_gpr_names;
+  case llvm::Triple::aarch64:
+    machine = llvm::ELF::EM_AARCH64;
+    return g_arm64_gpr_names;
+  default:
+    machine = llvm::ELF::EM_NONE;
+    return llvm::ArrayRef<const char *>();
+  }
+}
+
+static void PadTo(StreamString &strm, size_t alignment) {
+  while (strm.GetSize() % alignment)
+    strm.PutHex8(0);
+}
+
+static void PutNote(StreamString &notes, uint32_t type, llvm::StringRef name,
+                    llvm::StringRef desc) {
+  notes.PutHex32(name.size() + 1);
+  notes.PutHex32(desc.size());
+  notes.PutHex32(type);
+  notes.PutRawBytes(name.data(), name.size());
+  notes.PutHex8(0);
+  PadTo(notes, 4);
+  notes.PutRawBytes(desc.data(), desc.size());
+  PadTo(notes, 4);
+}
+
+static void PutFixedString(StreamString &strm, llvm::StringRef str,
+                           size_t size) {
+  str = str.take_front(size - 1);
+  strm.PutRawBytes(str.data(), str.size());
+  for (size_t i = str.size(); i < size; ++i)
+    strm.PutHex8(0);
+}
+
+static std::string GetPrStatus(Thread &thread, const ArchSpec &arch,
+                               llvm::ArrayRef<const char *> gpr_names) {
+  StreamString desc(Stream::eBinary, arch.GetAddressByteSize(),
+                    arch.GetByteOrder());
+
+  int32_t signo = 0;
+  StopInfoSP stop_info_sp = thread.GetStopInfo();
+  if (stop_info_sp && stop_info_sp->GetStopReason() == eStopReasonSignal)
+    signo = stop_info_sp->GetValue();
+
+  desc.PutHex32(signo); // si_signo
+  desc.PutHex32(0);     // si_code
+  desc.PutHex32(0);     // si_errno
+  desc.PutHex16(signo); // pr_cursig
+  PadTo(desc, 8);
+  desc.PutHex64(0); // pr_sigpend
+  desc.PutHex64(0); // pr_sighold
+  desc.PutHex32(thread.GetProtocolID()); // pr_pid
+  desc.PutHex32(0);                      // pr_ppid
+  desc.PutHex32(0);                      // pr_pgrp
+  desc.PutHex32(0);                      // pr_sid
+  while (desc.GetSize() < k_prstatus_size)
+    desc.PutHex8(0); // pr_utime, pr_stime, pr_cutime, pr_cstime
+
+  RegisterContextSP reg_ctx_sp = thread.GetRegisterContext();
+  for (const char *name : gpr_names) {
+    uint64_t value = 0;
+    if (reg_ctx_sp) {
+      const RegisterInfo *reg_info = reg_ctx_sp->GetRegisterInfoByName(name);
+      RegisterValue reg_value;
+      if (reg_info && reg_ctx_sp->ReadRegister(reg_info, reg_value))
+        value = reg_value.GetAsUInt64();
+    }
+    desc.PutHex64(value);
+  }
+
+  desc.PutHex32(0); // pr_fpvalid
+  PadTo(desc, 8);
+  return desc.GetString();
+}
+
+static std::string GetPrPsInfo(Process &process, const ArchSpec &arch) {
+  StreamString desc(Stream::eBinary, arch.GetAddressByteSize(),
+                    arch.GetByteOrder());
+
+  ProcessInstanceInfo info;
+  process.GetProcessInfo(info);
+
+  std::string fname;
+  if (Module *exe_module = process.GetTarget().GetExecutableModulePointer())
+    fname = exe_module->GetFileSpec().GetFilename().GetStringRef();
+  std::string psargs;
+  info.GetArguments().GetCommandString(psargs);
+
+  desc.PutHex8(0);   // pr_state
+  desc.PutHex8('t'); // pr_sname, stopped by the debugger
+  desc.PutHex8(0);   // pr_zomb
+  desc.PutHex8(0);   // pr_nice
+  PadTo(desc, 8);
+  desc.PutHex64(0); // pr_flag
+  desc.PutHex32(info.UserIDIsValid() ? info.GetUserID() : 0);
+  desc.PutHex32(info.GroupIDIsValid() ? info.GetGroupID() : 0);
+  desc.PutHex32(process.GetID());
+  desc.PutHex32(info.ParentProcessIDIsValid() ? info.GetParentProcessID()
+                                              : 0);
+  desc.PutHex32(0); // pr_pgrp
+  desc.PutHex32(0); // pr_sid
+  PutFixedString(desc, fname, 16);
+  PutFixedString(desc, psargs, 80);
+  assert(desc.GetSize() == k_prpsinfo_size);
+  return desc.GetString();
+}
+
+static std::string GetFileMappings(const ArchSpec &arch,
+                                   llvm::ArrayRef<FileMapping> mappings) {
+  StreamString desc(Stream::eBinary, arch.GetAddressByteSize(),
+                    arch.GetByteOrder());
+
+  desc.PutHex64(mappings.size());
+  desc.PutHex64(k_page_size);
+  for (const FileMapping &mapping : mappings) {
+    desc.PutHex64(mapping.start);
+    desc.PutHex64(mapping.end);
+    desc.PutHex64(0); // File offset, in pages; we don't know it.
+  }
+  for (const FileMapping &mapping : mappings) {
+    desc.PutRawBytes(mapping.path.c_str(), mapping.path.size());
+    desc.PutHex8(0);
+  }
+  return desc.GetString();
+}
+
+static bool IsZero(const uint8_t *bytes, size_t size) {
+  return std::all_of(bytes, bytes + size, [](uint8_t b) { return b == 0; });
+}
+
+// Write a chunk of memory at the given file offset, skipping pages that only
+// contain zeros so that they are left as holes in the (sparse) core file.
+static Error WriteChunk(File &core_file, const uint8_t *bytes, size_t size,
+                        uint64_t offset) {
+  size_t pos = 0;
+  while (pos < size) {
+    size_t end = std::min(pos + k_page_size, size);
+    if (IsZero(bytes + pos, end - pos)) {
+      pos = end;
+      continue;
+    }
+
+    // Write consecutive non-zero pages at once.
+    while (end < size) {
+      const size_t next = std::min(end + k_page_size, size);
+      if (IsZero(bytes + end, next - end))
+        break;
+      end = next;
+    }
+
+    size_t num_bytes = end - pos;
+    off_t write_offset = offset + pos;
+    Error error = core_file.Write(bytes + pos, num_bytes, write_offset);
+    if (error.Fail())
+      return error;
+    pos = end;
+  }
+  return Error();
+}
+
+static Error WriteSegments(Process &process, File &core_file,
+                           llvm::ArrayRef<CoreSegment> segments) {
+  std::vector<uint8_t> buffers[2];
+  buffers[0].resize(k_chunk_size);
+  buffers[1].resize(k_chunk_size);
+  unsigned current = 0;
+
+  Error error;
+  std::future<Error> pending_write;
+
+  for (const CoreSegment &segment : segments) {
+    if (!segment.save_contents)
+      continue;
+
+    for (addr_t done = 0; done < segment.size; done += k_chunk_size) {
+      const size_t size =
+          std::min<addr_t>(k_chunk_size, segment.size - done);
+      uint8_t *bytes = buffers[current].data();
+      process.ReadMemoryZeroFillingGaps(segment.vaddr + done, bytes, size);
+
+      if (pending_write.valid())
+        error = pending_write.get();
+      if (error.Fail())
+        return error;
+
+      pending_write =
+          std::async(std::launch::async, WriteChunk, std::ref(core_file),
+                     bytes, size, segment.offset + done);
+      current ^= 1;
+    }
+  }
+
+  if (pending_write.valid())
+    error = pending_write.get();
+  return error;
+}
+
+bool lldb_private::SaveELFCore(const ProcessSP &process_sp,
+                               const FileSpec &outfile, SaveCoreStyle style,
+                               Error &error) {
+  if (!process_sp)
+    return false;
+
+  Target &target = process_sp->GetTarget();
+  const ArchSpec &arch = target.GetArchitecture();
+  if (arch.GetTriple().getOS() != llvm::Triple::Linux)
+    return false;
+
+  uint16_t machine;
+  llvm::ArrayRef<const char *> gpr_names = GetGPRNames(arch, machine);
+  if (gpr_names.empty()) {
+    error.SetErrorStringWithFormat("unsupported core architecture: %s",
+                                   arch.GetTriple().str().c_str());
+    return true;
+  }
+
+  Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_PROCESS));
+  const ByteOrder byte_order = arch.GetByteOrder();
+  const uint32_t addr_byte_size = arch.GetAddressByteSize();
+
+  std::vector<MemoryRegionInfoSP> regions;
+  error = process_sp->GetMemoryRegions(regions);
+  if (error.Fail())
+    return true;
+
+  std::string exe_path;
+  if (Module *exe_module = target.GetExecutableModulePointer())
+    exe_path = exe_module->GetFileSpec().GetPath();
+
+  // Put the selected thread first; that's the one that is selected when the
+  // core file is loaded.
+  std::vector<ThreadSP> threads;
+  ThreadList &thread_list = process_sp->GetThreadList();
+  ThreadSP selected_thread_sp = thread_list.GetSelectedThread();
+  if (selected_thread_sp)
+    threads.push_back(selected_thread_sp);
+  for (uint32_t i = 0, e = thread_list.GetSize(); i != e; ++i) {
+    ThreadSP thread_sp = thread_list.GetThreadAtIndex(i);
+    if (thread_sp && thread_sp != selected_thread_sp)
+      threads.push_back(thread_sp);
+  }
+  if (threads.empty()) {
+    error.SetErrorString("process has no threads");
+    return true;
+  }
+
+  std::vector<addr_t> stack_pointers;
+  for (const ThreadSP &thread_sp : threads) {
+    if (RegisterContextSP reg_ctx_sp = thread_sp->GetRegisterContext())
+      stack_pointers.push_back(reg_ctx_sp->GetSP());
+  }
+
+  std::vector<CoreSegment> segments;
+  std::vector<FileMapping> mappings;
+  for (const MemoryRegionInfoSP &region_sp : regions) {
+    const MemoryRegionInfo::RangeType &range = region_sp->GetRange();
+    if (region_sp->GetMapped() == MemoryRegionInfo::eNo ||
+        range.GetByteSize() == 0)
+      continue;
+
+    CoreSegment segment;
+    segment.vaddr = range.GetRangeBase();
+    segment.size = range.GetByteSize();
+    segment.flags = 0;
+    if (region_sp->GetReadable() == MemoryRegionInfo::eYes)
+      segment.flags |= llvm::ELF::PF_R;
+    if (region_sp->GetWritable() == MemoryRegionInfo::eYes)
+      segment.flags |= llvm::ELF::PF_W;
+    if (region_sp->GetExecutable() == MemoryRegionInfo::eYes)
+      segment.flags |= llvm::ELF::PF_X;
+    segment.save_contents = (segment.flags & llvm::ELF::PF_R) != 0;
+    segment.offset = 0;
+
+    // Mappings of files have their path as the region name, special regions
+    // like the stack and heap are named "[stack]", "[heap]", etc.
+    llvm::StringRef name = region_sp->GetName().GetStringRef();
+    if (name.startswith("/")) {
+      mappings.push_back({segment.vaddr, range.GetRangeEnd(), name.str()});
+      if (style == eSaveCoreDirtyOnly && !(segment.flags & llvm::ELF::PF_W))
+        segment.save_contents = false;
+    }
+    if (style == eSaveCoreStackOnly &&
+        std::none_of(stack_pointers.begin(), stack_pointers.end(),
+                     [&range](addr_t sp) { return range.Contains(sp); }))
+      segment.save_contents = false;
+    segments.push_back(segment);
+  }
+
+  // ProcessElfCore takes the first NT_FILE entry to be the executable.
+  std::stable_partition(
+      mappings.begin(), mappings.end(),
+      [&exe_path](const FileMapping &mapping) {
+        return mapping.path == exe_path;
+      });
+
+  StreamString notes(Stream::eBinary, addr_byte_size, byte_order);
+  for (size_t i = 0; i < threads.size(); ++i) {
+    PutNote(notes, NT_PRSTATUS, "CORE",
+            GetPrStatus(*threads[i], arch, gpr_names));
+    if (i != 0)
+      continue;
+
+    PutNote(notes, NT_PRPSINFO, "CORE", GetPrPsInfo(*process_sp, arch));
+    DataBufferSP auxv_sp = process_sp->GetAuxvData();
+    if (auxv_sp && auxv_sp->GetByteSize())
+      PutNote(notes, NT_AUXV, "CORE",
+              llvm::StringRef((const char *)auxv_sp->GetBytes(),
+                              auxv_sp->GetByteSize()));
+    if (!mappings.empty())
+      PutNote(notes, NT_FILE, "CORE", GetFileMappings(arch, mappings));
+  }
+
+  const size_t num_phdrs = segments.size() + 1;
+  if (num_phdrs >= llvm::ELF::PN_XNUM) {
+    error.SetErrorStringWithFormat("too many memory regions (%" PRIu64 ")",
+                                   (uint64_t)segments.size());
+    return true;
+  }
+
+  // Lay out the file: headers, notes, then the contents of each segment,
+  // page aligned.
+  const uint64_t notes_offset = k_ehdr_size + num_phdrs * k_phdr_size;
+  uint64_t file_size = notes_offset + notes.GetSize();
+  for (CoreSegment &segment : segments) {
+    if (!segment.save_contents)
+      continue;
+    segment.offset = llvm::alignTo(file_size, k_page_size);
+    file_size = segment.offset + segment.size;
+  }
+
+  StreamString header(Stream::eBinary, addr_byte_size, byte_order);
+  header.PutHex8(0x7f);
+  header.PutRawBytes("ELF", 3);
+  header.PutHex8(llvm::ELF::ELFCLASS64);
+  header.PutHex8(byte_order == eByteOrderLittle ? llvm::ELF::ELFDATA2LSB
+                                                : llvm::ELF::ELFDATA2MSB);
+  header.PutHex8(llvm::ELF::EV_CURRENT);
+  header.PutHex8(llvm::ELF::ELFOSABI_NONE);
+  PadTo(header, 16);
+  header.PutHex16(llvm::ELF::ET_CORE);
+  header.PutHex16(machine);
+  header.PutHex32(llvm::ELF::EV_CURRENT);
+  header.PutHex64(0);           // e_entry
+  header.PutHex64(k_ehdr_size); // e_phoff
+  header.PutHex64(0);           // e_shoff
+  header.PutHex32(0);           // e_flags
+  header.PutHex16(k_ehdr_size);
+  header.PutHex16(k_phdr_size);
+  header.PutHex16(num_phdrs);
+  header.PutHex16(0); // e_shentsize
+  header.PutHex16(0); // e_shnum
+  header.PutHex16(0); // e_shstrndx
+
+  header.PutHex32(llvm::ELF::PT_NOTE);
+  header.PutHex32(0);              // p_flags
+  header.PutHex64(notes_offset);   // p_offset
+  header.PutHex64(0);              // p_vaddr
+  header.PutHex64(0);              // p_paddr
+  header.PutHex64(notes.GetSize()); // p_filesz
+  header.PutHex64(0);              // p_memsz
+  header.PutHex64(4);              // p_align
+
+  for (const CoreSegment &segment : segments) {
+    header.PutHex32(llvm::ELF::PT_LOAD);
+    header.PutHex32(segment.flags);
+    header.PutHex64(segment.offset);
+    header.PutHex64(segment.vaddr);
+    header.PutHex64(0);
+    header.PutHex64(segment.save_contents ? segment.size : 0);
+    header.PutHex64(segment.size);
+    header.PutHex64(k_page_size);
+  }
+  header.PutRawBytes(notes.GetData(), notes.GetSize());
+
+  File core_file;
+  const std::string core_file_path = outfile.GetPath();
+  error = core_file.Open(core_file_path.c_str(),
+                         File::eOpenOptionWrite | File::eOpenOptionTruncate |
+                             File::eOpenOptionCanCreate);
+  if (error.Fail())
+    return true;
+
+  size_t bytes_written = header.GetSize();
+  error = core_file.Write(header.GetData(), bytes_written);
+  if (error.Success())
+    error = WriteSegments(*process_sp, core_file, segments);
+
+  // If the file ends in a hole, write its last byte so it has the full size.
+  if (error.Success() && core_file.SeekFromEnd(0) < (off_t)file_size) {
+    const uint8_t zero = 0;
+    size_t num_bytes = 1;
+    off_t offset = file_size - 1;
+    error = core_file.Write(&zero, num_bytes, offset);
+  }
+
+  if (log)
+    log->Printf("SaveELFCore: wrote %" PRIu64 " segments, %" PRIu64
+                " bytes to '%s': %s",
+                (uint64_t)segments.size(), file_size, core_file_path.c_str(),
+                error.Success() ? "success" : error.AsCString());
+  return true;
+}
@@ -0,0 +1,41 @@
+//===-- ELFCoreWriter.h -----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ELFCoreWriter_h_
+#define liblldb_ELFCoreWriter_h_
+
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// Save a Linux process as an ELF core file that ProcessElfCore can load.
+///
+/// @param[in] process_sp
+///     The stopped process to save.
+///
+/// @param[in] outfile
+///     The core file to create.
+///
+/// @param[in] style
+///     Which memory regions get their contents saved.
+///
+/// @param[out] error
+///     Set if writing the core file failed.
+///
+/// @return
+///     False if this isn't a process an ELF core file can be written for,
+///     true otherwise (even if writing failed, see \a error).
+//----------------------------------------------------------------------
+bool SaveELFCore(const lldb::ProcessSP &process_sp, const FileSpec &outfile,
+                 lldb::SaveCoreStyle style, Error &error);
+
+} // namespace lldb_private
+
+#endif // liblldb_ELFCoreWriter_h_
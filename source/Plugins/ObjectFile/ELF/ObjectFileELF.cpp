@@ -8,9 +8,13 @@
 //===----------------------------------------------------------------------===//
 
 #include "ObjectFileELF.h"
+#include "ELFCoreWriter.h"
 
 #include <algorithm>
 #include <cassert>
+#include <map>
+#include <mutex>
+#include <tuple>
 #include <unordered_map>
 
 #include "lldb/Core/ArchSpec.h"
@@ -20,10 +24,14 @@
 #include "lldb/Core/PluginManager.h"
 #include "lldb/Core/Section.h"
 #include "lldb/Core/Timer.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Symbol/DWARFCallFrameInfo.h"
 #include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Target/ModuleCache.h"
+#include "lldb/Target/Platform.h"
 #include "lldb/Target/SectionLoadList.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/DataBufferLLVM.h"
 #include "lldb/Utility/Error.h"
 #include "lldb/Utility/Log.h"
@@ -31,6 +39,7 @@
 
 #include "llvm/ADT/PointerUnion.h"
 #include "llvm/ADT/StringRef.h"
+#include "llvm/Object/Decompressor.h"
 #include "llvm/Support/ARMBuildAttributes.h"
 #include "llvm/Support/MathExtras.h"
 #include "llvm/Support/MemoryBuffer.h"
@@ -381,7 +390,8 @@ const uint32_t ObjectFileELF::g_core_uuid_magic(0xE210C);
 void ObjectFileELF::Initialize() {
   PluginManager::RegisterPlugin(GetPluginNameStatic(),
                                 GetPluginDescriptionStatic(), CreateInstance,
-                                CreateMemoryInstance, GetModuleSpecifications);
+                                CreateMemoryInstance, GetModuleSpecifications,
+                                SaveCore);
 }
 
 void ObjectFileELF::Terminate() {
@@ -463,6 +473,13 @@ ObjectFile *ObjectFileELF::CreateMemoryInstance(
   return NULL;
 }
 
+bool ObjectFileELF::SaveCore(const lldb::ProcessSP &process_sp,
+                             const lldb_private::FileSpec &outfile,
+                             lldb::SaveCoreStyle style,
+                             lldb_private::Error &error) {
+  return SaveELFCore(process_sp, outfile, style, error);
+}
+
 bool ObjectFileELF::MagicBytesMatch(DataBufferSP &data_sp,
                                     lldb::addr_t data_offset,
                                     lldb::addr_t data_length) {
@@ -537,6 +554,47 @@ static uint32_t calc_gnu_debuglink_crc32(const void *buf, size_t size) {
   return calc_crc32(0U, buf, size);
 }
 
+// Calculating the .gnu_debuglink CRC of a file means reading all of it, and
+// symbol file lookups check the same candidate files again for every module
+// that names them. Remember each file's CRC for as long as its size and
+// modification time stay the same.
+static uint32_t calc_gnu_debuglink_crc32(const FileSpec &file,
+                                         lldb::offset_t file_offset,
+                                         lldb::offset_t length) {
+  struct CRCEntry {
+    uint64_t file_size;
+    llvm::sys::TimePoint<> mod_time;
+    uint32_t crc;
+  };
+  typedef std::tuple<std::string, lldb::offset_t, lldb::offset_t> CRCKey;
+  static std::mutex g_crc_mutex;
+  static std::map<CRCKey, CRCEntry> g_crcs;
+
+  const uint64_t file_size = file.GetByteSize();
+  if (length == lldb::offset_t(-1) && file_size >= file_offset)
+    length = file_size - file_offset;
+  const CRCKey key(file.GetPath(), file_offset, length);
+  const llvm::sys::TimePoint<> mod_time = FileSystem::GetModificationTime(file);
+  {
+    std::lock_guard<std::mutex> guard(g_crc_mutex);
+    auto pos = g_crcs.find(key);
+    if (pos != g_crcs.end() && pos->second.file_size == file_size &&
+        pos->second.mod_time == mod_time)
+      return pos->second.crc;
+  }
+
+  auto data_sp = DataBufferLLVM::CreateSliceFromPath(std::get<0>(key), length,
+                                                     file_offset);
+  if (!data_sp)
+    return 0;
+  const uint32_t crc =
+      calc_gnu_debuglink_crc32(data_sp->GetBytes(), data_sp->GetByteSize());
+
+  std::lock_guard<std::mutex> guard(g_crc_mutex);
+  g_crcs[key] = CRCEntry{file_size, mod_time, crc};
+  return crc;
+}
+
 uint32_t ObjectFileELF::CalculateELFNotesSegmentsCRC32(
     const ProgramHeaderColl &program_headers, DataExtractor &object_data) {
   typedef ProgramHeaderCollConstIter Iter;
@@ -766,14 +824,9 @@ size_t ObjectFileELF::GetModuleSpecifications(
                 core_notes_crc =
                     CalculateELFNotesSegmentsCRC32(program_headers, data);
               } else {
-                // Need to map entire file into memory to calculate the crc.
-                data_sp = DataBufferLLVM::CreateSliceFromPath(file.GetPath(), -1,
-                                                         file_offset);
-                if (data_sp) {
-                  data.SetData(data_sp);
-                  gnu_debuglink_crc = calc_gnu_debuglink_crc32(
-                      data.GetDataStart(), data.GetByteSize());
-                }
+                // The crc covers the entire file.
+                gnu_debuglink_crc =
+                    calc_gnu_debuglink_crc32(file, file_offset, -1);
               }
             }
             if (gnu_debuglink_crc) {
@@ -1000,9 +1053,14 @@ bool ObjectFileELF::GetUUID(lldb_private::UUID *uuid) {
       m_uuid.SetBytes(uuidt, sizeof(uuidt));
     }
   } else {
-    if (!m_gnu_debuglink_crc)
-      m_gnu_debuglink_crc =
-          calc_gnu_debuglink_crc32(m_data.GetDataStart(), m_data.GetByteSize());
+    if (!m_gnu_debuglink_crc) {
+      if (!IsInMemory() && m_file)
+        m_gnu_debuglink_crc = calc_gnu_debuglink_crc32(m_file, m_file_offset,
+                                                       m_data.GetByteSize());
+      else
+        m_gnu_debuglink_crc = calc_gnu_debuglink_crc32(m_data.GetDataStart(),
+                                                       m_data.GetByteSize());
+    }
     if (m_gnu_debuglink_crc) {
       // Use 4 bytes of crc from the .gnu_debuglink section.
       uint32_t uuidt[4] = {m_gnu_debuglink_crc, 0, 0, 0};
@@ -1883,6 +1941,11 @@ void ObjectFileELF::CreateSections(SectionList &unified_section_list) {
       const ELFSectionHeaderInfo &header = *I;
 
       ConstString &name = I->section_name;
+      // GNU style compressed debug sections are named .zdebug_* rather than
+      // .debug_*, their contents are decompressed when they are read.
+      ConstString type_name = name;
+      if (name.GetStringRef().startswith(".zdebug_"))
+        type_name.SetString(("." + name.GetStringRef().drop_front(2)).str());
       const uint64_t file_size =
           header.sh_type == SHT_NOBITS ? 0 : header.sh_size;
       const uint64_t vm_size = header.sh_flags & SHF_ALLOC ? header.sh_size : 0;
@@ -1925,16 +1988,16 @@ void ObjectFileELF::CreateSections(SectionList &unified_section_list) {
 
       bool is_thread_specific = false;
 
-      if (name == g_sect_name_text)
+      if (type_name == g_sect_name_text)
         sect_type = eSectionTypeCode;
-      else if (name == g_sect_name_data)
+      else if (type_name == g_sect_name_data)
         sect_type = eSectionTypeData;
-      else if (name == g_sect_name_bss)
+      else if (type_name == g_sect_name_bss)
         sect_type = eSectionTypeZeroFill;
-      else if (name == g_sect_name_tdata) {
+      else if (type_name == g_sect_name_tdata) {
         sect_type = eSectionTypeData;
         is_thread_specific = true;
-      } else if (name == g_sect_name_tbss) {
+      } else if (type_name == g_sect_name_tbss) {
         sect_type = eSectionTypeZeroFill;
         is_thread_specific = true;
       }
@@ -1958,55 +2021,55 @@ void ObjectFileELF::CreateSections(SectionList &unified_section_list) {
       // http://src.chromium.org/viewvc/chrome/trunk/src/build/gdb-add-index?pathrev=144644
       // MISSING? .debug_types - Type descriptions from DWARF 4? See
       // http://gcc.gnu.org/wiki/DwarfSeparateTypeInfo
-      else if (name == g_sect_name_dwarf_debug_abbrev)
+      else if (type_name == g_sect_name_dwarf_debug_abbrev)
         sect_type = eSectionTypeDWARFDebugAbbrev;
-      else if (name == g_sect_name_dwarf_debug_addr)
+      else if (type_name == g_sect_name_dwarf_debug_addr)
         sect_type = eSectionTypeDWARFDebugAddr;
-      else if (name == g_sect_name_dwarf_debug_aranges)
+      else if (type_name == g_sect_name_dwarf_debug_aranges)
         sect_type = eSectionTypeDWARFDebugAranges;
-      else if (name == g_sect_name_dwarf_debug_frame)
+      else if (type_name == g_sect_name_dwarf_debug_frame)
         sect_type = eSectionTypeDWARFDebugFrame;
-      else if (name == g_sect_name_dwarf_debug_info)
+      else if (type_name == g_sect_name_dwarf_debug_info)
         sect_type = eSectionTypeDWARFDebugInfo;
-      else if (name == g_sect_name_dwarf_debug_line)
+      else if (type_name == g_sect_name_dwarf_debug_line)
         sect_type = eSectionTypeDWARFDebugLine;
-      else if (name == g_sect_name_dwarf_debug_loc)
+      else if (type_name == g_sect_name_dwarf_debug_loc)
         sect_type = eSectionTypeDWARFDebugLoc;
-      else if (name == g_sect_name_dwarf_debug_macinfo)
+      else if (type_name == g_sect_name_dwarf_debug_macinfo)
         sect_type = eSectionTypeDWARFDebugMacInfo;
-      else if (name == g_sect_name_dwarf_debug_macro)
+      else if (type_name == g_sect_name_dwarf_debug_macro)
         sect_type = eSectionTypeDWARFDebugMacro;
-      else if (name == g_sect_name_dwarf_debug_pubnames)
+      else if (type_name == g_sect_name_dwarf_debug_pubnames)
         sect_type = eSectionTypeDWARFDebugPubNames;
-      else if (name == g_sect_name_dwarf_debug_pubtypes)
+      else if (type_name == g_sect_name_dwarf_debug_pubtypes)
         sect_type = eSectionTypeDWARFDebugPubTypes;
-      else if (name == g_sect_name_dwarf_debug_ranges)
+      else if (type_name == g_sect_name_dwarf_debug_ranges)
         sect_type = eSectionTypeDWARFDebugRanges;
-      else if (name == g_sect_name_dwarf_debug_str)
+      else if (type_name == g_sect_name_dwarf_debug_str)
         sect_type = eSectionTypeDWARFDebugStr;
-      else if (name == g_sect_name_dwarf_debug_str_offsets)
+      else if (type_name == g_sect_name_dwarf_debug_str_offsets)
         sect_type = eSectionTypeDWARFDebugStrOffsets;
-      else if (name == g_sect_name_dwarf_debug_abbrev_dwo)
+      else if (type_name == g_sect_name_dwarf_debug_abbrev_dwo)
         sect_type = eSectionTypeDWARFDebugAbbrev;
-      else if (name == g_sect_name_dwarf_debug_info_dwo)
+      else if (type_name == g_sect_name_dwarf_debug_info_dwo)
         sect_type = eSectionTypeDWARFDebugInfo;
-      else if (name == g_sect_name_dwarf_debug_line_dwo)
+      else if (type_name == g_sect_name_dwarf_debug_line_dwo)
         sect_type = eSectionTypeDWARFDebugLine;
-      else if (name == g_sect_name_dwarf_debug_macro_dwo)
+      else if (type_name == g_sect_name_dwarf_debug_macro_dwo)
         sect_type = eSectionTypeDWARFDebugMacro;
-      else if (name == g_sect_name_dwarf_debug_loc_dwo)
+      else if (type_name == g_sect_name_dwarf_debug_loc_dwo)
         sect_type = eSectionTypeDWARFDebugLoc;
-      else if (name == g_sect_name_dwarf_debug_str_dwo)
+      else if (type_name == g_sect_name_dwarf_debug_str_dwo)
         sect_type = eSectionTypeDWARFDebugStr;
-      else if (name == g_sect_name_dwarf_debug_str_offsets_dwo)
+      else if (type_name == g_sect_name_dwarf_debug_str_offsets_dwo)
         sect_type = eSectionTypeDWARFDebugStrOffsets;
-      else if (name == g_sect_name_eh_frame)
+      else if (type_name == g_sect_name_eh_frame)
         sect_type = eSectionTypeEHFrame;
-      else if (name == g_sect_name_arm_exidx)
+      else if (type_name == g_sect_name_arm_exidx)
         sect_type = eSectionTypeARMexidx;
-      else if (name == g_sect_name_arm_extab)
+      else if (type_name == g_sect_name_arm_extab)
         sect_type = eSectionTypeARMextab;
-      else if (name == g_sect_name_go_symtab)
+      else if (type_name == g_sect_name_go_symtab)
         sect_type = eSectionTypeGoSymtab;
 
       const uint32_t permissions =
@@ -2130,11 +2193,43 @@ static char FindArmAarch64MappingSymbol(const char *symbol_name) {
 #define IS_MICROMIPS(ST_OTHER) (((ST_OTHER)&STO_MIPS_ISA) == STO_MICROMIPS)
 
 // private
+Mangled ObjectFileELF::DecodeSymbolName(const char *symbol_name) {
+  bool is_mangled = (symbol_name[0] == '_' && symbol_name[1] == 'Z');
+
+  llvm::StringRef symbol_ref(symbol_name);
+
+  // Symbol names may contain @VERSION suffixes. Find those and strip them
+  // temporarily.
+  size_t version_pos = symbol_ref.find('@');
+  bool has_suffix = version_pos != llvm::StringRef::npos;
+  llvm::StringRef symbol_bare = symbol_ref.substr(0, version_pos);
+  Mangled mangled(ConstString(symbol_bare), is_mangled);
+
+  // Now append the suffix back to mangled and unmangled names. Only do it if
+  // the
+  // demangling was successful (string is not empty).
+  if (has_suffix) {
+    llvm::StringRef suffix = symbol_ref.substr(version_pos);
+
+    llvm::StringRef mangled_name = mangled.GetMangledName().GetStringRef();
+    if (!mangled_name.empty())
+      mangled.SetMangledName(ConstString((mangled_name + suffix).str()));
+
+    ConstString demangled =
+        mangled.GetDemangledName(lldb::eLanguageTypeUnknown);
+    llvm::StringRef demangled_name = demangled.GetStringRef();
+    if (!demangled_name.empty())
+      mangled.SetDemangledName(ConstString((demangled_name + suffix).str()));
+  }
+  return mangled;
+}
+
 unsigned ObjectFileELF::ParseSymbols(Symtab *symtab, user_id_t start_id,
                                      SectionList *section_list,
                                      const size_t num_symbols,
                                      const DataExtractor &symtab_data,
-                                     const DataExtractor &strtab_data) {
+                                     const DataExtractor &strtab_data,
+                                     Symtab::LazyNames *lazy_names) {
   ELFSymbol symbol;
   lldb::offset_t offset = 0;
 
@@ -2424,33 +2519,14 @@ unsigned ObjectFileELF::ParseSymbols(Symtab *symtab, user_id_t start_id,
 
     bool is_global = symbol.getBinding() == STB_GLOBAL;
     uint32_t flags = symbol.st_other << 8 | symbol.st_info | additional_flags;
-    bool is_mangled = (symbol_name[0] == '_' && symbol_name[1] == 'Z');
-
-    llvm::StringRef symbol_ref(symbol_name);
-
-    // Symbol names may contain @VERSION suffixes. Find those and strip them
-    // temporarily.
-    size_t version_pos = symbol_ref.find('@');
-    bool has_suffix = version_pos != llvm::StringRef::npos;
-    llvm::StringRef symbol_bare = symbol_ref.substr(0, version_pos);
-    Mangled mangled(ConstString(symbol_bare), is_mangled);
-
-    // Now append the suffix back to mangled and unmangled names. Only do it if
-    // the
-    // demangling was successful (string is not empty).
-    if (has_suffix) {
-      llvm::StringRef suffix = symbol_ref.substr(version_pos);
-
-      llvm::StringRef mangled_name = mangled.GetMangledName().GetStringRef();
-      if (!mangled_name.empty())
-        mangled.SetMangledName(ConstString((mangled_name + suffix).str()));
-
-      ConstString demangled =
-          mangled.GetDemangledName(lldb::eLanguageTypeUnknown);
-      llvm::StringRef demangled_name = demangled.GetStringRef();
-      if (!demangled_name.empty())
-        mangled.SetDemangledName(ConstString((demangled_name + suffix).str()));
-    }
+    bool has_suffix = ::strchr(symbol_name, '@') != nullptr;
+
+    // Interning and demangling the name is most of the cost of a symbol, so
+    // leave it to the symbol table to do when the name is first needed.
+    const bool lazy_name = lazy_names && symbol_name[0];
+    Mangled mangled;
+    if (!lazy_name)
+      mangled = DecodeSymbolName(symbol_name);
 
     // In ELF all symbol should have a valid size but it is not true for some
     // function symbols
@@ -2477,21 +2553,28 @@ unsigned ObjectFileELF::ParseSymbols(Symtab *symtab, user_id_t start_id,
         symbol_size_valid,              // Symbol size is valid
         has_suffix,                     // Contains linker annotations?
         flags);                         // Symbol flags.
-    symtab->AddSymbol(dc_symbol);
+    const uint32_t symbol_idx = symtab->AddSymbol(dc_symbol);
+    if (lazy_name) {
+      if (lazy_names->names.size() <= symbol_idx)
+        lazy_names->names.resize(symbol_idx + 1, nullptr);
+      lazy_names->names[symbol_idx] = symbol_name;
+    }
   }
   return i;
 }
 
 unsigned ObjectFileELF::ParseSymbolTable(Symtab *symbol_table,
                                          user_id_t start_id,
-                                         lldb_private::Section *symtab) {
+                                         lldb_private::Section *symtab,
+                                         Symtab::LazyNames *lazy_names) {
   if (symtab->GetObjectFile() != this) {
     // If the symbol table section is owned by a different object file, have it
     // do the
     // parsing.
     ObjectFileELF *obj_file_elf =
         static_cast<ObjectFileELF *>(symtab->GetObjectFile());
-    return obj_file_elf->ParseSymbolTable(symbol_table, start_id, symtab);
+    return obj_file_elf->ParseSymbolTable(symbol_table, start_id, symtab,
+                                          lazy_names);
   }
 
   // Get section list for this object file.
@@ -2519,8 +2602,14 @@ unsigned ObjectFileELF::ParseSymbolTable(Symtab *symbol_table,
         ReadSectionData(strtab, strtab_data)) {
       size_t num_symbols = symtab_data.GetByteSize() / symtab_hdr->sh_entsize;
 
+      // The raw names have to stay valid until they are decoded.
+      if (lazy_names && strtab_data.GetSharedDataBuffer())
+        lazy_names->buffers.push_back(strtab_data.GetSharedDataBuffer());
+      else
+        lazy_names = nullptr;
+
       return ParseSymbols(symbol_table, start_id, section_list, num_symbols,
-                          symtab_data, strtab_data);
+                          symtab_data, strtab_data, lazy_names);
     }
   }
 
@@ -2778,7 +2867,7 @@ unsigned ObjectFileELF::RelocateSection(
     Symtab *symtab, const ELFHeader *hdr, const ELFSectionHeader *rel_hdr,
     const ELFSectionHeader *symtab_hdr, const ELFSectionHeader *debug_hdr,
     DataExtractor &rel_data, DataExtractor &symtab_data,
-    DataExtractor &debug_data, Section *rel_section) {
+    DataBuffer &debug_data) {
   ELFRelocation rel(rel_hdr->sh_type);
   lldb::addr_t offset = 0;
   const unsigned num_relocations = rel_hdr->sh_size / rel_hdr->sh_entsize;
@@ -2811,12 +2900,12 @@ unsigned ObjectFileELF::RelocateSection(
       switch (reloc_type(rel)) {
       case R_X86_64_64: {
         symbol = symtab->FindSymbolByID(reloc_symbol(rel));
-        if (symbol) {
+        const uint64_t reloc_offset = ELFRelocation::RelocOffset64(rel);
+        if (symbol && reloc_offset + sizeof(uint64_t) <=
+                          debug_data.GetByteSize()) {
           addr_t value = symbol->GetAddressRef().GetFileAddress();
-          DataBufferSP &data_buffer_sp = debug_data.GetSharedDataBuffer();
-          uint64_t *dst = reinterpret_cast<uint64_t *>(
-              data_buffer_sp->GetBytes() + rel_section->GetFileOffset() +
-              ELFRelocation::RelocOffset64(rel));
+          uint64_t *dst = reinterpret_cast<uint64_t *>(debug_data.GetBytes() +
+                                                       reloc_offset);
           *dst = value + ELFRelocation::RelocAddend64(rel);
         }
         break;
@@ -2824,7 +2913,9 @@ unsigned ObjectFileELF::RelocateSection(
       case R_X86_64_32:
       case R_X86_64_32S: {
         symbol = symtab->FindSymbolByID(reloc_symbol(rel));
-        if (symbol) {
+        const uint64_t reloc_offset = ELFRelocation::RelocOffset32(rel);
+        if (symbol && reloc_offset + sizeof(uint32_t) <=
+                          debug_data.GetByteSize()) {
           addr_t value = symbol->GetAddressRef().GetFileAddress();
           value += ELFRelocation::RelocAddend32(rel);
           assert(
@@ -2832,10 +2923,8 @@ unsigned ObjectFileELF::RelocateSection(
               (reloc_type(rel) == R_X86_64_32S &&
                ((int64_t)value <= INT32_MAX && (int64_t)value >= INT32_MIN)));
           uint32_t truncated_addr = (value & 0xFFFFFFFF);
-          DataBufferSP &data_buffer_sp = debug_data.GetSharedDataBuffer();
-          uint32_t *dst = reinterpret_cast<uint32_t *>(
-              data_buffer_sp->GetBytes() + rel_section->GetFileOffset() +
-              ELFRelocation::RelocOffset32(rel));
+          uint32_t *dst = reinterpret_cast<uint32_t *>(debug_data.GetBytes() +
+                                                       reloc_offset);
           *dst = truncated_addr;
         }
         break;
@@ -2850,8 +2939,123 @@ unsigned ObjectFileELF::RelocateSection(
   return 0;
 }
 
+DataBufferSP ObjectFileELF::CreateSectionDataCopy(const Section *section) {
+  const ELFSectionHeaderInfo *header =
+      GetSectionHeaderByIndex(section->GetID());
+  if (!header)
+    return DataBufferSP();
+
+  DataBufferSP data_sp;
+  if (llvm::object::Decompressor::isCompressedELFSection(
+          header->sh_flags, header->section_name.GetStringRef())) {
+    // Read the section as empty rather than handing out compressed bytes if
+    // it can't be decompressed, e.g. because zlib isn't available.
+    data_sp = GetDecompressedSectionData(section, *header);
+    if (!data_sp)
+      return DataBufferSP(new DataBufferHeap());
+  }
+
+  // Only relocatable object files have relocations against their debug info.
+  if (CalculateType() != eTypeObjectFile)
+    return data_sp;
+
+  const user_id_t section_id = section->GetID();
+  for (SectionHeaderCollIter I = m_section_headers.begin();
+       I != m_section_headers.end(); ++I) {
+    if ((I->sh_type != SHT_RELA && I->sh_type != SHT_REL) ||
+        I->sh_info + 1 != section_id)
+      continue;
+    const char *section_name = I->section_name.AsCString("");
+    if (!strstr(section_name, ".rela.debug") &&
+        !strstr(section_name, ".rel.debug") &&
+        !strstr(section_name, ".rela.zdebug") &&
+        !strstr(section_name, ".rel.zdebug"))
+      continue;
+
+    // The file data is usually a read only memory mapping, so relocate a
+    // copy. Read the debug section straight from the file data:
+    // ReadSectionData() would ask us for the relocated copy again.
+    if (!data_sp) {
+      DataExtractor debug_data;
+      if (!GetData(section->GetFileOffset(), section->GetFileSize(),
+                   debug_data))
+        return DataBufferSP();
+      data_sp.reset(new DataBufferHeap(debug_data.GetDataStart(),
+                                       debug_data.GetByteSize()));
+    }
+    RelocateDebugSections(&*I, SectionIndex(I), *data_sp);
+    break;
+  }
+  return data_sp;
+}
+
+DataBufferSP ObjectFileELF::DecompressSection(const Section *section,
+                                              const ELFSectionHeader &header) {
+  Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_MODULES));
+  DataExtractor compressed_data;
+  if (!GetData(header.sh_offset, header.sh_size, compressed_data))
+    return DataBufferSP();
+
+  auto decompressor = llvm::object::Decompressor::create(
+      section->GetName().GetStringRef(),
+      llvm::StringRef(
+          reinterpret_cast<const char *>(compressed_data.GetDataStart()),
+          compressed_data.GetByteSize()),
+      GetByteOrder() == eByteOrderLittle, GetAddressByteSize() == 8);
+  if (!decompressor) {
+    LLDB_LOG(log, "Unable to decompress section {0} of {1}: {2}",
+             section->GetName(), m_file,
+             llvm::toString(decompressor.takeError()));
+    return DataBufferSP();
+  }
+
+  DataBufferSP data_sp(
+      new DataBufferHeap(decompressor->getDecompressedSize(), 0));
+  if (llvm::Error error = decompressor->decompress(
+          {reinterpret_cast<char *>(data_sp->GetBytes()),
+           size_t(data_sp->GetByteSize())})) {
+    LLDB_LOG(log, "Unable to decompress section {0} of {1}: {2}",
+             section->GetName(), m_file, llvm::toString(std::move(error)));
+    return DataBufferSP();
+  }
+  return data_sp;
+}
+
+DataBufferSP
+ObjectFileELF::GetDecompressedSectionData(const Section *section,
+                                          const ELFSectionHeader &header) {
+  // Relocatable object files are not cached, like their symbol tables.
+  FileSpec cache_root;
+  if (Platform::GetGlobalPlatformProperties()
+          ->GetCacheDecompressedSections() &&
+      CalculateType() != eTypeObjectFile)
+    cache_root =
+        Platform::GetGlobalPlatformProperties()->GetModuleCacheDirectory();
+
+  DataBufferSP data_sp;
+  if (cache_root) {
+    data_sp = ModuleCache::GetSectionData(cache_root, *this,
+                                          section->GetName());
+    if (data_sp)
+      return data_sp;
+  }
+
+  data_sp = DecompressSection(section, header);
+  if (data_sp && cache_root) {
+    Error error = ModuleCache::PutSectionData(cache_root, *this,
+                                              section->GetName(), *data_sp);
+    Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_MODULES));
+    if (error.Fail() && log)
+      log->Printf("ObjectFileELF::%s failed to cache section %s of %s: %s",
+                  __FUNCTION__, section->GetName().AsCString(),
+                  m_file.GetPath().c_str(), error.AsCString());
+  }
+  return data_sp;
+}
+
 unsigned ObjectFileELF::RelocateDebugSections(const ELFSectionHeader *rel_hdr,
-                                              user_id_t rel_id) {
+                                              user_id_t rel_id,
+                                              DataBuffer &debug_data) {
   assert(rel_hdr->sh_type == SHT_RELA || rel_hdr->sh_type == SHT_REL);
 
   // Parse in the section list if needed.
@@ -2859,6 +3063,10 @@ unsigned ObjectFileELF::RelocateDebugSections(const ELFSectionHeader *rel_hdr,
   if (!section_list)
     return 0;
 
+  Symtab *symtab = GetSymtab();
+  if (!symtab)
+    return 0;
+
   // Section ID's are ones based.
   user_id_t symtab_id = rel_hdr->sh_link + 1;
   user_id_t debug_id = rel_hdr->sh_info + 1;
@@ -2875,22 +3083,17 @@ unsigned ObjectFileELF::RelocateDebugSections(const ELFSectionHeader *rel_hdr,
   if (!rel)
     return 0;
 
-  Section *symtab = section_list->FindSectionByID(symtab_id).get();
-  if (!symtab)
-    return 0;
-
-  Section *debug = section_list->FindSectionByID(debug_id).get();
-  if (!debug)
+  Section *symtab_section = section_list->FindSectionByID(symtab_id).get();
+  if (!symtab_section)
     return 0;
 
   DataExtractor rel_data;
   DataExtractor symtab_data;
-  DataExtractor debug_data;
 
-  if (ReadSectionData(rel, rel_data) && ReadSectionData(symtab, symtab_data) &&
-      ReadSectionData(debug, debug_data)) {
-    RelocateSection(m_symtab_ap.get(), &m_header, rel_hdr, symtab_hdr,
-                    debug_hdr, rel_data, symtab_data, debug_data, debug);
+  if (ReadSectionData(rel, rel_data) &&
+      ReadSectionData(symtab_section, symtab_data)) {
+    RelocateSection(symtab, &m_header, rel_hdr, symtab_hdr, debug_hdr,
+                    rel_data, symtab_data, debug_data);
   }
 
   return 0;
@@ -2915,6 +3118,8 @@ Symtab *ObjectFileELF::GetSymtab() {
 
     uint64_t symbol_id = 0;
     std::lock_guard<std::recursive_mutex> guard(module_sp->GetMutex());
+    ScopedTimeAccumulator parse_time(
+        module_sp->GetStatistics().symtab_parse_nanos);
 
     // Sharable objects and dynamic executables usually have 2 distinct symbol
     // tables, one named ".symtab", and the other ".dynsym". The dynsym is a
@@ -2934,9 +3139,29 @@ Symtab *ObjectFileELF::GetSymtab() {
           section_list->FindSectionByType(eSectionTypeELFDynamicSymbols, true)
               .get();
     }
+
+    // A symbol table cached by this or another debugger process is only
+    // valid if it was parsed from this object file alone, i.e. if the symbols
+    // don't come from a separate debug file.
+    FileSpec symtab_cache_root;
+    if (Platform::GetGlobalPlatformProperties()->GetUseSymtabCache() &&
+        CalculateType() != eTypeObjectFile &&
+        (!symtab || symtab->GetObjectFile() == this))
+      symtab_cache_root =
+          Platform::GetGlobalPlatformProperties()->GetModuleCacheDirectory();
+    if (symtab_cache_root) {
+      std::unique_ptr<Symtab> cached_symtab_ap(new Symtab(this));
+      if (ModuleCache::GetSymtab(symtab_cache_root, *this, *cached_symtab_ap)) {
+        m_symtab_ap = std::move(cached_symtab_ap);
+        return m_symtab_ap.get();
+      }
+    }
+
+    Symtab::LazyNames lazy_names;
     if (symtab) {
       m_symtab_ap.reset(new Symtab(symtab->GetObjectFile()));
-      symbol_id += ParseSymbolTable(m_symtab_ap.get(), symbol_id, symtab);
+      symbol_id +=
+          ParseSymbolTable(m_symtab_ap.get(), symbol_id, symtab, &lazy_names);
     }
 
     // DT_JMPREL
@@ -2982,22 +3207,22 @@ Symtab *ObjectFileELF::GetSymtab() {
       m_symtab_ap.reset(new Symtab(this));
 
     m_symtab_ap->CalculateSymbolSizes();
-  }
 
-  for (SectionHeaderCollIter I = m_section_headers.begin();
-       I != m_section_headers.end(); ++I) {
-    if (I->sh_type == SHT_RELA || I->sh_type == SHT_REL) {
-      if (CalculateType() == eTypeObjectFile) {
-        const char *section_name = I->section_name.AsCString("");
-        if (strstr(section_name, ".rela.debug") ||
-            strstr(section_name, ".rel.debug")) {
-          const ELFSectionHeader &reloc_header = *I;
-          user_id_t reloc_id = SectionIndex(I);
-          RelocateDebugSections(&reloc_header, reloc_id);
-        }
-      }
+    // Only give the symbol table the names once it's complete: the lookups
+    // above would otherwise decode the names of most symbols.
+    m_symtab_ap->SetLazyNames(std::move(lazy_names), DecodeSymbolName);
+
+    if (symtab_cache_root) {
+      Error error =
+          ModuleCache::PutSymtab(symtab_cache_root, *this, *m_symtab_ap);
+      Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_MODULES));
+      if (error.Fail() && log)
+        log->Printf("ObjectFileELF::%s failed to cache the symbol table of "
+                    "%s: %s",
+                    __FUNCTION__, m_file.GetPath().c_str(), error.AsCString());
     }
   }
+
   return m_symtab_ap.get();
 }
 
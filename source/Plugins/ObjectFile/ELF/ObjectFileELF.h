@@ -92,6 +92,10 @@ public:
                                         lldb::offset_t length,
                                         lldb_private::ModuleSpecList &specs);
 
+  static bool SaveCore(const lldb::ProcessSP &process_sp,
+                       const lldb_private::FileSpec &outfile,
+                       lldb::SaveCoreStyle style, lldb_private::Error &error);
+
   static bool MagicBytesMatch(lldb::DataBufferSP &data_sp, lldb::addr_t offset,
                               lldb::addr_t length);
 
@@ -275,9 +279,12 @@ private:
 
   /// Populates m_symtab_ap will all non-dynamic linker symbols.  This method
   /// will parse the symbols only once.  Returns the number of symbols parsed.
+  /// If @p lazy_names is not null, the symbols are added without their
+  /// names, and their raw names are recorded in @p lazy_names instead.
   unsigned ParseSymbolTable(lldb_private::Symtab *symbol_table,
                             lldb::user_id_t start_id,
-                            lldb_private::Section *symtab);
+                            lldb_private::Section *symtab,
+                            lldb_private::Symtab::LazyNames *lazy_names);
 
   /// Helper routine for ParseSymbolTable().
   unsigned ParseSymbols(lldb_private::Symtab *symbol_table,
@@ -285,7 +292,11 @@ private:
                         lldb_private::SectionList *section_list,
                         const size_t num_symbols,
                         const lldb_private::DataExtractor &symtab_data,
-                        const lldb_private::DataExtractor &strtab_data);
+                        const lldb_private::DataExtractor &strtab_data,
+                        lldb_private::Symtab::LazyNames *lazy_names);
+
+  /// Decodes a raw ELF symbol name, including any @VERSION suffix.
+  static lldb_private::Mangled DecodeSymbolName(const char *symbol_name);
 
   /// Scans the relocation entries and adds a set of artificial symbols to the
   /// given symbol table for each PLT slot.  Returns the number of symbols
@@ -298,9 +309,28 @@ private:
   void ParseUnwindSymbols(lldb_private::Symtab *symbol_table,
                           lldb_private::DWARFCallFrameInfo *eh_frame);
 
-  /// Relocates debug sections
+  /// Returns the decompressed contents of compressed sections and relocated
+  /// copies of the debug sections of relocatable object files, and an empty
+  /// pointer for every other section.
+  lldb::DataBufferSP
+  CreateSectionDataCopy(const lldb_private::Section *section) override;
+
+  /// Decompresses an SHF_COMPRESSED or .zdebug_* section. Returns an empty
+  /// pointer if the section can't be decompressed.
+  lldb::DataBufferSP DecompressSection(const lldb_private::Section *section,
+                                       const elf::ELFSectionHeader &header);
+
+  /// Like DecompressSection(), but goes through the module cache if
+  /// platform.cache-decompressed-sections is set.
+  lldb::DataBufferSP
+  GetDecompressedSectionData(const lldb_private::Section *section,
+                             const elf::ELFSectionHeader &header);
+
+  /// Applies the relocations in the section \p rel_hdr to \p debug_data,
+  /// the contents of the debug section they refer to.
   unsigned RelocateDebugSections(const elf::ELFSectionHeader *rel_hdr,
-                                 lldb::user_id_t rel_id);
+                                 lldb::user_id_t rel_id,
+                                 lldb_private::DataBuffer &debug_data);
 
   unsigned RelocateSection(lldb_private::Symtab *symtab,
                            const elf::ELFHeader *hdr,
@@ -309,8 +339,7 @@ private:
                            const elf::ELFSectionHeader *debug_hdr,
                            lldb_private::DataExtractor &rel_data,
                            lldb_private::DataExtractor &symtab_data,
-                           lldb_private::DataExtractor &debug_data,
-                           lldb_private::Section *rel_section);
+                           lldb_private::DataBuffer &debug_data);
 
   /// Loads the section name string table into m_shstr_data.  Returns the
   /// number of bytes constituting the table.
@@ -1311,6 +1311,8 @@ Symtab *ObjectFileMachO::GetSymtab() {
   if (module_sp) {
     std::lock_guard<std::recursive_mutex> guard(module_sp->GetMutex());
     if (m_symtab_ap.get() == NULL) {
+      ScopedTimeAccumulator parse_time(
+          module_sp->GetStatistics().symtab_parse_nanos);
       m_symtab_ap.reset(new Symtab(this));
       std::lock_guard<std::recursive_mutex> symtab_guard(
           m_symtab_ap->GetMutex());
@@ -5968,7 +5970,8 @@ bool ObjectFileMachO::SetLoadAddress(Target &target, lldb::addr_t value,
 }
 
 bool ObjectFileMachO::SaveCore(const lldb::ProcessSP &process_sp,
-                               const FileSpec &outfile, Error &error) {
+                               const FileSpec &outfile,
+                               lldb::SaveCoreStyle style, Error &error) {
   if (process_sp) {
     Target &target = process_sp->GetTarget();
     const ArchSpec target_arch = target.GetArchitecture();
@@ -0,0 +1,472 @@
+//===-- MinidumpFileBuilder.cpp ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// Project includes
+#include "MinidumpFileBuilder.h"
+
+#include "Plugins/Process/minidump/RegisterContextMinidump_x86_64.h"
+
+// Other libraries and framework includes
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/Section.h"
+#include "lldb/Host/File.h"
+#include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/StopInfo.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+#include "lldb/Target/ThreadList.h"
+
+#include "llvm/Support/ConvertUTF.h"
+
+// C includes
+#include <time.h>
+
+// C++ includes
+#include <algorithm>
+
+using namespace lldb;
+using namespace lldb_private;
+using namespace lldb_private::minidump;
+
+namespace {
+
+// The size of the x86_64 CONTEXT record, including the floating point and
+// vector registers that MinidumpContext_x86_64 doesn't describe.
+const size_t k_context_x86_64_size = 1232;
+
+// Bytes below the stack pointer that leaf functions may use on x86_64.
+const addr_t k_red_zone_size = 128;
+
+// Memory is copied from the process to the file in chunks of this size.
+const size_t k_chunk_size = 1024 * 1024;
+
+} // namespace
+
+template <typename T>
+static void AppendObject(DataBufferHeap &data, const T &obj) {
+  data.AppendData(&obj, sizeof(obj));
+}
+
+static uint64_t ReadRegister(RegisterContext &reg_ctx, const char *name) {
+  const RegisterInfo *reg_info = reg_ctx.GetRegisterInfoByName(name);
+  if (!reg_info)
+    return 0;
+  return reg_ctx.ReadRegisterAsUnsigned(reg_info, 0);
+}
+
+static uint32_t GetProtection(const MemoryRegionInfo &region) {
+  const bool readable = region.GetReadable() == MemoryRegionInfo::eYes;
+  const bool writable = region.GetWritable() == MemoryRegionInfo::eYes;
+  const bool executable = region.GetExecutable() == MemoryRegionInfo::eYes;
+
+  MinidumpMemoryProtectionContants protect;
+  if (executable) {
+    if (writable)
+      protect = MinidumpMemoryProtectionContants::PageExecuteReadWrite;
+    else if (readable)
+      protect = MinidumpMemoryProtectionContants::PageExecuteRead;
+    else
+      protect = MinidumpMemoryProtectionContants::PageExecute;
+  } else if (writable) {
+    protect = MinidumpMemoryProtectionContants::PageReadWrite;
+  } else if (readable) {
+    protect = MinidumpMemoryProtectionContants::PageReadOnly;
+  } else {
+    protect = MinidumpMemoryProtectionContants::PageNoAccess;
+  }
+  return static_cast<uint32_t>(protect);
+}
+
+MinidumpFileBuilder::MinidumpFileBuilder() : m_data() {}
+
+uint32_t MinidumpFileBuilder::GetCurrentDataEndOffset() const {
+  return sizeof(MinidumpHeader) + m_data.GetByteSize();
+}
+
+void MinidumpFileBuilder::AddDirectory(MinidumpStreamType type,
+                                       uint32_t stream_size) {
+  MinidumpDirectory directory;
+  directory.stream_type = static_cast<uint32_t>(type);
+  directory.location.data_size = stream_size;
+  directory.location.rva = GetCurrentDataEndOffset();
+  m_directories.push_back(directory);
+}
+
+uint32_t MinidumpFileBuilder::AddString(llvm::StringRef str) {
+  const uint32_t rva = GetCurrentDataEndOffset();
+
+  llvm::SmallVector<llvm::UTF16, 128> utf16;
+  if (!llvm::convertUTF8ToUTF16String(str, utf16))
+    utf16.clear();
+  // convertUTF8ToUTF16String null terminates the result.
+  if (utf16.empty())
+    utf16.push_back(0);
+
+  llvm::support::ulittle32_t length(
+      static_cast<uint32_t>((utf16.size() - 1) * sizeof(llvm::UTF16)));
+  AppendObject(m_data, length);
+  for (llvm::UTF16 c : utf16) {
+    llvm::support::ulittle16_t le_c(c);
+    AppendObject(m_data, le_c);
+  }
+  return rva;
+}
+
+Error MinidumpFileBuilder::UpdateMemoryRegions(Process &process) {
+  if (!m_regions.empty())
+    return Error();
+  return process.GetMemoryRegions(m_regions);
+}
+
+Error MinidumpFileBuilder::AddSystemInfo(const llvm::Triple &target_triple) {
+  Error error;
+  if (target_triple.getArch() != llvm::Triple::x86_64 ||
+      target_triple.getOS() != llvm::Triple::Linux) {
+    error.SetErrorStringWithFormat("unsupported minidump target: %s",
+                                   target_triple.str().c_str());
+    return error;
+  }
+
+  const uint32_t csd_version_rva = AddString("");
+
+  MinidumpSystemInfo system_info;
+  memset(&system_info, 0, sizeof(system_info));
+  system_info.processor_arch =
+      static_cast<uint16_t>(MinidumpCPUArchitecture::AMD64);
+  system_info.platform_id = static_cast<uint32_t>(MinidumpOSPlatform::Linux);
+  system_info.csd_version_rva = csd_version_rva;
+
+  AddDirectory(MinidumpStreamType::SystemInfo, sizeof(system_info));
+  AppendObject(m_data, system_info);
+  return error;
+}
+
+Error MinidumpFileBuilder::AddModuleList(Process &process) {
+  Error error = UpdateMemoryRegions(process);
+  if (error.Fail())
+    return error;
+
+  Target &target = process.GetTarget();
+  const ModuleList &images = target.GetImages();
+  std::vector<MinidumpModule> modules;
+
+  for (size_t i = 0, e = images.GetSize(); i != e; ++i) {
+    ModuleSP module_sp = images.GetModuleAtIndex(i);
+    if (!module_sp)
+      continue;
+    const std::string path = module_sp->GetFileSpec().GetPath();
+
+    // Use the regions the file is mapped at, the lowest one maps the start
+    // of the file. Fall back to the loaded sections if the process doesn't
+    // name its memory regions.
+    addr_t base = LLDB_INVALID_ADDRESS;
+    addr_t end = 0;
+    for (const MemoryRegionInfoSP &region_sp : m_regions) {
+      if (region_sp->GetName().GetStringRef() != path)
+        continue;
+      base = std::min(base, region_sp->GetRange().GetRangeBase());
+      end = std::max(end, region_sp->GetRange().GetRangeEnd());
+    }
+    if (base == LLDB_INVALID_ADDRESS) {
+      if (SectionList *sections = module_sp->GetSectionList()) {
+        for (size_t j = 0, n = sections->GetSize(); j != n; ++j) {
+          SectionSP section_sp = sections->GetSectionAtIndex(j);
+          const addr_t load_addr = section_sp->GetLoadBaseAddress(&target);
+          if (load_addr == LLDB_INVALID_ADDRESS)
+            continue;
+          base = std::min(base, load_addr);
+          end = std::max(end, load_addr + section_sp->GetByteSize());
+        }
+      }
+    }
+    if (base == LLDB_INVALID_ADDRESS)
+      continue;
+
+    MinidumpModule module;
+    memset(&module, 0, sizeof(module));
+    module.base_of_image = base;
+    module.size_of_image = static_cast<uint32_t>(end - base);
+    module.module_name_rva = AddString(path);
+    modules.push_back(module);
+  }
+
+  llvm::support::ulittle32_t count(static_cast<uint32_t>(modules.size()));
+  AddDirectory(MinidumpStreamType::ModuleList,
+               sizeof(count) + modules.size() * sizeof(MinidumpModule));
+  AppendObject(m_data, count);
+  for (MinidumpModule &module : modules)
+    AppendObject(m_data, module);
+  return error;
+}
+
+Error MinidumpFileBuilder::AddThreadList(Process &process) {
+  Error error = UpdateMemoryRegions(process);
+  if (error.Fail())
+    return error;
+
+  ThreadList &thread_list = process.GetThreadList();
+  std::vector<MinidumpThread> threads;
+
+  for (uint32_t i = 0, e = thread_list.GetSize(); i != e; ++i) {
+    ThreadSP thread_sp = thread_list.GetThreadAtIndex(i);
+    if (!thread_sp)
+      continue;
+    RegisterContextSP reg_ctx_sp = thread_sp->GetRegisterContext();
+    if (!reg_ctx_sp) {
+      error.SetErrorStringWithFormat("no register context for thread %" PRIu64,
+                                     thread_sp->GetID());
+      return error;
+    }
+    RegisterContext &reg_ctx = *reg_ctx_sp;
+
+    MinidumpThread thread;
+    memset(&thread, 0, sizeof(thread));
+    thread.thread_id = static_cast<uint32_t>(thread_sp->GetProtocolID());
+
+    // Save the stack from just below the stack pointer (the red zone may be
+    // in use) up to the end of the region it is in, i.e. the used part.
+    const addr_t sp = reg_ctx.GetSP(0);
+    for (const MemoryRegionInfoSP &region_sp : m_regions) {
+      const MemoryRegionInfo::RangeType &range = region_sp->GetRange();
+      if (!range.Contains(sp) ||
+          region_sp->GetReadable() != MemoryRegionInfo::eYes)
+        continue;
+
+      const addr_t start =
+          std::max(range.GetRangeBase(),
+                   sp > k_red_zone_size ? sp - k_red_zone_size : 0);
+      const size_t size = range.GetRangeEnd() - start;
+      const uint32_t rva = GetCurrentDataEndOffset();
+      const size_t offset = m_data.GetByteSize();
+      m_data.SetByteSize(offset + size);
+      process.ReadMemoryZeroFillingGaps(start, m_data.GetBytes() + offset,
+                                        size);
+
+      thread.stack.start_of_memory_range = start;
+      thread.stack.memory.data_size = static_cast<uint32_t>(size);
+      thread.stack.memory.rva = rva;
+      m_stacks.push_back(thread.stack);
+      break;
+    }
+
+    MinidumpContext_x86_64 context;
+    memset(&context, 0, sizeof(context));
+    context.context_flags = static_cast<uint32_t>(
+        MinidumpContext_x86_64_Flags::Control |
+        MinidumpContext_x86_64_Flags::Integer |
+        MinidumpContext_x86_64_Flags::Segments);
+    context.mx_csr = ReadRegister(reg_ctx, "mxcsr");
+    context.cs = ReadRegister(reg_ctx, "cs");
+    context.ds = ReadRegister(reg_ctx, "ds");
+    context.es = ReadRegister(reg_ctx, "es");
+    context.fs = ReadRegister(reg_ctx, "fs");
+    context.gs = ReadRegister(reg_ctx, "gs");
+    context.ss = ReadRegister(reg_ctx, "ss");
+    context.eflags = ReadRegister(reg_ctx, "rflags");
+    context.rax = ReadRegister(reg_ctx, "rax");
+    context.rcx = ReadRegister(reg_ctx, "rcx");
+    context.rdx = ReadRegister(reg_ctx, "rdx");
+    context.rbx = ReadRegister(reg_ctx, "rbx");
+    context.rsp = ReadRegister(reg_ctx, "rsp");
+    context.rbp = ReadRegister(reg_ctx, "rbp");
+    context.rsi = ReadRegister(reg_ctx, "rsi");
+    context.rdi = ReadRegister(reg_ctx, "rdi");
+    context.r8 = ReadRegister(reg_ctx, "r8");
+    context.r9 = ReadRegister(reg_ctx, "r9");
+    context.r10 = ReadRegister(reg_ctx, "r10");
+    context.r11 = ReadRegister(reg_ctx, "r11");
+    context.r12 = ReadRegister(reg_ctx, "r12");
+    context.r13 = ReadRegister(reg_ctx, "r13");
+    context.r14 = ReadRegister(reg_ctx, "r14");
+    context.r15 = ReadRegister(reg_ctx, "r15");
+    context.rip = ReadRegister(reg_ctx, "rip");
+
+    thread.thread_context.data_size = k_context_x86_64_size;
+    thread.thread_context.rva = GetCurrentDataEndOffset();
+    AppendObject(m_data, context);
+    m_data.SetByteSize(m_data.GetByteSize() + k_context_x86_64_size -
+                       sizeof(context));
+    m_thread_contexts[thread_sp->GetID()] = thread.thread_context;
+
+    threads.push_back(thread);
+  }
+
+  llvm::support::ulittle32_t count(static_cast<uint32_t>(threads.size()));
+  AddDirectory(MinidumpStreamType::ThreadList,
+               sizeof(count) + threads.size() * sizeof(MinidumpThread));
+  AppendObject(m_data, count);
+  for (MinidumpThread &thread : threads)
+    AppendObject(m_data, thread);
+  return error;
+}
+
+Error MinidumpFileBuilder::AddExceptionStream(Process &process) {
+  ThreadSP thread_sp = process.GetThreadList().GetSelectedThread();
+  if (!thread_sp)
+    return Error();
+
+  auto pos = m_thread_contexts.find(thread_sp->GetID());
+  if (pos == m_thread_contexts.end())
+    return Error();
+
+  MinidumpExceptionStream exception;
+  memset(&exception, 0, sizeof(exception));
+  exception.thread_id = static_cast<uint32_t>(thread_sp->GetProtocolID());
+  exception.thread_context = pos->second;
+
+  // Linux minidumps store the signal number as the exception code.
+  StopInfoSP stop_info_sp = thread_sp->GetStopInfo();
+  if (stop_info_sp && stop_info_sp->GetStopReason() == eStopReasonSignal)
+    exception.exception_record.exception_code = stop_info_sp->GetValue();
+  else
+    exception.exception_record.exception_code =
+        MinidumpException::DumpRequested;
+  if (RegisterContextSP reg_ctx_sp = thread_sp->GetRegisterContext())
+    exception.exception_record.exception_address = reg_ctx_sp->GetPC(0);
+
+  AddDirectory(MinidumpStreamType::Exception, sizeof(exception));
+  AppendObject(m_data, exception);
+  return Error();
+}
+
+Error MinidumpFileBuilder::AddMiscInfo(Process &process) {
+  MinidumpMiscInfo misc_info;
+  memset(&misc_info, 0, sizeof(misc_info));
+  misc_info.size = sizeof(misc_info);
+  misc_info.flags1 = static_cast<uint32_t>(MinidumpMiscInfoFlags::ProcessID);
+  misc_info.process_id = static_cast<uint32_t>(process.GetID());
+
+  AddDirectory(MinidumpStreamType::MiscInfo, sizeof(misc_info));
+  AppendObject(m_data, misc_info);
+  return Error();
+}
+
+Error MinidumpFileBuilder::AddMemory(Process &process, SaveCoreStyle style) {
+  Error error = UpdateMemoryRegions(process);
+  if (error.Fail())
+    return error;
+
+  // The thread stacks were already copied by AddThreadList.
+  llvm::support::ulittle32_t stack_count(
+      static_cast<uint32_t>(m_stacks.size()));
+  AddDirectory(MinidumpStreamType::MemoryList,
+               sizeof(stack_count) +
+                   m_stacks.size() * sizeof(MinidumpMemoryDescriptor));
+  AppendObject(m_data, stack_count);
+  for (MinidumpMemoryDescriptor &stack : m_stacks)
+    AppendObject(m_data, stack);
+
+  std::vector<MinidumpMemoryInfo> infos;
+  for (const MemoryRegionInfoSP &region_sp : m_regions) {
+    const MemoryRegionInfo::RangeType &range = region_sp->GetRange();
+    if (range.GetByteSize() == 0)
+      continue;
+    const bool mapped = region_sp->GetMapped() != MemoryRegionInfo::eNo;
+    const bool file_backed = region_sp->GetName().GetStringRef().startswith("/");
+
+    MinidumpMemoryInfo info;
+    memset(&info, 0, sizeof(info));
+    info.base_address = range.GetRangeBase();
+    info.allocation_base = range.GetRangeBase();
+    info.region_size = range.GetByteSize();
+    info.protect = GetProtection(*region_sp);
+    info.allocation_protect = info.protect;
+    info.state = static_cast<uint32_t>(mapped
+                                           ? MinidumpMemoryInfoState::MemCommit
+                                           : MinidumpMemoryInfoState::MemFree);
+    info.type = static_cast<uint32_t>(file_backed
+                                          ? MinidumpMemoryInfoType::MemMapped
+                                          : MinidumpMemoryInfoType::MemPrivate);
+    infos.push_back(info);
+
+    if (style == eSaveCoreStackOnly || !mapped ||
+        region_sp->GetReadable() != MemoryRegionInfo::eYes)
+      continue;
+    if (style == eSaveCoreDirtyOnly && file_backed &&
+        region_sp->GetWritable() != MemoryRegionInfo::eYes)
+      continue;
+    m_memory64_ranges.push_back({range.GetRangeBase(), range.GetByteSize()});
+  }
+
+  MinidumpMemoryInfoListHeader info_header;
+  info_header.size_of_header = sizeof(info_header);
+  info_header.size_of_entry = sizeof(MinidumpMemoryInfo);
+  info_header.num_of_entries = infos.size();
+  AddDirectory(MinidumpStreamType::MemoryInfoList,
+               sizeof(info_header) + infos.size() * sizeof(MinidumpMemoryInfo));
+  AppendObject(m_data, info_header);
+  for (MinidumpMemoryInfo &info : infos)
+    AppendObject(m_data, info);
+
+  if (m_memory64_ranges.empty())
+    return error;
+
+  // The memory itself follows the stream directory, which gets one more
+  // entry for this stream.
+  llvm::support::ulittle64_t range_count(m_memory64_ranges.size());
+  const uint32_t stream_size =
+      sizeof(range_count) + sizeof(uint64_t) +
+      m_memory64_ranges.size() * sizeof(MinidumpMemoryDescriptor64);
+  llvm::support::ulittle64_t base_rva(
+      GetCurrentDataEndOffset() + stream_size +
+      (m_directories.size() + 1) * sizeof(MinidumpDirectory));
+  AddDirectory(MinidumpStreamType::Memory64List, stream_size);
+  AppendObject(m_data, range_count);
+  AppendObject(m_data, base_rva);
+  for (const MemoryRange &range : m_memory64_ranges) {
+    MinidumpMemoryDescriptor64 descriptor;
+    descriptor.start_of_memory_range = range.start;
+    descriptor.data_size = range.size;
+    AppendObject(m_data, descriptor);
+  }
+  return error;
+}
+
+Error MinidumpFileBuilder::Dump(Process &process, File &core_file) const {
+  MinidumpHeader header;
+  header.signature = static_cast<uint32_t>(MinidumpHeaderConstants::Signature);
+  header.version = static_cast<uint32_t>(MinidumpHeaderConstants::Version);
+  header.streams_count = m_directories.size();
+  header.stream_directory_rva = GetCurrentDataEndOffset();
+  header.checksum = 0;
+  header.time_date_stamp = static_cast<uint32_t>(time(nullptr));
+  header.flags = 0;
+
+  size_t bytes_written = sizeof(header);
+  Error error = core_file.Write(&header, bytes_written);
+  if (error.Fail())
+    return error;
+
+  bytes_written = m_data.GetByteSize();
+  error = core_file.Write(m_data.GetBytes(), bytes_written);
+  if (error.Fail())
+    return error;
+
+  bytes_written = m_directories.size() * sizeof(MinidumpDirectory);
+  error = core_file.Write(m_directories.data(), bytes_written);
+  if (error.Fail())
+    return error;
+
+  std::vector<uint8_t> buffer(k_chunk_size);
+  for (const MemoryRange &range : m_memory64_ranges) {
+    for (addr_t done = 0; done < range.size; done += k_chunk_size) {
+      const size_t size = std::min<addr_t>(k_chunk_size, range.size - done);
+      process.ReadMemoryZeroFillingGaps(range.start + done, buffer.data(),
+                                        size);
+      bytes_written = size;
+      error = core_file.Write(buffer.data(), bytes_written);
+      if (error.Fail())
+        return error;
+    }
+  }
+  return error;
+}
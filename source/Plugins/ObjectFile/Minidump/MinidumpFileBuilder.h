@@ -0,0 +1,93 @@
+//===-- MinidumpFileBuilder.h -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_MinidumpFileBuilder_h_
+#define liblldb_MinidumpFileBuilder_h_
+
+// Project includes
+#include "Plugins/Process/minidump/MinidumpTypes.h"
+
+// Other libraries and framework includes
+#include "lldb/Utility/DataBufferHeap.h"
+#include "lldb/Utility/Error.h"
+#include "lldb/lldb-private.h"
+
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringRef.h"
+#include "llvm/ADT/Triple.h"
+
+// C++ includes
+#include <vector>
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+/// @class MinidumpFileBuilder MinidumpFileBuilder.h
+/// Assembles the streams of a minidump for a stopped process.
+///
+/// The streams are built in memory, except for the contents of the
+/// Memory64List stream of full-memory minidumps, which are copied from the
+/// process straight to the file by Dump(). The file layout is:
+///
+///   header, stream data, stream directory, Memory64List memory
+//----------------------------------------------------------------------
+class MinidumpFileBuilder {
+public:
+  MinidumpFileBuilder();
+
+  Error AddSystemInfo(const llvm::Triple &target_triple);
+
+  // Add the modules of the target, with the address ranges the process maps
+  // them at.
+  Error AddModuleList(Process &process);
+
+  // Add the threads with their register contexts. The stack of each thread
+  // is saved in the MemoryList stream whatever style the core is saved in.
+  Error AddThreadList(Process &process);
+
+  // Record the signal the selected thread stopped with, if any.
+  Error AddExceptionStream(Process &process);
+
+  Error AddMiscInfo(Process &process);
+
+  // Add the MemoryInfoList stream describing all the regions of the process
+  // and, unless only the stacks are saved, a Memory64List stream for the
+  // regions \a style selects. This must be the last stream added.
+  Error AddMemory(Process &process, lldb::SaveCoreStyle style);
+
+  Error Dump(Process &process, File &core_file) const;
+
+private:
+  struct MemoryRange {
+    lldb::addr_t start;
+    lldb::addr_t size;
+  };
+
+  // Offset in the file of the next byte appended to m_data.
+  uint32_t GetCurrentDataEndOffset() const;
+
+  void AddDirectory(minidump::MinidumpStreamType type, uint32_t stream_size);
+
+  // Append a MinidumpString and return its RVA.
+  uint32_t AddString(llvm::StringRef str);
+
+  Error UpdateMemoryRegions(Process &process);
+
+  DataBufferHeap m_data;
+  std::vector<minidump::MinidumpDirectory> m_directories;
+  std::vector<lldb::MemoryRegionInfoSP> m_regions;
+  std::vector<minidump::MinidumpMemoryDescriptor> m_stacks;
+  llvm::DenseMap<lldb::tid_t, minidump::MinidumpLocationDescriptor>
+      m_thread_contexts;
+  std::vector<MemoryRange> m_memory64_ranges;
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_MinidumpFileBuilder_h_
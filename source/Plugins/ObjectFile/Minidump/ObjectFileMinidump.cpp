@@ -0,0 +1,108 @@
+//===-- ObjectFileMinidump.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+// Project includes
+#include "ObjectFileMinidump.h"
+#include "MinidumpFileBuilder.h"
+
+// Other libraries and framework includes
+#include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/PluginManager.h"
+#include "lldb/Host/File.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Logging.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+void ObjectFileMinidump::Initialize() {
+  PluginManager::RegisterPlugin(
+      GetPluginNameStatic(), GetPluginDescriptionStatic(), CreateInstance,
+      CreateMemoryInstance, GetModuleSpecifications, SaveCore);
+}
+
+void ObjectFileMinidump::Terminate() {
+  PluginManager::UnregisterPlugin(CreateInstance);
+}
+
+ConstString ObjectFileMinidump::GetPluginNameStatic() {
+  static ConstString g_name("minidump");
+  return g_name;
+}
+
+const char *ObjectFileMinidump::GetPluginDescriptionStatic() {
+  return "Minidump core file writer.";
+}
+
+ObjectFile *ObjectFileMinidump::CreateInstance(
+    const lldb::ModuleSP &module_sp, lldb::DataBufferSP &data_sp,
+    lldb::offset_t data_offset, const FileSpec *file,
+    lldb::offset_t file_offset, lldb::offset_t length) {
+  return nullptr;
+}
+
+ObjectFile *ObjectFileMinidump::CreateMemoryInstance(
+    const lldb::ModuleSP &module_sp, lldb::DataBufferSP &data_sp,
+    const lldb::ProcessSP &process_sp, lldb::addr_t header_addr) {
+  return nullptr;
+}
+
+size_t ObjectFileMinidump::GetModuleSpecifications(
+    const FileSpec &file, lldb::DataBufferSP &data_sp,
+    lldb::offset_t data_offset, lldb::offset_t file_offset,
+    lldb::offset_t length, ModuleSpecList &specs) {
+  return 0;
+}
+
+bool ObjectFileMinidump::SaveCore(const lldb::ProcessSP &process_sp,
+                                  const FileSpec &outfile,
+                                  lldb::SaveCoreStyle style, Error &error) {
+  if (!process_sp)
+    return false;
+
+  // Only Linux x86_64 minidumps can be written for now, that's the only
+  // register context ProcessMinidump and the builder share.
+  const llvm::Triple &triple =
+      process_sp->GetTarget().GetArchitecture().GetTriple();
+  if (triple.getOS() != llvm::Triple::Linux ||
+      triple.getArch() != llvm::Triple::x86_64)
+    return false;
+
+  MinidumpFileBuilder builder;
+  error = builder.AddSystemInfo(triple);
+  if (error.Success())
+    error = builder.AddModuleList(*process_sp);
+  if (error.Success())
+    error = builder.AddThreadList(*process_sp);
+  if (error.Success())
+    error = builder.AddExceptionStream(*process_sp);
+  if (error.Success())
+    error = builder.AddMiscInfo(*process_sp);
+  if (error.Success())
+    error = builder.AddMemory(*process_sp, style);
+  if (error.Fail())
+    return true;
+
+  File core_file;
+  const std::string core_file_path = outfile.GetPath();
+  error = core_file.Open(core_file_path.c_str(),
+                         File::eOpenOptionWrite | File::eOpenOptionTruncate |
+                             File::eOpenOptionCanCreate);
+  if (error.Success())
+    error = builder.Dump(*process_sp, core_file);
+
+  Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_PROCESS));
+  if (log)
+    log->Printf("ObjectFileMinidump::%s wrote '%s': %s", __FUNCTION__,
+                core_file_path.c_str(),
+                error.Success() ? "success" : error.AsCString());
+  return true;
+}
@@ -0,0 +1,62 @@
+//===-- ObjectFileMinidump.h ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef liblldb_ObjectFileMinidump_h_
+#define liblldb_ObjectFileMinidump_h_
+
+// Other libraries and framework includes
+#include "lldb/Utility/ConstString.h"
+#include "lldb/lldb-private.h"
+
+namespace lldb_private {
+
+//----------------------------------------------------------------------
+// ObjectFileMinidump
+//
+// Minidumps are loaded by ProcessMinidump; this plug-in only exists so that
+// "process save-core --plugin-name minidump" can write them. It never
+// creates object files.
+//----------------------------------------------------------------------
+class ObjectFileMinidump {
+public:
+  static void Initialize();
+
+  static void Terminate();
+
+  static ConstString GetPluginNameStatic();
+
+  static const char *GetPluginDescriptionStatic();
+
+  static ObjectFile *CreateInstance(const lldb::ModuleSP &module_sp,
+                                    lldb::DataBufferSP &data_sp,
+                                    lldb::offset_t data_offset,
+                                    const FileSpec *file,
+                                    lldb::offset_t file_offset,
+                                    lldb::offset_t length);
+
+  static ObjectFile *CreateMemoryInstance(const lldb::ModuleSP &module_sp,
+                                          lldb::DataBufferSP &data_sp,
+                                          const lldb::ProcessSP &process_sp,
+                                          lldb::addr_t header_addr);
+
+  static size_t GetModuleSpecifications(const FileSpec &file,
+                                        lldb::DataBufferSP &data_sp,
+                                        lldb::offset_t data_offset,
+                                        lldb::offset_t file_offset,
+                                        lldb::offset_t length,
+                                        ModuleSpecList &specs);
+
+  static bool SaveCore(const lldb::ProcessSP &process_sp,
+                       const FileSpec &outfile, lldb::SaveCoreStyle style,
+                       Error &error);
+};
+
+} // namespace lldb_private
+
+#endif // liblldb_ObjectFileMinidump_h_
@@ -145,6 +145,7 @@ size_t ObjectFilePECOFF::GetModuleSpecifications(
 
 bool ObjectFilePECOFF::SaveCore(const lldb::ProcessSP &process_sp,
                                 const lldb_private::FileSpec &outfile,
+                                lldb::SaveCoreStyle style,
                                 lldb_private::Error &error) {
   return SaveMiniDump(process_sp, outfile, error);
 }
@@ -517,6 +518,8 @@ Symtab *ObjectFilePECOFF::GetSymtab() {
   if (module_sp) {
     std::lock_guard<std::recursive_mutex> guard(module_sp->GetMutex());
     if (m_symtab_ap.get() == NULL) {
+      ScopedTimeAccumulator parse_time(
+          module_sp->GetStatistics().symtab_parse_nanos);
       SectionList *sect_list = GetSectionList();
       m_symtab_ap.reset(new Symtab(this));
       std::lock_guard<std::recursive_mutex> guard(m_symtab_ap->GetMutex());
@@ -937,6 +937,21 @@ void NativeProcessLinux::MonitorTrace(NativeThreadLinux &thread) {
   Log *log(ProcessPOSIXLog::GetLogIfAllCategoriesSet(POSIX_LOG_PROCESS));
   LLDB_LOG(log, "received trace event, pid = {0}", thread.GetID());
 
+  // A thread that is stepping through a range keeps going without telling
+  // anyone until it leaves the range, unless another thread has stopped in
+  // the meantime.
+  if (m_pending_notification_tid == LLDB_INVALID_THREAD_ID) {
+    NativeRegisterContextSP reg_ctx_sp = thread.GetRegisterContext();
+    if (reg_ctx_sp && thread.IsInStepRange(reg_ctx_sp->GetPC())) {
+      Error error = thread.SingleStep(LLDB_INVALID_SIGNAL_NUMBER);
+      if (error.Success())
+        return;
+      LLDB_LOG(log, "failed to keep stepping tid {0}: {1}", thread.GetID(),
+               error);
+    }
+  }
+  thread.SetStepRange(0, 0);
+
   // This thread is currently stopped.
   thread.SetStoppedByTrace();
 
@@ -1268,6 +1283,9 @@ Error NativeProcessLinux::Resume(const ResumeActionList &resume_actions) {
   for (auto thread_sp : m_threads) {
     assert(thread_sp && "thread list should not contain NULL threads");
 
+    NativeThreadLinux &thread = static_cast<NativeThreadLinux &>(*thread_sp);
+    thread.SetStepRange(0, 0);
+
     const ResumeAction *const action =
         resume_actions.GetActionForThread(thread_sp->GetID(), true);
 
@@ -1277,6 +1295,12 @@ Error NativeProcessLinux::Resume(const ResumeActionList &resume_actions) {
       continue;
     }
 
+    // With software single stepping every step needs new breakpoints, so
+    // step once and let the client ask again.
+    if (action->state == eStateStepping && !software_single_step &&
+        action->range_start < action->range_end)
+      thread.SetStepRange(action->range_start, action->range_end);
+
     LLDB_LOG(log, "processing resume action state {0} for pid {1} tid {2}",
              action->state, GetID(), thread_sp->GetID());
 
@@ -1285,8 +1309,7 @@ Error NativeProcessLinux::Resume(const ResumeActionList &resume_actions) {
     case eStateStepping: {
       // Run the thread, possibly feeding it the signal.
       const int signo = action->signal;
-      ResumeThread(static_cast<NativeThreadLinux &>(*thread_sp), action->state,
-                   signo);
+      ResumeThread(thread, action->state, signo);
       break;
     }
 
@@ -63,6 +63,17 @@ private:
   /// LLDB_INVALID_SIGNAL_NUMBER, deliver that signal to the thread.
   Error SingleStep(uint32_t signo);
 
+  /// Keep single stepping while the PC is in [@p start, @p end), rather than
+  /// stopping after one instruction. An empty range turns this off.
+  void SetStepRange(lldb::addr_t start, lldb::addr_t end) {
+    m_step_range_start = start;
+    m_step_range_end = end;
+  }
+
+  bool IsInStepRange(lldb::addr_t pc) const {
+    return m_step_range_start <= pc && pc < m_step_range_end;
+  }
+
   void SetStoppedBySignal(uint32_t signo, const siginfo_t *info = nullptr);
 
   /// Return true if the thread is stopped.
@@ -108,6 +119,8 @@ private:
   WatchpointIndexMap m_watchpoint_index_map;
   WatchpointIndexMap m_hw_break_index_map;
   std::unique_ptr<SingleStepWorkaround> m_step_workaround;
+  lldb::addr_t m_step_range_start;
+  lldb::addr_t m_step_range_end;
 };
 
 typedef std::shared_ptr<NativeThreadLinux> NativeThreadLinuxSP;
@@ -178,6 +178,7 @@ GDBRemoteClientBase::SendPacketAndWaitForResponse(
 GDBRemoteCommunication::PacketResult
 GDBRemoteClientBase::SendPacketAndWaitForResponseNoLock(
     llvm::StringRef payload, StringExtractorGDBRemote &response) {
+  const auto start = std::chrono::steady_clock::now();
   PacketResult packet_result = SendPacketNoLock(payload);
   if (packet_result != PacketResult::Success)
     return packet_result;
@@ -189,8 +190,10 @@ GDBRemoteClientBase::SendPacketAndWaitForResponseNoLock(
     if (packet_result != PacketResult::Success)
       return packet_result;
     // Make sure our response is valid for the payload that was sent
-    if (response.ValidateResponse())
+    if (response.ValidateResponse()) {
+      RecordPacketTime(payload, std::chrono::steady_clock::now() - start);
       return packet_result;
+    }
     // Response says it wasn't valid
     Log *log = ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PACKETS);
     if (log)
@@ -204,6 +207,38 @@ GDBRemoteClientBase::SendPacketAndWaitForResponseNoLock(
   return packet_result;
 }
 
+// The name of a packet is its first character, followed by the letters and
+// digits after it for the packets that have multi-letter names.
+static llvm::StringRef GetPacketName(llvm::StringRef payload) {
+  if (payload.empty())
+    return payload;
+  switch (payload[0]) {
+  case 'q':
+  case 'Q':
+  case 'v':
+  case 'j':
+  case '_':
+    return payload.take_while([](char c) { return isalnum(c) || c == '_'; });
+  default:
+    return payload.take_front(1);
+  }
+}
+
+void GDBRemoteClientBase::RecordPacketTime(llvm::StringRef payload,
+                                           std::chrono::nanoseconds duration) {
+  std::lock_guard<std::mutex> guard(m_packet_stats_mutex);
+  PacketStatistics &stats = m_packet_stats[GetPacketName(payload).str()];
+  ++stats.count;
+  stats.total_time += duration;
+  stats.max_time = std::max(stats.max_time, duration);
+}
+
+std::map<std::string, GDBRemoteClientBase::PacketStatistics>
+GDBRemoteClientBase::GetPacketStatistics() {
+  std::lock_guard<std::mutex> guard(m_packet_stats_mutex);
+  return m_packet_stats;
+}
+
 bool GDBRemoteClientBase::SendvContPacket(llvm::StringRef payload,
                                           StringExtractorGDBRemote &response) {
   Log *log(ProcessGDBRemoteLog::GetLogIfAllCategoriesSet(GDBR_LOG_PROCESS));
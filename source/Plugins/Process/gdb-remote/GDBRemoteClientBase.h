@@ -12,7 +12,10 @@
 
 #include "GDBRemoteCommunication.h"
 
+#include <chrono>
 #include <condition_variable>
+#include <map>
+#include <string>
 
 namespace lldb_private {
 namespace process_gdb_remote {
@@ -51,6 +54,19 @@ public:
   bool SendvContPacket(llvm::StringRef payload,
                        StringExtractorGDBRemote &response);
 
+  //------------------------------------------------------------------
+  // How many packets were sent with SendPacketAndWaitForResponse and how
+  // long it took to get their responses, grouped by packet name ("m",
+  // "qXfer", "vCont", ...).
+  //------------------------------------------------------------------
+  struct PacketStatistics {
+    uint64_t count = 0;
+    std::chrono::nanoseconds total_time{0};
+    std::chrono::nanoseconds max_time{0};
+  };
+
+  std::map<std::string, PacketStatistics> GetPacketStatistics();
+
   class Lock {
   public:
     Lock(GDBRemoteClientBase &comm, bool interrupt);
@@ -117,6 +133,12 @@ private:
   // simple mutex.
   std::recursive_mutex m_async_mutex;
 
+  std::mutex m_packet_stats_mutex;
+  std::map<std::string, PacketStatistics> m_packet_stats;
+
+  void RecordPacketTime(llvm::StringRef payload,
+                        std::chrono::nanoseconds duration);
+
   bool ShouldStop(const UnixSignals &signals,
                   StringExtractorGDBRemote &response);
 
@@ -64,6 +64,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_vCont_C(eLazyBoolCalculate),
       m_supports_vCont_s(eLazyBoolCalculate),
       m_supports_vCont_S(eLazyBoolCalculate),
+      m_supports_vCont_r(eLazyBoolCalculate),
       m_qHostInfo_is_valid(eLazyBoolCalculate),
       m_curr_pid_is_valid(eLazyBoolCalculate),
       m_qProcessInfo_is_valid(eLazyBoolCalculate),
@@ -87,6 +88,7 @@ GDBRemoteCommunicationClient::GDBRemoteCommunicationClient()
       m_supports_jLoadedDynamicLibrariesInfos(eLazyBoolCalculate),
       m_supports_jGetSharedCacheInfo(eLazyBoolCalculate),
       m_supports_QPassSignals(eLazyBoolCalculate),
+      m_supports_qMemoryChecksums(eLazyBoolCalculate),
       m_supports_qProcessInfoPID(true), m_supports_qfProcessInfo(true),
       m_supports_qUserName(true), m_supports_qGroupName(true),
       m_supports_qThreadStopInfo(true), m_supports_z0(true),
@@ -157,6 +159,13 @@ bool GDBRemoteCommunicationClient::GetQPassSignalsSupported() {
   return m_supports_QPassSignals == eLazyBoolYes;
 }
 
+bool GDBRemoteCommunicationClient::GetMemoryChecksumsSupported() {
+  if (m_supports_qMemoryChecksums == eLazyBoolCalculate) {
+    GetRemoteQSupported();
+  }
+  return m_supports_qMemoryChecksums == eLazyBoolYes;
+}
+
 bool GDBRemoteCommunicationClient::GetAugmentedLibrariesSVR4ReadSupported() {
   if (m_supports_augmented_libraries_svr4_read == eLazyBoolCalculate) {
     GetRemoteQSupported();
@@ -281,6 +290,7 @@ void GDBRemoteCommunicationClient::ResetDiscoverableSettings(bool did_exec) {
     m_supports_vCont_C = eLazyBoolCalculate;
     m_supports_vCont_s = eLazyBoolCalculate;
     m_supports_vCont_S = eLazyBoolCalculate;
+    m_supports_vCont_r = eLazyBoolCalculate;
     m_supports_p = eLazyBoolCalculate;
     m_supports_x = eLazyBoolCalculate;
     m_supports_QSaveRegisterState = eLazyBoolCalculate;
@@ -431,6 +441,11 @@ void GDBRemoteCommunicationClient::GetRemoteQSupported() {
     else
       m_supports_QPassSignals = eLazyBoolNo;
 
+    if (::strstr(response_cstr, "qMemoryChecksums+"))
+      m_supports_qMemoryChecksums = eLazyBoolYes;
+    else
+      m_supports_qMemoryChecksums = eLazyBoolNo;
+
     const char *packet_size_str = ::strstr(response_cstr, "PacketSize=");
     if (packet_size_str) {
       StringExtractorGDBRemote packet_response(packet_size_str +
@@ -469,6 +484,7 @@ bool GDBRemoteCommunicationClient::GetVContSupported(char flavor) {
     m_supports_vCont_C = eLazyBoolNo;
     m_supports_vCont_s = eLazyBoolNo;
     m_supports_vCont_S = eLazyBoolNo;
+    m_supports_vCont_r = eLazyBoolNo;
     if (SendPacketAndWaitForResponse("vCont?", response, false) ==
         PacketResult::Success) {
       const char *response_cstr = response.GetStringRef().c_str();
@@ -484,6 +500,9 @@ bool GDBRemoteCommunicationClient::GetVContSupported(char flavor) {
       if (::strstr(response_cstr, ";S"))
         m_supports_vCont_S = eLazyBoolYes;
 
+      if (::strstr(response_cstr, ";r"))
+        m_supports_vCont_r = eLazyBoolYes;
+
       if (m_supports_vCont_c == eLazyBoolYes &&
           m_supports_vCont_C == eLazyBoolYes &&
           m_supports_vCont_s == eLazyBoolYes &&
@@ -513,6 +532,8 @@ bool GDBRemoteCommunicationClient::GetVContSupported(char flavor) {
     return m_supports_vCont_s;
   case 'S':
     return m_supports_vCont_S;
+  case 'r':
+    return m_supports_vCont_r;
   default:
     break;
   }
@@ -1529,6 +1550,82 @@ Error GDBRemoteCommunicationClient::GetMemoryRegionInfo(
   return error;
 }
 
+Error GDBRemoteCommunicationClient::GetMemoryChecksums(
+    llvm::ArrayRef<MemoryCache::AddrRange> ranges,
+    std::vector<llvm::Optional<uint32_t>> &checksums) {
+  Error error;
+  checksums.clear();
+
+  if (!GetMemoryChecksumsSupported()) {
+    error.SetErrorString("qMemoryChecksums is not supported");
+    return error;
+  }
+
+  // Each range needs at most 34 bytes in the packet ("<addr>,<size>;"), so
+  // send as many ranges per packet as the remote side will accept.
+  const uint64_t max_packet_size =
+      std::min<uint64_t>(GetRemoteMaxPacketSize(), 64 * 1024);
+  const size_t max_ranges_per_packet =
+      std::max<uint64_t>(1, (max_packet_size - 32) / 34);
+
+  while (!ranges.empty()) {
+    llvm::ArrayRef<MemoryCache::AddrRange> batch =
+        ranges.take_front(max_ranges_per_packet);
+    ranges = ranges.drop_front(batch.size());
+
+    StreamString packet;
+    packet.PutCString("qMemoryChecksums:");
+    for (size_t i = 0; i < batch.size(); ++i)
+      packet.Printf("%s%" PRIx64 ",%" PRIx64, i == 0 ? "" : ";",
+                    batch[i].GetRangeBase(), batch[i].GetByteSize());
+
+    StringExtractorGDBRemote response;
+    if (SendPacketAndWaitForResponse(packet.GetString(), response, false) !=
+        PacketResult::Success) {
+      error.SetErrorString("failed to send qMemoryChecksums packet");
+      break;
+    }
+    if (response.IsUnsupportedResponse()) {
+      m_supports_qMemoryChecksums = eLazyBoolNo;
+      error.SetErrorString("qMemoryChecksums is not supported");
+      break;
+    }
+    if (response.IsErrorResponse()) {
+      error.SetErrorString("qMemoryChecksums failed");
+      break;
+    }
+
+    // The response has one entry per range, separated by ';'. Each entry is
+    // either the hex CRC-32 of the range or 'x' if it couldn't be read.
+    for (size_t i = 0; i < batch.size() && error.Success(); ++i) {
+      if (i > 0 && response.GetChar() != ';') {
+        error.SetErrorString("invalid qMemoryChecksums response");
+        break;
+      }
+      if (response.PeekChar() == 'x') {
+        response.GetChar();
+        checksums.push_back(llvm::None);
+        continue;
+      }
+      const uint64_t checksum = response.GetHexMaxU64(false, UINT64_MAX);
+      if (checksum > UINT32_MAX)
+        error.SetErrorString("invalid qMemoryChecksums response");
+      else
+        checksums.push_back(static_cast<uint32_t>(checksum));
+    }
+    if (error.Fail())
+      break;
+    if (response.GetBytesLeft() != 0) {
+      error.SetErrorString("invalid qMemoryChecksums response");
+      break;
+    }
+  }
+
+  if (error.Fail())
+    checksums.clear();
+  return error;
+}
+
 Error GDBRemoteCommunicationClient::GetWatchpointSupportInfo(uint32_t &num) {
   Error error;
 
@@ -234,6 +234,9 @@ public:
 
   Error GetMemoryRegionInfo(lldb::addr_t addr, MemoryRegionInfo &range_info);
 
+  Error GetMemoryChecksums(llvm::ArrayRef<MemoryCache::AddrRange> ranges,
+                           std::vector<llvm::Optional<uint32_t>> &checksums);
+
   Error GetWatchpointSupportInfo(uint32_t &num);
 
   Error GetWatchpointSupportInfo(uint32_t &num, bool &after,
@@ -349,6 +352,8 @@ public:
 
   bool GetQPassSignalsSupported();
 
+  bool GetMemoryChecksumsSupported();
+
   bool GetAugmentedLibrariesSVR4ReadSupported();
 
   bool GetQXferFeaturesReadSupported();
@@ -509,6 +514,7 @@ protected:
   LazyBool m_supports_vCont_C;
   LazyBool m_supports_vCont_s;
   LazyBool m_supports_vCont_S;
+  LazyBool m_supports_vCont_r;
   LazyBool m_qHostInfo_is_valid;
   LazyBool m_curr_pid_is_valid;
   LazyBool m_qProcessInfo_is_valid;
@@ -533,6 +539,7 @@ protected:
   LazyBool m_supports_jLoadedDynamicLibrariesInfos;
   LazyBool m_supports_jGetSharedCacheInfo;
   LazyBool m_supports_QPassSignals;
+  LazyBool m_supports_qMemoryChecksums;
 
   bool m_supports_qProcessInfoPID : 1, m_supports_qfProcessInfo : 1,
       m_supports_qUserName : 1, m_supports_qGroupName : 1,
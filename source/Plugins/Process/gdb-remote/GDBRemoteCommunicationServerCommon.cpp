@@ -524,7 +524,7 @@ GDBRemoteCommunicationServerCommon::Handle_vFile_Open(
       if (packet.GetChar() == ',') {
         mode_t mode = packet.GetHexMaxU32(false, 0600);
         Error error;
-        const FileSpec path_spec{path, true};
+        const FileSpec path_spec{ResolvePacketPath(path), true};
         int fd = ::open(path_spec.GetCString(), flags, mode);
         const int save_errno = fd == -1 ? errno : 0;
         StreamString response;
@@ -642,7 +642,7 @@ GDBRemoteCommunicationServerCommon::Handle_vFile_Size(
   packet.GetHexByteString(path);
   if (!path.empty()) {
     uint64_t Size;
-    if (llvm::sys::fs::file_size(path, Size))
+    if (llvm::sys::fs::file_size(ResolvePacketPath(path), Size))
       return SendErrorResponse(5);
     StreamString response;
     response.PutChar('F');
@@ -664,7 +664,8 @@ GDBRemoteCommunicationServerCommon::Handle_vFile_Mode(
   packet.GetHexByteString(path);
   if (!path.empty()) {
     Error error;
-    const uint32_t mode = File::GetPermissions(FileSpec{path, true}, error);
+    const uint32_t mode =
+        File::GetPermissions(FileSpec{ResolvePacketPath(path), true}, error);
     StreamString response;
     response.Printf("F%u", mode);
     if (mode == 0 || error.Fail())
@@ -681,7 +682,7 @@ GDBRemoteCommunicationServerCommon::Handle_vFile_Exists(
   std::string path;
   packet.GetHexByteString(path);
   if (!path.empty()) {
-    bool retcode = llvm::sys::fs::exists(path);
+    bool retcode = llvm::sys::fs::exists(ResolvePacketPath(path));
     StreamString response;
     response.PutChar('F');
     response.PutChar(',');
@@ -702,7 +703,10 @@ GDBRemoteCommunicationServerCommon::Handle_vFile_symlink(
   packet.GetHexByteStringTerminatedBy(dst, ',');
   packet.GetChar(); // Skip ',' char
   packet.GetHexByteString(src);
-  Error error = FileSystem::Symlink(FileSpec{src, true}, FileSpec{dst, false});
+  // The link target (dst) is stored as given, only the location of the new
+  // link is resolved.
+  Error error = FileSystem::Symlink(FileSpec{ResolvePacketPath(src), true},
+                                    FileSpec{dst, false});
   StreamString response;
   response.Printf("F%u,%u", error.GetError(), error.GetError());
   return SendPacketNoLock(response.GetString());
@@ -714,7 +718,7 @@ GDBRemoteCommunicationServerCommon::Handle_vFile_unlink(
   packet.SetFilePos(::strlen("vFile:unlink:"));
   std::string path;
   packet.GetHexByteString(path);
-  Error error(llvm::sys::fs::remove(path));
+  Error error(llvm::sys::fs::remove(ResolvePacketPath(path)));
   StreamString response;
   response.Printf("F%u,%u", error.GetError(), error.GetError());
   return SendPacketNoLock(response.GetString());
@@ -736,9 +740,12 @@ GDBRemoteCommunicationServerCommon::Handle_qPlatform_shell(
         packet.GetHexByteString(working_dir);
       int status, signo;
       std::string output;
-      Error err =
-          Host::RunShellCommand(path.c_str(), FileSpec{working_dir, true},
-                                &status, &signo, &output, timeout);
+      // An empty working directory means the server's own.
+      if (working_dir.empty())
+        working_dir = ".";
+      Error err = Host::RunShellCommand(
+          path.c_str(), FileSpec{ResolvePacketPath(working_dir), true},
+          &status, &signo, &output, timeout);
       StreamGDBRemote response;
       if (err.Fail()) {
         response.PutCString("F,");
@@ -772,7 +779,7 @@ GDBRemoteCommunicationServerCommon::Handle_vFile_MD5(
   packet.GetHexByteString(path);
   if (!path.empty()) {
     StreamGDBRemote response;
-    auto Result = llvm::sys::fs::md5_contents(path);
+    auto Result = llvm::sys::fs::md5_contents(ResolvePacketPath(path));
     if (!Result) {
       response.PutCString("F,");
       response.PutCString("x");
@@ -794,7 +801,8 @@ GDBRemoteCommunicationServerCommon::Handle_qPlatform_mkdir(
   if (packet.GetChar() == ',') {
     std::string path;
     packet.GetHexByteString(path);
-    Error error(llvm::sys::fs::create_directory(path, mode));
+    Error error(
+        llvm::sys::fs::create_directory(ResolvePacketPath(path), mode));
 
     StreamGDBRemote response;
     response.Printf("F%u", error.GetError());
@@ -814,7 +822,7 @@ GDBRemoteCommunicationServerCommon::Handle_qPlatform_chmod(
   if (packet.GetChar() == ',') {
     std::string path;
     packet.GetHexByteString(path);
-    Error error(llvm::sys::fs::setPermissions(path, perms));
+    Error error(llvm::sys::fs::setPermissions(ResolvePacketPath(path), perms));
 
     StreamGDBRemote response;
     response.Printf("F%u", error.GetError());
@@ -841,6 +849,7 @@ GDBRemoteCommunicationServerCommon::Handle_qSupported(
 #if defined(__linux__) || defined(__NetBSD__)
   response.PutCString(";QPassSignals+");
   response.PutCString(";qXfer:auxv:read+");
+  response.PutCString(";qMemoryChecksums+");
 #endif
 
   return SendPacketNoLock(response.GetString());
@@ -1272,12 +1281,18 @@ void GDBRemoteCommunicationServerCommon::
 FileSpec GDBRemoteCommunicationServerCommon::FindModuleFile(
     const std::string &module_path, const ArchSpec &arch) {
 #ifdef __ANDROID__
-  return HostInfoAndroid::ResolveLibraryPath(module_path, arch);
+  return HostInfoAndroid::ResolveLibraryPath(ResolvePacketPath(module_path),
+                                             arch);
 #else
-  return FileSpec(module_path, true);
+  return FileSpec(ResolvePacketPath(module_path), true);
 #endif
 }
 
+std::string
+GDBRemoteCommunicationServerCommon::ResolvePacketPath(const std::string &path) {
+  return path;
+}
+
 ModuleSpec GDBRemoteCommunicationServerCommon::GetModuleInfo(
     const std::string &module_path, const std::string &triple) {
   ArchSpec arch(triple.c_str());
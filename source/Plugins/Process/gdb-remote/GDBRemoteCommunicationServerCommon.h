@@ -152,6 +152,13 @@ protected:
   virtual FileSpec FindModuleFile(const std::string &module_path,
                                   const ArchSpec &arch);
 
+  //------------------------------------------------------------------
+  /// Resolve a path received in a file or platform packet. Relative
+  /// paths are relative to the server's working directory, which is the
+  /// working directory of the process unless a subclass keeps its own.
+  //------------------------------------------------------------------
+  virtual std::string ResolvePacketPath(const std::string &path);
+
 private:
   ModuleSpec GetModuleInfo(const std::string &module_path,
                            const std::string &triple);
@@ -43,6 +43,7 @@
 #include "lldb/Utility/StreamString.h"
 #include "lldb/Utility/UriParser.h"
 #include "llvm/ADT/Triple.h"
+#include "llvm/Support/JamCRC.h"
 #include "llvm/Support/ScopedPrinter.h"
 
 // Project includes
@@ -125,6 +126,9 @@ void GDBRemoteCommunicationServerLLGS::RegisterPacketHandlers() {
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_qMemoryRegionInfoSupported,
       &GDBRemoteCommunicationServerLLGS::Handle_qMemoryRegionInfoSupported);
+  RegisterMemberFunctionHandler(
+      StringExtractorGDBRemote::eServerPacketType_qMemoryChecksums,
+      &GDBRemoteCommunicationServerLLGS::Handle_qMemoryChecksums);
   RegisterMemberFunctionHandler(
       StringExtractorGDBRemote::eServerPacketType_qProcessInfo,
       &GDBRemoteCommunicationServerLLGS::Handle_qProcessInfo);
@@ -1328,7 +1332,7 @@ GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_vCont_actions(
     StringExtractorGDBRemote &packet) {
   StreamString response;
-  response.Printf("vCont;c;C;s;S");
+  response.Printf("vCont;c;C;s;S;r");
 
   return SendPacketNoLock(response.GetString());
 }
@@ -1382,6 +1386,8 @@ GDBRemoteCommunicationServerLLGS::Handle_vCont(
     thread_action.tid = LLDB_INVALID_THREAD_ID;
     thread_action.state = eStateInvalid;
     thread_action.signal = 0;
+    thread_action.range_start = 0;
+    thread_action.range_end = 0;
 
     const char action = packet.GetChar();
     switch (action) {
@@ -1409,6 +1415,19 @@ GDBRemoteCommunicationServerLLGS::Handle_vCont(
       thread_action.state = eStateStepping;
       break;
 
+    case 'r':
+      // Step until the PC leaves [start, end)
+      thread_action.state = eStateStepping;
+      thread_action.range_start = packet.GetHexMaxU64(false, 0);
+      if (packet.GetChar() != ',')
+        return SendIllFormedResponse(
+            packet, "Missing range end in vCont packet r action");
+      thread_action.range_end = packet.GetHexMaxU64(false, 0);
+      if (thread_action.range_end <= thread_action.range_start)
+        return SendIllFormedResponse(
+            packet, "Invalid range in vCont packet r action");
+      break;
+
     default:
       return SendIllFormedResponse(packet, "Unsupported vCont action");
       break;
@@ -2409,6 +2428,68 @@ GDBRemoteCommunicationServerLLGS::Handle_qMemoryRegionInfo(
   return SendPacketNoLock(response.GetString());
 }
 
+GDBRemoteCommunication::PacketResult
+GDBRemoteCommunicationServerLLGS::Handle_qMemoryChecksums(
+    StringExtractorGDBRemote &packet) {
+  Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PROCESS));
+
+  // Ensure we have a process.
+  if (!m_debugged_process_sp ||
+      (m_debugged_process_sp->GetID() == LLDB_INVALID_PROCESS_ID)) {
+    if (log)
+      log->Printf(
+          "GDBRemoteCommunicationServerLLGS::%s failed, no process available",
+          __FUNCTION__);
+    return SendErrorResponse(0x15);
+  }
+
+  // qMemoryChecksums:<addr>,<size>[;<addr>,<size>]...
+  packet.SetFilePos(strlen("qMemoryChecksums:"));
+  if (packet.GetBytesLeft() < 1)
+    return SendIllFormedResponse(packet, "Too short qMemoryChecksums: packet");
+
+  StreamGDBRemote response;
+  std::vector<char> buf;
+  bool first = true;
+  while (packet.GetBytesLeft() > 0) {
+    if (!first && packet.GetChar() != ';')
+      return SendIllFormedResponse(packet,
+                                   "Range separator missing in "
+                                   "qMemoryChecksums: packet");
+    const lldb::addr_t addr = packet.GetHexMaxU64(false, LLDB_INVALID_ADDRESS);
+    if (packet.GetChar() != ',')
+      return SendIllFormedResponse(packet,
+                                   "Comma sep missing in qMemoryChecksums: "
+                                   "packet");
+    const uint64_t byte_count = packet.GetHexMaxU64(false, 0);
+    // Ranges are expected to be memory cache blocks; don't let a malformed
+    // packet make us allocate an unreasonable amount of memory.
+    if (addr == LLDB_INVALID_ADDRESS || byte_count == 0 ||
+        byte_count > 16 * 1024 * 1024)
+      return SendIllFormedResponse(packet,
+                                   "Invalid range in qMemoryChecksums: packet");
+
+    if (!first)
+      response.PutChar(';');
+    first = false;
+
+    buf.resize(byte_count);
+    size_t bytes_read = 0;
+    Error error = m_debugged_process_sp->ReadMemoryWithoutTrap(
+        addr, buf.data(), byte_count, bytes_read);
+    if (error.Fail() || bytes_read != byte_count) {
+      response.PutChar('x');
+      continue;
+    }
+
+    llvm::JamCRC crc;
+    crc.update(buf);
+    response.Printf("%" PRIx32, crc.getCRC());
+  }
+
+  return SendPacketNoLock(response.GetString());
+}
+
 GDBRemoteCommunication::PacketResult
 GDBRemoteCommunicationServerLLGS::Handle_Z(StringExtractorGDBRemote &packet) {
   // Ensure we have a process.
@@ -179,6 +179,8 @@ protected:
 
   PacketResult Handle_qMemoryRegionInfo(StringExtractorGDBRemote &packet);
 
+  PacketResult Handle_qMemoryChecksums(StringExtractorGDBRemote &packet);
+
   PacketResult Handle_Z(StringExtractorGDBRemote &packet);
 
   PacketResult Handle_z(StringExtractorGDBRemote &packet);
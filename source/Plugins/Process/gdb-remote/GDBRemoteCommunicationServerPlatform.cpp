@@ -20,6 +20,7 @@
 
 // Other libraries and framework includes
 #include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
 #include "llvm/Support/Threading.h"
 
 #include "lldb/Core/StructuredData.h"
@@ -52,7 +53,9 @@ GDBRemoteCommunicationServerPlatform::GDBRemoteCommunicationServerPlatform(
     : GDBRemoteCommunicationServerCommon("gdb-remote.server",
                                          "gdb-remote.server.rx_packet"),
       m_socket_protocol(socket_protocol), m_socket_scheme(socket_scheme),
-      m_spawned_pids_mutex(), m_port_map(), m_port_offset(0) {
+      m_spawned_pids_mutex(),
+      m_port_map_sp(std::make_shared<SharedPortMap>()), m_port_offset(0),
+      m_use_session_working_dir(false) {
   m_pending_gdb_server.pid = LLDB_INVALID_PROCESS_ID;
   m_pending_gdb_server.port = 0;
 
@@ -119,6 +122,8 @@ Error GDBRemoteCommunicationServerPlatform::LaunchGDBServer(
   // Do not run in a new session so that it can not linger after the
   // platform closes.
   debugserver_launch_info.SetLaunchInSeparateProcessGroup(false);
+  if (m_session_working_dir)
+    debugserver_launch_info.SetWorkingDirectory(m_session_working_dir);
   debugserver_launch_info.SetMonitorProcessCallback(
       std::bind(&GDBRemoteCommunicationServerPlatform::DebugserverProcessReaped,
                 this, std::placeholders::_1),
@@ -355,7 +360,9 @@ GDBRemoteCommunicationServerPlatform::Handle_qGetWorkingDir(
     StringExtractorGDBRemote &packet) {
 
   llvm::SmallString<64> cwd;
-  if (std::error_code ec = llvm::sys::fs::current_path(cwd))
+  if (m_session_working_dir)
+    cwd = m_session_working_dir.GetPath();
+  else if (std::error_code ec = llvm::sys::fs::current_path(cwd))
     return SendErrorResponse(ec.value());
 
   StreamString response;
@@ -370,6 +377,19 @@ GDBRemoteCommunicationServerPlatform::Handle_QSetWorkingDir(
   std::string path;
   packet.GetHexByteString(path);
 
+  if (m_use_session_working_dir) {
+    // Relative paths are relative to the previous session directory.
+    llvm::SmallString<64> abs_path(path);
+    if (m_session_working_dir)
+      llvm::sys::fs::make_absolute(m_session_working_dir.GetPath(), abs_path);
+    else if (std::error_code ec = llvm::sys::fs::make_absolute(abs_path))
+      return SendErrorResponse(ec.value());
+    if (!llvm::sys::fs::is_directory(abs_path))
+      return SendErrorResponse(ENOTDIR);
+    m_session_working_dir.SetFile(abs_path, false);
+    return SendOKResponse();
+  }
+
   if (std::error_code ec = llvm::sys::fs::set_current_path(path))
     return SendErrorResponse(ec.value());
   return SendOKResponse();
@@ -436,9 +456,15 @@ bool GDBRemoteCommunicationServerPlatform::DebugserverProcessReaped(
   std::lock_guard<std::recursive_mutex> guard(m_spawned_pids_mutex);
   FreePortForProcess(pid);
   m_spawned_pids.erase(pid);
+  m_spawned_pids_cv.notify_all();
   return true;
 }
 
+void GDBRemoteCommunicationServerPlatform::WaitForSpawnedProcesses() {
+  std::unique_lock<std::recursive_mutex> lock(m_spawned_pids_mutex);
+  m_spawned_pids_cv.wait(lock, [this] { return m_spawned_pids.empty(); });
+}
+
 Error GDBRemoteCommunicationServerPlatform::LaunchProcess() {
   if (!m_process_launch_info.GetArguments().GetArgumentCount())
     return Error("%s: no process command line specified to launch",
@@ -454,6 +480,9 @@ Error GDBRemoteCommunicationServerPlatform::LaunchProcess() {
             this, std::placeholders::_1),
         false);
 
+  if (m_session_working_dir && !m_process_launch_info.GetWorkingDirectory())
+    m_process_launch_info.SetWorkingDirectory(m_session_working_dir);
+
   Error error = Host::LaunchProcess(m_process_launch_info);
   if (!error.Success()) {
     fprintf(stderr, "%s: failed to launch executable %s", __FUNCTION__,
@@ -477,16 +506,41 @@ Error GDBRemoteCommunicationServerPlatform::LaunchProcess() {
   return error;
 }
 
+std::string GDBRemoteCommunicationServerPlatform::ResolvePacketPath(
+    const std::string &path) {
+  if (!m_session_working_dir || path.empty() ||
+      !llvm::sys::path::is_relative(path))
+    return path;
+
+  llvm::SmallString<64> abs_path(path);
+  llvm::sys::fs::make_absolute(m_session_working_dir.GetPath(), abs_path);
+  return abs_path.str();
+}
+
+void GDBRemoteCommunicationServerPlatform::SetUseSessionWorkingDirectory(
+    bool enable) {
+  m_use_session_working_dir = enable;
+}
+
 void GDBRemoteCommunicationServerPlatform::SetPortMap(PortMap &&port_map) {
-  m_port_map = port_map;
+  std::lock_guard<std::mutex> guard(m_port_map_sp->mutex);
+  m_port_map_sp->ports = std::move(port_map);
+}
+
+void GDBRemoteCommunicationServerPlatform::SetSharedPortMap(
+    const SharedPortMapSP &port_map_sp) {
+  if (port_map_sp)
+    m_port_map_sp = port_map_sp;
 }
 
 uint16_t GDBRemoteCommunicationServerPlatform::GetNextAvailablePort() {
-  if (m_port_map.empty())
+  std::lock_guard<std::mutex> guard(m_port_map_sp->mutex);
+  PortMap &port_map = m_port_map_sp->ports;
+  if (port_map.empty())
     return 0; // Bind to port zero and get a port, we didn't have any
               // limitations
 
-  for (auto &pair : m_port_map) {
+  for (auto &pair : port_map) {
     if (pair.second == LLDB_INVALID_PROCESS_ID) {
       pair.second = ~(lldb::pid_t)LLDB_INVALID_PROCESS_ID;
       return pair.first;
@@ -497,8 +551,9 @@ uint16_t GDBRemoteCommunicationServerPlatform::GetNextAvailablePort() {
 
 bool GDBRemoteCommunicationServerPlatform::AssociatePortWithProcess(
     uint16_t port, lldb::pid_t pid) {
-  PortMap::iterator pos = m_port_map.find(port);
-  if (pos != m_port_map.end()) {
+  std::lock_guard<std::mutex> guard(m_port_map_sp->mutex);
+  PortMap::iterator pos = m_port_map_sp->ports.find(port);
+  if (pos != m_port_map_sp->ports.end()) {
     pos->second = pid;
     return true;
   }
@@ -506,8 +561,9 @@ bool GDBRemoteCommunicationServerPlatform::AssociatePortWithProcess(
 }
 
 bool GDBRemoteCommunicationServerPlatform::FreePort(uint16_t port) {
-  PortMap::iterator pos = m_port_map.find(port);
-  if (pos != m_port_map.end()) {
+  std::lock_guard<std::mutex> guard(m_port_map_sp->mutex);
+  PortMap::iterator pos = m_port_map_sp->ports.find(port);
+  if (pos != m_port_map_sp->ports.end()) {
     pos->second = LLDB_INVALID_PROCESS_ID;
     return true;
   }
@@ -515,12 +571,11 @@ bool GDBRemoteCommunicationServerPlatform::FreePort(uint16_t port) {
 }
 
 bool GDBRemoteCommunicationServerPlatform::FreePortForProcess(lldb::pid_t pid) {
-  if (!m_port_map.empty()) {
-    for (auto &pair : m_port_map) {
-      if (pair.second == pid) {
-        pair.second = LLDB_INVALID_PROCESS_ID;
-        return true;
-      }
+  std::lock_guard<std::mutex> guard(m_port_map_sp->mutex);
+  for (auto &pair : m_port_map_sp->ports) {
+    if (pair.second == pid) {
+      pair.second = LLDB_INVALID_PROCESS_ID;
+      return true;
     }
   }
   return false;
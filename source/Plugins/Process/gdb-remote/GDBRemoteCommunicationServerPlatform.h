@@ -12,7 +12,9 @@
 
 // C Includes
 // C++ Includes
+#include <condition_variable>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <set>
 
@@ -29,6 +31,18 @@ class GDBRemoteCommunicationServerPlatform
 public:
   typedef std::map<uint16_t, lldb::pid_t> PortMap;
 
+  //----------------------------------------------------------------------
+  // The ports gdbserver instances may be launched on, along with the mutex
+  // that guards them. Platform servers that run as sessions inside the same
+  // lldb-server process share one of these so that they never hand out the
+  // same port twice.
+  //----------------------------------------------------------------------
+  struct SharedPortMap {
+    std::mutex mutex;
+    PortMap ports;
+  };
+  typedef std::shared_ptr<SharedPortMap> SharedPortMapSP;
+
   GDBRemoteCommunicationServerPlatform(
       const Socket::SocketProtocol socket_protocol, const char *socket_scheme);
 
@@ -40,6 +54,10 @@ public:
   // a port chosen by the OS.
   void SetPortMap(PortMap &&port_map);
 
+  // Use a port map that is shared with other platform servers in this
+  // process.
+  void SetSharedPortMap(const SharedPortMapSP &port_map_sp);
+
   //----------------------------------------------------------------------
   // If we are using a port map where we can only use certain ports,
   // get the next available port.
@@ -59,6 +77,14 @@ public:
 
   void SetPortOffset(uint16_t port_offset);
 
+  //----------------------------------------------------------------------
+  // Keep the working directory set by QSetWorkingDir in this server
+  // instead of changing the working directory of the whole process. This is
+  // needed when several platform sessions are served by one process.
+  // Processes launched by this server start in that directory.
+  //----------------------------------------------------------------------
+  void SetUseSessionWorkingDirectory(bool enable);
+
   void SetInferiorArguments(const lldb_private::Args &args);
 
   Error LaunchGDBServer(const lldb_private::Args &args, std::string hostname,
@@ -68,14 +94,25 @@ public:
   void SetPendingGdbServer(lldb::pid_t pid, uint16_t port,
                            const std::string &socket_name);
 
+  //----------------------------------------------------------------------
+  // Block until every process launched by this server has been reaped.
+  // The monitor callbacks of those processes refer to this object, so a
+  // server that does not own the whole process must call this before it
+  // goes away.
+  //----------------------------------------------------------------------
+  void WaitForSpawnedProcesses();
+
 protected:
   const Socket::SocketProtocol m_socket_protocol;
   const std::string m_socket_scheme;
   std::recursive_mutex m_spawned_pids_mutex;
   std::set<lldb::pid_t> m_spawned_pids;
+  std::condition_variable_any m_spawned_pids_cv;
 
-  PortMap m_port_map;
+  SharedPortMapSP m_port_map_sp;
   uint16_t m_port_offset;
+  bool m_use_session_working_dir;
+  FileSpec m_session_working_dir;
   struct {
     lldb::pid_t pid;
     uint16_t port;
@@ -98,6 +135,8 @@ protected:
 
   PacketResult Handle_jSignalsInfo(StringExtractorGDBRemote &packet);
 
+  std::string ResolvePacketPath(const std::string &path) override;
+
 private:
   bool KillSpawnedProcess(lldb::pid_t pid);
 
@@ -251,7 +251,8 @@ ProcessGDBRemote::ProcessGDBRemote(lldb::TargetSP target_sp,
       m_async_thread_state_mutex(), m_thread_ids(), m_thread_pcs(),
       m_jstopinfo_sp(), m_jthreadsinfo_sp(), m_continue_c_tids(),
       m_continue_C_tids(), m_continue_s_tids(), m_continue_S_tids(),
-      m_max_memory_size(0), m_remote_stub_max_memory_size(0),
+      m_continue_step_ranges(), m_max_memory_size(0),
+      m_remote_stub_max_memory_size(0),
       m_addr_to_mmap_size(), m_thread_create_bp_sp(),
       m_waiting_for_attach(false), m_destroy_tried_resuming(false),
       m_command_sp(), m_breakpoint_pc_offset(0),
@@ -1252,7 +1253,9 @@ Error ProcessGDBRemote::WillResume() {
   m_continue_C_tids.clear();
   m_continue_s_tids.clear();
   m_continue_S_tids.clear();
+  m_continue_step_ranges.clear();
   m_jstopinfo_sp.reset();
+  m_jstopinfo_tids.clear();
   m_jthreadsinfo_sp.reset();
   return Error();
 }
@@ -1310,11 +1313,19 @@ Error ProcessGDBRemote::DoResume() {
 
         if (!continue_packet_error && !m_continue_s_tids.empty()) {
           if (m_gdb_comm.GetVContSupported('s')) {
+            const bool range_stepping = m_gdb_comm.GetVContSupported('r');
             for (tid_collection::const_iterator
                      t_pos = m_continue_s_tids.begin(),
                      t_end = m_continue_s_tids.end();
-                 t_pos != t_end; ++t_pos)
-              continue_packet.Printf(";s:%4.4" PRIx64, *t_pos);
+                 t_pos != t_end; ++t_pos) {
+              auto range_pos = m_continue_step_ranges.find(*t_pos);
+              if (range_stepping && range_pos != m_continue_step_ranges.end())
+                continue_packet.Printf(";r%" PRIx64 ",%" PRIx64 ":%4.4" PRIx64,
+                                       range_pos->second.first,
+                                       range_pos->second.second, *t_pos);
+              else
+                continue_packet.Printf(";s:%4.4" PRIx64, *t_pos);
+            }
           } else
             continue_packet_error = true;
         }
@@ -1704,6 +1715,15 @@ bool ProcessGDBRemote::GetThreadStopInfoFromJSON(
   return false;
 }
 
+bool ProcessGDBRemote::ThreadHasNoStopReason(lldb::tid_t tid) const {
+  // "jstopinfo" describes every thread that has a stop reason, see
+  // CalculateThreadStopInfo().
+  if (!m_jstopinfo_sp || !m_jstopinfo_sp->GetAsArray())
+    return false;
+  return !std::binary_search(m_jstopinfo_tids.begin(), m_jstopinfo_tids.end(),
+                             tid);
+}
+
 bool ProcessGDBRemote::CalculateThreadStopInfo(ThreadGDBRemote *thread) {
   // See if we got thread stop infos for all threads via the "jThreadsInfo"
   // packet
@@ -2237,6 +2257,21 @@ StateType ProcessGDBRemote::SetThreadStopInfo(StringExtractor &stop_packet) {
         // This JSON contains thread IDs and thread stop info for all threads.
         // It doesn't contain expedited registers, memory or queue info.
         m_jstopinfo_sp = StructuredData::ParseJSON(json);
+        m_jstopinfo_tids.clear();
+        StructuredData::Array *thread_infos =
+            m_jstopinfo_sp ? m_jstopinfo_sp->GetAsArray() : nullptr;
+        if (thread_infos) {
+          thread_infos->ForEach([this](StructuredData::Object *object) -> bool {
+            StructuredData::Dictionary *thread_dict =
+                object->GetAsDictionary();
+            lldb::tid_t tid;
+            if (thread_dict &&
+                thread_dict->GetValueForKeyAsInteger<lldb::tid_t>("tid", tid))
+              m_jstopinfo_tids.push_back(tid);
+            return true;
+          });
+          std::sort(m_jstopinfo_tids.begin(), m_jstopinfo_tids.end());
+        }
       } else if (key.compare("hexname") == 0) {
         StringExtractor name_extractor(value);
         std::string name;
@@ -2873,6 +2908,12 @@ Error ProcessGDBRemote::GetMemoryRegionInfo(addr_t load_addr,
   return error;
 }
 
+Error ProcessGDBRemote::CalculateMemoryChecksums(
+    llvm::ArrayRef<MemoryCache::AddrRange> ranges,
+    std::vector<llvm::Optional<uint32_t>> &checksums) {
+  return m_gdb_comm.GetMemoryChecksums(ranges, checksums);
+}
+
 Error ProcessGDBRemote::GetWatchpointSupportInfo(uint32_t &num) {
 
   Error error(m_gdb_comm.GetWatchpointSupportInfo(num));
@@ -3962,6 +4003,35 @@ ProcessGDBRemote::GetLoadedDynamicLibrariesInfos_sender(
   return object_sp;
 }
 
+StructuredData::DictionarySP ProcessGDBRemote::GetStatistics() {
+  StructuredData::DictionarySP stats_sp = Process::GetStatistics();
+
+  auto packets_sp = std::make_shared<StructuredData::Dictionary>();
+  uint64_t total_count = 0;
+  std::chrono::nanoseconds total_time(0);
+  for (const auto &pair : m_gdb_comm.GetPacketStatistics()) {
+    const GDBRemoteClientBase::PacketStatistics &packet_stats = pair.second;
+    auto packet_sp = std::make_shared<StructuredData::Dictionary>();
+    packet_sp->AddIntegerItem("count", packet_stats.count);
+    packet_sp->AddFloatItem(
+        "totalTime",
+        std::chrono::duration<double>(packet_stats.total_time).count());
+    packet_sp->AddFloatItem(
+        "maxTime", std::chrono::duration<double>(packet_stats.max_time).count());
+    packets_sp->AddItem(pair.first, packet_sp);
+    total_count += packet_stats.count;
+    total_time += packet_stats.total_time;
+  }
+
+  auto gdb_remote_sp = std::make_shared<StructuredData::Dictionary>();
+  gdb_remote_sp->AddIntegerItem("packetCount", total_count);
+  gdb_remote_sp->AddFloatItem(
+      "totalResponseTime", std::chrono::duration<double>(total_time).count());
+  gdb_remote_sp->AddItem("packets", packets_sp);
+  stats_sp->AddItem("gdbRemote", gdb_remote_sp);
+  return stats_sp;
+}
+
 StructuredData::ObjectSP ProcessGDBRemote::GetSharedCacheInfo() {
   StructuredData::ObjectSP object_sp;
   StructuredData::ObjectSP args_dict(new StructuredData::Dictionary());
@@ -154,6 +154,10 @@ public:
   Error GetMemoryRegionInfo(lldb::addr_t load_addr,
                             MemoryRegionInfo &region_info) override;
 
+  Error CalculateMemoryChecksums(
+      llvm::ArrayRef<MemoryCache::AddrRange> ranges,
+      std::vector<llvm::Optional<uint32_t>> &checksums) override;
+
   Error DoDeallocateMemory(lldb::addr_t ptr) override;
 
   //------------------------------------------------------------------
@@ -230,6 +234,8 @@ public:
 
   StructuredData::ObjectSP GetSharedCacheInfo() override;
 
+  StructuredData::DictionarySP GetStatistics() override;
+
   std::string HarmonizeThreadIdsForProfileData(
       StringExtractorGDBRemote &inputStringExtractor);
 
@@ -264,11 +270,15 @@ protected:
   typedef std::vector<std::pair<lldb::tid_t, int>> tid_sig_collection;
   typedef std::map<lldb::addr_t, lldb::addr_t> MMapMap;
   typedef std::map<uint32_t, std::string> ExpeditedRegisterMap;
+  typedef std::map<lldb::tid_t, std::pair<lldb::addr_t, lldb::addr_t>>
+      StepRangeMap;
   tid_collection m_thread_ids; // Thread IDs for all threads. This list gets
                                // updated after stopping
   std::vector<lldb::addr_t> m_thread_pcs;     // PC values for all the threads.
   StructuredData::ObjectSP m_jstopinfo_sp;    // Stop info only for any threads
                                               // that have valid stop infos
+  tid_collection m_jstopinfo_tids; // Sorted IDs of the threads in
+                                   // m_jstopinfo_sp
   StructuredData::ObjectSP m_jthreadsinfo_sp; // Full stop info, expedited
                                               // registers and memory for all
                                               // threads if "jThreadsInfo"
@@ -277,6 +287,9 @@ protected:
   tid_sig_collection m_continue_C_tids;       // 'C' for continue with signal
   tid_collection m_continue_s_tids;           // 's' for step
   tid_sig_collection m_continue_S_tids;       // 'S' for step with signal
+  StepRangeMap m_continue_step_ranges; // 'r' for the threads in
+                                       // m_continue_s_tids that step through
+                                       // a range
   uint64_t m_max_memory_size; // The maximum number of bytes to read/write when
                               // reading and writing memory
   uint64_t m_remote_stub_max_memory_size; // The maximum memory size the remote
@@ -358,6 +371,10 @@ protected:
   GetThreadStopInfoFromJSON(ThreadGDBRemote *thread,
                             const StructuredData::ObjectSP &thread_infos_sp);
 
+  // True if the stop reply said which threads stopped for a reason and
+  // "tid" isn't one of them.
+  bool ThreadHasNoStopReason(lldb::tid_t tid) const;
+
   lldb::ThreadSP SetThreadStopInfo(StructuredData::Dictionary *thread_dict);
 
   lldb::ThreadSP
@@ -18,6 +18,7 @@
 #include "lldb/Target/StopInfo.h"
 #include "lldb/Target/SystemRuntime.h"
 #include "lldb/Target/Target.h"
+#include "lldb/Target/ThreadPlan.h"
 #include "lldb/Target/UnixSignals.h"
 #include "lldb/Target/Unwind.h"
 #include "lldb/Utility/DataExtractor.h"
@@ -262,8 +263,15 @@ void ThreadGDBRemote::WillResume(StateType resume_state) {
     case eStateStepping:
       if (gdb_process->GetUnixSignals()->SignalIsValid(signo))
         gdb_process->m_continue_S_tids.push_back(std::make_pair(tid, signo));
-      else
+      else {
         gdb_process->m_continue_s_tids.push_back(tid);
+        // Let the remote keep stepping while we are in the plan's range.
+        lldb::addr_t range_start, range_end;
+        ThreadPlan *plan = GetCurrentPlan();
+        if (plan && plan->GetSteppingRange(range_start, range_end))
+          gdb_process->m_continue_step_ranges[tid] =
+              std::make_pair(range_start, range_end);
+      }
       break;
 
     default:
@@ -281,8 +289,12 @@ void ThreadGDBRemote::RefreshStateAfterStop() {
   // which registers are valid by putting hooks in the register read and
   // register supply functions where they check the process stop ID and do
   // the right thing.
+  // If the register context hasn't been made yet, there is nothing to
+  // invalidate, and making it here for every thread is a waste when only a
+  // few of many threads are ever looked at.
   const bool force = false;
-  GetRegisterContext()->InvalidateIfNeeded(force);
+  if (m_reg_context_sp)
+    m_reg_context_sp->InvalidateIfNeeded(force);
 }
 
 bool ThreadGDBRemote::ThreadIDIsValid(lldb::tid_t thread) {
@@ -348,3 +360,11 @@ bool ThreadGDBRemote::CalculateStopInfo() {
         ->CalculateThreadStopInfo(this);
   return false;
 }
+
+bool ThreadGDBRemote::KnownToHaveNoStopReason() {
+  ProcessSP process_sp(GetProcess());
+  if (process_sp)
+    return static_cast<ProcessGDBRemote *>(process_sp.get())
+        ->ThreadHasNoStopReason(GetID());
+  return false;
+}
@@ -115,6 +115,8 @@ protected:
   void SetStopInfoFromPacket(StringExtractor &stop_packet, uint32_t stop_id);
 
   bool CalculateStopInfo() override;
+
+  bool KnownToHaveNoStopReason() override;
 };
 
 } // namespace process_gdb_remote
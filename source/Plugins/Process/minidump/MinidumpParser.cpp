@@ -17,6 +17,7 @@
 
 // C includes
 // C++ includes
+#include <algorithm>
 #include <map>
 
 using namespace lldb_private;
@@ -67,6 +68,7 @@ MinidumpParser::MinidumpParser(
     const lldb::DataBufferSP &data_buf_sp, const MinidumpHeader *header,
     llvm::DenseMap<uint32_t, MinidumpLocationDescriptor> &&directory_map)
     : m_data_sp(data_buf_sp), m_header(header), m_directory_map(directory_map) {
+  IndexMemoryRanges();
 }
 
 llvm::ArrayRef<uint8_t> MinidumpParser::GetData() {
@@ -304,40 +306,31 @@ const MinidumpExceptionStream *MinidumpParser::GetExceptionStream() {
   return MinidumpExceptionStream::Parse(data);
 }
 
-llvm::Optional<minidump::Range>
-MinidumpParser::FindMemoryRange(lldb::addr_t addr) {
+void MinidumpParser::IndexMemoryRanges() {
   llvm::ArrayRef<uint8_t> data = GetStream(MinidumpStreamType::MemoryList);
   llvm::ArrayRef<uint8_t> data64 = GetStream(MinidumpStreamType::Memory64List);
 
-  if (data.empty() && data64.empty())
-    return llvm::None;
-
   if (!data.empty()) {
     llvm::ArrayRef<MinidumpMemoryDescriptor> memory_list =
         MinidumpMemoryDescriptor::ParseMemoryList(data);
 
-    if (memory_list.empty())
-      return llvm::None;
-
     for (const auto &memory_desc : memory_list) {
       const MinidumpLocationDescriptor &loc_desc = memory_desc.memory;
       const lldb::addr_t range_start = memory_desc.start_of_memory_range;
       const size_t range_size = loc_desc.data_size;
 
       if (loc_desc.rva + loc_desc.data_size > GetData().size())
-        return llvm::None;
+        break;
 
-      if (range_start <= addr && addr < range_start + range_size) {
-        return minidump::Range(range_start,
-                               GetData().slice(loc_desc.rva, range_size));
-      }
+      m_memory_ranges.emplace_back(
+          Range(range_start, GetData().slice(loc_desc.rva, range_size)),
+          m_memory_ranges.size());
     }
   }
 
   // Some Minidumps have a Memory64ListStream that captures all the heap
-  // memory (full-memory Minidumps).  We can't exactly use the same loop as
-  // above, because the Minidump uses slightly different data structures to
-  // describe those
+  // memory (full-memory Minidumps).  Its descriptors don't have an RVA each,
+  // the data of all the ranges follows the list contiguously.
 
   if (!data64.empty()) {
     llvm::ArrayRef<MinidumpMemoryDescriptor64> memory64_list;
@@ -345,33 +338,62 @@ MinidumpParser::FindMemoryRange(lldb::addr_t addr) {
     std::tie(memory64_list, base_rva) =
         MinidumpMemoryDescriptor64::ParseMemory64List(data64);
 
-    if (memory64_list.empty())
-      return llvm::None;
-
     for (const auto &memory_desc64 : memory64_list) {
       const lldb::addr_t range_start = memory_desc64.start_of_memory_range;
       const size_t range_size = memory_desc64.data_size;
 
       if (base_rva + range_size > GetData().size())
-        return llvm::None;
+        break;
 
-      if (range_start <= addr && addr < range_start + range_size) {
-        return minidump::Range(range_start,
-                               GetData().slice(base_rva, range_size));
-      }
+      m_memory_ranges.emplace_back(
+          Range(range_start, GetData().slice(base_rva, range_size)),
+          m_memory_ranges.size());
       base_rva += range_size;
     }
   }
 
-  return llvm::None;
+  std::sort(m_memory_ranges.begin(), m_memory_ranges.end(),
+            [](const IndexedRange &lhs, const IndexedRange &rhs) {
+              return lhs.range.start < rhs.range.start;
+            });
+
+  lldb::addr_t max_end = 0;
+  for (IndexedRange &entry : m_memory_ranges) {
+    max_end = std::max<lldb::addr_t>(
+        max_end, entry.range.start + entry.range.range_ref.size());
+    entry.max_end = max_end;
+  }
+}
+
+llvm::Optional<minidump::Range>
+MinidumpParser::FindMemoryRange(lldb::addr_t addr) {
+  // Find the last range that starts at or before addr.
+  auto pos = std::upper_bound(m_memory_ranges.begin(), m_memory_ranges.end(),
+                              addr,
+                              [](lldb::addr_t addr, const IndexedRange &entry) {
+                                return addr < entry.range.start;
+                              });
+
+  // Walk back over the ranges that start before addr until none of the
+  // remaining ones reach it. Ranges don't normally overlap, so this usually
+  // looks at a single range.
+  const IndexedRange *match = nullptr;
+  while (pos != m_memory_ranges.begin()) {
+    --pos;
+    if (pos->max_end <= addr)
+      break;
+    if (addr < pos->range.start + pos->range.range_ref.size() &&
+        (!match || pos->order < match->order))
+      match = &*pos;
+  }
+
+  if (!match)
+    return llvm::None;
+  return match->range;
 }
 
 llvm::ArrayRef<uint8_t> MinidumpParser::GetMemory(lldb::addr_t addr,
                                                   size_t size) {
-  // I don't have a sense of how frequently this is called or how many memory
-  // ranges a Minidump typically has, so I'm not sure if searching for the
-  // appropriate range linearly each time is stupid.  Perhaps we should build
-  // an index for faster lookups.
   llvm::Optional<minidump::Range> range = FindMemoryRange(addr);
   if (!range)
     return {};
@@ -29,6 +29,7 @@
 // C++ includes
 #include <cstring>
 #include <unordered_map>
+#include <vector>
 
 namespace lldb_private {
 
@@ -88,9 +89,27 @@ public:
   llvm::Optional<MemoryRegionInfo> GetMemoryRegionInfo(lldb::addr_t);
 
 private:
+  struct IndexedRange {
+    Range range;
+    // Position of the range in the streams, MemoryList first. When ranges
+    // overlap the one that comes first wins.
+    size_t order;
+    // The largest end address of this and all the preceding ranges.
+    lldb::addr_t max_end;
+
+    IndexedRange(const Range &range, size_t order)
+        : range(range), order(order), max_end(0) {}
+  };
+
+  // Collect the ranges of the MemoryList and Memory64List streams, sorted by
+  // start address, so FindMemoryRange can binary search them. This is done
+  // once, when the parser is created.
+  void IndexMemoryRanges();
+
   lldb::DataBufferSP m_data_sp;
   const MinidumpHeader *m_header;
   llvm::DenseMap<uint32_t, MinidumpLocationDescriptor> m_directory_map;
+  std::vector<IndexedRange> m_memory_ranges;
 
   MinidumpParser(
       const lldb::DataBufferSP &data_buf_sp, const MinidumpHeader *header,
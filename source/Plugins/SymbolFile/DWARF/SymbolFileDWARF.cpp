@@ -1924,6 +1924,35 @@ void SymbolFileDWARF::Index() {
   Timer scoped_timer(
       LLVM_PRETTY_FUNCTION, "SymbolFileDWARF::Index (%s)",
       GetObjectFile()->GetFileSpec().GetFilename().AsCString("<Unknown>"));
+  ModuleSP module_sp(GetObjectFile()->GetModule());
+  std::atomic<uint64_t> unused_nanos(0);
+  ScopedTimeAccumulator index_time(
+      module_sp ? module_sp->GetStatistics().debug_info_index_nanos
+                : unused_nanos);
+
+  // Load the sections indexing reads concurrently. Compressed sections are
+  // decompressed when they are first loaded, and each of them is a single
+  // zlib stream, so this is where decompression gets parallelized.
+  //
+  // Relocating the debug sections of a relocatable object file needs its
+  // symbol table, and parsing that takes the module mutex, which the thread
+  // indexing usually holds. Parse it here so the tasks never wait for the
+  // mutex, and load the sections on this thread if there is no symbol table
+  // because then every task would try to parse it again.
+  if (m_obj_file->GetType() != ObjectFile::eTypeObjectFile ||
+      m_obj_file->GetSymtab()) {
+    TaskPool::RunTasks([this]() { get_debug_info_data(); },
+                       [this]() { get_debug_abbrev_data(); },
+                       [this]() { get_debug_str_data(); },
+                       [this]() { get_debug_str_offsets_data(); },
+                       [this]() { get_debug_addr_data(); });
+  } else {
+    get_debug_info_data();
+    get_debug_abbrev_data();
+    get_debug_str_data();
+    get_debug_str_offsets_data();
+    get_debug_addr_data();
+  }
 
   DWARFDebugInfo *debug_info = DebugInfo();
   if (debug_info) {
@@ -501,6 +501,15 @@ size_t ObjectFile::ReadSectionData(const Section *section,
                                       dst_len, error);
     }
   } else {
+    if (DataBufferSP data_sp = GetSectionDataCopy(section)) {
+      if (section_offset >= data_sp->GetByteSize())
+        return 0;
+      const size_t copy_len =
+          std::min<uint64_t>(dst_len, data_sp->GetByteSize() - section_offset);
+      memcpy(dst, data_sp->GetBytes() + section_offset, copy_len);
+      return copy_len;
+    }
+
     const lldb::offset_t section_file_size = section->GetFileSize();
     if (section_offset < section_file_size) {
       const size_t section_bytes_left = section_file_size - section_offset;
@@ -568,6 +577,13 @@ size_t ObjectFile::MemoryMapSectionData(const Section *section,
   if (IsInMemory()) {
     return ReadSectionData(section, section_data);
   } else {
+    if (DataBufferSP data_sp = GetSectionDataCopy(section)) {
+      section_data.SetData(data_sp, 0, data_sp->GetByteSize());
+      section_data.SetByteOrder(m_data.GetByteOrder());
+      section_data.SetAddressByteSize(m_data.GetAddressByteSize());
+      return section_data.GetByteSize();
+    }
+
     // The object file now contains a full mmap'ed copy of the object file data,
     // so just use this
     return GetData(section->GetFileOffset(), section->GetFileSize(),
@@ -575,6 +591,63 @@ size_t ObjectFile::MemoryMapSectionData(const Section *section,
   }
 }
 
+DataBufferSP ObjectFile::GetSectionDataCopy(const Section *section) const {
+  const lldb::user_id_t section_id = section->GetID();
+  {
+    std::lock_guard<std::mutex> guard(m_section_data_mutex);
+    auto pos = m_section_data_copies.find(section_id);
+    if (pos != m_section_data_copies.end())
+      return pos->second;
+  }
+
+  // Don't hold the lock while the plug-in creates the copy: it may have to
+  // read other sections, like the symbol table relocations refer to.
+  DataBufferSP data_sp =
+      const_cast<ObjectFile *>(this)->CreateSectionDataCopy(section);
+
+  // Another thread may have created the copy meanwhile, keep the first one
+  // so that every reader sees the same bytes.
+  std::lock_guard<std::mutex> guard(m_section_data_mutex);
+  return m_section_data_copies.emplace(section_id, data_sp).first->second;
+}
+
+void ObjectFile::GetSectionDataByteSizes(uint64_t &mapped_byte_size,
+                                         uint64_t &heap_byte_size) const {
+  mapped_byte_size = 0;
+  heap_byte_size = 0;
+
+  uint64_t file_byte_size = 0;
+  if (m_sections_ap) {
+    const size_t num_sections = m_sections_ap->GetSize();
+    for (size_t i = 0; i < num_sections; ++i) {
+      // Segments contain their sections, so only look at the top level.
+      SectionSP section_sp = m_sections_ap->GetSectionAtIndex(i);
+      if (section_sp && section_sp->GetObjectFile() == this)
+        file_byte_size += section_sp->GetFileSize();
+    }
+  }
+
+  // In memory object files and files we didn't map, e.g. because they are
+  // on a network file system, are read into the heap.
+  const DataBufferSP &data_sp = m_data.GetSharedDataBuffer();
+  if (!IsInMemory() && data_sp && data_sp->IsMemoryMapped())
+    mapped_byte_size = file_byte_size;
+  else
+    heap_byte_size = file_byte_size;
+
+  // Copies can be mapped too, e.g. decompressed sections from the module
+  // cache.
+  std::lock_guard<std::mutex> guard(m_section_data_mutex);
+  for (const auto &entry : m_section_data_copies) {
+    if (!entry.second)
+      continue;
+    if (entry.second->IsMemoryMapped())
+      mapped_byte_size += entry.second->GetByteSize();
+    else
+      heap_byte_size += entry.second->GetByteSize();
+  }
+}
+
 bool ObjectFile::SplitArchivePathWithObject(const char *path_with_object,
                                             FileSpec &archive_file,
                                             ConstString &archive_object,
@@ -29,7 +29,8 @@ using namespace lldb_private;
 Symtab::Symtab(ObjectFile *objfile)
     : m_objfile(objfile), m_symbols(), m_file_addr_to_index(),
       m_name_to_index(), m_mutex(), m_file_addr_to_index_computed(false),
-      m_name_indexes_computed(false) {}
+      m_name_indexes_computed(false), m_lazy_names(),
+      m_lazy_name_decoder(nullptr), m_has_lazy_names(false) {}
 
 Symtab::~Symtab() {}
 
@@ -68,8 +69,45 @@ void Symtab::SectionFileAddressesChanged() {
   m_file_addr_to_index_computed = false;
 }
 
+void Symtab::SetLazyNames(LazyNames lazy_names, NameDecoder decoder) {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  DecodeAllLazyNames();
+  if (!decoder || lazy_names.names.empty())
+    return;
+  m_lazy_names = std::move(lazy_names);
+  m_lazy_name_decoder = decoder;
+  m_has_lazy_names = true;
+}
+
+void Symtab::DecodeLazyName(size_t idx) const {
+  if (!m_has_lazy_names)
+    return;
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  if (idx < m_lazy_names.names.size() && m_lazy_names.names[idx]) {
+    const_cast<Symbol &>(m_symbols[idx]).GetMangled() =
+        m_lazy_name_decoder(m_lazy_names.names[idx]);
+    m_lazy_names.names[idx] = nullptr;
+  }
+}
+
+void Symtab::DecodeAllLazyNames() const {
+  if (!m_has_lazy_names)
+    return;
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  const size_t num_names =
+      std::min(m_lazy_names.names.size(), m_symbols.size());
+  for (size_t idx = 0; idx < num_names; ++idx) {
+    if (m_lazy_names.names[idx])
+      const_cast<Symbol &>(m_symbols[idx]).GetMangled() =
+          m_lazy_name_decoder(m_lazy_names.names[idx]);
+  }
+  m_lazy_names = LazyNames();
+  m_has_lazy_names = false;
+}
+
 void Symtab::Dump(Stream *s, Target *target, SortOrder sort_order) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  DecodeAllLazyNames();
 
   //    s->Printf("%.*p: ", (int)sizeof(void*) * 2, this);
   s->Indent();
@@ -143,6 +181,7 @@ void Symtab::Dump(Stream *s, Target *target, SortOrder sort_order) {
 void Symtab::Dump(Stream *s, Target *target,
                   std::vector<uint32_t> &indexes) const {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  DecodeAllLazyNames();
 
   const size_t num_symbols = GetNumSymbols();
   // s->Printf("%.*p: ", (int)sizeof(void*) * 2, this);
@@ -194,22 +233,28 @@ Symbol *Symtab::FindSymbolByID(lldb::user_id_t symbol_uid) const {
   Symbol *symbol =
       (Symbol *)::bsearch(&symbol_uid, &m_symbols[0], m_symbols.size(),
                           sizeof(m_symbols[0]), CompareSymbolID);
+  if (symbol)
+    DecodeLazyName(symbol - &m_symbols[0]);
   return symbol;
 }
 
 Symbol *Symtab::SymbolAtIndex(size_t idx) {
   // Clients should grab the mutex from this symbol table and lock it manually
   // when calling this function to avoid performance issues.
-  if (idx < m_symbols.size())
+  if (idx < m_symbols.size()) {
+    DecodeLazyName(idx);
     return &m_symbols[idx];
+  }
   return nullptr;
 }
 
 const Symbol *Symtab::SymbolAtIndex(size_t idx) const {
   // Clients should grab the mutex from this symbol table and lock it manually
   // when calling this function to avoid performance issues.
-  if (idx < m_symbols.size())
+  if (idx < m_symbols.size()) {
+    DecodeLazyName(idx);
     return &m_symbols[idx];
+  }
   return nullptr;
 }
 
@@ -220,7 +265,13 @@ void Symtab::InitNameIndexes() {
   // Protected function, no need to lock mutex...
   if (!m_name_indexes_computed) {
     m_name_indexes_computed = true;
+    DecodeAllLazyNames();
     Timer scoped_timer(LLVM_PRETTY_FUNCTION, "%s", LLVM_PRETTY_FUNCTION);
+    ModuleSP module_sp(m_objfile ? m_objfile->GetModule() : ModuleSP());
+    std::atomic<uint64_t> unused_nanos(0);
+    ScopedTimeAccumulator index_time(
+        module_sp ? module_sp->GetStatistics().symtab_index_nanos
+                  : unused_nanos);
     // Create the name index vector to be able to quickly search by name
     const size_t num_symbols = m_symbols.size();
 #if 1
@@ -433,6 +484,7 @@ void Symtab::AppendSymbolNamesToMap(const IndexCollection &indexes,
   if (add_demangled || add_mangled) {
     Timer scoped_timer(LLVM_PRETTY_FUNCTION, "%s", LLVM_PRETTY_FUNCTION);
     std::lock_guard<std::recursive_mutex> guard(m_mutex);
+    DecodeAllLazyNames();
 
     // Create the name index vector to be able to quickly search by name
     NameToIndexMap::Entry entry;
@@ -698,6 +750,7 @@ uint32_t Symtab::AppendSymbolIndexesMatchingRegExAndType(
     const RegularExpression &regexp, SymbolType symbol_type,
     std::vector<uint32_t> &indexes) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  DecodeAllLazyNames();
 
   uint32_t prev_size = indexes.size();
   uint32_t sym_end = m_symbols.size();
@@ -720,6 +773,7 @@ uint32_t Symtab::AppendSymbolIndexesMatchingRegExAndType(
     Debug symbol_debug_type, Visibility symbol_visibility,
     std::vector<uint32_t> &indexes) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  DecodeAllLazyNames();
 
   uint32_t prev_size = indexes.size();
   uint32_t sym_end = m_symbols.size();
@@ -752,7 +806,7 @@ Symbol *Symtab::FindSymbolWithType(SymbolType symbol_type,
         m_symbols[idx].GetType() == symbol_type) {
       if (CheckSymbolAtIndex(idx, symbol_debug_type, symbol_visibility)) {
         start_idx = idx;
-        return &m_symbols[idx];
+        return SymbolAtIndex(idx);
       }
     }
   }
@@ -19,6 +19,8 @@
 #include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/Log.h"
 
+#include "llvm/Support/JamCRC.h"
+
 using namespace lldb;
 using namespace lldb_private;
 
@@ -26,9 +28,10 @@ using namespace lldb_private;
 // MemoryCache constructor
 //----------------------------------------------------------------------
 MemoryCache::MemoryCache(Process &process)
-    : m_mutex(), m_L1_cache(), m_L2_cache(), m_invalid_ranges(),
-      m_process(process),
-      m_L2_cache_line_byte_size(process.GetMemoryCacheLineSize()) {}
+    : m_mutex(), m_L1_cache(), m_L2_cache(), m_unverified_L1_cache(),
+      m_unverified_L2_cache(), m_invalid_ranges(), m_process(process),
+      m_L2_cache_line_byte_size(process.GetMemoryCacheLineSize()),
+      m_statistics() {}
 
 //----------------------------------------------------------------------
 // Destructor
@@ -39,11 +42,81 @@ void MemoryCache::Clear(bool clear_invalid_ranges) {
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
   m_L1_cache.clear();
   m_L2_cache.clear();
+  m_unverified_L1_cache.clear();
+  m_unverified_L2_cache.clear();
   if (clear_invalid_ranges)
     m_invalid_ranges.Clear();
   m_L2_cache_line_byte_size = m_process.GetMemoryCacheLineSize();
 }
 
+void MemoryCache::ProcessDidStop() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  if (!m_process.GetRevalidateMemoryCache() ||
+      m_L2_cache_line_byte_size != m_process.GetMemoryCacheLineSize()) {
+    Clear();
+    return;
+  }
+
+  // Blocks left over from an earlier stop that were never verified are still
+  // good candidates, but anything read since then replaces them.
+  for (auto &pair : m_L1_cache)
+    m_unverified_L1_cache[pair.first] = pair.second;
+  for (auto &pair : m_L2_cache)
+    m_unverified_L2_cache[pair.first] = pair.second;
+  m_L1_cache.clear();
+  m_L2_cache.clear();
+}
+
+static uint32_t CalculateBlockChecksum(const DataBufferSP &block_sp) {
+  llvm::JamCRC crc;
+  crc.update(llvm::ArrayRef<char>(
+      reinterpret_cast<const char *>(block_sp->GetBytes()),
+      block_sp->GetByteSize()));
+  return crc.getCRC();
+}
+
+void MemoryCache::VerifyUnverifiedBlocks() {
+  std::vector<AddrRange> ranges;
+  ranges.reserve(m_unverified_L1_cache.size() + m_unverified_L2_cache.size());
+  for (const auto &pair : m_unverified_L1_cache)
+    ranges.push_back(AddrRange(pair.first, pair.second->GetByteSize()));
+  for (const auto &pair : m_unverified_L2_cache)
+    ranges.push_back(AddrRange(pair.first, pair.second->GetByteSize()));
+
+  std::vector<llvm::Optional<uint32_t>> checksums;
+  Error error = m_process.CalculateMemoryChecksums(ranges, checksums);
+  if (error.Success() && checksums.size() == ranges.size()) {
+    size_t idx = 0;
+    size_t num_reused = 0;
+    auto reuse_matching_blocks = [&](const BlockMap &unverified,
+                                     BlockMap &cache) {
+      for (const auto &pair : unverified) {
+        const llvm::Optional<uint32_t> &checksum = checksums[idx++];
+        if (checksum && *checksum == CalculateBlockChecksum(pair.second) &&
+            cache.insert(pair).second)
+          ++num_reused;
+      }
+    };
+    reuse_matching_blocks(m_unverified_L1_cache, m_L1_cache);
+    reuse_matching_blocks(m_unverified_L2_cache, m_L2_cache);
+    m_statistics.reused_blocks += num_reused;
+
+    Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_PROCESS));
+    if (log)
+      log->Printf("MemoryCache::%s reused %" PRIu64 " of %" PRIu64
+                  " cached blocks",
+                  __FUNCTION__, (uint64_t)num_reused, (uint64_t)ranges.size());
+  }
+
+  m_unverified_L1_cache.clear();
+  m_unverified_L2_cache.clear();
+}
+
+MemoryCache::Statistics MemoryCache::GetStatistics() {
+  std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  return m_statistics;
+}
+
 void MemoryCache::AddL1CacheData(lldb::addr_t addr, const void *src,
                                  size_t src_len) {
   AddL1CacheData(
@@ -56,12 +129,30 @@ void MemoryCache::AddL1CacheData(lldb::addr_t addr,
   m_L1_cache[addr] = data_buffer_sp;
 }
 
+static void FlushIntersectingBlocks(std::map<addr_t, DataBufferSP> &blocks,
+                                    addr_t addr, size_t size) {
+  Range<addr_t, addr_t> flush_range(addr, size);
+  for (auto pos = blocks.begin(), end = blocks.end();
+       pos != end && pos->first < flush_range.GetRangeEnd();) {
+    Range<addr_t, addr_t> block_range(pos->first, pos->second->GetByteSize());
+    if (block_range.DoesIntersect(flush_range))
+      pos = blocks.erase(pos);
+    else
+      ++pos;
+  }
+}
+
 void MemoryCache::Flush(addr_t addr, size_t size) {
   if (size == 0)
     return;
 
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
 
+  // Blocks waiting for verification are dropped outright; the flush means
+  // we know they are stale.
+  FlushIntersectingBlocks(m_unverified_L1_cache, addr, size);
+  FlushIntersectingBlocks(m_unverified_L2_cache, addr, size);
+
   // Erase any blocks from the L1 cache that intersect with the flush range
   if (!m_L1_cache.empty()) {
     AddrRange flush_range(addr, size);
@@ -140,6 +231,9 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len, Error &error) {
   // tricky when reading from them (no partial reads from the L1 cache).
 
   std::lock_guard<std::recursive_mutex> guard(m_mutex);
+  if (!m_unverified_L1_cache.empty() || !m_unverified_L2_cache.empty())
+    VerifyUnverifiedBlocks();
+
   if (!m_L1_cache.empty()) {
     AddrRange read_range(addr, dst_len);
     BlockMap::iterator pos = m_L1_cache.upper_bound(addr);
@@ -150,6 +244,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len, Error &error) {
     if (chunk_range.Contains(read_range)) {
       memcpy(dst, pos->second->GetBytes() + addr - chunk_range.GetRangeBase(),
              dst_len);
+      ++m_statistics.l1_hits;
       return dst_len;
     }
   }
@@ -162,6 +257,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len, Error &error) {
   // 4 bytes after the large memory read - so there's little benefit to saving
   // it in the cache.
   if (dst && dst_len > m_L2_cache_line_byte_size) {
+    ++m_statistics.misses;
     size_t bytes_read =
         m_process.ReadMemoryFromInferior(addr, dst, dst_len, error);
     // Add this non block sized range to the L1 cache if we actually read
@@ -188,6 +284,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len, Error &error) {
       BlockMap::const_iterator end = m_L2_cache.end();
 
       if (pos != end) {
+        ++m_statistics.l2_hits;
         size_t curr_read_size = cache_line_byte_size - cache_offset;
         if (curr_read_size > bytes_left)
           curr_read_size = bytes_left;
@@ -207,6 +304,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len, Error &error) {
             if (pos->first != curr_addr)
               break;
 
+            ++m_statistics.l2_hits;
             curr_read_size = pos->second->GetByteSize();
             if (curr_read_size > bytes_left)
               curr_read_size = bytes_left;
@@ -230,6 +328,7 @@ size_t MemoryCache::Read(addr_t addr, void *dst, size_t dst_len, Error &error) {
 
       if (bytes_left > 0) {
         assert((curr_addr % cache_line_byte_size) == 0);
+        ++m_statistics.misses;
         std::unique_ptr<DataBufferHeap> data_buffer_heap_ap(
             new DataBufferHeap(cache_line_byte_size, 0));
         size_t process_bytes_read = m_process.ReadMemoryFromInferior(
@@ -12,15 +12,24 @@
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleList.h"
 #include "lldb/Core/ModuleSpec.h"
+#include "lldb/Core/Section.h"
 #include "lldb/Host/File.h"
+#include "lldb/Host/FileSystem.h"
 #include "lldb/Host/LockFile.h"
+#include "lldb/Symbol/ObjectFile.h"
+#include "lldb/Symbol/Symbol.h"
+#include "lldb/Symbol/Symtab.h"
+#include "lldb/Utility/DataBufferLLVM.h"
 #include "lldb/Utility/Log.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FileUtilities.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include <assert.h>
 
 #include <cstdio>
+#include <cstring>
 
 using namespace lldb;
 using namespace lldb_private;
@@ -32,6 +41,8 @@ const char *kLockDirName = ".lock";
 const char *kTempFileName = ".temp";
 const char *kTempSymFileName = ".symtemp";
 const char *kSymFileExtension = ".sym";
+const char *kSymtabFileExtension = ".symtab";
+const char *kSectionFileExtension = ".section";
 const char *kFSIllegalChars = "\\/:*?\"<>|";
 
 std::string GetEscapedHostname(const char *hostname) {
@@ -149,6 +160,187 @@ Error CreateHostSysRootModuleLink(const FileSpec &root_dir_spec,
                                          sysroot_module_path_spec.GetPath());
 }
 
+//----------------------------------------------------------------------
+// Layout of a cached symbol table: a SymtabFileHeader, num_symbols
+// SymtabFileSymbol records and a string table of NUL terminated names.
+// Everything is in host byte order, a file written by a host with another
+// byte order is rejected by the byte order mark.
+//----------------------------------------------------------------------
+const char kSymtabMagic[8] = {'L', 'L', 'D', 'B', 'S', 'Y', 'M', 'T'};
+const uint32_t kSymtabVersion = 1;
+const uint32_t kSymtabByteOrderMark = 0x01020304;
+const uint32_t kSymtabNoName = UINT32_MAX;
+
+struct SymtabFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t byte_order_mark;
+  // Identify the object file the symbol table was parsed from, in case a
+  // module without a real build ID gets rebuilt.
+  uint64_t file_size;
+  uint64_t file_offset;
+  int64_t file_mtime_ns;
+  uint32_t num_symbols;
+  uint32_t string_table_size;
+};
+
+enum SymtabFileSymbolBits {
+  eSymtabBitExternal = (1u << 0),
+  eSymtabBitDebug = (1u << 1),
+  eSymtabBitSynthetic = (1u << 2),
+  eSymtabBitSizeIsValid = (1u << 3),
+  eSymtabBitSizeIsSynthesized = (1u << 4),
+  eSymtabBitDemangledIsSynthesized = (1u << 5),
+  eSymtabBitContainsLinkerAnnotations = (1u << 6)
+};
+
+struct SymtabFileSymbol {
+  uint32_t uid;
+  uint32_t mangled_name;   // Offset in the string table or kSymtabNoName
+  uint32_t demangled_name; // Offset in the string table or kSymtabNoName
+  uint32_t flags;
+  uint64_t section_id; // Zero if the value isn't an address in a section
+  uint64_t value;      // Offset in the section or the raw symbol value
+  uint64_t size;
+  uint8_t type;
+  uint8_t bits;
+  uint8_t padding[6];
+};
+
+static_assert(sizeof(SymtabFileSymbol) == 48,
+              "SymtabFileSymbol must not depend on the host ABI");
+
+FileSpec GetSymtabFileSpec(const FileSpec &root_dir_spec, ObjectFile &objfile,
+                           UUID &uuid) {
+  if (!objfile.GetUUID(&uuid) || !uuid.IsValid() ||
+      !objfile.GetFileSpec().GetFilename())
+    return FileSpec();
+  return JoinPath(
+      GetModuleDirectory(root_dir_spec, uuid),
+      (objfile.GetFileSpec().GetFilename().GetStringRef() + kSymtabFileExtension)
+          .str()
+          .c_str());
+}
+
+int64_t GetModificationTimeNs(const FileSpec &file_spec) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             FileSystem::GetModificationTime(file_spec).time_since_epoch())
+      .count();
+}
+
+void FillSymtabFileHeader(ObjectFile &objfile, SymtabFileHeader &header) {
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kSymtabMagic, sizeof(header.magic));
+  header.version = kSymtabVersion;
+  header.byte_order_mark = kSymtabByteOrderMark;
+  header.file_size = objfile.GetFileSpec().GetByteSize();
+  header.file_offset = objfile.GetFileOffset();
+  header.file_mtime_ns = GetModificationTimeNs(objfile.GetFileSpec());
+}
+
+//----------------------------------------------------------------------
+// Layout of a cached section: a SectionFileHeader followed by the section
+// contents.
+//----------------------------------------------------------------------
+const char kSectionMagic[8] = {'L', 'L', 'D', 'B', 'S', 'E', 'C', 'T'};
+const uint32_t kSectionVersion = 1;
+
+struct SectionFileHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t padding;
+  uint64_t file_size;
+  uint64_t file_offset;
+  int64_t file_mtime_ns;
+  uint64_t data_size;
+};
+
+FileSpec GetSectionFileSpec(const FileSpec &root_dir_spec, ObjectFile &objfile,
+                            const ConstString &section_name, UUID &uuid) {
+  if (!section_name || section_name.GetStringRef().find_first_of(
+                           kFSIllegalChars) != llvm::StringRef::npos)
+    return FileSpec();
+  if (!objfile.GetUUID(&uuid) || !uuid.IsValid() ||
+      !objfile.GetFileSpec().GetFilename())
+    return FileSpec();
+  return JoinPath(GetModuleDirectory(root_dir_spec, uuid),
+                  (objfile.GetFileSpec().GetFilename().GetStringRef() +
+                   section_name.GetStringRef() + kSectionFileExtension)
+                      .str()
+                      .c_str());
+}
+
+void FillSectionFileHeader(ObjectFile &objfile, SectionFileHeader &header) {
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, kSectionMagic, sizeof(header.magic));
+  header.version = kSectionVersion;
+  header.file_size = objfile.GetFileSpec().GetByteSize();
+  header.file_offset = objfile.GetFileOffset();
+  header.file_mtime_ns = GetModificationTimeNs(objfile.GetFileSpec());
+}
+
+// A cache file is current if it has the header and the size of the file we
+// would write, which identify the object file it was made from.
+bool IsCacheFileCurrent(const FileSpec &file_spec,
+                        llvm::ArrayRef<llvm::StringRef> parts) {
+  uint64_t file_size = 0;
+  for (llvm::StringRef part : parts)
+    file_size += part.size();
+  if (parts.empty() || file_spec.GetByteSize() != file_size)
+    return false;
+
+  const llvm::StringRef header = parts.front();
+  auto header_sp = DataBufferLLVM::CreateSliceFromPath(file_spec.GetPath(),
+                                                       header.size(), 0);
+  return header_sp && header_sp->GetByteSize() == header.size() &&
+         memcmp(header_sp->GetBytes(), header.data(), header.size()) == 0;
+}
+
+// Write "parts" to "file_spec" in the cache directory of module "uuid",
+// unless another debugger wrote it already. The first part is the header,
+// a stale file with another header is replaced. Readers never take the
+// module lock, so the file is written to a temporary name and renamed into
+// place.
+Error WriteCacheFile(const FileSpec &root_dir_spec, const UUID &uuid,
+                     const FileSpec &file_spec,
+                     llvm::ArrayRef<llvm::StringRef> parts) {
+  const auto module_spec_dir = GetModuleDirectory(root_dir_spec, uuid);
+  Error error = MakeDirectory(module_spec_dir);
+  if (error.Fail())
+    return error;
+
+  ModuleLock lock(root_dir_spec, uuid, error);
+  if (error.Fail())
+    return Error("Failed to lock module %s: %s", uuid.GetAsString().c_str(),
+                 error.AsCString());
+
+  if (file_spec.Exists() && IsCacheFileCurrent(file_spec, parts))
+    return Error();
+
+  llvm::SmallString<128> tmp_file_path;
+  int fd;
+  if (std::error_code ec = llvm::sys::fs::createUniqueFile(
+          JoinPath(module_spec_dir, ".cachetemp-%%%%%%").GetPath(), fd,
+          tmp_file_path))
+    return Error("Failed to create temp file: %s", ec.message().c_str());
+  llvm::FileRemover tmp_file_remover(tmp_file_path);
+  {
+    llvm::raw_fd_ostream tmp_file(fd, true);
+    for (llvm::StringRef part : parts)
+      tmp_file << part;
+    tmp_file.close();
+    if (tmp_file.has_error())
+      return Error("Failed to write to %s", tmp_file_path.c_str());
+  }
+
+  if (std::error_code ec =
+          llvm::sys::fs::rename(tmp_file_path, file_spec.GetPath()))
+    return Error("Failed to rename file %s to %s: %s", tmp_file_path.c_str(),
+                 file_spec.GetPath().c_str(), ec.message().c_str());
+  tmp_file_remover.releaseFile();
+  return Error();
+}
+
 } // namespace
 
 ModuleLock::ModuleLock(const FileSpec &root_dir_spec, const UUID &uuid,
@@ -329,3 +521,265 @@ Error ModuleCache::GetAndPut(const FileSpec &root_dir_spec,
   cached_module_sp->SetSymbolFileFileSpec(symfile_spec);
   return Error();
 }
+
+Error ModuleCache::PutSymtab(const FileSpec &root_dir_spec,
+                             ObjectFile &objfile, const Symtab &symtab) {
+  UUID uuid;
+  const FileSpec symtab_file_spec =
+      GetSymtabFileSpec(root_dir_spec, objfile, uuid);
+  if (!symtab_file_spec)
+    return Error("Object file %s has no UUID",
+                 objfile.GetFileSpec().GetPath().c_str());
+
+  SectionList *section_list = objfile.GetSectionList();
+  if (!section_list)
+    return Error("Object file %s has no sections",
+                 objfile.GetFileSpec().GetPath().c_str());
+
+  // Encode the symbols before writing anything, a symbol table we can't
+  // describe with section IDs doesn't get cached at all.
+  SymtabFileHeader header;
+  FillSymtabFileHeader(objfile, header);
+  std::vector<SymtabFileSymbol> records;
+  std::string strings;
+  llvm::DenseMap<const char *, uint32_t> string_offsets;
+  auto add_string = [&](const ConstString &name) -> uint32_t {
+    if (!name)
+      return kSymtabNoName;
+    auto insert_result =
+        string_offsets.insert(std::make_pair(name.GetCString(), 0));
+    if (insert_result.second) {
+      insert_result.first->second = strings.size();
+      strings.append(name.GetCString(), name.GetLength() + 1);
+    }
+    return insert_result.first->second;
+  };
+
+  const size_t num_symbols = symtab.GetNumSymbols();
+  records.reserve(num_symbols);
+  for (size_t i = 0; i < num_symbols; ++i) {
+    const Symbol *symbol = symtab.SymbolAtIndex(i);
+    SymtabFileSymbol record;
+    memset(&record, 0, sizeof(record));
+    record.uid = symbol->GetID();
+    const Mangled &mangled = symbol->GetMangled();
+    record.mangled_name = add_string(mangled.GetMangledName());
+    record.demangled_name =
+        add_string(mangled.GetDemangledName(symbol->GetLanguage()));
+    record.flags = symbol->GetFlags();
+    record.type = symbol->GetType();
+    record.size = symbol->GetByteSizeIsValid() ? symbol->GetByteSize() : 0;
+
+    const Address &addr = symbol->GetAddressRef();
+    SectionSP section_sp = addr.GetSection();
+    if (section_sp) {
+      if (section_list->FindSectionByID(section_sp->GetID()) != section_sp)
+        return Error("Symbol %s refers to a section of another object file",
+                     symbol->GetName().AsCString("<noname>"));
+      record.section_id = section_sp->GetID();
+    }
+    record.value = addr.GetOffset();
+
+    if (symbol->IsExternal())
+      record.bits |= eSymtabBitExternal;
+    if (symbol->IsDebug())
+      record.bits |= eSymtabBitDebug;
+    if (symbol->IsSynthetic())
+      record.bits |= eSymtabBitSynthetic;
+    if (symbol->GetByteSizeIsValid())
+      record.bits |= eSymtabBitSizeIsValid;
+    if (symbol->GetSizeIsSynthesized())
+      record.bits |= eSymtabBitSizeIsSynthesized;
+    if (symbol->GetDemangledNameIsSynthesized())
+      record.bits |= eSymtabBitDemangledIsSynthesized;
+    if (symbol->ContainsLinkerAnnotations())
+      record.bits |= eSymtabBitContainsLinkerAnnotations;
+    records.push_back(record);
+  }
+  header.num_symbols = records.size();
+  header.string_table_size = strings.size();
+
+  const llvm::StringRef parts[] = {
+      llvm::StringRef(reinterpret_cast<const char *>(&header), sizeof(header)),
+      llvm::StringRef(reinterpret_cast<const char *>(records.data()),
+                      records.size() * sizeof(SymtabFileSymbol)),
+      strings};
+  return WriteCacheFile(root_dir_spec, uuid, symtab_file_spec, parts);
+}
+
+bool ModuleCache::GetSymtab(const FileSpec &root_dir_spec, ObjectFile &objfile,
+                            Symtab &symtab) {
+  Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_MODULES));
+  UUID uuid;
+  const FileSpec symtab_file_spec =
+      GetSymtabFileSpec(root_dir_spec, objfile, uuid);
+  if (!symtab_file_spec || !symtab_file_spec.Exists())
+    return false;
+
+  SectionList *section_list = objfile.GetSectionList();
+  if (!section_list)
+    return false;
+
+  // Large files are mapped rather than read, so concurrent debuggers share
+  // the pages of the cached symbol table.
+  auto data_sp = DataBufferLLVM::CreateFromPath(symtab_file_spec.GetPath());
+  if (!data_sp || data_sp->GetByteSize() < sizeof(SymtabFileHeader))
+    return false;
+
+  SymtabFileHeader expected;
+  FillSymtabFileHeader(objfile, expected);
+  SymtabFileHeader header;
+  memcpy(&header, data_sp->GetBytes(), sizeof(header));
+  if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+      header.version != expected.version ||
+      header.byte_order_mark != expected.byte_order_mark ||
+      header.file_size != expected.file_size ||
+      header.file_offset != expected.file_offset ||
+      header.file_mtime_ns != expected.file_mtime_ns) {
+    if (log)
+      log->Printf("Ignoring stale symbol table %s",
+                  symtab_file_spec.GetPath().c_str());
+    return false;
+  }
+
+  const uint64_t records_size =
+      uint64_t(header.num_symbols) * sizeof(SymtabFileSymbol);
+  if (data_sp->GetByteSize() !=
+      sizeof(header) + records_size + header.string_table_size)
+    return false;
+  const uint8_t *records_start = data_sp->GetBytes() + sizeof(header);
+  const char *strings =
+      reinterpret_cast<const char *>(records_start + records_size);
+  if (header.string_table_size > 0 &&
+      strings[header.string_table_size - 1] != '\0')
+    return false;
+
+  auto get_string = [&](uint32_t offset, ConstString &name) {
+    if (offset == kSymtabNoName)
+      return true;
+    if (offset >= header.string_table_size)
+      return false;
+    name.SetCString(strings + offset);
+    return true;
+  };
+
+  llvm::DenseMap<lldb::user_id_t, SectionSP> sections;
+  std::vector<Symbol> symbols;
+  symbols.reserve(header.num_symbols);
+  for (uint32_t i = 0; i < header.num_symbols; ++i) {
+    SymtabFileSymbol record;
+    memcpy(&record, records_start + i * sizeof(SymtabFileSymbol),
+           sizeof(record));
+
+    Mangled mangled;
+    ConstString mangled_name, demangled_name;
+    if (!get_string(record.mangled_name, mangled_name) ||
+        !get_string(record.demangled_name, demangled_name))
+      return false;
+    mangled.SetMangledName(mangled_name);
+    mangled.SetDemangledName(demangled_name);
+
+    SectionSP section_sp;
+    if (record.section_id != 0) {
+      SectionSP &cached_section_sp = sections[record.section_id];
+      if (!cached_section_sp)
+        cached_section_sp = section_list->FindSectionByID(record.section_id);
+      if (!cached_section_sp)
+        return false;
+      section_sp = cached_section_sp;
+    }
+
+    symbols.emplace_back(
+        record.uid, mangled, (lldb::SymbolType)record.type,
+        record.bits & eSymtabBitExternal, record.bits & eSymtabBitDebug, false,
+        record.bits & eSymtabBitSynthetic,
+        AddressRange(section_sp, record.value, record.size),
+        record.bits & eSymtabBitSizeIsValid,
+        record.bits & eSymtabBitContainsLinkerAnnotations, record.flags);
+    symbols.back().SetSizeIsSynthesized(record.bits &
+                                        eSymtabBitSizeIsSynthesized);
+    symbols.back().SetDemangledNameIsSynthesized(
+        record.bits & eSymtabBitDemangledIsSynthesized);
+  }
+
+  symtab.Reserve(symbols.size());
+  for (const Symbol &symbol : symbols) {
+    // Copying a symbol doesn't preserve whether its size was synthesized.
+    const uint32_t idx = symtab.AddSymbol(symbol);
+    symtab.SymbolAtIndex(idx)->SetSizeIsSynthesized(
+        symbol.GetSizeIsSynthesized());
+  }
+
+  if (log)
+    log->Printf("Loaded %u symbols for %s from %s", header.num_symbols,
+                objfile.GetFileSpec().GetPath().c_str(),
+                symtab_file_spec.GetPath().c_str());
+  return true;
+}
+
+Error ModuleCache::PutSectionData(const FileSpec &root_dir_spec,
+                                  ObjectFile &objfile,
+                                  const ConstString &section_name,
+                                  const DataBuffer &data) {
+  UUID uuid;
+  const FileSpec section_file_spec =
+      GetSectionFileSpec(root_dir_spec, objfile, section_name, uuid);
+  if (!section_file_spec)
+    return Error("Section %s of %s can't be cached",
+                 section_name.AsCString("<noname>"),
+                 objfile.GetFileSpec().GetPath().c_str());
+
+  SectionFileHeader header;
+  FillSectionFileHeader(objfile, header);
+  header.data_size = data.GetByteSize();
+  const llvm::StringRef parts[] = {
+      llvm::StringRef(reinterpret_cast<const char *>(&header), sizeof(header)),
+      llvm::StringRef(reinterpret_cast<const char *>(data.GetBytes()),
+                      data.GetByteSize())};
+  return WriteCacheFile(root_dir_spec, uuid, section_file_spec, parts);
+}
+
+DataBufferSP ModuleCache::GetSectionData(const FileSpec &root_dir_spec,
+                                         ObjectFile &objfile,
+                                         const ConstString &section_name) {
+  Log *log(GetLogIfAllCategoriesSet(LIBLLDB_LOG_MODULES));
+  UUID uuid;
+  const FileSpec section_file_spec =
+      GetSectionFileSpec(root_dir_spec, objfile, section_name, uuid);
+  if (!section_file_spec || !section_file_spec.Exists())
+    return DataBufferSP();
+
+  const std::string path = section_file_spec.GetPath();
+  auto header_sp =
+      DataBufferLLVM::CreateSliceFromPath(path, sizeof(SectionFileHeader), 0);
+  if (!header_sp || header_sp->GetByteSize() != sizeof(SectionFileHeader))
+    return DataBufferSP();
+
+  SectionFileHeader expected;
+  FillSectionFileHeader(objfile, expected);
+  SectionFileHeader header;
+  memcpy(&header, header_sp->GetBytes(), sizeof(header));
+  if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+      header.version != expected.version ||
+      header.file_size != expected.file_size ||
+      header.file_offset != expected.file_offset ||
+      header.file_mtime_ns != expected.file_mtime_ns ||
+      section_file_spec.GetByteSize() != sizeof(header) + header.data_size) {
+    if (log)
+      log->Printf("Ignoring stale section data %s", path.c_str());
+    return DataBufferSP();
+  }
+
+  // Map only the section contents, so that they can be handed out as they
+  // are.
+  DataBufferSP data_sp =
+      DataBufferLLVM::CreateSliceFromPath(path, header.data_size,
+                                          sizeof(header));
+  if (!data_sp || data_sp->GetByteSize() != header.data_size)
+    return DataBufferSP();
+
+  if (log)
+    log->Printf("Loaded section %s of %s from %s", section_name.AsCString(),
+                objfile.GetFileSpec().GetPath().c_str(), path.c_str());
+  return data_sp;
+}
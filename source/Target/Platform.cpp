@@ -71,9 +71,24 @@ PropertyDefinition g_properties[] = {
      nullptr, "Use module cache."},
     {"module-cache-directory", OptionValue::eTypeFileSpec, true, 0, nullptr,
      nullptr, "Root directory for cached modules."},
+    {"use-symtab-cache", OptionValue::eTypeBoolean, true, false, nullptr,
+     nullptr, "Save the symbol tables of modules with a UUID in the module "
+              "cache directory, and load them from there instead of parsing "
+              "them again. The cached symbol tables are shared by all the "
+              "debugger processes that use the same module cache directory."},
+    {"cache-decompressed-sections", OptionValue::eTypeBoolean, true, false,
+     nullptr, nullptr, "Save the decompressed contents of compressed debug "
+                       "sections of modules with a UUID in the module cache "
+                       "directory, and map them from there instead of "
+                       "decompressing them again."},
     {nullptr, OptionValue::eTypeInvalid, false, 0, nullptr, nullptr, nullptr}};
 
-enum { ePropertyUseModuleCache, ePropertyModuleCacheDirectory };
+enum {
+  ePropertyUseModuleCache,
+  ePropertyModuleCacheDirectory,
+  ePropertyUseSymtabCache,
+  ePropertyCacheDecompressedSections
+};
 
 } // namespace
 
@@ -121,6 +136,28 @@ bool PlatformProperties::SetModuleCacheDirectory(const FileSpec &dir_spec) {
       nullptr, ePropertyModuleCacheDirectory, dir_spec);
 }
 
+bool PlatformProperties::GetUseSymtabCache() const {
+  const auto idx = ePropertyUseSymtabCache;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_properties[idx].default_uint_value != 0);
+}
+
+bool PlatformProperties::SetUseSymtabCache(bool use_symtab_cache) {
+  return m_collection_sp->SetPropertyAtIndexAsBoolean(
+      nullptr, ePropertyUseSymtabCache, use_symtab_cache);
+}
+
+bool PlatformProperties::GetCacheDecompressedSections() const {
+  const auto idx = ePropertyCacheDecompressedSections;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_properties[idx].default_uint_value != 0);
+}
+
+bool PlatformProperties::SetCacheDecompressedSections(bool cache_sections) {
+  return m_collection_sp->SetPropertyAtIndexAsBoolean(
+      nullptr, ePropertyCacheDecompressedSections, cache_sections);
+}
+
 //------------------------------------------------------------------
 /// Get the native host platform plug-in.
 ///
@@ -13,6 +13,7 @@
 #include <mutex>
 
 // Other libraries and framework includes
+#include "llvm/Support/MathExtras.h"
 #include "llvm/Support/ScopedPrinter.h"
 #include "llvm/Support/Threading.h"
 
@@ -144,6 +145,12 @@ static PropertyDefinition g_properties[] = {
     {"optimization-warnings", OptionValue::eTypeBoolean, false, true, nullptr,
      nullptr, "If true, warn when stopped in code that is optimized where "
               "stepping and variable availability may not behave as expected."},
+    {"revalidate-memory-cache", OptionValue::eTypeBoolean, false, false,
+     nullptr, nullptr,
+     "If true, memory read during previous stops is kept and verified with "
+     "checksums on the next stop instead of being read again, when the "
+     "process plug-in supports it. The checksums are CRC-32s, so a changed "
+     "block whose checksum collides with the old one is not read again."},
     {nullptr, OptionValue::eTypeInvalid, false, 0, nullptr, nullptr, nullptr}};
 
 enum {
@@ -155,7 +162,8 @@ enum {
   ePropertyStopOnSharedLibraryEvents,
   ePropertyDetachKeepsStopped,
   ePropertyMemCacheLineSize,
-  ePropertyWarningOptimization
+  ePropertyWarningOptimization,
+  ePropertyRevalidateMemCache
 };
 
 ProcessProperties::ProcessProperties(lldb_private::Process *process)
@@ -272,6 +280,12 @@ bool ProcessProperties::GetWarningsOptimization() const {
       nullptr, idx, g_properties[idx].default_uint_value != 0);
 }
 
+bool ProcessProperties::GetRevalidateMemoryCache() const {
+  const uint32_t idx = ePropertyRevalidateMemCache;
+  return m_collection_sp->GetPropertyAtIndexAsBoolean(
+      nullptr, idx, g_properties[idx].default_uint_value != 0);
+}
+
 void ProcessInstanceInfo::Dump(Stream &s, Platform *platform) const {
   const char *cstr;
   if (m_pid != LLDB_INVALID_PROCESS_ID)
@@ -1708,7 +1722,7 @@ void Process::SetPrivateState(StateType new_state) {
       m_mod_id.BumpStopID();
       if (!m_mod_id.IsLastResumeForUserExpression())
         m_mod_id.SetStopEventForLastNaturalStopID(event_sp);
-      m_memory_cache.Clear();
+      m_memory_cache.ProcessDidStop();
       if (log)
         log->Printf("Process::SetPrivateState (%s) stop_id = %u",
                     StateAsCString(new_state), m_mod_id.GetStopID());
@@ -1955,30 +1969,29 @@ void Process::RemoveOwnerFromBreakpointSite(lldb::user_id_t owner_id,
 size_t Process::RemoveBreakpointOpcodesFromBuffer(addr_t bp_addr, size_t size,
                                                   uint8_t *buf) const {
   size_t bytes_removed = 0;
-  BreakpointSiteList bp_sites_in_range;
 
-  if (m_breakpoint_site_list.FindInRange(bp_addr, bp_addr + size,
-                                         bp_sites_in_range)) {
-    bp_sites_in_range.ForEach([bp_addr, size,
-                               buf](BreakpointSite *bp_site) -> void {
-      if (bp_site->GetType() == BreakpointSite::eSoftware) {
-        addr_t intersect_addr;
-        size_t intersect_size;
-        size_t opcode_offset;
-        if (bp_site->IntersectsRange(bp_addr, size, &intersect_addr,
-                                     &intersect_size, &opcode_offset)) {
-          assert(bp_addr <= intersect_addr && intersect_addr < bp_addr + size);
-          assert(bp_addr < intersect_addr + intersect_size &&
-                 intersect_addr + intersect_size <= bp_addr + size);
-          assert(opcode_offset + intersect_size <= bp_site->GetByteSize());
-          size_t buf_offset = intersect_addr - bp_addr;
-          ::memcpy(buf + buf_offset,
-                   bp_site->GetSavedOpcodeBytes() + opcode_offset,
-                   intersect_size);
+  // This runs on every memory read, so walk the sites in place rather than
+  // copying them into another list.
+  m_breakpoint_site_list.ForEachInRange(
+      bp_addr, bp_addr + size, [bp_addr, size, buf](BreakpointSite *bp_site) {
+        if (bp_site->GetType() == BreakpointSite::eSoftware) {
+          addr_t intersect_addr;
+          size_t intersect_size;
+          size_t opcode_offset;
+          if (bp_site->IntersectsRange(bp_addr, size, &intersect_addr,
+                                       &intersect_size, &opcode_offset)) {
+            assert(bp_addr <= intersect_addr &&
+                   intersect_addr < bp_addr + size);
+            assert(bp_addr < intersect_addr + intersect_size &&
+                   intersect_addr + intersect_size <= bp_addr + size);
+            assert(opcode_offset + intersect_size <= bp_site->GetByteSize());
+            size_t buf_offset = intersect_addr - bp_addr;
+            ::memcpy(buf + buf_offset,
+                     bp_site->GetSavedOpcodeBytes() + opcode_offset,
+                     intersect_size);
+          }
         }
-      }
-    });
-  }
+      });
   return bytes_removed;
 }
 
@@ -2317,6 +2330,29 @@ size_t Process::ReadCStringFromMemory(addr_t addr, char *dst,
   return total_cstr_len;
 }
 
+size_t Process::ReadMemoryZeroFillingGaps(addr_t addr, void *buf,
+                                          size_t size) {
+  const addr_t page_size = 0x1000;
+  uint8_t *bytes = static_cast<uint8_t *>(buf);
+  size_t bytes_read = 0;
+  size_t total_bytes_read = 0;
+  while (bytes_read < size) {
+    Error error;
+    const size_t curr_bytes_read = ReadMemory(
+        addr + bytes_read, bytes + bytes_read, size - bytes_read, error);
+    bytes_read += curr_bytes_read;
+    total_bytes_read += curr_bytes_read;
+    if (bytes_read < size) {
+      // Skip to the start of the next page, which may be readable again.
+      const size_t next = std::min<size_t>(
+          llvm::alignTo(addr + bytes_read + 1, page_size) - addr, size);
+      memset(bytes + bytes_read, 0, next - bytes_read);
+      bytes_read = next;
+    }
+  }
+  return total_bytes_read;
+}
+
 size_t Process::ReadMemoryFromInferior(addr_t addr, void *buf, size_t size,
                                        Error &error) {
   if (buf == nullptr || size == 0)
@@ -5970,6 +6006,24 @@ void Process::PrintWarning(uint64_t warning_type, const void *repeat_key,
   }
 }
 
+StructuredData::DictionarySP Process::GetStatistics() {
+  auto stats_sp = std::make_shared<StructuredData::Dictionary>();
+  const MemoryCache::Statistics cache_stats = m_memory_cache.GetStatistics();
+  auto cache_sp = std::make_shared<StructuredData::Dictionary>();
+  cache_sp->AddIntegerItem("l1Hits", cache_stats.l1_hits);
+  cache_sp->AddIntegerItem("l2Hits", cache_stats.l2_hits);
+  cache_sp->AddIntegerItem("misses", cache_stats.misses);
+  cache_sp->AddIntegerItem("reusedBlocks", cache_stats.reused_blocks);
+  const uint64_t lookups =
+      cache_stats.l1_hits + cache_stats.l2_hits + cache_stats.misses;
+  cache_sp->AddFloatItem("hitRate",
+                         lookups ? double(lookups - cache_stats.misses) /
+                                       lookups
+                                 : 0.0);
+  stats_sp->AddItem("memoryCache", cache_sp);
+  return stats_sp;
+}
+
 void Process::PrintWarningOptimization(const SymbolContext &sc) {
   if (GetWarningsOptimization() && sc.module_sp &&
       !sc.module_sp->GetFileSpec().GetFilename().IsEmpty() && sc.function &&
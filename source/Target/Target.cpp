@@ -79,7 +79,8 @@ Target::Target(Debugger &debugger, const ArchSpec &target_arch,
       m_breakpoint_list(false), m_internal_breakpoint_list(true),
       m_watchpoint_list(), m_process_sp(), m_search_filter_sp(),
       m_image_search_paths(ImageSearchPathsChanged, this), m_ast_importer_sp(),
-      m_source_manager_ap(), m_stop_hooks(), m_stop_hook_next_id(0),
+      m_source_manager_ap(), m_user_expression_cache(), m_stop_hooks(),
+      m_stop_hook_next_id(0),
       m_valid(true), m_suppress_stop_hooks(false),
       m_is_dummy_target(is_dummy_target)
 
@@ -159,6 +160,7 @@ void Target::CleanupProcess() {
 
 void Target::DeleteCurrentProcess() {
   if (m_process_sp) {
+    m_user_expression_cache.Clear();
     m_section_load_history.Clear();
     if (m_process_sp->IsAlive())
       m_process_sp->Destroy(false);
@@ -245,6 +247,7 @@ void Target::Destroy() {
   m_arch.Clear();
   ClearModules(true);
   m_section_load_history.Clear();
+  m_user_expression_cache.Clear();
   const bool notify = false;
   m_breakpoint_list.RemoveAll(notify);
   m_internal_breakpoint_list.RemoveAll(notify);
@@ -1402,6 +1405,7 @@ void Target::ModuleUpdated(const ModuleList &module_list,
 
 void Target::ModulesDidLoad(ModuleList &module_list) {
   if (m_valid && module_list.GetSize()) {
+    m_user_expression_cache.Clear();
     m_breakpoint_list.UpdateBreakpoints(module_list, true, false);
     m_internal_breakpoint_list.UpdateBreakpoints(module_list, true, false);
     if (m_process_sp) {
@@ -1414,6 +1418,7 @@ void Target::ModulesDidLoad(ModuleList &module_list) {
 
 void Target::SymbolsDidLoad(ModuleList &module_list) {
   if (m_valid && module_list.GetSize()) {
+    m_user_expression_cache.Clear();
     if (m_process_sp) {
       LanguageRuntime *runtime =
           m_process_sp->GetLanguageRuntime(lldb::eLanguageTypeObjC);
@@ -1432,6 +1437,7 @@ void Target::SymbolsDidLoad(ModuleList &module_list) {
 
 void Target::ModulesDidUnload(ModuleList &module_list, bool delete_locations) {
   if (m_valid && module_list.GetSize()) {
+    m_user_expression_cache.Clear();
     UnloadModuleSections(module_list);
     m_breakpoint_list.UpdateBreakpoints(module_list, false, delete_locations);
     m_internal_breakpoint_list.UpdateBreakpoints(module_list, false,
@@ -3349,6 +3355,10 @@ static PropertyDefinition g_properties[] = {
                        "support."},
     {"non-stop-mode", OptionValue::eTypeBoolean, false, 0, nullptr, nullptr,
      "Disable lock-step debugging, instead control threads independently."},
+    {"expression-cache-size", OptionValue::eTypeUInt64, false, 64, nullptr,
+     nullptr, "The maximum number of parsed expressions kept for reuse by "
+              "later evaluations of the same expression. 0 disables the "
+              "cache."},
     {nullptr, OptionValue::eTypeInvalid, false, 0, nullptr, nullptr, nullptr}};
 
 enum {
@@ -3393,6 +3403,7 @@ enum {
   ePropertyTrapHandlerNames,
   ePropertyDisplayRuntimeSupportValues,
   ePropertyNonStopModeEnabled,
+  ePropertyExpressionCacheSize,
   ePropertyExperimental
 };
 
@@ -3949,6 +3960,12 @@ void TargetProperties::SetNonStopModeEnabled(bool b) {
   m_collection_sp->SetPropertyAtIndexAsBoolean(nullptr, idx, b);
 }
 
+uint64_t TargetProperties::GetExpressionCacheSize() const {
+  const uint32_t idx = ePropertyExpressionCacheSize;
+  return m_collection_sp->GetPropertyAtIndexAsUInt64(
+      nullptr, idx, g_properties[idx].default_uint_value);
+}
+
 const ProcessLaunchInfo &TargetProperties::GetProcessLaunchInfo() {
   m_launch_info.SetArg0(GetArg0()); // FIXME: Arg0 callback doesn't work
   return m_launch_info;
@@ -520,6 +520,27 @@ bool Thread::ThreadStoppedForAReason(void) {
   return (bool)GetPrivateStopInfo();
 }
 
+bool Thread::IsIdleAtStop() {
+  if (m_destroy_called || m_plan_stack.size() != 1 ||
+      !m_completed_plan_stack.empty())
+    return false;
+
+  ProcessSP process_sp(GetProcess());
+  if (!process_sp)
+    return false;
+
+  // The stop info has already been worked out for this stop.
+  if (m_stop_info_stop_id == process_sp->GetStopID())
+    return !m_stop_info_sp;
+
+  // A stop info from an earlier stop might still apply, see
+  // GetPrivateStopInfo().
+  if (m_stop_info_sp)
+    return false;
+
+  return KnownToHaveNoStopReason();
+}
+
 bool Thread::CheckpointThreadState(ThreadStateCheckpoint &saved_state) {
   saved_state.register_backup_sp.reset();
   lldb::StackFrameSP frame_sp(GetStackFrameAtIndex(0));
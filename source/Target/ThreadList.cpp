@@ -226,6 +226,11 @@ bool ThreadList::ShouldStop(Event *event_ptr) {
   // a chance to hang any interesting operations on those threads yet.
 
   collection threads_copy;
+  // Threads that were allowed to run but have nothing to say about this stop:
+  // no stop reason and no plans beyond the base plan.  Processes with many
+  // threads usually have only one or two that aren't idle, so these are
+  // counted rather than consulted.
+  size_t num_idle_threads = 0;
   {
     // Scope for locker
     std::lock_guard<std::recursive_mutex> guard(GetMutex());
@@ -245,15 +250,19 @@ bool ThreadList::ShouldStop(Event *event_ptr) {
       // allowed to run since the
       // previous stop.
       if (thread_sp->GetTemporaryResumeState() != eStateSuspended ||
-          thread_sp->IsStillAtLastBreakpointHit())
-        threads_copy.push_back(thread_sp);
+          thread_sp->IsStillAtLastBreakpointHit()) {
+        if (thread_sp->IsIdleAtStop())
+          ++num_idle_threads;
+        else
+          threads_copy.push_back(thread_sp);
+      }
     }
 
     // It is possible the threads we were allowing to run all exited and then
     // maybe the user interrupted
     // or something, then fall back on looking at all threads:
 
-    if (threads_copy.size() == 0)
+    if (threads_copy.size() == 0 && num_idle_threads == 0)
       threads_copy = m_threads;
   }
 
@@ -262,12 +271,16 @@ bool ThreadList::ShouldStop(Event *event_ptr) {
   if (log) {
     log->PutCString("");
     log->Printf("ThreadList::%s: %" PRIu64 " threads, %" PRIu64
-                " unsuspended threads",
+                " unsuspended threads, %" PRIu64 " of them idle",
                 __FUNCTION__, (uint64_t)m_threads.size(),
-                (uint64_t)threads_copy.size());
+                (uint64_t)(threads_copy.size() + num_idle_threads),
+                (uint64_t)num_idle_threads);
   }
 
-  bool did_anybody_stop_for_a_reason = false;
+  // An idle thread would only have counted here because of the stop ID, see
+  // below.
+  bool did_anybody_stop_for_a_reason =
+      num_idle_threads > 0 && m_process->GetStopID() > 1;
 
   // If the event is an Interrupt event, then we're going to stop no matter
   // what.  Otherwise, presume we won't stop.
@@ -370,6 +383,9 @@ Vote ThreadList::ShouldReportStop(Event *event_ptr) {
   // opinion.
   for (pos = m_threads.begin(); pos != end; ++pos) {
     ThreadSP thread_sp(*pos);
+    // Idle threads didn't stop for a reason, so they have no opinion.
+    if (thread_sp->IsIdleAtStop())
+      continue;
     const Vote vote = thread_sp->ShouldReportStop(event_ptr);
     switch (vote) {
     case eVoteNoOpinion:
@@ -84,6 +84,7 @@ void ThreadPlanStepRange::AddRange(const AddressRange &new_range) {
   // indices to match, but I don't want to do the work to disassemble this range
   // if I don't step into it.
   m_instruction_ranges.push_back(DisassemblerSP());
+  m_branch_maps.push_back(RangeBranchMap());
 }
 
 void ThreadPlanStepRange::DumpRanges(Stream *s) {
@@ -237,6 +238,27 @@ bool ThreadPlanStepRange::StopOthers() {
           m_stop_others == lldb::eOnlyDuringStepping);
 }
 
+bool ThreadPlanStepRange::GetSteppingRange(lldb::addr_t &range_start,
+                                           lldb::addr_t &range_end) {
+  // With fast stepping off we want to see every instruction, and while the
+  // next branch breakpoint is set we aren't stepping at all.
+  if (!m_use_fast_step || m_next_branch_bp_sp)
+    return false;
+
+  Target &target = GetTarget();
+  lldb::addr_t pc = m_thread.GetRegisterContext()->GetPC();
+  for (const AddressRange &range : m_address_ranges) {
+    if (range.GetByteSize() == 0 || !range.ContainsLoadAddress(pc, &target))
+      continue;
+    range_start = range.GetBaseAddress().GetLoadAddress(&target);
+    if (range_start == LLDB_INVALID_ADDRESS)
+      return false;
+    range_end = range_start + range.GetByteSize();
+    return true;
+  }
+  return false;
+}
+
 InstructionList *ThreadPlanStepRange::GetInstructionsForAddress(
     lldb::addr_t addr, size_t &range_index, size_t &insn_offset) {
   size_t num_ranges = m_address_ranges.size();
@@ -291,6 +313,84 @@ void ThreadPlanStepRange::ClearNextBranchBreakpoint() {
   }
 }
 
+BranchMap *ThreadPlanStepRange::GetBranchMapForRange(size_t range_index) {
+  RangeBranchMap &range_map = m_branch_maps[range_index];
+  if (!range_map.looked_up) {
+    range_map.looked_up = true;
+    SymbolContext sc;
+    m_address_ranges[range_index].GetBaseAddress().CalculateSymbolContext(
+        &sc, eSymbolContextFunction | eSymbolContextSymbol);
+    AddressRange function_range;
+    const bool use_inline_block_range = false;
+    if (sc.GetAddressRange(eSymbolContextFunction | eSymbolContextSymbol, 0,
+                           use_inline_block_range, function_range)) {
+      ExecutionContext exe_ctx(m_thread.GetProcess());
+      const char *plugin_name = nullptr;
+      const char *flavor = nullptr;
+      range_map.branch_map_sp = Disassembler::GetBranchMap(
+          GetTarget().GetArchitecture(), plugin_name, flavor, exe_ctx,
+          function_range);
+    }
+  }
+  return range_map.branch_map_sp.get();
+}
+
+bool ThreadPlanStepRange::GetRunToAddressFromBranchMap(
+    lldb::addr_t pc, Address &run_to_address) {
+  Target &target = GetTarget();
+  // Hexagon has to run to the start of the packet that holds the branch,
+  // leave that to InstructionList::GetIndexOfNextBranchInstruction.
+  if (target.GetArchitecture().GetMachine() == llvm::Triple::hexagon)
+    return false;
+
+  size_t num_ranges = m_address_ranges.size();
+  for (size_t i = 0; i < num_ranges; i++) {
+    const AddressRange &range = m_address_ranges[i];
+    if (!range.ContainsLoadAddress(pc, &target))
+      continue;
+    if (range.GetByteSize() == 0)
+      return false;
+
+    BranchMap *branch_map = GetBranchMapForRange(i);
+    if (!branch_map)
+      return false;
+
+    // The range decodes the same way on its own as it does as part of the
+    // function only if it starts on one of the function's instructions.
+    const Address &range_base = range.GetBaseAddress();
+    const addr_t range_file_addr = range_base.GetFileAddress();
+    const addr_t pc_file_addr =
+        range_file_addr + (pc - range_base.GetLoadAddress(&target));
+    const uint32_t pc_index = branch_map->GetIndexOfInstructionAt(pc_file_addr);
+    if (pc_index == UINT32_MAX ||
+        branch_map->GetIndexOfInstructionAt(range_file_addr) == UINT32_MAX)
+      return false;
+    const uint32_t last_index = branch_map->GetIndexOfLastInstructionBefore(
+        range_file_addr + range.GetByteSize());
+    if (last_index == UINT32_MAX)
+      return false;
+
+    uint32_t branch_index = branch_map->GetIndexOfNextBranch(pc_index);
+    if (branch_index != UINT32_MAX && branch_index > last_index)
+      branch_index = UINT32_MAX;
+
+    // If we didn't find a branch, run to the end of the range.
+    if (branch_index == UINT32_MAX) {
+      if (last_index - pc_index > 1) {
+        run_to_address = range_base;
+        run_to_address.Slide(branch_map->GetInstructionEndAddress(last_index) -
+                             range_file_addr);
+      }
+    } else if (branch_index - pc_index > 1) {
+      run_to_address = range_base;
+      run_to_address.Slide(branch_map->GetInstructionAddress(branch_index) -
+                           range_file_addr);
+    }
+    return true;
+  }
+  return false;
+}
+
 bool ThreadPlanStepRange::SetNextBranchBreakpoint() {
   if (m_next_branch_bp_sp)
     return true;
@@ -303,22 +403,24 @@ bool ThreadPlanStepRange::SetNextBranchBreakpoint() {
     return false;
 
   lldb::addr_t cur_addr = GetThread().GetRegisterContext()->GetPC();
-  // Find the current address in our address ranges, and fetch the disassembly
-  // if we haven't already:
-  size_t pc_index;
-  size_t range_index;
-  InstructionList *instructions =
-      GetInstructionsForAddress(cur_addr, range_index, pc_index);
-  if (instructions == nullptr)
-    return false;
-  else {
+  Address run_to_address;
+  // The function's branch map answers this without decoding anything, fall
+  // back to disassembling the range if there isn't one.
+  if (!GetRunToAddressFromBranchMap(cur_addr, run_to_address)) {
+    // Find the current address in our address ranges, and fetch the
+    // disassembly if we haven't already:
+    size_t pc_index;
+    size_t range_index;
+    InstructionList *instructions =
+        GetInstructionsForAddress(cur_addr, range_index, pc_index);
+    if (instructions == nullptr)
+      return false;
+
     Target &target = GetThread().GetProcess()->GetTarget();
     uint32_t branch_index;
     branch_index =
         instructions->GetIndexOfNextBranchInstruction(pc_index, target);
 
-    Address run_to_address;
-
     // If we didn't find a branch, run to the end of the range.
     if (branch_index == UINT32_MAX) {
       uint32_t last_index = instructions->GetSize() - 1;
@@ -333,34 +435,34 @@ bool ThreadPlanStepRange::SetNextBranchBreakpoint() {
       run_to_address =
           instructions->GetInstructionAtIndex(branch_index)->GetAddress();
     }
+  }
 
-    if (run_to_address.IsValid()) {
-      const bool is_internal = true;
-      m_next_branch_bp_sp =
-          GetTarget().CreateBreakpoint(run_to_address, is_internal, false);
-      if (m_next_branch_bp_sp) {
-        if (log) {
-          lldb::break_id_t bp_site_id = LLDB_INVALID_BREAK_ID;
-          BreakpointLocationSP bp_loc =
-              m_next_branch_bp_sp->GetLocationAtIndex(0);
-          if (bp_loc) {
-            BreakpointSiteSP bp_site = bp_loc->GetBreakpointSite();
-            if (bp_site) {
-              bp_site_id = bp_site->GetID();
-            }
+  if (run_to_address.IsValid()) {
+    const bool is_internal = true;
+    m_next_branch_bp_sp =
+        GetTarget().CreateBreakpoint(run_to_address, is_internal, false);
+    if (m_next_branch_bp_sp) {
+      if (log) {
+        lldb::break_id_t bp_site_id = LLDB_INVALID_BREAK_ID;
+        BreakpointLocationSP bp_loc =
+            m_next_branch_bp_sp->GetLocationAtIndex(0);
+        if (bp_loc) {
+          BreakpointSiteSP bp_site = bp_loc->GetBreakpointSite();
+          if (bp_site) {
+            bp_site_id = bp_site->GetID();
           }
-          log->Printf("ThreadPlanStepRange::SetNextBranchBreakpoint - Setting "
-                      "breakpoint %d (site %d) to run to address 0x%" PRIx64,
-                      m_next_branch_bp_sp->GetID(), bp_site_id,
-                      run_to_address.GetLoadAddress(
-                          &m_thread.GetProcess()->GetTarget()));
         }
-        m_next_branch_bp_sp->SetThreadID(m_thread.GetID());
-        m_next_branch_bp_sp->SetBreakpointKind("next-branch-location");
-        return true;
-      } else
-        return false;
-    }
+        log->Printf("ThreadPlanStepRange::SetNextBranchBreakpoint - Setting "
+                    "breakpoint %d (site %d) to run to address 0x%" PRIx64,
+                    m_next_branch_bp_sp->GetID(), bp_site_id,
+                    run_to_address.GetLoadAddress(
+                        &m_thread.GetProcess()->GetTarget()));
+      }
+      m_next_branch_bp_sp->SetThreadID(m_thread.GetID());
+      m_next_branch_bp_sp->SetBreakpointKind("next-branch-location");
+      return true;
+    } else
+      return false;
   }
   return false;
 }
@@ -65,6 +65,10 @@ lldb::offset_t DataBufferLLVM::GetByteSize() const {
   return Buffer->getBufferSize();
 }
 
+bool DataBufferLLVM::IsMemoryMapped() const {
+  return Buffer->getBufferKind() == llvm::MemoryBuffer::MemoryBuffer_MMap;
+}
+
 const uint8_t *DataBufferLLVM::GetBuffer() const {
   return reinterpret_cast<const uint8_t *>(Buffer->getBufferStart());
 }
@@ -22,10 +22,16 @@
 #include "llvm/Support/Threading.h"
 #include "llvm/Support/raw_ostream.h"
 
+#include <algorithm>
 #include <chrono> // for duration, system_clock, syst...
+#include <condition_variable>
 #include <cstdarg>
+#include <map>
 #include <mutex>
+#include <set>
+#include <thread>
 #include <utility> // for pair
+#include <vector>
 
 #include <assert.h>  // for assert
 #if defined(LLVM_ON_WIN32)
@@ -38,6 +44,301 @@ using namespace lldb_private;
 
 llvm::ManagedStatic<Log::ChannelMap> Log::g_channel_map;
 
+// The number of records a circular channel keeps unless told otherwise.
+static const size_t g_default_circular_records = 10000;
+
+// Set once the logging is torn down, the crash handler must not look at the
+// channels anymore.
+static std::atomic<bool> g_log_terminated{false};
+
+static std::recursive_mutex &GetThreadSafeLogMutex() {
+  static std::recursive_mutex g_LogThreadedMutex;
+  return g_LogThreadedMutex;
+}
+
+//----------------------------------------------------------------------
+// A log record that was queued by a buffered channel. Everything that
+// is cheap to capture is kept raw and only formatted by the writer.
+//----------------------------------------------------------------------
+struct Log::Record {
+  Log *log = nullptr;
+  std::chrono::system_clock::time_point time;
+  uint64_t thread_id = 0;
+  // Only the LLDB_LOG macros pass a file and function, as literals.
+  llvm::StringRef file;
+  llvm::StringRef function;
+  // The thread name and backtrace, which can only be captured on the
+  // logging thread.
+  std::string context;
+  std::string message;
+  // The number of records this thread dropped before this one because
+  // its buffer was full.
+  uint64_t dropped = 0;
+};
+
+//----------------------------------------------------------------------
+// A single producer, single consumer ring of records. Only the owning
+// thread adds records, so logging to a buffered channel never takes a
+// lock. The records are consumed with the registry mutex held, either by
+// the writer thread or by a thread that needs them written right away.
+//----------------------------------------------------------------------
+class Log::RecordBuffer {
+public:
+  static Record *Begin(Log &log, llvm::StringRef file,
+                       llvm::StringRef function);
+  static void Commit();
+
+  static void SetBuffered(Log &log, bool buffered);
+  static void DrainAll();
+  static void StopWriter();
+
+private:
+  static const size_t kCapacity = 1024; // Must be a power of two
+
+  struct Registry {
+    // Protects the list of buffers, the buffered logs and the consumer side
+    // of all the buffers.
+    std::mutex mutex;
+    std::vector<RecordBuffer *> buffers;
+    std::set<Log *> buffered_logs;
+    std::thread writer;
+
+    std::mutex wake_mutex;
+    std::condition_variable wake_cv;
+    bool wake = false;
+    bool stop = false;
+  };
+
+  // Owned by a thread_local so that exiting threads hand their buffer over
+  // to the consumer, which frees it once it has been drained.
+  struct ThreadBuffer {
+    RecordBuffer *buffer = nullptr;
+    ~ThreadBuffer() {
+      if (buffer)
+        buffer->m_orphaned.store(true, std::memory_order_release);
+    }
+  };
+
+  RecordBuffer();
+
+  static Registry &GetRegistry();
+  static RecordBuffer &GetForCurrentThread();
+  static void Wake();
+  static void RunWriter();
+  static void DrainAllLocked(Registry &registry);
+
+  void Drain(std::vector<Record> &records);
+
+  Record m_records[kCapacity];
+  std::atomic<size_t> m_head{0};
+  std::atomic<size_t> m_tail{0};
+  std::atomic<bool> m_orphaned{false};
+  uint64_t m_dropped = 0;
+  const uint64_t m_thread_id;
+  std::string m_thread_name;
+};
+
+Log::RecordBuffer::RecordBuffer() : m_thread_id(llvm::get_threadid()) {
+  // Asking for the thread name can be expensive, and our threads are named
+  // before they start logging.
+  llvm::SmallString<32> thread_name;
+  llvm::get_thread_name(thread_name);
+  m_thread_name.assign(thread_name.begin(), thread_name.end());
+}
+
+Log::RecordBuffer::Registry &Log::RecordBuffer::GetRegistry() {
+  // Leaked on purpose, threads may log after static destructors ran.
+  static Registry *g_registry_ptr = new Registry();
+  return *g_registry_ptr;
+}
+
+Log::RecordBuffer &Log::RecordBuffer::GetForCurrentThread() {
+  static thread_local ThreadBuffer g_thread_buffer;
+  if (!g_thread_buffer.buffer) {
+    RecordBuffer *buffer = new RecordBuffer();
+    Registry &registry = GetRegistry();
+    {
+      std::lock_guard<std::mutex> guard(registry.mutex);
+      registry.buffers.push_back(buffer);
+    }
+    g_thread_buffer.buffer = buffer;
+  }
+  return *g_thread_buffer.buffer;
+}
+
+Log::Record *Log::RecordBuffer::Begin(Log &log, llvm::StringRef file,
+                                      llvm::StringRef function) {
+  RecordBuffer &buffer = GetForCurrentThread();
+  const size_t head = buffer.m_head.load(std::memory_order_relaxed);
+  if (head - buffer.m_tail.load(std::memory_order_acquire) == kCapacity) {
+    ++buffer.m_dropped;
+    Wake();
+    return nullptr;
+  }
+
+  Record &record = buffer.m_records[head & (kCapacity - 1)];
+  Flags options = log.GetOptions();
+  record.log = &log;
+  record.time = std::chrono::system_clock::now();
+  record.thread_id = buffer.m_thread_id;
+  record.file = file;
+  record.function = function;
+  record.dropped = buffer.m_dropped;
+  buffer.m_dropped = 0;
+
+  // Reuse the storage of the strings, the ring is allocated only once.
+  record.context.clear();
+  if (options.Test(LLDB_LOG_OPTION_PREPEND_THREAD_NAME))
+    record.context += buffer.m_thread_name;
+  if (options.Test(LLDB_LOG_OPTION_BACKTRACE)) {
+    llvm::SmallString<1024> backtrace;
+    llvm::raw_svector_ostream backtrace_stream(backtrace);
+    llvm::sys::PrintStackTrace(backtrace_stream);
+    record.context.append(backtrace.begin(), backtrace.end());
+  }
+  record.message.clear();
+  return &record;
+}
+
+void Log::RecordBuffer::Commit() {
+  RecordBuffer &buffer = GetForCurrentThread();
+  const size_t head = buffer.m_head.load(std::memory_order_relaxed) + 1;
+  buffer.m_head.store(head, std::memory_order_release);
+  // Only wake the writer up early when the buffer fills up, it drains the
+  // buffers periodically anyway.
+  if (head - buffer.m_tail.load(std::memory_order_relaxed) == kCapacity / 2)
+    Wake();
+}
+
+void Log::RecordBuffer::Drain(std::vector<Record> &records) {
+  size_t tail = m_tail.load(std::memory_order_relaxed);
+  const size_t head = m_head.load(std::memory_order_acquire);
+  for (; tail != head; ++tail)
+    records.push_back(m_records[tail & (kCapacity - 1)]);
+  m_tail.store(tail, std::memory_order_release);
+}
+
+void Log::RecordBuffer::SetBuffered(Log &log, bool buffered) {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  if (!buffered) {
+    // Once a log is out of the set, the records still pointing to it are
+    // discarded without being looked at, so it can be destroyed.
+    registry.buffered_logs.erase(&log);
+    return;
+  }
+  registry.buffered_logs.insert(&log);
+  if (!registry.writer.joinable())
+    registry.writer = std::thread(RunWriter);
+  Wake();
+}
+
+void Log::RecordBuffer::Wake() {
+  Registry &registry = GetRegistry();
+  {
+    std::lock_guard<std::mutex> guard(registry.wake_mutex);
+    registry.wake = true;
+  }
+  registry.wake_cv.notify_one();
+}
+
+void Log::RecordBuffer::RunWriter() {
+  llvm::set_thread_name("lldb.log.writer");
+  Registry &registry = GetRegistry();
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(registry.wake_mutex);
+      registry.wake_cv.wait_for(
+          lock, std::chrono::milliseconds(50),
+          [&registry] { return registry.wake || registry.stop; });
+      if (registry.stop)
+        return;
+      registry.wake = false;
+    }
+    DrainAll();
+  }
+}
+
+void Log::RecordBuffer::DrainAll() {
+  Registry &registry = GetRegistry();
+  std::lock_guard<std::mutex> guard(registry.mutex);
+  DrainAllLocked(registry);
+}
+
+void Log::RecordBuffer::StopWriter() {
+  Registry &registry = GetRegistry();
+  std::thread writer;
+  {
+    std::lock_guard<std::mutex> guard(registry.mutex);
+    writer.swap(registry.writer);
+  }
+  if (writer.joinable()) {
+    {
+      std::lock_guard<std::mutex> guard(registry.wake_mutex);
+      registry.stop = true;
+    }
+    registry.wake_cv.notify_one();
+    writer.join();
+    std::lock_guard<std::mutex> guard(registry.wake_mutex);
+    registry.stop = false;
+  }
+  // Write out whatever the writer didn't get to.
+  DrainAll();
+}
+
+void Log::RecordBuffer::DrainAllLocked(Registry &registry) {
+  std::vector<Record> records;
+  for (auto pos = registry.buffers.begin(); pos != registry.buffers.end();) {
+    RecordBuffer *buffer = *pos;
+    // Check before draining: a buffer that was orphaned before we drained it
+    // won't get any more records.
+    const bool orphaned = buffer->m_orphaned.load(std::memory_order_acquire);
+    buffer->Drain(records);
+    if (orphaned) {
+      delete buffer;
+      pos = registry.buffers.erase(pos);
+    } else
+      ++pos;
+  }
+  if (records.empty())
+    return;
+
+  // Each buffer is in order, interleave the threads by time.
+  std::stable_sort(records.begin(), records.end(),
+                   [](const Record &lhs, const Record &rhs) {
+                     return lhs.time < rhs.time;
+                   });
+
+  // Write everything that goes to the same log with a single write.
+  std::map<Log *, std::string> output;
+  for (const Record &record : records) {
+    if (registry.buffered_logs.count(record.log))
+      record.log->WriteRecord(record, output[record.log]);
+  }
+  for (auto &entry : output) {
+    if (entry.second.empty())
+      continue;
+    auto stream_sp = entry.first->GetStream();
+    if (!stream_sp)
+      continue;
+    std::lock_guard<std::recursive_mutex> guard(GetThreadSafeLogMutex());
+    *stream_sp << entry.second;
+    stream_sp->flush();
+  }
+}
+
+Log::~Log() {
+  // The writer thread must not look at the records of a destroyed log.
+  RecordBuffer::SetBuffered(*this, false);
+}
+
+void Log::DumpCircularLogsOnCrash(void *) {
+  if (g_log_terminated.load(std::memory_order_acquire))
+    return;
+  for (auto &entry : *g_channel_map)
+    entry.second.WriteCircularRecordsOnCrash();
+}
+
 void Log::ListCategories(llvm::raw_ostream &stream, const ChannelMap::value_type &entry) {
   stream << llvm::formatv("Logging categories for '{0}':\n", entry.first());
   stream << "  all - all available logging categories\n";
@@ -77,24 +378,74 @@ uint32_t Log::GetFlags(llvm::raw_ostream &stream, const ChannelMap::value_type &
 }
 
 void Log::Enable(const std::shared_ptr<llvm::raw_ostream> &stream_sp,
-                 uint32_t options, uint32_t flags) {
-  llvm::sys::ScopedWriter lock(m_mutex);
-
-  uint32_t mask = m_mask.fetch_or(flags, std::memory_order_relaxed);
-  if (mask | flags) {
-    m_options.store(options, std::memory_order_relaxed);
-    m_stream_sp = stream_sp;
-    m_channel.log_ptr.store(this, std::memory_order_relaxed);
+                 uint32_t options, uint32_t flags, size_t buffer_size) {
+  // What was buffered so far goes to the old stream.
+  const bool was_buffered = GetOptions().Test(LLDB_LOG_OPTION_BUFFERED);
+  if (was_buffered)
+    RecordBuffer::DrainAll();
+
+  if (options & LLDB_LOG_OPTION_CIRCULAR) {
+    options |= LLDB_LOG_OPTION_BUFFERED;
+    static std::once_flag g_once_flag;
+    std::call_once(g_once_flag, [] {
+      llvm::sys::AddSignalHandler(Log::DumpCircularLogsOnCrash, nullptr);
+    });
+  }
+  const bool buffered = options & LLDB_LOG_OPTION_BUFFERED;
+  if (buffered)
+    RecordBuffer::SetBuffered(*this, true);
+
+  {
+    llvm::sys::ScopedWriter lock(m_mutex);
+
+    uint32_t mask = m_mask.fetch_or(flags, std::memory_order_relaxed);
+    if (mask | flags) {
+      m_options.store(options, std::memory_order_relaxed);
+      m_stream_sp = stream_sp;
+      m_channel.log_ptr.store(this, std::memory_order_relaxed);
+    }
   }
+
+  {
+    std::lock_guard<std::mutex> guard(m_circular_mutex);
+    if (options & LLDB_LOG_OPTION_CIRCULAR) {
+      m_circular_capacity =
+          buffer_size ? buffer_size : g_default_circular_records;
+      while (m_circular_records.size() > m_circular_capacity)
+        m_circular_records.pop_front();
+      m_circular_stream_sp = stream_sp;
+    } else {
+      m_circular_records.clear();
+      m_circular_stream_sp.reset();
+    }
+  }
+
+  if (was_buffered && !buffered)
+    RecordBuffer::SetBuffered(*this, false);
 }
 
 void Log::Disable(uint32_t flags) {
-  llvm::sys::ScopedWriter lock(m_mutex);
+  // Write out what was buffered while we still have a stream.
+  if (GetOptions().Test(LLDB_LOG_OPTION_BUFFERED))
+    RecordBuffer::DrainAll();
+
+  bool disabled = false;
+  {
+    llvm::sys::ScopedWriter lock(m_mutex);
+
+    uint32_t mask = m_mask.fetch_and(~flags, std::memory_order_relaxed);
+    if (!(mask & ~flags)) {
+      m_stream_sp.reset();
+      m_channel.log_ptr.store(nullptr, std::memory_order_relaxed);
+      disabled = true;
+    }
+  }
 
-  uint32_t mask = m_mask.fetch_and(~flags, std::memory_order_relaxed);
-  if (!(mask & ~flags)) {
-    m_stream_sp.reset();
-    m_channel.log_ptr.store(nullptr, std::memory_order_relaxed);
+  if (disabled) {
+    RecordBuffer::SetBuffered(*this, false);
+    std::lock_guard<std::mutex> guard(m_circular_mutex);
+    m_circular_records.clear();
+    m_circular_stream_sp.reset();
   }
 }
 
@@ -125,6 +476,17 @@ void Log::Printf(const char *format, ...) {
 // a valid file handle, we also log to the file.
 //----------------------------------------------------------------------
 void Log::VAPrintf(const char *format, va_list args) {
+  if (GetOptions().Test(LLDB_LOG_OPTION_BUFFERED)) {
+    if (Record *record = RecordBuffer::Begin(*this, "", "")) {
+      llvm::SmallString<256> Content;
+      lldb_private::VASprintf(Content, format, args);
+      record->message.append(Content.begin(), Content.end());
+      record->message += '\n';
+      RecordBuffer::Commit();
+    }
+    return;
+  }
+
   llvm::SmallString<64> FinalMessage;
   llvm::raw_svector_ostream Stream(FinalMessage);
   WriteHeader(Stream, "", "");
@@ -197,7 +559,8 @@ void Log::Unregister(llvm::StringRef name) {
 bool Log::EnableLogChannel(
     const std::shared_ptr<llvm::raw_ostream> &log_stream_sp,
     uint32_t log_options, llvm::StringRef channel,
-    llvm::ArrayRef<const char *> categories, llvm::raw_ostream &error_stream) {
+    llvm::ArrayRef<const char *> categories, llvm::raw_ostream &error_stream,
+    size_t buffer_size) {
   auto iter = g_channel_map->find(channel);
   if (iter == g_channel_map->end()) {
     error_stream << llvm::formatv("Invalid log channel '{0}'.\n", channel);
@@ -206,10 +569,43 @@ bool Log::EnableLogChannel(
   uint32_t flags = categories.empty()
                        ? iter->second.m_channel.default_flags
                        : GetFlags(error_stream, *iter, categories);
-  iter->second.Enable(log_stream_sp, log_options, flags);
+  iter->second.Enable(log_stream_sp, log_options, flags, buffer_size);
   return true;
 }
 
+bool Log::DumpLogChannel(llvm::StringRef channel,
+                         const std::shared_ptr<llvm::raw_ostream> &stream_sp,
+                         llvm::raw_ostream &error_stream) {
+  auto iter = g_channel_map->find(channel);
+  if (iter == g_channel_map->end()) {
+    error_stream << llvm::formatv("Invalid log channel '{0}'.\n", channel);
+    return false;
+  }
+  Log &log = iter->second;
+  if (!log.GetOptions().Test(LLDB_LOG_OPTION_CIRCULAR) || !log.GetStream()) {
+    error_stream << llvm::formatv(
+        "Log channel '{0}' is not keeping records in memory.\n", channel);
+    return false;
+  }
+
+  RecordBuffer::DrainAll();
+  auto output_sp = stream_sp ? stream_sp : log.GetStream();
+  if (output_sp)
+    log.WriteCircularRecords(*output_sp);
+  return true;
+}
+
+void Log::FlushBufferedLogChannels() {
+  RecordBuffer::DrainAll();
+  for (auto &entry : *g_channel_map) {
+    Log &log = entry.second;
+    if (!log.GetOptions().Test(LLDB_LOG_OPTION_CIRCULAR))
+      continue;
+    if (auto stream_sp = log.GetStream())
+      log.WriteCircularRecords(*stream_sp);
+  }
+}
+
 bool Log::DisableLogChannel(llvm::StringRef channel,
                             llvm::ArrayRef<const char *> categories,
                             llvm::raw_ostream &error_stream) {
@@ -236,6 +632,11 @@ bool Log::ListChannelCategories(llvm::StringRef channel,
   return true;
 }
 
+void Log::Terminate() {
+  g_log_terminated.store(true, std::memory_order_release);
+  RecordBuffer::StopWriter();
+}
+
 void Log::DisableAllLogChannels() {
   for (auto &entry : *g_channel_map)
     entry.second.Disable(UINT32_MAX);
@@ -255,9 +656,9 @@ bool Log::GetVerbose() const {
   return m_options.load(std::memory_order_relaxed) & LLDB_LOG_OPTION_VERBOSE;
 }
 
-void Log::WriteHeader(llvm::raw_ostream &OS, llvm::StringRef file,
-                      llvm::StringRef function) {
-  Flags options = GetOptions();
+static void WriteSequenceTimeAndThread(llvm::raw_ostream &OS, Flags options,
+                                       std::chrono::system_clock::time_point time,
+                                       uint64_t thread_id) {
   static uint32_t g_sequence_id = 0;
   // Add a sequence ID if requested
   if (options.Test(LLDB_LOG_OPTION_PREPEND_SEQUENCE))
@@ -265,15 +666,30 @@ void Log::WriteHeader(llvm::raw_ostream &OS, llvm::StringRef file,
 
   // Timestamp if requested
   if (options.Test(LLDB_LOG_OPTION_PREPEND_TIMESTAMP)) {
-    auto now = std::chrono::duration<double>(
-        std::chrono::system_clock::now().time_since_epoch());
+    auto now = std::chrono::duration<double>(time.time_since_epoch());
     OS << llvm::formatv("{0:f9} ", now.count());
   }
 
   // Add the process and thread if requested
   if (options.Test(LLDB_LOG_OPTION_PREPEND_PROC_AND_THREAD))
-    OS << llvm::formatv("[{0,0+4}/{1,0+4}] ", getpid(),
-                        llvm::get_threadid());
+    OS << llvm::formatv("[{0,0+4}/{1,0+4}] ", getpid(), thread_id);
+}
+
+static void WriteFileFunction(llvm::raw_ostream &OS, Flags options,
+                              llvm::StringRef file, llvm::StringRef function) {
+  if (options.Test(LLDB_LOG_OPTION_PREPEND_FILE_FUNCTION) &&
+      (!file.empty() || !function.empty())) {
+    file = llvm::sys::path::filename(file).take_front(40);
+    function = function.take_front(40);
+    OS << llvm::formatv("{0,-60:60} ", (file + ":" + function).str());
+  }
+}
+
+void Log::WriteHeader(llvm::raw_ostream &OS, llvm::StringRef file,
+                      llvm::StringRef function) {
+  Flags options = GetOptions();
+  WriteSequenceTimeAndThread(OS, options, std::chrono::system_clock::now(),
+                             llvm::get_threadid());
 
   // Add the thread name if requested
   if (options.Test(LLDB_LOG_OPTION_PREPEND_THREAD_NAME)) {
@@ -286,12 +702,58 @@ void Log::WriteHeader(llvm::raw_ostream &OS, llvm::StringRef file,
   if (options.Test(LLDB_LOG_OPTION_BACKTRACE))
     llvm::sys::PrintStackTrace(OS);
 
-  if (options.Test(LLDB_LOG_OPTION_PREPEND_FILE_FUNCTION) &&
-      (!file.empty() || !function.empty())) {
-    file = llvm::sys::path::filename(file).take_front(40);
-    function = function.take_front(40);
-    OS << llvm::formatv("{0,-60:60} ", (file + ":" + function).str());
+  WriteFileFunction(OS, options, file, function);
+}
+
+void Log::WriteRecord(const Record &record, std::string &output) {
+  llvm::sys::ScopedReader lock(m_mutex);
+  // The channel may have been disabled since the record was queued.
+  if (!m_stream_sp)
+    return;
+
+  Flags options = GetOptions();
+  std::string text;
+  llvm::raw_string_ostream OS(text);
+  if (record.dropped)
+    OS << llvm::formatv("[{0} log records dropped]\n", record.dropped);
+  WriteSequenceTimeAndThread(OS, options, record.time, record.thread_id);
+  OS << record.context;
+  WriteFileFunction(OS, options, record.file, record.function);
+  OS << record.message;
+  OS.flush();
+
+  if (options.Test(LLDB_LOG_OPTION_CIRCULAR)) {
+    std::lock_guard<std::mutex> guard(m_circular_mutex);
+    m_circular_records.push_back(std::move(text));
+    while (m_circular_records.size() > m_circular_capacity)
+      m_circular_records.pop_front();
+  } else
+    output += text;
+}
+
+void Log::WriteCircularRecords(llvm::raw_ostream &stream) {
+  std::deque<std::string> records;
+  {
+    std::lock_guard<std::mutex> guard(m_circular_mutex);
+    records.swap(m_circular_records);
   }
+  std::lock_guard<std::recursive_mutex> guard(GetThreadSafeLogMutex());
+  for (const std::string &record : records)
+    stream << record;
+  stream.flush();
+}
+
+void Log::WriteCircularRecordsOnCrash() {
+  // We are in a signal handler: don't wait for a lock the crashing thread may
+  // hold and don't allocate. The file streams of the log channels are
+  // unbuffered, so writing to them goes straight to the file. The records
+  // still queued by the logging threads are lost, formatting them allocates.
+  std::unique_lock<std::mutex> lock(m_circular_mutex, std::try_to_lock);
+  if (!lock.owns_lock() || !m_circular_stream_sp)
+    return;
+  for (const std::string &record : m_circular_records)
+    m_circular_stream_sp->write(record.data(), record.size());
+  m_circular_stream_sp->flush();
 }
 
 void Log::WriteMessage(const std::string &message) {
@@ -303,8 +765,7 @@ void Log::WriteMessage(const std::string &message) {
 
   Flags options = GetOptions();
   if (options.Test(LLDB_LOG_OPTION_THREADSAFE)) {
-    static std::recursive_mutex g_LogThreadedMutex;
-    std::lock_guard<std::recursive_mutex> guard(g_LogThreadedMutex);
+    std::lock_guard<std::recursive_mutex> guard(GetThreadSafeLogMutex());
     *stream_sp << message;
     stream_sp->flush();
   } else {
@@ -315,6 +776,17 @@ void Log::WriteMessage(const std::string &message) {
 
 void Log::Format(llvm::StringRef file, llvm::StringRef function,
                  const llvm::formatv_object_base &payload) {
+  if (GetOptions().Test(LLDB_LOG_OPTION_BUFFERED)) {
+    if (Record *record = RecordBuffer::Begin(*this, file, function)) {
+      llvm::SmallString<256> message;
+      llvm::raw_svector_ostream message_stream(message);
+      message_stream << payload << "\n";
+      record->message.append(message.begin(), message.end());
+      RecordBuffer::Commit();
+    }
+    return;
+  }
+
   std::string message_string;
   llvm::raw_string_ostream message(message_string);
   WriteHeader(message, file, function);
@@ -202,6 +202,8 @@ StringExtractorGDBRemote::GetServerPacketType() const {
       break;
 
     case 'M':
+      if (PACKET_STARTS_WITH("qMemoryChecksums:"))
+        return eServerPacketType_qMemoryChecksums;
       if (PACKET_STARTS_WITH("qMemoryRegionInfo:"))
         return eServerPacketType_qMemoryRegionInfo;
       if (PACKET_MATCHES("qMemoryRegionInfo"))
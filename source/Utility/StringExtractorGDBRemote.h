@@ -113,6 +113,7 @@ public:
     eServerPacketType_qGetPid,
     eServerPacketType_qGetProfileData,
     eServerPacketType_qGDBServerVersion,
+    eServerPacketType_qMemoryChecksums,
     eServerPacketType_qMemoryRegionInfo,
     eServerPacketType_qMemoryRegionInfoSupported,
     eServerPacketType_qProcessInfo,
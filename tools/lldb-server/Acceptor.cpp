@@ -57,12 +57,12 @@ const char *FindSchemeByProtocol(const Socket::SocketProtocol protocol) {
 }
 
 Error Acceptor::Listen(int backlog) {
-  return m_listener_socket_up->Listen(StringRef(m_name), backlog);
+  return m_listener_socket_sp->Listen(StringRef(m_name), backlog);
 }
 
 Error Acceptor::Accept(const bool child_processes_inherit, Connection *&conn) {
   Socket *conn_socket = nullptr;
-  auto error = m_listener_socket_up->Accept(
+  auto error = m_listener_socket_sp->Accept(
       StringRef(m_name), child_processes_inherit, conn_socket);
   if (error.Success())
     conn = new ConnectionFileDescriptor(conn_socket);
@@ -70,8 +70,22 @@ Error Acceptor::Accept(const bool child_processes_inherit, Connection *&conn) {
   return error;
 }
 
+MainLoopBase::ReadHandleUP
+Acceptor::RegisterWithMainLoop(MainLoopBase &loop,
+                               const bool child_processes_inherit,
+                               const AcceptCallback &callback, Error &error) {
+  return loop.RegisterReadObject(
+      m_listener_socket_sp,
+      [this, child_processes_inherit, callback](MainLoopBase &loop) {
+        Connection *conn = nullptr;
+        Error error = Accept(child_processes_inherit, conn);
+        callback(loop, error, std::unique_ptr<Connection>(conn));
+      },
+      error);
+}
+
 Socket::SocketProtocol Acceptor::GetSocketProtocol() const {
-  return m_listener_socket_up->GetSocketProtocol();
+  return m_listener_socket_sp->GetSocketProtocol();
 }
 
 const char *Acceptor::GetSocketScheme() const {
@@ -133,5 +147,5 @@ std::unique_ptr<Acceptor> Acceptor::Create(StringRef name,
 
 Acceptor::Acceptor(std::unique_ptr<Socket> &&listener_socket, StringRef name,
                    const LocalSocketIdFunc &local_socket_id)
-    : m_listener_socket_up(std::move(listener_socket)), m_name(name.str()),
+    : m_listener_socket_sp(std::move(listener_socket)), m_name(name.str()),
       m_local_socket_id(local_socket_id) {}
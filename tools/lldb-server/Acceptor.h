@@ -10,6 +10,7 @@
 #define lldb_server_Acceptor_h_
 
 #include "lldb/Core/Connection.h"
+#include "lldb/Host/MainLoopBase.h"
 #include "lldb/Host/Socket.h"
 #include "lldb/Utility/Error.h"
 
@@ -32,6 +33,19 @@ public:
 
   Error Accept(const bool child_processes_inherit, Connection *&conn);
 
+  typedef std::function<void(MainLoopBase &loop, const Error &error,
+                             std::unique_ptr<Connection> conn)>
+      AcceptCallback;
+
+  // Watch the listening socket with |loop| and accept connections as they
+  // come in. |callback| is invoked on the loop thread once per accepted
+  // connection (or failed accept), so the loop can multiplex the listening
+  // socket with other work instead of blocking in Accept. Connections stop
+  // being accepted when the returned handle is destroyed.
+  MainLoopBase::ReadHandleUP
+  RegisterWithMainLoop(MainLoopBase &loop, const bool child_processes_inherit,
+                       const AcceptCallback &callback, Error &error);
+
   static std::unique_ptr<Acceptor> Create(llvm::StringRef name,
                                           const bool child_processes_inherit,
                                           Error &error);
@@ -50,7 +64,7 @@ private:
   Acceptor(std::unique_ptr<Socket> &&listener_socket, llvm::StringRef name,
            const LocalSocketIdFunc &local_socket_id);
 
-  const std::unique_ptr<Socket> m_listener_socket_up;
+  const std::shared_ptr<Socket> m_listener_socket_sp;
   const std::string m_name;
   const LocalSocketIdFunc m_local_socket_id;
 };
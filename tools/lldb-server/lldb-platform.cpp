@@ -21,6 +21,7 @@
 
 // C++ Includes
 #include <fstream>
+#include <thread>
 
 // Other libraries and framework includes
 #include "llvm/Support/FileSystem.h"
@@ -32,10 +33,13 @@
 #include "Plugins/Process/gdb-remote/ProcessGDBRemoteLog.h"
 #include "lldb/Host/ConnectionFileDescriptor.h"
 #include "lldb/Host/HostGetOpt.h"
+#include "lldb/Host/MainLoop.h"
 #include "lldb/Host/OptionParser.h"
 #include "lldb/Host/common/TCPSocket.h"
 #include "lldb/Utility/Error.h"
 #include "lldb/Utility/FileSpec.h"
+#include "lldb/Utility/Log.h"
+#include "lldb/Utility/Logging.h"
 
 using namespace lldb;
 using namespace lldb_private;
@@ -50,6 +54,7 @@ using namespace llvm;
 static int g_debug = 0;
 static int g_verbose = 0;
 static int g_server = 0;
+static int g_threaded = 0;
 
 static struct option g_long_options[] = {
     {"debug", no_argument, &g_debug, 1},
@@ -63,6 +68,7 @@ static struct option g_long_options[] = {
     {"max-gdbserver-port", required_argument, NULL, 'M'},
     {"socket-file", required_argument, NULL, 'f'},
     {"server", no_argument, &g_server, 1},
+    {"threaded", no_argument, &g_threaded, 1},
     {NULL, 0, NULL, 0}};
 
 #if defined(__APPLE__)
@@ -93,7 +99,7 @@ static void signal_handler(int signo) {
 static void display_usage(const char *progname, const char *subcommand) {
   fprintf(stderr, "Usage:\n  %s %s [--log-file log-file-name] [--log-channels "
                   "log-channel-list] [--port-file port-file-path] --server "
-                  "--listen port\n",
+                  "[--threaded] --listen port\n",
           progname, subcommand);
   exit(0);
 }
@@ -133,6 +139,121 @@ static Error save_socket_id_to_file(const std::string &socket_id,
   return Error();
 }
 
+//----------------------------------------------------------------------
+// Talk to the lldb client on |conn| until it disconnects. |platform|
+// takes ownership of the connection.
+//----------------------------------------------------------------------
+static void
+serve_platform_connection(GDBRemoteCommunicationServerPlatform &platform,
+                          Connection *conn, const Args &inferior_arguments) {
+  platform.SetConnection(conn);
+
+  if (!platform.IsConnected())
+    return;
+
+  if (inferior_arguments.GetArgumentCount() > 0) {
+    lldb::pid_t pid = LLDB_INVALID_PROCESS_ID;
+    uint16_t port = 0;
+    std::string socket_name;
+    Error error = platform.LaunchGDBServer(inferior_arguments,
+                                           "", // hostname
+                                           pid, port, socket_name);
+    if (error.Success())
+      platform.SetPendingGdbServer(pid, port, socket_name);
+    else
+      fprintf(stderr, "failed to start gdbserver: %s\n", error.AsCString());
+  }
+
+  // After we connected, we need to get an initial ack from...
+  if (platform.HandshakeWithClient()) {
+    Error error;
+    bool interrupt = false;
+    bool done = false;
+    while (!interrupt && !done) {
+      if (platform.GetPacketAndSendResponse(llvm::None, error, interrupt,
+                                            done) !=
+          GDBRemoteCommunication::PacketResult::Success)
+        break;
+    }
+
+    if (error.Fail()) {
+      fprintf(stderr, "error: %s\n", error.AsCString());
+    }
+  } else {
+    fprintf(stderr, "error: handshake with client failed\n");
+  }
+}
+
+//----------------------------------------------------------------------
+// Serve every connection accepted on |acceptor| on its own thread of this
+// process instead of forking a child for it. All sessions share the state
+// that lldb-server initialized once at startup (HostInfo, the plugins, the
+// module cache) as well as the gdbserver port map, so accepting a connection
+// costs a thread rather than a fork. Each gdbserver launched for a session is
+// still a process of its own.
+//----------------------------------------------------------------------
+static int serve_platform_sessions(
+    Acceptor &acceptor, uint16_t port_offset,
+    const GDBRemoteCommunicationServerPlatform::SharedPortMapSP &port_map_sp,
+    const Args &inferior_arguments) {
+  const Socket::SocketProtocol protocol = acceptor.GetSocketProtocol();
+  const std::string scheme = acceptor.GetSocketScheme();
+
+  // Sessions run in the same process, so the accepted sockets must not leak
+  // into the processes that other sessions launch.
+  const bool children_inherit_accept_socket = false;
+  MainLoop main_loop;
+  Error error;
+  int exit_code = 0;
+  auto handle = acceptor.RegisterWithMainLoop(
+      main_loop, children_inherit_accept_socket,
+      [&](MainLoopBase &loop, const Error &accept_error,
+          std::unique_ptr<Connection> conn) {
+        Log *log(GetLogIfAnyCategoriesSet(LIBLLDB_LOG_PLATFORM));
+        if (accept_error.Fail()) {
+          if (log)
+            log->Printf("lldb-platform failed to accept a connection: %s",
+                        accept_error.AsCString());
+          fprintf(stderr, "error: failed to accept a connection: %s\n",
+                  accept_error.AsCString());
+          exit_code = -1;
+          loop.RequestTermination();
+          return;
+        }
+        if (log)
+          log->Printf("lldb-platform accepted a connection, starting a "
+                      "session thread");
+
+        std::thread session(
+            [protocol, scheme, port_offset, port_map_sp,
+             inferior_arguments](Connection *conn) {
+              GDBRemoteCommunicationServerPlatform platform(protocol,
+                                                            scheme.c_str());
+              if (port_offset > 0)
+                platform.SetPortOffset(port_offset);
+              platform.SetSharedPortMap(port_map_sp);
+              platform.SetUseSessionWorkingDirectory(true);
+              serve_platform_connection(platform, conn, inferior_arguments);
+              platform.WaitForSpawnedProcesses();
+            },
+            conn.release());
+        session.detach();
+      },
+      error);
+  if (error.Fail()) {
+    fprintf(stderr, "failed to watch the listening socket: %s\n",
+            error.AsCString());
+    return -1;
+  }
+
+  error = main_loop.Run();
+  if (error.Fail()) {
+    fprintf(stderr, "error: %s\n", error.AsCString());
+    return -1;
+  }
+  return exit_code;
+}
+
 //----------------------------------------------------------------------
 // main
 //----------------------------------------------------------------------
@@ -303,6 +424,19 @@ int main_platform(int argc, char *argv[]) {
     }
   }
 
+  if (g_server && g_threaded) {
+    auto port_map_sp = std::make_shared<
+        GDBRemoteCommunicationServerPlatform::SharedPortMap>();
+    port_map_sp->ports = std::move(gdbserver_portmap);
+    const int exit_code = serve_platform_sessions(*acceptor_up, port_offset,
+                                                  port_map_sp,
+                                                  inferior_arguments);
+    if (exit_code != 0)
+      exit(socket_error);
+    fprintf(stderr, "lldb-server exiting...\n");
+    return 0;
+  }
+
   do {
     GDBRemoteCommunicationServerPlatform platform(
         acceptor_up->GetSocketProtocol(), acceptor_up->GetSocketScheme());
@@ -343,40 +477,7 @@ int main_platform(int argc, char *argv[]) {
       // connections while a connection is active.
       acceptor_up.reset();
     }
-    platform.SetConnection(conn);
-
-    if (platform.IsConnected()) {
-      if (inferior_arguments.GetArgumentCount() > 0) {
-        lldb::pid_t pid = LLDB_INVALID_PROCESS_ID;
-        uint16_t port = 0;
-        std::string socket_name;
-        Error error = platform.LaunchGDBServer(inferior_arguments,
-                                               "", // hostname
-                                               pid, port, socket_name);
-        if (error.Success())
-          platform.SetPendingGdbServer(pid, port, socket_name);
-        else
-          fprintf(stderr, "failed to start gdbserver: %s\n", error.AsCString());
-      }
-
-      // After we connected, we need to get an initial ack from...
-      if (platform.HandshakeWithClient()) {
-        bool interrupt = false;
-        bool done = false;
-        while (!interrupt && !done) {
-          if (platform.GetPacketAndSendResponse(llvm::None, error, interrupt,
-                                                done) !=
-              GDBRemoteCommunication::PacketResult::Success)
-            break;
-        }
-
-        if (error.Fail()) {
-          fprintf(stderr, "error: %s\n", error.AsCString());
-        }
-      } else {
-        fprintf(stderr, "error: handshake with client failed\n");
-      }
-    }
+    serve_platform_connection(platform, conn, inferior_arguments);
   } while (g_server);
 
   fprintf(stderr, "lldb-server exiting...\n");
@@ -0,0 +1,140 @@
+//===-- MainLoopBenchmark.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Measures how long MainLoop takes to notice a ready descriptor when many
+// idle descriptors are registered, with each of its backends.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Host/File.h"
+#include "lldb/Host/MainLoop.h"
+#include "lldb/Utility/Error.h"
+
+#include "llvm/Support/CommandLine.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <chrono>
+#include <memory>
+#include <unistd.h>
+#include <vector>
+
+using namespace lldb_private;
+
+static llvm::cl::opt<unsigned>
+    NumDescriptors("descriptors", llvm::cl::init(1000),
+                   llvm::cl::desc("Number of registered descriptors"));
+
+static llvm::cl::opt<unsigned>
+    NumWakeups("wakeups", llvm::cl::init(10000),
+               llvm::cl::desc("Number of wakeups to time"));
+
+static const char *GetBackendName(MainLoop::Backend backend) {
+  return backend == MainLoop::Backend::EPoll ? "epoll" : "pselect";
+}
+
+// Returns the average wakeup latency in microseconds, or a negative value if
+// the loop couldn't be set up.
+static double MeasureWakeupLatency(MainLoop &loop) {
+  int ready_fds[2];
+  int idle_fds[2];
+  if (pipe(ready_fds) != 0)
+    return -1;
+  if (pipe(idle_fds) != 0) {
+    close(ready_fds[0]);
+    close(ready_fds[1]);
+    return -1;
+  }
+
+  // All the idle descriptors refer to the same pipe, which never becomes
+  // readable, so that this stays below FD_SETSIZE for pselect.
+  Error error;
+  std::vector<lldb::IOObjectSP> files;
+  std::vector<MainLoop::ReadHandleUP> handles;
+  for (unsigned i = 0; i + 1 < NumDescriptors && error.Success(); ++i) {
+    files.push_back(std::make_shared<File>(dup(idle_fds[0]), true));
+    handles.push_back(
+        loop.RegisterReadObject(files.back(), [](MainLoopBase &) {}, error));
+  }
+
+  // The callback makes its own descriptor ready again, so every iteration of
+  // the loop handles exactly one wakeup.
+  const char byte = 'X';
+  unsigned wakeups = 0;
+  std::chrono::steady_clock::time_point written;
+  std::chrono::nanoseconds total_latency(0);
+  auto ready_sp = std::make_shared<File>(ready_fds[0], true);
+  if (error.Success()) {
+    handles.push_back(loop.RegisterReadObject(
+        ready_sp,
+        [&](MainLoopBase &mainloop) {
+          total_latency += std::chrono::steady_clock::now() - written;
+          char c;
+          if (read(ready_fds[0], &c, 1) != 1 || ++wakeups == NumWakeups) {
+            mainloop.RequestTermination();
+            return;
+          }
+          written = std::chrono::steady_clock::now();
+          if (write(ready_fds[1], &byte, 1) != 1)
+            mainloop.RequestTermination();
+        },
+        error));
+  }
+
+  if (error.Success()) {
+    written = std::chrono::steady_clock::now();
+    if (write(ready_fds[1], &byte, 1) == 1)
+      error = loop.Run();
+  }
+
+  handles.clear();
+  files.clear();
+  ready_sp.reset();
+  close(ready_fds[1]);
+  close(idle_fds[0]);
+  close(idle_fds[1]);
+
+  if (error.Fail()) {
+    llvm::errs() << GetBackendName(loop.GetBackend())
+                 << ": " << error.AsCString() << "\n";
+    return -1;
+  }
+  if (wakeups != NumWakeups)
+    return -1;
+  return std::chrono::duration<double, std::micro>(total_latency).count() /
+         wakeups;
+}
+
+int main(int argc, char *argv[]) {
+  llvm::cl::ParseCommandLineOptions(argc, argv,
+                                    "MainLoop wakeup latency benchmark\n");
+  if (NumDescriptors == 0 || NumWakeups == 0) {
+    llvm::errs() << "--descriptors and --wakeups must be positive\n";
+    return 1;
+  }
+
+  int result = 0;
+  for (MainLoop::Backend backend :
+       {MainLoop::Backend::PSelect, MainLoop::Backend::EPoll}) {
+    MainLoop loop(backend);
+    if (loop.GetBackend() != backend) {
+      llvm::outs() << GetBackendName(backend) << ": not available\n";
+      continue;
+    }
+    const double latency = MeasureWakeupLatency(loop);
+    if (latency < 0) {
+      result = 1;
+      continue;
+    }
+    llvm::outs() << llvm::format(
+        "%s: average wakeup latency with %u descriptors: %.2f us\n",
+        GetBackendName(backend), unsigned(NumDescriptors), latency);
+  }
+  return result;
+}
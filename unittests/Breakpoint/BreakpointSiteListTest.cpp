@@ -0,0 +1,68 @@
+//===-- BreakpointSiteListTest.cpp ------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Breakpoint/BreakpointSite.h"
+#include "lldb/Breakpoint/BreakpointSiteList.h"
+
+#include <vector>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace lldb_private {
+class BreakpointSiteListTest : public testing::Test {
+protected:
+  BreakpointSiteSP AddSite(addr_t addr, uint32_t byte_size) {
+    BreakpointSiteSP site_sp(
+        new BreakpointSite(&m_sites, BreakpointLocationSP(), addr, false));
+    const uint8_t trap_opcode[] = {0xcc, 0xcc, 0xcc, 0xcc};
+    EXPECT_TRUE(site_sp->SetTrapOpcode(trap_opcode, byte_size));
+    EXPECT_NE(LLDB_INVALID_BREAK_ID, m_sites.Add(site_sp));
+    return site_sp;
+  }
+
+  std::vector<addr_t> SitesInRange(addr_t lower_bound, addr_t upper_bound) {
+    std::vector<addr_t> addresses;
+    m_sites.ForEachInRange(lower_bound, upper_bound,
+                           [&addresses](BreakpointSite *site) {
+                             addresses.push_back(site->GetLoadAddress());
+                           });
+    return addresses;
+  }
+
+  BreakpointSiteList m_sites;
+};
+} // namespace lldb_private
+
+TEST_F(BreakpointSiteListTest, ForEachInRange) {
+  AddSite(0x1000, 4);
+  AddSite(0x1010, 4);
+  AddSite(0x1020, 1);
+
+  typedef std::vector<addr_t> Addresses;
+  EXPECT_EQ(Addresses({0x1000, 0x1010, 0x1020}), SitesInRange(0, 0x2000));
+  EXPECT_EQ(Addresses({0x1010}), SitesInRange(0x1010, 0x1020));
+  EXPECT_EQ(Addresses(), SitesInRange(0x1004, 0x1010));
+  EXPECT_EQ(Addresses(), SitesInRange(0x1010, 0x1010));
+
+  // A site starting at the end of the range is not in it.
+  EXPECT_EQ(Addresses({0x1000}), SitesInRange(0xff0, 0x1010));
+  EXPECT_EQ(Addresses(), SitesInRange(0xff0, 0x1000));
+
+  // A site whose opcode starts before the range and extends into it is.
+  EXPECT_EQ(Addresses({0x1000}), SitesInRange(0x1003, 0x1004));
+  EXPECT_EQ(Addresses({0x1000, 0x1010}), SitesInRange(0x1002, 0x1011));
+
+  BreakpointSiteList found;
+  EXPECT_FALSE(m_sites.FindInRange(0x1014, 0x1020, found));
+  EXPECT_TRUE(m_sites.FindInRange(0x1014, 0x1021, found));
+  EXPECT_EQ(1u, found.GetSize());
+}
@@ -0,0 +1,138 @@
+//===-- NativeBreakpointListTest.cpp ----------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Core/ArchSpec.h"
+#include "lldb/Host/common/NativeBreakpointList.h"
+#include "lldb/Host/common/NativeProcessProtocol.h"
+#include "lldb/Host/common/SoftwareBreakpoint.h"
+
+#include <cstring>
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+// The breakpoints only need a process to enable and disable themselves,
+// which these tests never do.
+class TestProcess : public NativeProcessProtocol {
+public:
+  TestProcess() : NativeProcessProtocol(1) {}
+
+  Error Resume(const ResumeActionList &resume_actions) override {
+    return Error();
+  }
+  Error Halt() override { return Error(); }
+  Error Detach() override { return Error(); }
+  Error Signal(int signo) override { return Error(); }
+  Error Kill() override { return Error(); }
+  Error ReadMemory(addr_t addr, void *buf, size_t size,
+                   size_t &bytes_read) override {
+    return Error("unimplemented");
+  }
+  Error ReadMemoryWithoutTrap(addr_t addr, void *buf, size_t size,
+                              size_t &bytes_read) override {
+    return Error("unimplemented");
+  }
+  Error WriteMemory(addr_t addr, const void *buf, size_t size,
+                    size_t &bytes_written) override {
+    return Error("unimplemented");
+  }
+  Error AllocateMemory(size_t size, uint32_t permissions,
+                       addr_t &addr) override {
+    return Error("unimplemented");
+  }
+  Error DeallocateMemory(addr_t addr) override {
+    return Error("unimplemented");
+  }
+  addr_t GetSharedLibraryInfoAddress() override {
+    return LLDB_INVALID_ADDRESS;
+  }
+  size_t UpdateThreads() override { return 0; }
+  bool GetArchitecture(ArchSpec &arch) const override { return false; }
+  Error SetBreakpoint(addr_t addr, uint32_t size, bool hardware) override {
+    return Error("unimplemented");
+  }
+  llvm::ErrorOr<std::unique_ptr<llvm::MemoryBuffer>>
+  GetAuxvData() const override {
+    return std::make_error_code(std::errc::not_supported);
+  }
+  Error GetLoadedModuleFileSpec(const char *module_path,
+                                FileSpec &file_spec) override {
+    return Error("unimplemented");
+  }
+  Error GetFileLoadAddress(const llvm::StringRef &file_name,
+                           addr_t &load_addr) override {
+    return Error("unimplemented");
+  }
+  Error GetSoftwareBreakpointTrapOpcode(
+      size_t trap_opcode_size_hint, size_t &actual_opcode_size,
+      const uint8_t *&trap_opcode_bytes) override {
+    return Error("unimplemented");
+  }
+};
+
+class NativeBreakpointListTest : public testing::Test {
+protected:
+  // Adds a software breakpoint whose saved opcode bytes are \a saved_byte.
+  void AddBreakpoint(addr_t addr, size_t opcode_size, uint8_t saved_byte) {
+    TestProcess &process = m_process;
+    auto create_func = [&process, opcode_size, saved_byte](
+        addr_t addr, size_t size_hint, bool hardware,
+        NativeBreakpointSP &breakpoint_sp) {
+      uint8_t saved_opcodes[8];
+      uint8_t trap_opcodes[8];
+      ::memset(saved_opcodes, saved_byte, sizeof(saved_opcodes));
+      ::memset(trap_opcodes, 0xcc, sizeof(trap_opcodes));
+      breakpoint_sp.reset(new SoftwareBreakpoint(
+          process, addr, saved_opcodes, trap_opcodes, opcode_size));
+      return Error();
+    };
+    ASSERT_TRUE(m_breakpoints.AddRef(addr, opcode_size, false, create_func)
+                    .Success());
+  }
+
+  // Reads [addr, addr + size) of memory that is all traps.
+  std::string RemoveTraps(addr_t addr, size_t size) {
+    std::string buffer(size, '\xcc');
+    EXPECT_TRUE(
+        m_breakpoints.RemoveTrapsFromBuffer(addr, &buffer[0], size).Success());
+    return buffer;
+  }
+
+  TestProcess m_process;
+  NativeBreakpointList m_breakpoints;
+};
+} // namespace
+
+TEST_F(NativeBreakpointListTest, RemoveTrapsFromBuffer) {
+  AddBreakpoint(0x1000, 4, 'a');
+  AddBreakpoint(0x1008, 4, 'b');
+
+  EXPECT_EQ("aaaa\xcc\xcc\xcc\xcc"
+            "bbbb",
+            RemoveTraps(0x1000, 12));
+
+  // A breakpoint that starts before the buffer is clipped to its start.
+  EXPECT_EQ("aa\xcc\xcc", RemoveTraps(0x1002, 4));
+
+  // A breakpoint that ends past the buffer is clipped to its end.
+  EXPECT_EQ("\xcc\xcc"
+            "bb",
+            RemoveTraps(0x1006, 4));
+
+  // A breakpoint covering the whole buffer.
+  EXPECT_EQ("bb", RemoveTraps(0x1009, 2));
+
+  // Breakpoints right before or right after the buffer don't touch it.
+  EXPECT_EQ("\xcc\xcc\xcc\xcc", RemoveTraps(0x1004, 4));
+  EXPECT_EQ("\xcc\xcc\xcc\xcc", RemoveTraps(0x100c, 4));
+  EXPECT_EQ("", RemoveTraps(0x1000, 0));
+}
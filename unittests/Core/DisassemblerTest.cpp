@@ -0,0 +1,301 @@
+//===-- DisassemblerTest.cpp ------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/Disassembler.h"
+#include "lldb/Core/PluginManager.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "gtest/gtest.h"
+
+#include <utility>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace {
+
+class TestInstruction : public Instruction {
+public:
+  TestInstruction(lldb::addr_t file_addr, size_t size, bool does_branch)
+      : Instruction(Address(file_addr)), m_does_branch(does_branch) {
+    uint8_t bytes[16] = {};
+    m_opcode.SetOpcodeBytes(bytes, size);
+  }
+
+  void
+  CalculateMnemonicOperandsAndComment(const ExecutionContext *) override {
+    ++m_num_calculations;
+    m_opcode_name = "nop";
+    m_comment += "comment";
+  }
+
+  bool DoesBranch() override { return m_does_branch; }
+
+  size_t Decode(const Disassembler &, const DataExtractor &,
+                lldb::offset_t) override {
+    return m_opcode.GetByteSize();
+  }
+
+  int m_num_calculations = 0;
+
+private:
+  bool m_does_branch;
+};
+
+// Decodes a made up instruction set, in which the first byte of an
+// instruction is its size and a zero byte is an invalid instruction.
+class TestDisassembler : public Disassembler {
+public:
+  TestDisassembler(const ArchSpec &arch, const char *flavor)
+      : Disassembler(arch, flavor) {}
+
+  static ConstString GetPluginNameStatic() {
+    static ConstString g_name("test-disassembler");
+    return g_name;
+  }
+
+  static Disassembler *CreateInstance(const ArchSpec &arch,
+                                      const char *flavor) {
+    return new TestDisassembler(arch, flavor);
+  }
+
+  size_t DecodeInstructions(const Address &base_addr,
+                            const DataExtractor &data,
+                            lldb::offset_t data_offset,
+                            size_t num_instructions, bool append,
+                            bool data_from_file) override {
+    if (!append)
+      m_instruction_list.Clear();
+    const lldb::addr_t base_file_addr = base_addr.GetFileAddress();
+    lldb::offset_t offset = data_offset;
+    for (; num_instructions > 0 && data.ValidOffset(offset);
+         --num_instructions) {
+      const uint8_t size = *data.PeekData(offset, 1);
+      if (size == 0 || !data.ValidOffsetForDataOfSize(offset, size))
+        break;
+      lldb::InstructionSP inst_sp(new TestInstruction(
+          base_file_addr + offset - data_offset, size, false));
+      m_instruction_list.Append(inst_sp);
+      offset += size;
+    }
+    return offset - data_offset;
+  }
+
+  bool FlavorValidForArchSpec(const ArchSpec &arch,
+                              const char *flavor) override {
+    return true;
+  }
+
+  ConstString GetPluginName() override { return GetPluginNameStatic(); }
+
+  uint32_t GetPluginVersion() override { return 1; }
+};
+
+typedef std::vector<std::pair<lldb::addr_t, size_t>> InstructionRanges;
+
+InstructionRanges GetInstructionRanges(Disassembler &disassembler) {
+  InstructionRanges ranges;
+  InstructionList &instructions = disassembler.GetInstructionList();
+  for (size_t i = 0; i < instructions.GetSize(); ++i) {
+    lldb::InstructionSP inst_sp = instructions.GetInstructionAtIndex(i);
+    ranges.emplace_back(inst_sp->GetAddress().GetFileAddress(),
+                        inst_sp->GetOpcode().GetByteSize());
+  }
+  return ranges;
+}
+
+class DisassemblerTest : public testing::Test {
+public:
+  static void SetUpTestCase() {
+    PluginManager::RegisterPlugin(TestDisassembler::GetPluginNameStatic(),
+                                  "Test disassembler",
+                                  TestDisassembler::CreateInstance);
+  }
+
+  static void TearDownTestCase() {
+    PluginManager::UnregisterPlugin(TestDisassembler::CreateInstance);
+  }
+
+protected:
+  void SetUp() override {
+    // Instructions of 1 to 7 bytes, 4000 bytes in all.
+    for (uint8_t size = 1; m_bytes.size() + size <= 4000;
+         size = size % 7 + 1) {
+      m_inst_starts.push_back(m_bytes.size());
+      m_bytes.push_back(size);
+      m_bytes.insert(m_bytes.end(), size - 1, 0xff);
+    }
+  }
+
+  lldb::DisassemblerSP CreateDisassembler() {
+    return Disassembler::FindPlugin(
+        ArchSpec("x86_64-pc-linux"), nullptr,
+        TestDisassembler::GetPluginNameStatic().GetCString());
+  }
+
+  DataExtractor GetData() {
+    return DataExtractor(m_bytes.data(), m_bytes.size(),
+                         lldb::eByteOrderLittle, 8);
+  }
+
+  // Decodes all the bytes in one go.
+  InstructionRanges DecodeSequentially() {
+    lldb::DisassemblerSP disasm_sp = CreateDisassembler();
+    disasm_sp->DecodeInstructions(Address(m_base_addr), GetData(), 0,
+                                  UINT32_MAX, false, true);
+    return GetInstructionRanges(*disasm_sp);
+  }
+
+  const lldb::addr_t m_base_addr = 0x10000;
+  std::vector<uint8_t> m_bytes;
+  std::vector<lldb::offset_t> m_inst_starts;
+};
+
+} // namespace
+
+TEST(BranchMapTest, Lookup) {
+  // Instructions at 0x1000, 0x1002, 0x1005, 0x1009 and 0x100a, the ones at
+  // 0x1005 and 0x100a branch.
+  const lldb::addr_t base = 0x1000;
+  InstructionList instructions;
+  auto add = [&](lldb::addr_t file_addr, size_t size, bool does_branch) {
+    lldb::InstructionSP inst_sp(
+        new TestInstruction(file_addr, size, does_branch));
+    instructions.Append(inst_sp);
+  };
+  add(0x1000, 2, false);
+  add(0x1002, 3, false);
+  add(0x1005, 4, true);
+  add(0x1009, 1, false);
+  add(0x100a, 2, true);
+
+  BranchMap branch_map(base, instructions);
+  EXPECT_EQ(5u, branch_map.GetNumInstructions());
+
+  EXPECT_EQ(0u, branch_map.GetIndexOfInstructionAt(0x1000));
+  EXPECT_EQ(2u, branch_map.GetIndexOfInstructionAt(0x1005));
+  EXPECT_EQ(4u, branch_map.GetIndexOfInstructionAt(0x100a));
+  EXPECT_EQ(UINT32_MAX, branch_map.GetIndexOfInstructionAt(0x1003));
+  EXPECT_EQ(UINT32_MAX, branch_map.GetIndexOfInstructionAt(0x0fff));
+  EXPECT_EQ(UINT32_MAX, branch_map.GetIndexOfInstructionAt(0x100c));
+
+  EXPECT_EQ(1u, branch_map.GetIndexOfLastInstructionBefore(0x1005));
+  EXPECT_EQ(2u, branch_map.GetIndexOfLastInstructionBefore(0x1006));
+  EXPECT_EQ(4u, branch_map.GetIndexOfLastInstructionBefore(0x100c));
+  EXPECT_EQ(UINT32_MAX, branch_map.GetIndexOfLastInstructionBefore(0x1000));
+  EXPECT_EQ(UINT32_MAX, branch_map.GetIndexOfLastInstructionBefore(0x100d));
+
+  EXPECT_EQ(2u, branch_map.GetIndexOfNextBranch(0));
+  EXPECT_EQ(2u, branch_map.GetIndexOfNextBranch(2));
+  EXPECT_EQ(4u, branch_map.GetIndexOfNextBranch(3));
+  EXPECT_EQ(UINT32_MAX, branch_map.GetIndexOfNextBranch(5));
+
+  EXPECT_EQ(0x1005u, branch_map.GetInstructionAddress(2));
+  EXPECT_EQ(0x1009u, branch_map.GetInstructionEndAddress(2));
+  EXPECT_EQ(0x100cu, branch_map.GetInstructionEndAddress(4));
+}
+
+TEST_F(DisassemblerTest, DecodeInstructionsInChunks) {
+  lldb::DisassemblerSP disasm_sp = CreateDisassembler();
+  ASSERT_TRUE(disasm_sp);
+  const InstructionRanges expected = DecodeSequentially();
+  ASSERT_EQ(m_inst_starts.size(), expected.size());
+
+  // Pieces that start where instructions do are decoded in parallel.
+  const size_t num_insts = m_inst_starts.size();
+  std::vector<lldb::offset_t> chunk_starts = {
+      0, m_inst_starts[num_insts / 3], m_inst_starts[2 * num_insts / 3]};
+  EXPECT_EQ(m_bytes.size(),
+            disasm_sp->DecodeInstructionsInChunks(Address(m_base_addr),
+                                                  GetData(), chunk_starts,
+                                                  true));
+  EXPECT_EQ(expected, GetInstructionRanges(*disasm_sp));
+
+  // A piece that starts in the middle of an instruction is decoded again
+  // from where the previous piece stopped.
+  size_t idx = num_insts / 2;
+  while (m_bytes[m_inst_starts[idx]] == 1)
+    ++idx;
+  chunk_starts = {0, m_inst_starts[idx] + 1};
+  EXPECT_EQ(m_bytes.size(),
+            disasm_sp->DecodeInstructionsInChunks(Address(m_base_addr),
+                                                  GetData(), chunk_starts,
+                                                  true));
+  EXPECT_EQ(expected, GetInstructionRanges(*disasm_sp));
+}
+
+TEST_F(DisassemblerTest, DecodeInstructionsInChunksStopsAtInvalid) {
+  // An invalid instruction in the second piece ends the decoding there, and
+  // the third piece is dropped.
+  const size_t num_insts = m_inst_starts.size();
+  m_bytes[m_inst_starts[num_insts / 2]] = 0;
+  const InstructionRanges expected = DecodeSequentially();
+  ASSERT_EQ(num_insts / 2, expected.size());
+
+  lldb::DisassemblerSP disasm_sp = CreateDisassembler();
+  std::vector<lldb::offset_t> chunk_starts = {
+      0, m_inst_starts[num_insts / 3], m_inst_starts[2 * num_insts / 3]};
+  EXPECT_EQ(m_inst_starts[num_insts / 2],
+            disasm_sp->DecodeInstructionsInChunks(Address(m_base_addr),
+                                                  GetData(), chunk_starts,
+                                                  true));
+  EXPECT_EQ(expected, GetInstructionRanges(*disasm_sp));
+}
+
+TEST_F(DisassemblerTest, InstructionStrings) {
+  TestInstruction inst(0x1000, 1, false);
+  EXPECT_EQ("nop", inst.GetMnemonic(nullptr));
+  EXPECT_EQ("", inst.GetOperands(nullptr));
+  EXPECT_EQ("comment", inst.GetComment(nullptr));
+  // The strings are only computed again for another execution context.
+  EXPECT_EQ(1, inst.m_num_calculations);
+}
+
+TEST_F(DisassemblerTest, DisassemblyCache) {
+  const ConstString config("test");
+  const ExecutionContext exe_ctx;
+  auto decode = [this](size_t num_bytes) {
+    lldb::DisassemblerSP disasm_sp = CreateDisassembler();
+    std::vector<uint8_t> bytes(num_bytes, 1);
+    DataExtractor data(bytes.data(), bytes.size(), lldb::eByteOrderLittle, 8);
+    disasm_sp->DecodeInstructions(Address(m_base_addr), data, 0, UINT32_MAX,
+                                  false, true);
+    return disasm_sp;
+  };
+  auto range = [](lldb::addr_t file_addr, lldb::addr_t size) {
+    return AddressRange(Address(file_addr), size);
+  };
+
+  DisassemblyCache cache;
+  lldb::DisassemblerSP small_sp = decode(16);
+  cache.Add(config, range(0x1000, 16), exe_ctx, true, small_sp);
+  EXPECT_EQ(small_sp, cache.Find(config, range(0x1000, 16), exe_ctx, false));
+  EXPECT_FALSE(cache.Find(config, range(0x1000, 8), exe_ctx, false));
+  EXPECT_FALSE(
+      cache.Find(ConstString("other"), range(0x1000, 16), exe_ctx, false));
+
+  // Disassembly of process memory isn't kept without a process.
+  cache.Add(config, range(0x2000, 16), exe_ctx, false, small_sp);
+  EXPECT_FALSE(cache.Find(config, range(0x2000, 16), exe_ctx, false));
+
+  // Ranges with more instructions than the cache keeps aren't kept, and
+  // adding ranges evicts the least recently used ones to stay within the
+  // instruction budget.
+  cache.Add(config, range(0x10000, 100000), exe_ctx, true, decode(100000));
+  EXPECT_FALSE(cache.Find(config, range(0x10000, 100000), exe_ctx, false));
+
+  lldb::DisassemblerSP first_sp = decode(40000);
+  lldb::DisassemblerSP second_sp = decode(40000);
+  cache.Add(config, range(0x10000, 40000), exe_ctx, true, first_sp);
+  EXPECT_EQ(small_sp, cache.Find(config, range(0x1000, 16), exe_ctx, false));
+  cache.Add(config, range(0x20000, 40000), exe_ctx, true, second_sp);
+  EXPECT_FALSE(cache.Find(config, range(0x10000, 40000), exe_ctx, false));
+  EXPECT_EQ(second_sp,
+            cache.Find(config, range(0x20000, 40000), exe_ctx, false));
+  EXPECT_EQ(small_sp, cache.Find(config, range(0x1000, 16), exe_ctx, false));
+}
@@ -0,0 +1,115 @@
+//===-- SourceManagerTest.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Core/SourceManager.h"
+#include "gtest/gtest.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/raw_ostream.h"
+
+#include <string>
+
+using namespace lldb_private;
+
+namespace {
+
+class SourceManagerTest : public testing::Test {
+protected:
+  void TearDown() override {
+    if (!m_path.empty())
+      llvm::sys::fs::remove(m_path);
+  }
+
+  SourceManager::FileSP CreateFile(llvm::StringRef contents) {
+    int fd;
+    if (llvm::sys::fs::createTemporaryFile("SourceManagerTest", "c", fd,
+                                           m_path))
+      return SourceManager::FileSP();
+    {
+      llvm::raw_fd_ostream os(fd, true);
+      os << contents;
+    }
+    FileSpec file_spec(m_path.c_str(), false);
+    return std::make_shared<SourceManager::File>(file_spec,
+                                                 lldb::DebuggerSP());
+  }
+
+  llvm::SmallString<128> m_path;
+};
+
+} // namespace
+
+TEST_F(SourceManagerTest, LineEndings) {
+  auto file_sp = CreateFile("a\nbb\r\nccc\n\rdddd");
+  ASSERT_TRUE(file_sp);
+
+  std::string line;
+  ASSERT_TRUE(file_sp->GetLine(1, line));
+  EXPECT_EQ("a\n", line);
+  ASSERT_TRUE(file_sp->GetLine(2, line));
+  EXPECT_EQ("bb\r\n", line);
+  ASSERT_TRUE(file_sp->GetLine(3, line));
+  EXPECT_EQ("ccc\n\r", line);
+  ASSERT_TRUE(file_sp->GetLine(4, line));
+  EXPECT_EQ("dddd", line);
+  EXPECT_FALSE(file_sp->LineIsValid(5));
+
+  EXPECT_EQ(2u, file_sp->GetLineLength(2, false));
+  EXPECT_EQ(4u, file_sp->GetLineLength(2, true));
+  EXPECT_EQ(5u, file_sp->GetNumLines());
+}
+
+TEST_F(SourceManagerTest, IndexOnDemand) {
+  const uint32_t num_lines = 10000;
+  std::string contents;
+  for (uint32_t i = 1; i <= num_lines; ++i)
+    contents += "line " + std::to_string(i) + (i % 7 ? "\n" : "\r\n");
+  auto file_sp = CreateFile(contents);
+  ASSERT_TRUE(file_sp);
+
+  // Asking for an early line first must not change what later lines are.
+  std::string line;
+  ASSERT_TRUE(file_sp->GetLine(3, line));
+  EXPECT_EQ("line 3\n", line);
+  ASSERT_TRUE(file_sp->GetLine(5000, line));
+  EXPECT_EQ("line 5000\n", line);
+  ASSERT_TRUE(file_sp->GetLine(4998, line));
+  EXPECT_EQ("line 4998\r\n", line);
+  ASSERT_TRUE(file_sp->GetLine(num_lines, line));
+  EXPECT_EQ("line 10000\n", line);
+  EXPECT_FALSE(file_sp->LineIsValid(num_lines + 1));
+  EXPECT_EQ(num_lines + 1, file_sp->GetNumLines());
+}
+
+TEST(SourceFileCacheTest, EvictsLeastRecentlyUsed) {
+  SourceManager::SourceFileCache cache(2);
+  FileSpec a("/src/a.c", false), b("/src/b.c", false), c("/src/c.c", false);
+  auto a_sp = std::make_shared<SourceManager::File>(a, lldb::DebuggerSP());
+  auto b_sp = std::make_shared<SourceManager::File>(b, lldb::DebuggerSP());
+  auto c_sp = std::make_shared<SourceManager::File>(c, lldb::DebuggerSP());
+
+  cache.AddSourceFile(a_sp);
+  cache.AddSourceFile(b_sp);
+  EXPECT_EQ(a_sp, cache.FindSourceFile(a, nullptr));
+
+  // b is now the least recently used file.
+  cache.AddSourceFile(c_sp);
+  EXPECT_EQ(2u, cache.GetSize());
+  EXPECT_EQ(a_sp, cache.FindSourceFile(a, nullptr));
+  EXPECT_EQ(nullptr, cache.FindSourceFile(b, nullptr));
+  EXPECT_EQ(c_sp, cache.FindSourceFile(c, nullptr));
+
+  // Adding a file again replaces it rather than taking another slot.
+  auto a2_sp = std::make_shared<SourceManager::File>(a, lldb::DebuggerSP());
+  cache.AddSourceFile(a2_sp);
+  EXPECT_EQ(2u, cache.GetSize());
+  EXPECT_EQ(a2_sp, cache.FindSourceFile(a, nullptr));
+  EXPECT_EQ(c_sp, cache.FindSourceFile(c, nullptr));
+}
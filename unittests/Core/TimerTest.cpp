@@ -12,6 +12,7 @@
 
 #include "lldb/Utility/StreamString.h"
 #include <thread>
+#include <vector>
 
 using namespace lldb_private;
 
@@ -64,3 +65,27 @@ TEST(TimerTest, CategoryTimes2) {
   EXPECT_LT(0.001, seconds2);
   EXPECT_GT(0.1, seconds2);
 }
+
+TEST(TimerTest, CategoryTimesThreads) {
+  Timer::ResetCategoryTimes();
+  const unsigned num_threads = 8;
+  const unsigned timers_per_thread = 1000;
+  const char *category = "CAT1";
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < num_threads; ++i)
+    threads.emplace_back([category] {
+      for (unsigned j = 0; j < timers_per_thread; ++j)
+        Timer t(category, "");
+    });
+  for (std::thread &thread : threads)
+    thread.join();
+  {
+    Timer t(category, "");
+  }
+
+  // Both the exited threads and the current one are counted.
+  std::vector<Timer::CategoryStats> stats = Timer::GetCategoryStats();
+  ASSERT_EQ(1u, stats.size());
+  EXPECT_STREQ("CAT1", stats[0].category);
+  EXPECT_EQ(num_threads * timers_per_thread + 1, stats[0].count);
+}
@@ -0,0 +1,306 @@
+//===-- DWARFExpressionTest.cpp ---------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Expression/DWARFExpression.h"
+#include "Plugins/Platform/Linux/PlatformLinux.h"
+#include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/Listener.h"
+#include "lldb/Core/RegisterValue.h"
+#include "lldb/Core/Value.h"
+#include "lldb/Core/dwarf.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Target/ExecutionContext.h"
+#include "lldb/Target/Platform.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/RegisterContext.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/Thread.h"
+#include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/DataExtractor.h"
+#include "lldb/Utility/Error.h"
+
+#include "gtest/gtest.h"
+
+#include <string>
+#include <vector>
+
+using namespace lldb_private;
+using namespace lldb_private::platform_linux;
+
+namespace {
+
+struct EvaluationResult {
+  bool success;
+  std::string error;
+  Value value;
+};
+
+// Evaluate "opcodes" both through the DWARFExpression object, which decodes
+// simple locations once and evaluates them directly, and through the DWARF
+// stack machine.
+void EvaluateBothWays(const std::vector<uint8_t> &opcodes,
+                      EvaluationResult &decoded, EvaluationResult &stack,
+                      ExecutionContext *exe_ctx = nullptr,
+                      RegisterContext *reg_ctx = nullptr) {
+  DataExtractor data(opcodes.data(), opcodes.size(), lldb::eByteOrderLittle,
+                     8);
+  DWARFExpression expr(lldb::ModuleSP(), data, nullptr, 0, opcodes.size());
+
+  Error error;
+  decoded.success =
+      expr.Evaluate(exe_ctx, nullptr, nullptr, reg_ctx, LLDB_INVALID_ADDRESS,
+                    nullptr, nullptr, decoded.value, &error);
+  decoded.error = error.AsCString("");
+
+  error.Clear();
+  stack.success = DWARFExpression::Evaluate(
+      exe_ctx, nullptr, nullptr, reg_ctx, lldb::ModuleSP(), data, nullptr, 0,
+      opcodes.size(), lldb::eRegisterKindDWARF, nullptr, nullptr, stack.value,
+      &error);
+  stack.error = error.AsCString("");
+}
+
+// Eight 64-bit registers whose DWARF and native numbers are both their
+// index, register N holding "N * 0x1000 + 0x100".
+class MockRegisterContext : public RegisterContext {
+public:
+  static const size_t kNumRegisters = 8;
+
+  MockRegisterContext(Thread &thread) : RegisterContext(thread, 0) {
+    for (size_t i = 0; i < kNumRegisters; ++i) {
+      RegisterInfo &info = m_reg_infos[i];
+      info = RegisterInfo();
+      info.name = ConstString("r" + std::to_string(i)).GetCString();
+      info.byte_size = 8;
+      info.encoding = lldb::eEncodingUint;
+      info.format = lldb::eFormatHex;
+      for (uint32_t &kind : info.kinds)
+        kind = i;
+    }
+  }
+
+  static uint64_t GetValue(uint32_t reg) { return reg * 0x1000 + 0x100; }
+
+  void InvalidateAllRegisters() override {}
+
+  size_t GetRegisterCount() override { return kNumRegisters; }
+
+  const RegisterInfo *GetRegisterInfoAtIndex(size_t reg) override {
+    return reg < kNumRegisters ? &m_reg_infos[reg] : nullptr;
+  }
+
+  size_t GetRegisterSetCount() override { return 0; }
+
+  const RegisterSet *GetRegisterSet(size_t reg_set) override {
+    return nullptr;
+  }
+
+  bool ReadRegister(const RegisterInfo *reg_info,
+                    RegisterValue &reg_value) override {
+    reg_value.SetUInt64(GetValue(reg_info->kinds[lldb::eRegisterKindLLDB]));
+    return true;
+  }
+
+  bool WriteRegister(const RegisterInfo *reg_info,
+                     const RegisterValue &reg_value) override {
+    return false;
+  }
+
+  uint32_t ConvertRegisterKindToRegisterNumber(lldb::RegisterKind kind,
+                                               uint32_t num) override {
+    if (kind == lldb::eRegisterKindGeneric)
+      return LLDB_INVALID_REGNUM;
+    return num < kNumRegisters ? num : LLDB_INVALID_REGNUM;
+  }
+
+private:
+  RegisterInfo m_reg_infos[kNumRegisters];
+};
+
+class MockProcess : public Process {
+public:
+  MockProcess(lldb::TargetSP target_sp, lldb::ListenerSP listener_sp)
+      : Process(target_sp, listener_sp) {}
+
+  ConstString GetPluginName() override { return ConstString("mock"); }
+  uint32_t GetPluginVersion() override { return 1; }
+
+  bool CanDebug(lldb::TargetSP target, bool plugin_specified_by_name) override {
+    return false;
+  }
+  Error DoDestroy() override { return Error(); }
+  void RefreshStateAfterStop() override {}
+  size_t DoReadMemory(lldb::addr_t vm_addr, void *buf, size_t size,
+                      Error &error) override {
+    error.SetErrorString("mock process has no memory");
+    return 0;
+  }
+  bool UpdateThreadList(ThreadList &old_thread_list,
+                        ThreadList &new_thread_list) override {
+    return false;
+  }
+};
+
+class MockThread : public Thread {
+public:
+  MockThread(Process &process) : Thread(process, 1) {}
+  ~MockThread() override { DestroyThread(); }
+
+  void RefreshStateAfterStop() override {}
+  lldb::RegisterContextSP GetRegisterContext() override {
+    return lldb::RegisterContextSP();
+  }
+  lldb::RegisterContextSP
+  CreateRegisterContextForFrame(StackFrame *frame) override {
+    return lldb::RegisterContextSP();
+  }
+  bool CalculateStopInfo() override { return false; }
+};
+
+} // namespace
+
+// Evaluates expressions against a register context that belongs to a thread
+// of a mock process.
+class DWARFExpressionRegisterTest : public ::testing::Test {
+public:
+  static void SetUpTestCase() {
+    HostInfo::Initialize();
+    PlatformLinux::Initialize();
+    Debugger::Initialize(nullptr);
+    ArchSpec arch("x86_64-pc-linux");
+    Platform::SetHostPlatform(PlatformLinux::CreateInstance(true, &arch));
+  }
+
+  static void TearDownTestCase() {
+    Debugger::Terminate();
+    PlatformLinux::Terminate();
+    HostInfo::Terminate();
+  }
+
+  void SetUp() override {
+    m_debugger_sp = Debugger::CreateInstance();
+    ArchSpec arch("x86_64-pc-linux");
+    lldb::PlatformSP platform_sp = Platform::GetHostPlatform();
+    ASSERT_TRUE(m_debugger_sp->GetTargetList()
+                    .CreateTarget(*m_debugger_sp, "", arch, false,
+                                  platform_sp, m_target_sp)
+                    .Success());
+    m_process_sp = std::make_shared<MockProcess>(
+        m_target_sp, Listener::MakeListener("DWARFExpressionRegisterTest"));
+    m_thread_sp = std::make_shared<MockThread>(*m_process_sp);
+    m_reg_ctx_sp = std::make_shared<MockRegisterContext>(*m_thread_sp);
+  }
+
+  void TearDown() override {
+    m_reg_ctx_sp.reset();
+    m_thread_sp.reset();
+    m_process_sp.reset();
+    m_target_sp.reset();
+    Debugger::Destroy(m_debugger_sp);
+  }
+
+protected:
+  lldb::DebuggerSP m_debugger_sp;
+  lldb::TargetSP m_target_sp;
+  lldb::ProcessSP m_process_sp;
+  lldb::ThreadSP m_thread_sp;
+  lldb::RegisterContextSP m_reg_ctx_sp;
+};
+
+TEST(DWARFExpressionTest, SimpleLocationsMatchEvaluator) {
+  const std::vector<std::vector<uint8_t>> expressions = {
+      {DW_OP_reg5},
+      {DW_OP_regx, 0x21},
+      {DW_OP_breg7, 0x78},
+      {DW_OP_bregx, 0x10, 0x08},
+      {DW_OP_fbreg, 0x70},
+      // Not simple: more than one opcode.
+      {DW_OP_breg7, 0x00, DW_OP_deref},
+  };
+
+  for (const auto &opcodes : expressions) {
+    EvaluationResult decoded, stack;
+    EvaluateBothWays(opcodes, decoded, stack);
+    EXPECT_EQ(stack.success, decoded.success);
+    EXPECT_EQ(stack.error, decoded.error);
+  }
+}
+
+TEST(DWARFExpressionTest, NonSimpleLocation) {
+  EvaluationResult decoded, stack;
+  EvaluateBothWays({DW_OP_lit5, DW_OP_lit3, DW_OP_plus}, decoded, stack);
+  ASSERT_TRUE(decoded.success);
+  ASSERT_TRUE(stack.success);
+  EXPECT_EQ(8u, decoded.value.GetScalar().UInt());
+  EXPECT_EQ(stack.value.GetScalar().UInt(), decoded.value.GetScalar().UInt());
+}
+
+TEST_F(DWARFExpressionRegisterTest, Register) {
+  for (const std::vector<uint8_t> &opcodes :
+       std::vector<std::vector<uint8_t>>{{DW_OP_reg5}, {DW_OP_regx, 0x05}}) {
+    EvaluationResult decoded, stack;
+    EvaluateBothWays(opcodes, decoded, stack, nullptr, m_reg_ctx_sp.get());
+    ASSERT_TRUE(stack.success) << stack.error;
+    ASSERT_TRUE(decoded.success) << decoded.error;
+    EXPECT_EQ(Value::eValueTypeScalar, decoded.value.GetValueType());
+    EXPECT_EQ(Value::eContextTypeRegisterInfo, decoded.value.GetContextType());
+    EXPECT_EQ(m_reg_ctx_sp->GetRegisterInfoAtIndex(5),
+              decoded.value.GetRegisterInfo());
+    EXPECT_EQ(MockRegisterContext::GetValue(5),
+              decoded.value.GetScalar().ULongLong());
+    EXPECT_EQ(stack.value.GetScalar().ULongLong(),
+              decoded.value.GetScalar().ULongLong());
+  }
+}
+
+TEST_F(DWARFExpressionRegisterTest, RegisterOffset) {
+  struct {
+    std::vector<uint8_t> opcodes;
+    uint64_t address;
+  } cases[] = {
+      // r7 - 8
+      {{DW_OP_breg7, 0x78}, MockRegisterContext::GetValue(7) - 8},
+      // r3 + 16
+      {{DW_OP_bregx, 0x03, 0x10}, MockRegisterContext::GetValue(3) + 16},
+  };
+
+  ExecutionContext exe_ctx(m_thread_sp);
+  for (const auto &c : cases) {
+    EvaluationResult decoded, stack;
+    EvaluateBothWays(c.opcodes, decoded, stack, &exe_ctx, m_reg_ctx_sp.get());
+    ASSERT_TRUE(stack.success) << stack.error;
+    ASSERT_TRUE(decoded.success) << decoded.error;
+    EXPECT_EQ(Value::eValueTypeLoadAddress, decoded.value.GetValueType());
+    EXPECT_EQ(Value::eContextTypeInvalid, decoded.value.GetContextType());
+    EXPECT_EQ(c.address, decoded.value.GetScalar().ULongLong());
+    EXPECT_EQ(stack.value.GetValueType(), decoded.value.GetValueType());
+    EXPECT_EQ(stack.value.GetScalar().ULongLong(),
+              decoded.value.GetScalar().ULongLong());
+  }
+}
+
+TEST_F(DWARFExpressionRegisterTest, Errors) {
+  const std::vector<std::vector<uint8_t>> expressions = {
+      // There is no register 31.
+      {DW_OP_reg31},
+      {DW_OP_breg31, 0x00},
+      // The execution context has a thread but no frame.
+      {DW_OP_fbreg, 0x70},
+  };
+
+  ExecutionContext exe_ctx(m_thread_sp);
+  for (const auto &opcodes : expressions) {
+    EvaluationResult decoded, stack;
+    EvaluateBothWays(opcodes, decoded, stack, &exe_ctx, m_reg_ctx_sp.get());
+    EXPECT_FALSE(decoded.success);
+    EXPECT_FALSE(stack.success);
+    EXPECT_EQ(stack.error, decoded.error);
+  }
+}
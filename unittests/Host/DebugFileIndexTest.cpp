@@ -0,0 +1,80 @@
+//===-- DebugFileIndexTest.cpp ----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Host/DebugFileIndex.h"
+#include "gtest/gtest.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
+
+using namespace lldb_private;
+
+namespace {
+
+class DebugFileIndexTest : public testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_FALSE(
+        llvm::sys::fs::createUniqueDirectory("DebugFileIndexTest", m_dir));
+  }
+
+  void TearDown() override { llvm::sys::fs::remove_directories(m_dir); }
+
+  // Creates "<m_dir>/.build-id/<subdir>/<name>".
+  void CreateFile(llvm::StringRef subdir, llvm::StringRef name) {
+    llvm::SmallString<128> path(m_dir);
+    llvm::sys::path::append(path, ".build-id", subdir);
+    ASSERT_FALSE(llvm::sys::fs::create_directories(path));
+    llvm::sys::path::append(path, name);
+    std::error_code EC;
+    llvm::raw_fd_ostream os(path, EC, llvm::sys::fs::F_None);
+    ASSERT_FALSE(EC);
+  }
+
+  llvm::SmallString<128> m_dir;
+};
+
+UUID MakeBuildID(uint8_t first_byte) {
+  uint8_t bytes[20];
+  for (size_t i = 0; i < sizeof(bytes); ++i)
+    bytes[i] = 0xa0 + i;
+  bytes[0] = first_byte;
+  UUID uuid;
+  uuid.SetBytes(bytes, sizeof(bytes));
+  return uuid;
+}
+
+} // namespace
+
+TEST_F(DebugFileIndexTest, FindBuildIDFile) {
+  const UUID uuid = MakeBuildID(0xab);
+  CreateFile("ab", "a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3.debug");
+
+  DebugFileIndex index;
+  FileSpec debug_dir(m_dir.c_str(), false);
+  FileSpec found = index.FindBuildIDFile(debug_dir, uuid);
+  EXPECT_TRUE(found.Exists());
+  EXPECT_EQ("a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3.debug",
+            found.GetFilename().GetStringRef());
+
+  EXPECT_FALSE(index.FindBuildIDFile(debug_dir, MakeBuildID(0xac)));
+  EXPECT_FALSE(index.FindBuildIDFile(debug_dir, UUID()));
+}
+
+TEST_F(DebugFileIndexTest, FindsFilesAddedLater) {
+  const UUID uuid = MakeBuildID(0x12);
+  DebugFileIndex index;
+  FileSpec debug_dir(m_dir.c_str(), false);
+  EXPECT_FALSE(index.FindBuildIDFile(debug_dir, uuid));
+
+  CreateFile("12", "a1a2a3a4a5a6a7a8a9aaabacadaeafb0b1b2b3.debug");
+  EXPECT_TRUE(index.FindBuildIDFile(debug_dir, uuid).Exists());
+}
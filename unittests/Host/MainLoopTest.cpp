@@ -0,0 +1,160 @@
+//===-- MainLoopTest.cpp ----------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "lldb/Host/MainLoop.h"
+#include "lldb/Host/File.h"
+
+#include "gtest/gtest.h"
+
+#include <csignal>
+#include <memory>
+#include <unistd.h>
+#include <vector>
+
+using namespace lldb_private;
+
+namespace {
+
+class MainLoopTest : public testing::TestWithParam<MainLoop::Backend> {
+public:
+  void SetUp() override {
+    ASSERT_EQ(0, pipe(m_fds));
+    m_read_sp = std::make_shared<File>(m_fds[0], true);
+  }
+
+  void TearDown() override {
+    m_read_sp.reset();
+    close(m_fds[1]);
+  }
+
+protected:
+  void WriteByte() {
+    char c = 'X';
+    ASSERT_EQ(1, write(m_fds[1], &c, 1));
+  }
+
+  void ReadByte() {
+    char c;
+    ASSERT_EQ(1, read(m_fds[0], &c, 1));
+  }
+
+  int m_fds[2];
+  lldb::IOObjectSP m_read_sp;
+};
+
+} // namespace
+
+TEST_P(MainLoopTest, ReadObject) {
+  MainLoop loop(GetParam());
+  Error error;
+  unsigned callback_count = 0;
+
+  WriteByte();
+  auto handle = loop.RegisterReadObject(
+      m_read_sp,
+      [&](MainLoopBase &loop) {
+        ++callback_count;
+        loop.RequestTermination();
+      },
+      error);
+  ASSERT_TRUE(error.Success());
+  ASSERT_TRUE(handle);
+
+  ASSERT_TRUE(loop.Run().Success());
+  EXPECT_EQ(1u, callback_count);
+}
+
+TEST_P(MainLoopTest, RegisterTwice) {
+  MainLoop loop(GetParam());
+  Error error;
+
+  auto handle = loop.RegisterReadObject(
+      m_read_sp, [](MainLoopBase &) {}, error);
+  ASSERT_TRUE(error.Success());
+  ASSERT_TRUE(handle);
+
+  auto handle2 = loop.RegisterReadObject(
+      m_read_sp, [](MainLoopBase &) {}, error);
+  EXPECT_TRUE(error.Fail());
+  EXPECT_FALSE(handle2);
+}
+
+TEST_P(MainLoopTest, Signal) {
+  MainLoop loop(GetParam());
+  Error error;
+  unsigned callback_count = 0;
+
+  auto handle = loop.RegisterSignal(SIGUSR1,
+                                    [&](MainLoopBase &loop) {
+                                      ++callback_count;
+                                      loop.RequestTermination();
+                                    },
+                                    error);
+  ASSERT_TRUE(error.Success());
+  ASSERT_TRUE(handle);
+
+  // The signal is blocked until the loop waits for it.
+  ASSERT_EQ(0, pthread_kill(pthread_self(), SIGUSR1));
+  ASSERT_TRUE(loop.Run().Success());
+  EXPECT_EQ(1u, callback_count);
+}
+
+// Check that the loop keeps dispatching to the one ready descriptor among
+// 1000 registered ones. The callback makes its own descriptor ready again, so
+// every iteration of the loop handles exactly one wakeup.
+TEST_P(MainLoopTest, ManyIdleDescriptors) {
+  const size_t num_descriptors = 1000;
+  const unsigned num_wakeups = 1000;
+
+  MainLoop loop(GetParam());
+  Error error;
+
+  // Stay below FD_SETSIZE so that the pselect backend is covered too: all
+  // the idle descriptors refer to the same pipe, which never becomes
+  // readable.
+  int idle_fds[2];
+  ASSERT_EQ(0, pipe(idle_fds));
+  unsigned idle_callbacks = 0;
+  std::vector<lldb::IOObjectSP> files;
+  std::vector<MainLoop::ReadHandleUP> handles;
+  for (size_t i = 0; i + 1 < num_descriptors; ++i) {
+    files.push_back(std::make_shared<File>(dup(idle_fds[0]), true));
+    handles.push_back(loop.RegisterReadObject(
+        files.back(), [&](MainLoopBase &) { ++idle_callbacks; }, error));
+    ASSERT_TRUE(error.Success());
+  }
+
+  unsigned wakeups = 0;
+  handles.push_back(loop.RegisterReadObject(
+      m_read_sp,
+      [&](MainLoopBase &loop) {
+        ReadByte();
+        if (++wakeups == num_wakeups) {
+          loop.RequestTermination();
+          return;
+        }
+        WriteByte();
+      },
+      error));
+  ASSERT_TRUE(error.Success());
+
+  WriteByte();
+  ASSERT_TRUE(loop.Run().Success());
+  EXPECT_EQ(num_wakeups, wakeups);
+  EXPECT_EQ(0u, idle_callbacks);
+
+  handles.clear();
+  files.clear();
+  close(idle_fds[0]);
+  close(idle_fds[1]);
+}
+
+INSTANTIATE_TEST_CASE_P(Backends, MainLoopTest,
+                        testing::Values(MainLoop::Backend::PSelect,
+                                        MainLoop::Backend::EPoll));
@@ -370,3 +370,52 @@ TEST_F(GDBRemoteCommunicationClientTest, GetMemoryRegionInfoInvalidResponse) {
   HandlePacket(server, "qMemoryRegionInfo:4000", "start:4000;size:0000;");
   EXPECT_FALSE(result.get().Success());
 }
+
+TEST_F(GDBRemoteCommunicationClientTest, GetMemoryChecksums) {
+  TestClient client;
+  MockServer server;
+  Connect(client, server);
+  if (HasFailure())
+    return;
+
+  std::vector<MemoryCache::AddrRange> ranges = {
+      MemoryCache::AddrRange(0x1000, 0x200),
+      MemoryCache::AddrRange(0x1200, 0x200),
+      MemoryCache::AddrRange(0x8000, 0x10)};
+  std::vector<llvm::Optional<uint32_t>> checksums;
+  std::future<Error> result = std::async(std::launch::async, [&] {
+    return client.GetMemoryChecksums(ranges, checksums);
+  });
+
+  HandlePacket(server, "qSupported:xmlRegisters=i386,arm,mips",
+               "PacketSize=20000;qMemoryChecksums+");
+  HandlePacket(server, "qMemoryChecksums:1000,200;1200,200;8000,10",
+               "deadbeef;0;x");
+  ASSERT_TRUE(result.get().Success());
+  ASSERT_EQ(3u, checksums.size());
+  EXPECT_EQ(0xdeadbeefu, checksums[0].getValue());
+  EXPECT_EQ(0u, checksums[1].getValue());
+  EXPECT_FALSE(checksums[2].hasValue());
+}
+
+TEST_F(GDBRemoteCommunicationClientTest, GetMemoryChecksumsInvalidResponse) {
+  TestClient client;
+  MockServer server;
+  Connect(client, server);
+  if (HasFailure())
+    return;
+
+  std::vector<MemoryCache::AddrRange> ranges = {
+      MemoryCache::AddrRange(0x1000, 0x200),
+      MemoryCache::AddrRange(0x1200, 0x200)};
+  std::vector<llvm::Optional<uint32_t>> checksums;
+  std::future<Error> result = std::async(std::launch::async, [&] {
+    return client.GetMemoryChecksums(ranges, checksums);
+  });
+
+  HandlePacket(server, "qSupported:xmlRegisters=i386,arm,mips",
+               "PacketSize=20000;qMemoryChecksums+");
+  HandlePacket(server, "qMemoryChecksums:1000,200;1200,200", "deadbeef");
+  EXPECT_FALSE(result.get().Success());
+  EXPECT_TRUE(checksums.empty());
+}
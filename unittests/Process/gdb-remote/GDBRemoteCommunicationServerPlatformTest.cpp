@@ -0,0 +1,171 @@
+//===-- GDBRemoteCommunicationServerPlatformTest.cpp ------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+#include <thread>
+
+#include "GDBRemoteTestUtils.h"
+
+#include "Plugins/Process/gdb-remote/GDBRemoteCommunicationClient.h"
+#include "Plugins/Process/gdb-remote/GDBRemoteCommunicationServerPlatform.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Utility/FileSpec.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+
+using namespace lldb_private::process_gdb_remote;
+using namespace lldb_private;
+using namespace lldb;
+using namespace llvm;
+
+namespace {
+
+typedef GDBRemoteCommunication::PacketResult PacketResult;
+
+struct TestClient : public GDBRemoteCommunicationClient {
+  TestClient() { m_send_acks = false; }
+};
+
+struct TestPlatformServer : public GDBRemoteCommunicationServerPlatform {
+  TestPlatformServer()
+      : GDBRemoteCommunicationServerPlatform(Socket::ProtocolTcp, "tcp") {
+    m_send_acks = false;
+  }
+};
+
+// Serves the packets of one client on a thread until it disconnects, the
+// way lldb-server platform serves a session.
+class PlatformSession {
+public:
+  PlatformSession() {
+    Connect(m_client, m_server);
+    m_server.SetUseSessionWorkingDirectory(true);
+    m_thread = std::thread([this] {
+      Error error;
+      bool interrupt = false;
+      bool done = false;
+      while (!interrupt && !done &&
+             m_server.GetPacketAndSendResponse(llvm::None, error, interrupt,
+                                               done) == PacketResult::Success)
+        ;
+    });
+  }
+
+  ~PlatformSession() {
+    m_client.Disconnect();
+    m_thread.join();
+  }
+
+  TestClient &GetClient() { return m_client; }
+
+private:
+  TestClient m_client;
+  TestPlatformServer m_server;
+  std::thread m_thread;
+};
+
+std::string GetCurrentPath() {
+  SmallString<128> cwd;
+  EXPECT_FALSE(sys::fs::current_path(cwd));
+  return cwd.str();
+}
+
+} // end anonymous namespace
+
+class GDBRemoteCommunicationServerPlatformTest : public GDBRemoteTest {
+public:
+  static void SetUpTestCase() {
+    GDBRemoteTest::SetUpTestCase();
+    HostInfo::Initialize();
+  }
+
+  static void TearDownTestCase() {
+    HostInfo::Terminate();
+    GDBRemoteTest::TearDownTestCase();
+  }
+
+  void SetUp() override {
+    for (SmallString<128> &dir : m_dirs)
+      ASSERT_FALSE(sys::fs::createUniqueDirectory("platform-session", dir));
+  }
+
+  void TearDown() override {
+    for (SmallString<128> &dir : m_dirs)
+      sys::fs::remove(dir);
+  }
+
+protected:
+  SmallString<128> m_dirs[2];
+};
+
+TEST_F(GDBRemoteCommunicationServerPlatformTest, SharedPortMap) {
+  GDBRemoteCommunicationServerPlatform::SharedPortMapSP port_map_sp =
+      std::make_shared<GDBRemoteCommunicationServerPlatform::SharedPortMap>();
+  TestPlatformServer first;
+  TestPlatformServer second;
+  first.SetSharedPortMap(port_map_sp);
+  second.SetSharedPortMap(port_map_sp);
+  first.SetPortMap({{1000, LLDB_INVALID_PROCESS_ID},
+                    {1001, LLDB_INVALID_PROCESS_ID}});
+
+  // Ports handed out by one session aren't available to the other.
+  const uint16_t first_port = first.GetNextAvailablePort();
+  const uint16_t second_port = second.GetNextAvailablePort();
+  EXPECT_EQ(1000, first_port);
+  EXPECT_EQ(1001, second_port);
+  EXPECT_EQ(UINT16_MAX, first.GetNextAvailablePort());
+
+  EXPECT_TRUE(first.AssociatePortWithProcess(first_port, 47));
+  EXPECT_TRUE(second.FreePortForProcess(47));
+  EXPECT_EQ(1000, second.GetNextAvailablePort());
+}
+
+TEST_F(GDBRemoteCommunicationServerPlatformTest, SessionWorkingDirectory) {
+  const std::string process_cwd = GetCurrentPath();
+  PlatformSession sessions[2];
+
+  for (int i = 0; i < 2; ++i) {
+    TestClient &client = sessions[i].GetClient();
+    ASSERT_EQ(0, client.SetWorkingDir(FileSpec(m_dirs[i], false)));
+  }
+
+  // Each session has its own working directory and the one of the process
+  // doesn't change.
+  for (int i = 0; i < 2; ++i) {
+    FileSpec working_dir;
+    ASSERT_TRUE(sessions[i].GetClient().GetWorkingDir(working_dir));
+    EXPECT_EQ(m_dirs[i].str(), working_dir.GetPath());
+  }
+  EXPECT_EQ(process_cwd, GetCurrentPath());
+
+  // Relative paths in file and platform packets are resolved against the
+  // session's directory.
+  TestClient &client = sessions[0].GetClient();
+  const FileSpec subdir("session-subdir", false);
+  SmallString<128> subdir_path(m_dirs[0]);
+  sys::path::append(subdir_path, "session-subdir");
+
+  ASSERT_TRUE(client.MakeDirectory(subdir, 0755).Success());
+  EXPECT_TRUE(sys::fs::is_directory(subdir_path));
+  EXPECT_TRUE(client.GetFileExists(subdir));
+  EXPECT_FALSE(sessions[1].GetClient().GetFileExists(subdir));
+
+  ASSERT_TRUE(client.Unlink(subdir).Success());
+  EXPECT_FALSE(sys::fs::exists(subdir_path));
+
+  // Shell commands run in the session's directory by default.
+  int status = -1;
+  std::string output;
+  ASSERT_TRUE(client
+                  .RunShellCommand("pwd", FileSpec(), &status, nullptr,
+                                   &output, 10)
+                  .Success());
+  EXPECT_EQ(0, status);
+  EXPECT_EQ(m_dirs[0].str(), StringRef(output).rtrim());
+}
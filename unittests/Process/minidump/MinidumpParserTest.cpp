@@ -20,12 +20,14 @@
 
 #include "lldb/Core/ArchSpec.h"
 #include "lldb/Target/MemoryRegionInfo.h"
+#include "lldb/Utility/DataBufferHeap.h"
 #include "lldb/Utility/DataBufferLLVM.h"
 #include "lldb/Utility/DataExtractor.h"
 #include "lldb/Utility/FileSpec.h"
 
 #include "llvm/ADT/ArrayRef.h"
 #include "llvm/ADT/Optional.h"
+#include "llvm/ADT/STLExtras.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/MemoryBuffer.h"
 #include "llvm/Support/Path.h"
@@ -221,6 +223,100 @@ TEST_F(MinidumpParserTest, FindMemoryRangeWithFullMemoryMinidump) {
   EXPECT_FALSE(parser->FindMemoryRange(0x7ffe0000 + 4096).hasValue());
 }
 
+template <typename T>
+static void AppendObject(std::vector<uint8_t> &data, const T &obj) {
+  const uint8_t *bytes = reinterpret_cast<const uint8_t *>(&obj);
+  data.insert(data.end(), bytes, bytes + sizeof(obj));
+}
+
+TEST_F(MinidumpParserTest, FindMemoryRangeUnsortedAndOverlapping) {
+  // Build a minidump with an unsorted MemoryList and a Memory64List range
+  // that covers several of the MemoryList ranges.
+  const uint64_t memory_list_starts[] = {0x3000, 0x1800, 0x1a00,
+                                         0x1b00, 0x1c00, 0x1d00};
+  const uint32_t memory_list_count = llvm::array_lengthof(memory_list_starts);
+  const uint32_t directory_rva = sizeof(MinidumpHeader);
+  const uint32_t memory_list_rva =
+      directory_rva + 2 * sizeof(MinidumpDirectory);
+  const uint32_t memory_list_size =
+      sizeof(uint32_t) + memory_list_count * sizeof(MinidumpMemoryDescriptor);
+  const uint32_t memory64_list_rva = memory_list_rva + memory_list_size;
+  const uint32_t memory64_list_size =
+      2 * sizeof(uint64_t) + sizeof(MinidumpMemoryDescriptor64);
+  const uint32_t data_rva = memory64_list_rva + memory64_list_size;
+  const uint32_t memory64_data_rva = data_rva + memory_list_count * 0x100;
+
+  std::vector<uint8_t> data;
+  MinidumpHeader header;
+  memset(&header, 0, sizeof(header));
+  header.signature = static_cast<uint32_t>(MinidumpHeaderConstants::Signature);
+  header.version = static_cast<uint32_t>(MinidumpHeaderConstants::Version);
+  header.streams_count = 2;
+  header.stream_directory_rva = directory_rva;
+  AppendObject(data, header);
+
+  MinidumpDirectory directory;
+  directory.stream_type = static_cast<uint32_t>(MinidumpStreamType::MemoryList);
+  directory.location.data_size = memory_list_size;
+  directory.location.rva = memory_list_rva;
+  AppendObject(data, directory);
+  directory.stream_type =
+      static_cast<uint32_t>(MinidumpStreamType::Memory64List);
+  directory.location.data_size = memory64_list_size;
+  directory.location.rva = memory64_list_rva;
+  AppendObject(data, directory);
+
+  // Each MemoryList range is 0x80 bytes, with its data 0x100 bytes after the
+  // previous one's.
+  AppendObject(data, llvm::support::ulittle32_t(memory_list_count));
+  for (uint32_t i = 0; i < memory_list_count; ++i) {
+    MinidumpMemoryDescriptor descriptor;
+    descriptor.start_of_memory_range = memory_list_starts[i];
+    descriptor.memory.data_size = 0x80;
+    descriptor.memory.rva = data_rva + i * 0x100;
+    AppendObject(data, descriptor);
+  }
+
+  // 0x1000-0x2000 at memory64_data_rva.
+  AppendObject(data, llvm::support::ulittle64_t(1));
+  AppendObject(data, llvm::support::ulittle64_t(memory64_data_rva));
+  MinidumpMemoryDescriptor64 descriptor64;
+  descriptor64.start_of_memory_range = 0x1000;
+  descriptor64.data_size = 0x1000;
+  AppendObject(data, descriptor64);
+
+  data.resize(memory64_data_rva + 0x1000);
+
+  llvm::Optional<MinidumpParser> optional_parser = MinidumpParser::Create(
+      std::make_shared<DataBufferHeap>(data.data(), data.size()));
+  ASSERT_TRUE(optional_parser.hasValue());
+  parser.reset(new MinidumpParser(optional_parser.getValue()));
+
+  EXPECT_FALSE(parser->FindMemoryRange(0xfff).hasValue());
+  check_mem_range_exists(parser, 0x1000, 0x1000);
+  for (uint32_t i = 0; i < memory_list_count; ++i)
+    check_mem_range_exists(parser, memory_list_starts[i], 0x80);
+  EXPECT_FALSE(parser->FindMemoryRange(0x2000).hasValue());
+  EXPECT_FALSE(parser->FindMemoryRange(0x3080).hasValue());
+
+  // The MemoryList ranges take precedence over the Memory64List one.
+  llvm::Optional<minidump::Range> range = parser->FindMemoryRange(0x1a40);
+  ASSERT_TRUE(range.hasValue());
+  EXPECT_EQ(0x1a00UL, range->start);
+  EXPECT_EQ(parser->GetData().data() + data_rva + 2 * 0x100,
+            range->range_ref.data());
+
+  // Addresses past the small ranges fall back to the one covering them, no
+  // matter how many small ranges start in between.
+  for (lldb::addr_t addr : {0x1900, 0x1e00, 0x1fff}) {
+    range = parser->FindMemoryRange(addr);
+    ASSERT_TRUE(range.hasValue());
+    EXPECT_EQ(0x1000UL, range->start);
+    EXPECT_EQ(parser->GetData().data() + memory64_data_rva,
+              range->range_ref.data());
+  }
+}
+
 void check_region_info(std::unique_ptr<MinidumpParser> &parser,
                        const uint64_t addr, MemoryRegionInfo::OptionalBool read,
                        MemoryRegionInfo::OptionalBool write,
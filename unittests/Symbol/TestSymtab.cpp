@@ -0,0 +1,73 @@
+//===-- TestSymtab.cpp ------------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "lldb/Symbol/Symtab.h"
+#include "lldb/Utility/DataBufferHeap.h"
+
+using namespace lldb;
+using namespace lldb_private;
+
+namespace {
+unsigned g_num_decoded = 0;
+
+Mangled DecodeName(const char *raw_name) {
+  ++g_num_decoded;
+  return Mangled(ConstString(raw_name), false);
+}
+
+// Adds one nameless symbol per raw name in "names".
+void AddSymbols(Symtab &symtab, Symtab::LazyNames &lazy_names,
+                const std::vector<const char *> &names) {
+  for (const char *name : names) {
+    Symbol symbol(symtab.GetNumSymbols(), nullptr, false, eSymbolTypeCode,
+                  true, false, false, false, SectionSP(),
+                  0x1000 + 0x10 * symtab.GetNumSymbols(), 0x10, true, false,
+                  0);
+    uint32_t idx = symtab.AddSymbol(symbol);
+    lazy_names.names.resize(idx + 1, nullptr);
+    lazy_names.names[idx] = name;
+  }
+}
+} // namespace
+
+TEST(SymtabTest, LazyNames) {
+  const char raw_strtab[] = "foo\0bar\0baz";
+  auto strtab_sp =
+      std::make_shared<DataBufferHeap>(raw_strtab, sizeof(raw_strtab));
+  const char *strtab = (const char *)strtab_sp->GetBytes();
+
+  Symtab symtab(nullptr);
+  Symtab::LazyNames lazy_names;
+  lazy_names.buffers.push_back(strtab_sp);
+  AddSymbols(symtab, lazy_names, {strtab, strtab + 4, strtab + 8});
+
+  g_num_decoded = 0;
+  symtab.SetLazyNames(std::move(lazy_names), DecodeName);
+  EXPECT_EQ(0u, g_num_decoded);
+
+  // Handing out a symbol decodes only its name.
+  const Symbol *bar = symtab.SymbolAtIndex(1);
+  ASSERT_NE(nullptr, bar);
+  EXPECT_EQ(ConstString("bar"), bar->GetName());
+  EXPECT_EQ(1u, g_num_decoded);
+  EXPECT_EQ(bar, symtab.FindSymbolByID(1));
+  EXPECT_EQ(1u, g_num_decoded);
+
+  // Name lookups need all the names.
+  Symbol *baz = symtab.FindFirstSymbolWithNameAndType(
+      ConstString("baz"), eSymbolTypeAny, Symtab::eDebugAny,
+      Symtab::eVisibilityAny);
+  ASSERT_NE(nullptr, baz);
+  EXPECT_EQ(2u, baz->GetID());
+  EXPECT_EQ(3u, g_num_decoded);
+  EXPECT_EQ(ConstString("foo"), symtab.SymbolAtIndex(0)->GetName());
+  EXPECT_EQ(3u, g_num_decoded);
+}
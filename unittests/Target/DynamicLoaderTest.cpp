@@ -0,0 +1,174 @@
+//===-- DynamicLoaderTest.cpp -----------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
+#include "Plugins/Platform/Linux/PlatformLinux.h"
+#include "lldb/Core/ArchSpec.h"
+#include "lldb/Core/Debugger.h"
+#include "lldb/Core/Listener.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Target/DynamicLoader.h"
+#include "lldb/Target/Platform.h"
+#include "lldb/Target/Process.h"
+#include "lldb/Target/Target.h"
+#include "lldb/Target/ThreadPlan.h"
+#include "lldb/Utility/ConstString.h"
+#include "lldb/Utility/FileSpec.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+
+#include <vector>
+
+extern const char *TestMainArgv0;
+
+using namespace lldb_private;
+using namespace lldb_private::platform_linux;
+using namespace lldb;
+
+namespace {
+
+class MockProcess : public Process {
+public:
+  MockProcess(TargetSP target_sp, ListenerSP listener_sp)
+      : Process(target_sp, listener_sp) {}
+
+  ConstString GetPluginName() override { return ConstString("mock"); }
+  uint32_t GetPluginVersion() override { return 1; }
+
+  bool CanDebug(TargetSP target, bool plugin_specified_by_name) override {
+    return false;
+  }
+  Error DoDestroy() override { return Error(); }
+  void RefreshStateAfterStop() override {}
+  size_t DoReadMemory(addr_t vm_addr, void *buf, size_t size,
+                      Error &error) override {
+    error.SetErrorString("mock process has no memory");
+    return 0;
+  }
+  bool UpdateThreadList(ThreadList &old_thread_list,
+                        ThreadList &new_thread_list) override {
+    return false;
+  }
+};
+
+class MockDynamicLoader : public DynamicLoader {
+public:
+  MockDynamicLoader(Process *process) : DynamicLoader(process) {}
+
+  ConstString GetPluginName() override { return ConstString("mock"); }
+  uint32_t GetPluginVersion() override { return 1; }
+
+  void DidAttach() override {}
+  void DidLaunch() override {}
+  ThreadPlanSP GetStepThroughTrampolinePlan(Thread &thread,
+                                            bool stop_others) override {
+    return ThreadPlanSP();
+  }
+  Error CanLoadImage() override { return Error("not supported"); }
+};
+
+class DynamicLoaderTest : public testing::Test {
+public:
+  static void SetUpTestCase() {
+    HostInfo::Initialize();
+    ObjectFileELF::Initialize();
+    PlatformLinux::Initialize();
+    Debugger::Initialize(nullptr);
+    // Modules are only preloaded for host platforms.
+    Platform::SetHostPlatform(std::make_shared<PlatformLinux>(true));
+  }
+
+  static void TearDownTestCase() {
+    Debugger::Terminate();
+    PlatformLinux::Terminate();
+    ObjectFileELF::Terminate();
+    HostInfo::Terminate();
+  }
+
+  // Make two copies of the test module that no other test has put in the
+  // shared module list, and a process to load them into.
+  void SetUp() override {
+    ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("dynamic-loader", m_dir));
+    llvm::SmallString<128> input(llvm::sys::path::parent_path(TestMainArgv0));
+    llvm::sys::path::append(input, "Inputs", "TestModule.so");
+    for (const char *name : {"libfirst.so", "libsecond.so"}) {
+      llvm::SmallString<128> path(m_dir);
+      llvm::sys::path::append(path, name);
+      ASSERT_FALSE(llvm::sys::fs::copy_file(input, path));
+      m_files.push_back(FileSpec(path, false));
+    }
+
+    m_debugger_sp = Debugger::CreateInstance();
+    ArchSpec arch("x86_64-pc-linux");
+    PlatformSP platform_sp = Platform::GetHostPlatform();
+    ASSERT_TRUE(m_debugger_sp->GetTargetList()
+                    .CreateTarget(*m_debugger_sp, "", arch, false,
+                                  platform_sp, m_target_sp)
+                    .Success());
+    m_process_sp = std::make_shared<MockProcess>(
+        m_target_sp, Listener::MakeListener("DynamicLoaderTest"));
+  }
+
+  void TearDown() override {
+    m_process_sp.reset();
+    m_target_sp.reset();
+    Debugger::Destroy(m_debugger_sp);
+    ModuleList::RemoveOrphanSharedModules(true);
+    for (const FileSpec &file : m_files)
+      llvm::sys::fs::remove(file.GetPath());
+    llvm::sys::fs::remove(m_dir);
+  }
+
+protected:
+  llvm::SmallString<128> m_dir;
+  std::vector<FileSpec> m_files;
+  DebuggerSP m_debugger_sp;
+  TargetSP m_target_sp;
+  ProcessSP m_process_sp;
+};
+
+} // namespace
+
+TEST_F(DynamicLoaderTest, PreloadModules) {
+  const ArchSpec &arch = m_target_sp->GetArchitecture();
+  const ModuleSpec first_spec(m_files[0], arch);
+  const ModuleSpec second_spec(m_files[1], arch);
+
+  // The first library is in the target already.
+  ModuleSP first_sp = m_target_sp->GetSharedModule(first_spec);
+  ASSERT_TRUE(first_sp);
+
+  MockDynamicLoader loader(m_process_sp.get());
+  loader.PreloadModules(m_files);
+
+  // Both libraries are in the shared module list now, and the first one
+  // wasn't created again.
+  ModuleList matching_modules;
+  EXPECT_EQ(1u, ModuleList::FindSharedModules(first_spec, matching_modules));
+  EXPECT_EQ(first_sp, matching_modules.GetModuleAtIndex(0));
+
+  ModuleSP second_sp;
+  bool did_create = true;
+  EXPECT_TRUE(ModuleList::GetSharedModule(second_spec, second_sp, nullptr,
+                                          nullptr, &did_create)
+                  .Success());
+  ASSERT_TRUE(second_sp);
+  EXPECT_FALSE(did_create);
+  EXPECT_TRUE(second_sp->GetObjectFile() != nullptr);
+
+  // Loading the second library finds the preloaded module.
+  EXPECT_EQ(second_sp, m_target_sp->GetSharedModule(second_spec));
+}
@@ -3,13 +3,17 @@
 #include "llvm/ADT/SmallString.h"
 #include "llvm/Support/FileSystem.h"
 #include "llvm/Support/Path.h"
+#include "llvm/Support/raw_ostream.h"
 
 #include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
 #include "lldb/Core/Module.h"
 #include "lldb/Core/ModuleSpec.h"
 #include "lldb/Host/HostInfo.h"
+#include "lldb/Symbol/ObjectFile.h"
 #include "lldb/Symbol/SymbolContext.h"
+#include "lldb/Symbol/Symtab.h"
 #include "lldb/Target/ModuleCache.h"
+#include "lldb/Utility/DataBufferHeap.h"
 
 extern const char *TestMainArgv0;
 
@@ -167,3 +171,119 @@ TEST_F(ModuleCacheTest, GetAndPutStrangeHostname) {
   TryGetAndPut(test_cache_dir, "tab\tcolon:asterisk*", expect_download);
   VerifyDiskState(test_cache_dir, "tab_colon_asterisk_");
 }
+
+TEST_F(ModuleCacheTest, PutAndGetSymtab) {
+  FileSpec test_cache_dir = s_cache_dir;
+  test_cache_dir.AppendPathComponent("PutAndGetSymtab");
+
+  FileSpec module_file(s_test_executable, false);
+  auto module_sp = std::make_shared<Module>(ModuleSpec(module_file));
+  ObjectFile *objfile = module_sp->GetObjectFile();
+  ASSERT_NE(nullptr, objfile);
+  Symtab *symtab = objfile->GetSymtab();
+  ASSERT_NE(nullptr, symtab);
+  ASSERT_LT(0u, symtab->GetNumSymbols());
+
+  Error error = ModuleCache::PutSymtab(test_cache_dir, *objfile, *symtab);
+  ASSERT_TRUE(error.Success()) << "Error was: " << error.AsCString();
+  FileSpec symtab_file = GetUuidView(test_cache_dir);
+  symtab_file.GetFilename().SetString(std::string(module_name) + ".symtab");
+  EXPECT_TRUE(symtab_file.Exists());
+
+  // Load the cached symbol table into a separate instance of the module.
+  auto other_module_sp = std::make_shared<Module>(ModuleSpec(module_file));
+  ObjectFile *other_objfile = other_module_sp->GetObjectFile();
+  ASSERT_NE(nullptr, other_objfile);
+  Symtab cached_symtab(other_objfile);
+  ASSERT_TRUE(
+      ModuleCache::GetSymtab(test_cache_dir, *other_objfile, cached_symtab));
+
+  ASSERT_EQ(symtab->GetNumSymbols(), cached_symtab.GetNumSymbols());
+  for (size_t i = 0; i < symtab->GetNumSymbols(); ++i) {
+    const Symbol *expected = symtab->SymbolAtIndex(i);
+    const Symbol *actual = cached_symtab.SymbolAtIndex(i);
+    EXPECT_EQ(expected->GetID(), actual->GetID());
+    EXPECT_EQ(expected->GetName(), actual->GetName());
+    EXPECT_EQ(expected->GetType(), actual->GetType());
+    EXPECT_EQ(expected->GetByteSize(), actual->GetByteSize());
+    EXPECT_EQ(expected->GetFileAddress(), actual->GetFileAddress());
+  }
+}
+
+TEST_F(ModuleCacheTest, PutAndGetSectionData) {
+  FileSpec test_cache_dir = s_cache_dir;
+  test_cache_dir.AppendPathComponent("PutAndGetSectionData");
+
+  FileSpec module_file(s_test_executable, false);
+  auto module_sp = std::make_shared<Module>(ModuleSpec(module_file));
+  ObjectFile *objfile = module_sp->GetObjectFile();
+  ASSERT_NE(nullptr, objfile);
+
+  const ConstString section_name(".zdebug_info");
+  EXPECT_EQ(nullptr, ModuleCache::GetSectionData(test_cache_dir, *objfile,
+                                                 section_name));
+
+  const std::string contents = "decompressed section contents";
+  DataBufferHeap data(contents.data(), contents.size());
+  Error error = ModuleCache::PutSectionData(test_cache_dir, *objfile,
+                                            section_name, data);
+  ASSERT_TRUE(error.Success()) << "Error was: " << error.AsCString();
+  FileSpec section_file = GetUuidView(test_cache_dir);
+  section_file.GetFilename().SetString(std::string(module_name) +
+                                       ".zdebug_info.section");
+  EXPECT_TRUE(section_file.Exists());
+
+  auto other_module_sp = std::make_shared<Module>(ModuleSpec(module_file));
+  ObjectFile *other_objfile = other_module_sp->GetObjectFile();
+  ASSERT_NE(nullptr, other_objfile);
+  DataBufferSP cached_sp = ModuleCache::GetSectionData(
+      test_cache_dir, *other_objfile, section_name);
+  ASSERT_NE(nullptr, cached_sp);
+  EXPECT_EQ(contents,
+            std::string(reinterpret_cast<const char *>(cached_sp->GetBytes()),
+                        cached_sp->GetByteSize()));
+  EXPECT_EQ(nullptr, ModuleCache::GetSectionData(
+                         test_cache_dir, *other_objfile,
+                         ConstString(".zdebug_line")));
+}
+
+TEST_F(ModuleCacheTest, PutSectionDataReplacesStaleFile) {
+  FileSpec test_cache_dir = s_cache_dir;
+  test_cache_dir.AppendPathComponent("PutSectionDataReplacesStaleFile");
+
+  FileSpec module_file(s_test_executable, false);
+  auto module_sp = std::make_shared<Module>(ModuleSpec(module_file));
+  ObjectFile *objfile = module_sp->GetObjectFile();
+  ASSERT_NE(nullptr, objfile);
+
+  // Cache the section once, then clobber the header as if the file had been
+  // written for another build of the module.
+  const ConstString section_name(".zdebug_info");
+  const std::string contents = "decompressed section contents";
+  DataBufferHeap data(contents.data(), contents.size());
+  Error error = ModuleCache::PutSectionData(test_cache_dir, *objfile,
+                                            section_name, data);
+  ASSERT_TRUE(error.Success()) << "Error was: " << error.AsCString();
+  FileSpec section_file = GetUuidView(test_cache_dir);
+  section_file.GetFilename().SetString(std::string(module_name) +
+                                       ".zdebug_info.section");
+  {
+    std::error_code ec;
+    llvm::raw_fd_ostream stale_file(section_file.GetPath(), ec,
+                                    llvm::sys::fs::F_None);
+    ASSERT_FALSE(ec) << ec.message();
+    stale_file << "stale";
+  }
+  EXPECT_EQ(nullptr, ModuleCache::GetSectionData(test_cache_dir, *objfile,
+                                                 section_name));
+
+  error = ModuleCache::PutSectionData(test_cache_dir, *objfile, section_name,
+                                      data);
+  ASSERT_TRUE(error.Success()) << "Error was: " << error.AsCString();
+  DataBufferSP cached_sp =
+      ModuleCache::GetSectionData(test_cache_dir, *objfile, section_name);
+  ASSERT_NE(nullptr, cached_sp);
+  EXPECT_EQ(contents,
+            std::string(reinterpret_cast<const char *>(cached_sp->GetBytes()),
+                        cached_sp->GetByteSize()));
+}
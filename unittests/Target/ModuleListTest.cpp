@@ -0,0 +1,103 @@
+//===-- ModuleListTest.cpp --------------------------------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+
+#include "gtest/gtest.h"
+
+#include "Plugins/ObjectFile/ELF/ObjectFileELF.h"
+#include "lldb/Core/Module.h"
+#include "lldb/Core/ModuleList.h"
+#include "lldb/Core/ModuleSpec.h"
+#include "lldb/Host/HostInfo.h"
+#include "lldb/Utility/FileSpec.h"
+
+#include "llvm/ADT/SmallString.h"
+#include "llvm/Support/FileSystem.h"
+#include "llvm/Support/Path.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+extern const char *TestMainArgv0;
+
+using namespace lldb_private;
+using namespace lldb;
+
+namespace {
+
+class ModuleListTest : public testing::Test {
+public:
+  static void SetUpTestCase() {
+    HostInfo::Initialize();
+    ObjectFileELF::Initialize();
+  }
+
+  static void TearDownTestCase() {
+    ObjectFileELF::Terminate();
+    HostInfo::Terminate();
+  }
+
+  // Work on a copy of the test module that no other test has put in the
+  // shared module list.
+  void SetUp() override {
+    ASSERT_FALSE(llvm::sys::fs::createUniqueDirectory("module-list", m_dir));
+    llvm::SmallString<128> input(llvm::sys::path::parent_path(TestMainArgv0));
+    llvm::sys::path::append(input, "Inputs", "TestModule.so");
+    m_module_path = m_dir;
+    llvm::sys::path::append(m_module_path, "TestModule.so");
+    ASSERT_FALSE(llvm::sys::fs::copy_file(input, m_module_path));
+  }
+
+  void TearDown() override {
+    llvm::sys::fs::remove(m_module_path);
+    llvm::sys::fs::remove(m_dir);
+  }
+
+protected:
+  llvm::SmallString<128> m_dir;
+  llvm::SmallString<128> m_module_path;
+};
+
+} // namespace
+
+TEST_F(ModuleListTest, GetSharedModuleFromManyThreads) {
+  // GetSharedModule() doesn't hold the shared module list lock while it
+  // creates a module, so all of these threads can get to create one.
+  const ModuleSpec module_spec(FileSpec(m_module_path, false));
+  const size_t num_threads = 8;
+  std::vector<ModuleSP> module_sps(num_threads);
+  std::vector<int> did_create(num_threads, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < num_threads; ++i) {
+    threads.emplace_back([&, i] {
+      bool created = false;
+      Error error = ModuleList::GetSharedModule(module_spec, module_sps[i],
+                                                nullptr, nullptr, &created);
+      EXPECT_TRUE(error.Success()) << error.AsCString();
+      did_create[i] = created;
+    });
+  }
+  for (std::thread &thread : threads)
+    thread.join();
+
+  // They must all end up with the one module in the shared list.
+  ASSERT_TRUE(module_sps[0]);
+  for (const ModuleSP &module_sp : module_sps)
+    EXPECT_EQ(module_sps[0], module_sp);
+  EXPECT_EQ(1, std::count(did_create.begin(), did_create.end(), 1));
+
+  ModuleList matching_modules;
+  EXPECT_EQ(1u, ModuleList::FindSharedModules(module_spec, matching_modules));
+  EXPECT_EQ(module_sps[0], matching_modules.GetModuleAtIndex(0));
+
+  ModuleSP module_sp = module_sps[0];
+  module_sps.clear();
+  matching_modules.Clear();
+  EXPECT_TRUE(ModuleList::RemoveSharedModule(module_sp));
+}
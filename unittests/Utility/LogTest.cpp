@@ -278,3 +278,76 @@ TEST_F(LogChannelTest, LogGetLogThread) {
   // any undefined behavior (run the test under TSAN to verify this).
   EXPECT_TRUE(mask == 0 || mask == FOO) << "mask: " << mask;
 }
+
+TEST_F(LogChannelTest, Buffered) {
+  // Test that the records of a buffered channel are all written, in order,
+  // when the channel is disabled.
+  std::string message;
+  std::shared_ptr<llvm::raw_string_ostream> stream_sp(
+      new llvm::raw_string_ostream(message));
+  std::string err;
+  EXPECT_TRUE(EnableChannel(stream_sp, LLDB_LOG_OPTION_BUFFERED, "chan", {},
+                            err));
+  Log *log = test_channel.GetLogIfAll(FOO);
+
+  std::thread log_thread([log] {
+    for (int i = 0; i < 100; ++i)
+      LLDB_LOG(log, "{0}", i);
+  });
+  log_thread.join();
+  EXPECT_TRUE(DisableChannel("chan", {}, err));
+
+  std::string expected;
+  for (int i = 0; i < 100; ++i)
+    expected += llvm::formatv("{0}\n", i).str();
+  EXPECT_EQ(expected, stream_sp->str());
+}
+
+TEST_F(LogChannelTest, TerminateWritesBufferedRecords) {
+  // Test that terminating the logging writes out the pending records and that
+  // buffered channels keep working afterwards.
+  std::string message;
+  std::shared_ptr<llvm::raw_string_ostream> stream_sp(
+      new llvm::raw_string_ostream(message));
+  std::string err;
+  EXPECT_TRUE(EnableChannel(stream_sp, LLDB_LOG_OPTION_BUFFERED, "chan", {},
+                            err));
+  Log *log = test_channel.GetLogIfAll(FOO);
+
+  LLDB_LOG(log, "Hello");
+  Log::Terminate();
+  EXPECT_EQ("Hello\n", stream_sp->str());
+
+  LLDB_LOG(log, "World");
+  EXPECT_TRUE(DisableChannel("chan", {}, err));
+  EXPECT_EQ("Hello\nWorld\n", stream_sp->str());
+}
+
+TEST_F(LogChannelTest, Circular) {
+  // Test that a circular channel keeps the last records in memory, and only
+  // writes them when dumped.
+  std::string message;
+  std::shared_ptr<llvm::raw_string_ostream> stream_sp(
+      new llvm::raw_string_ostream(message));
+  std::string error;
+  llvm::raw_string_ostream error_stream(error);
+  EXPECT_TRUE(Log::EnableLogChannel(stream_sp, LLDB_LOG_OPTION_CIRCULAR,
+                                    "chan", {}, error_stream, 2));
+  Log *log = test_channel.GetLogIfAll(FOO);
+
+  LLDB_LOG(log, "Hello");
+  LLDB_LOG(log, "World");
+  log->Printf("{0}");
+  Log::FlushBufferedLogChannels();
+  EXPECT_EQ("World\n{0}\n", stream_sp->str());
+
+  LLDB_LOG(log, "Hello World");
+  std::string dump;
+  std::shared_ptr<llvm::raw_string_ostream> dump_sp(
+      new llvm::raw_string_ostream(dump));
+  EXPECT_TRUE(Log::DumpLogChannel("chan", dump_sp, error_stream));
+  EXPECT_EQ("Hello World\n", dump_sp->str());
+
+  EXPECT_TRUE(Log::DisableLogChannel("chan", {}, error_stream));
+  EXPECT_FALSE(Log::DumpLogChannel("chan", nullptr, error_stream));
+}